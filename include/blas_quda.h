@@ -451,6 +451,28 @@ namespace quda {
     */
     void cDotProductCopy(Complex* result, std::vector<ColorSpinorField*>& a, std::vector<ColorSpinorField*>& b, std::vector<ColorSpinorField*>& c);
 
+    // ---------- block_orthonormalize.cpp ----------
+
+    /**
+       @brief Orthonormalize a set of vectors in place using block
+       classical Gram-Schmidt with reorthogonalization (BCGS2).  Each
+       block is projected against the preceding vectors and
+       orthonormalized with Cholesky QR, where a single multi-reduction
+       computes both the projection coefficients and the Gram matrix
+       of the block.  Each block is processed twice, so the
+       orthonormalization costs two global reductions per block,
+       compared to O(N^2) for pairwise Gram-Schmidt.  Works on both
+       host and device fields.
+
+       @param v[in,out] The set of vectors to orthonormalize
+       @param block_size[in] Number of vectors orthonormalized together
+       (if zero, all vectors form a single block)
+       @param loss[out] If non-null, the orthogonality loss ||I - V^dag V||_F,
+       which costs one additional reduction that is not counted
+       @return The number of global reductions performed
+    */
+    int blockOrthonormalize(std::vector<ColorSpinorField *> &v, int block_size = 8, double *loss = nullptr);
+
   } // namespace blas
 
 } // namespace quda
@@ -170,6 +170,23 @@ namespace quda {
        @return Absolute minimum value
      */
     double abs_min(bool inverse = false) const;
+
+    using LatticeField::prefetch;
+
+    /**
+      @brief If managed memory and prefetch is enabled, prefetch the
+      clover and/or inverse fields as specified to the CPU or the GPU
+      (no-op for host fields)
+      @param[in] mem_space Memory space we are prefetching to
+      @param[in] stream Which stream to run the prefetch in
+      @param[in] type Whether to grab the clover, inverse, or both
+      @param[in] parity Whether to grab the full clover or just the even/odd parity
+    */
+    virtual void prefetch(QudaFieldLocation mem_space, cudaStream_t stream, CloverPrefetchType type,
+                          QudaParity parity = QUDA_INVALID_PARITY) const
+    {
+      ;
+    }
   };
 
   class cudaCloverField : public CloverField {
@@ -364,6 +381,20 @@ namespace quda {
   */
   void copyGenericClover(CloverField &out, const CloverField &in, bool inverse,
 			 QudaFieldLocation location, void *Out=0, void *In=0, void *outNorm=0, void *inNorm=0);
+
+  /**
+     @brief Compute the SciDAC-style CRC32 checksum of a clover
+     field, with sites combined as for the gauge-field variant.  The
+     site record is the lower triangle of each Hermitian chiral block
+     (chirality, row, column, real/imaginary, with the real diagonal).
+     Device fields and host fields in other orders are first copied
+     to a packed host field.
+     @param[in] clover The clover field we are checksumming
+     @param[in] inverse Whether we checksum the inverse or direct field
+     @return Checksum, with the modulo-29 sum in the upper 32 bits and
+     the modulo-31 sum in the lower 32 bits
+  */
+  uint64_t ChecksumCRC32(const CloverField &clover, bool inverse = false);
   
 
 
@@ -1017,6 +1017,19 @@ namespace quda {
   int genericCompare(const cpuColorSpinorField &a, const cpuColorSpinorField &b, int tol);
 
   void genericPrintVector(const cpuColorSpinorField &a, unsigned int x);
+
+  /**
+     @brief Compute the SciDAC-style CRC32 checksum of a
+     color-spinor field, with sites combined as for the gauge-field
+     variant, and each site record in (spin, color, real/imaginary)
+     order.  Device fields are first copied to the host, with half and
+     quarter precision promoted to single.
+     @param[in] v The field we are checksumming
+     @return Checksum, with the modulo-29 sum in the upper 32 bits and
+     the modulo-31 sum in the lower 32 bits
+  */
+  uint64_t ChecksumCRC32(const ColorSpinorField &v);
+
   void genericCudaPrintVector(const cudaColorSpinorField &a, unsigned x);
 
   void exchangeExtendedGhost(cudaColorSpinorField* spinor, int R[], int parity, cudaStream_t *stream_p);
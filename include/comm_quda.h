@@ -26,6 +26,65 @@ extern "C" {
   void comm_set_default_topology(Topology *topo);
   Topology *comm_default_topology(void);
 
+  /**
+     Map data for comm_node_rank_from_coords.  The local lattice
+     dimensions are only used to weight the halo surfaces; if they are
+     left zero an isotropic local volume is assumed.
+   */
+  typedef struct {
+    int ndim;
+    int dims[4];
+    int local_dims[4];
+  } CommNodeMapData;
+
+  /**
+     @brief Node-aware rank map (of type QudaCommsMap).  On first call
+     the hostnames of all processes are gathered, and the processes
+     that share a node are packed into a compact sub-block of the
+     process grid, with the sub-block shape chosen to minimize the
+     inter-node halo surface.  If the processes are not evenly
+     distributed over nodes the default lexicographical ordering (t
+     fastest) is used instead.
+     @param coords Process grid coordinates
+     @param fdata Pointer to CommNodeMapData
+     @return Rank corresponding to the grid coordinates
+  */
+  int comm_node_rank_from_coords(const int *coords, void *fdata);
+
+  /**
+     @brief Compute the node-aware layout of ranks on the process
+     grid.  This is the communication-free kernel of
+     comm_node_rank_from_coords and may be used to simulate a mapping
+     for an arbitrary number of nodes.
+     @param[in] ndim Number of grid dimensions
+     @param[in] dims Process grid dimensions
+     @param[in] local_dims Local lattice dimensions (may be NULL for isotropic)
+     @param[in] nranks Total number of ranks (product of dims)
+     @param[in] node_of_rank Node id of each rank, numbered in order of first appearance
+     @param[out] rank_of_grid Rank at each lexicographical grid index (t fastest)
+     @param[out] block Shape of the per-node sub-block, or all zero if
+     a lexicographical fill of the nodes had the smaller inter-node surface
+     @return Whether a node-aware layout was found (false if the ranks
+     are not evenly distributed over the nodes)
+  */
+  int comm_node_map_layout(int ndim, const int *dims, const int *local_dims, int nranks, const int *node_of_rank,
+                           int *rank_of_grid, int *block);
+
+  /**
+     @brief Score a rank layout by the halo surface (in lattice sites
+     summed over all ranks and both directions) that stays within a
+     node, and that which crosses between nodes.
+     @param[in] ndim Number of grid dimensions
+     @param[in] dims Process grid dimensions
+     @param[in] local_dims Local lattice dimensions (may be NULL for isotropic)
+     @param[in] rank_of_grid Rank at each lexicographical grid index (t fastest)
+     @param[in] node_of_rank Node id of each rank
+     @param[out] intra_node Halo surface exchanged within a node
+     @param[out] inter_node Halo surface exchanged between nodes
+  */
+  void comm_node_map_surface(int ndim, const int *dims, const int *local_dims, const int *rank_of_grid,
+                             const int *node_of_rank, double *intra_node, double *inter_node);
+
   // routines related to direct peer-2-peer access
   void comm_set_neighbor_ranks(Topology *topo=NULL);
   int comm_neighbor_rank(int dir, int dim);
@@ -112,6 +171,7 @@ extern "C" {
 
   void comm_finalize(void);
   void comm_dim_partitioned_set(int dim);
+  void comm_dim_partitioned_reset();
   int comm_dim_partitioned(int dim);
 
   /**
@@ -305,6 +365,19 @@ extern "C" {
   void comm_allreduce_int(int* data);
   void comm_allreduce_xor(uint64_t *data);
   void comm_broadcast(void *data, size_t nbytes);
+
+  /**
+     @brief All-to-all exchange among the processes that share all
+     coordinates of the process grid except the one in dimension dim.
+     Block j of send is sent to the process with coordinate j in dim,
+     and block j of recv is received from it.
+     @param[out] recv Receive buffer of comm_dim(dim) blocks
+     @param[in] send Send buffer of comm_dim(dim) blocks
+     @param[in] nbytes Size of each block in bytes
+     @param[in] dim Dimension of the process grid
+   */
+  void comm_alltoall_dim(void *recv, const void *send, size_t nbytes, int dim);
+
   void comm_barrier(void);
   void comm_abort(int status);
   void comm_abort_(int status);
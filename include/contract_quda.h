@@ -1,9 +1,81 @@
 #pragma once
 
+#include <vector>
 #include <quda_internal.h>
 #include <quda.h>
+#include <complex_quda.h>
 
 namespace quda
 {
   void contractQuda(const ColorSpinorField &x, const ColorSpinorField &y, void *result, QudaContractType cType);
+
+  /**
+     @brief Momentum-projected, time-sliced contraction of x and y,
+     summing the phased site contractions of each time slice on the fly
+     rather than storing the contraction of every site
+     @param[in] x Left spinor, conjugated
+     @param[in] y Right spinor
+     @param[out] result Host array of Nt x n_mom x 16 double-precision
+     complex correlators, with t the global time slice
+     @param[in] cType Open spin or Degrand-Rossi contraction
+     @param[in] mom n_mom spatial momenta (px, py, pz) in units of 2 pi /
+     L, each projected with exp(-i p.x)
+     @param[in] n_mom Number of momenta
+  */
+  void contractMomentumQuda(const ColorSpinorField &x, const ColorSpinorField &y, void *result,
+                            QudaContractType cType, const int *mom, int n_mom);
+
+  /**
+     Meson correlator tr[G_snk S1(x) G_src g5 S2(x)^dag g5] of the
+     propagators S1 and S2, with the gammas in the Degrand-Rossi basis
+  */
+  struct MesonContraction {
+    QudaContractGamma snk;
+    QudaContractGamma src;
+  };
+
+  /**
+     Nucleon-type baryon correlator of the interpolator
+     eps_abc u_a (u_b^T CG d_c), with u = S1 and d = S2, C = g4 g2 and
+     G = diquark:
+
+     sum_{k k'} P_{k'k} eps_abc eps_a'b'c' (CG)_{ij} (CG)bar_{j'i'} S2^{cc'}_{jj'}
+       (S1^{aa'}_{kk'} S1^{bb'}_{ii'} - S1^{ab'}_{ki'} S1^{ba'}_{ik'})
+
+     with color indices a, b, c and spin indices i, j, k, where
+     (CG)bar = g4 (CG)^dag g4 and P is the parity projector
+  */
+  struct BaryonContraction {
+    QudaContractGamma diquark;
+    complex<double> projector[4][4];
+  };
+
+  /**
+     @brief Propagator-level contraction engine.  The requested meson
+     and baryon correlators of the point-source propagators S1 and S2
+     are computed in a single pass over the lattice, projected on the
+     spatial momenta and summed per time slice.
+     @param[in] S1 Propagator, 12 host fields whose column 3 * spin +
+     color is the solution for that source spin and color
+     @param[in] S2 Second propagator, as S1
+     @param[in] mesons Requested meson correlators
+     @param[in] baryons Requested baryon correlators
+     @param[in] mom n_mom spatial momenta (px, py, pz) in units of 2 pi / L
+     @param[in] n_mom Number of momenta
+     @param[out] meson_result Nt x n_mom x mesons.size() correlators, with Nt the global temporal extent
+     @param[out] baryon_result Nt x n_mom x baryons.size() correlators
+  */
+  void contractPropagatorsQuda(const std::vector<ColorSpinorField *> &S1, const std::vector<ColorSpinorField *> &S2,
+                               const std::vector<MesonContraction> &mesons,
+                               const std::vector<BaryonContraction> &baryons, const int *mom, int n_mom,
+                               std::vector<complex<double>> &meson_result,
+                               std::vector<complex<double>> &baryon_result);
+
+  /**
+     @brief The gamma matrix of a contraction index, in the
+     Degrand-Rossi basis used by the contractions
+     @param[out] gamma The gamma matrix
+     @param[in] g The contraction index
+  */
+  void contractionGamma(complex<double> gamma[4][4], QudaContractGamma g);
 } // namespace quda
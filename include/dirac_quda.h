@@ -31,11 +31,11 @@ namespace quda {
     Complex c_5[QUDA_MAX_DWF_LS]; // used by mobius domain wall only
     QudaMatPCType matpcType;
     QudaDagType dagger;
-    cudaGaugeField *gauge;
-    cudaGaugeField *fatGauge;  // used by staggered only
-    cudaGaugeField *longGauge; // used by staggered only
+    GaugeField *gauge;
+    GaugeField *fatGauge;  // used by staggered only
+    GaugeField *longGauge; // used by staggered only
     int laplace3D;
-    cudaCloverField *clover;
+    CloverField *clover;
   
     double mu; // used by twisted mass only
     double mu_factor; // used by multigrid only
@@ -123,7 +123,7 @@ namespace quda {
     friend class DiracMdag;
 
   protected:
-    cudaGaugeField *gauge;
+    GaugeField *gauge;
     double kappa;
     double mass;
     int laplace3D;
@@ -360,7 +360,7 @@ namespace quda {
   class DiracClover : public DiracWilson {
 
   protected:
-    cudaCloverField &clover;
+    CloverField &clover;
     void checkParitySpinor(const ColorSpinorField &, const ColorSpinorField &) const;
     void initConstants();
 
@@ -489,7 +489,7 @@ namespace quda {
     // Inherit these so I will comment them out
     /*
   protected:
-    cudaCloverField &clover;
+    CloverField &clover;
     void checkParitySpinor(const ColorSpinorField &, const ColorSpinorField &) const;
     void initConstants();
     */
@@ -838,7 +838,7 @@ public:
   protected:
     double mu;
     double epsilon;
-    cudaCloverField &clover;
+    CloverField &clover;
     void checkParitySpinor(const ColorSpinorField &, const ColorSpinorField &) const;
     void twistedCloverApply(ColorSpinorField &out, const ColorSpinorField &in, 
           const QudaTwistGamma5Type twistType, const int parity) const;
@@ -1028,8 +1028,8 @@ public:
   class DiracImprovedStaggered : public Dirac {
 
   protected:
-    cudaGaugeField &fatGauge;
-    cudaGaugeField &longGauge;
+    GaugeField &fatGauge;
+    GaugeField &longGauge;
 
   public:
     DiracImprovedStaggered(const DiracParam &param);
@@ -1134,8 +1134,10 @@ public:
     /**
        @brief Initialize the coarse gauge fields.  Location is
        determined by gpu_setup variable.
+       @param[in] compute_links Whether to compute the links, or only
+       allocate them
     */
-    void initializeCoarse();
+    void initializeCoarse(bool compute_links = true);
 
     /**
        @brief Create the CPU or GPU coarse gauge fields on demand
@@ -1164,6 +1166,8 @@ public:
      */
     void createYhat(bool gpu = true) const;
 
+    friend class HierarchyCheckpoint;
+
   public:
     double Mass() const { return mass; }
     double Mu() const { return mu; }
@@ -1173,8 +1177,10 @@ public:
        @param[in] param Parameters defining this operator
        @param[in] gpu_setup Whether to do the setup on GPU or CPU
        @param[in] mapped Set to true to put Y and X fields in mapped memory
+       @param[in] compute_links Whether to compute the coarse links, or
+       only allocate them to be restored from a hierarchy checkpoint
      */
-    DiracCoarse(const DiracParam &param, bool gpu_setup=true, bool mapped=false);
+    DiracCoarse(const DiracParam &param, bool gpu_setup=true, bool mapped=false, bool compute_links=true);
 
     /**
        @param[in] param Parameters defining this operator
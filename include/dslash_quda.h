@@ -615,6 +615,50 @@ namespace quda {
   void ApplyTwistClover(ColorSpinorField &out, const ColorSpinorField &in, const CloverField &clover,
 			double kappa, double mu, double epsilon, int parity, int dagger, QudaTwistGamma5Type twist);
 
+  /**
+     Host implementations of the above operators, used by the drivers
+     when the fields are QUDA_CPU_FIELD_LOCATION.  These require the
+     spinors to be in QUDA_SPACE_SPIN_COLOR_FIELD_ORDER (with the UKQCD
+     gamma basis for Wilson-type fields), the gauge fields to be in
+     QUDA_QDP_GAUGE_ORDER (with the staggered phases and any
+     normalization already applied) and the clover field to be in
+     QUDA_PACKED_CLOVER_ORDER.  If any dimension is partitioned, the
+     gauge-field ghost zone must have been exchanged.  Only
+     single-flavor twisted mass is supported.
+  */
+  void ApplyWilsonCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                      const ColorSpinorField &x, int parity, bool dagger, const int *comm_override);
+
+  void ApplyWilsonCloverCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                            const CloverField &A, double a, const ColorSpinorField &x, int parity, bool dagger,
+                            const int *comm_override);
+
+  void ApplyWilsonCloverPreconditionedCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                          const CloverField &A, double a, const ColorSpinorField &x, int parity,
+                                          bool dagger, const int *comm_override);
+
+  void ApplyTwistedMassCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                           double b, const ColorSpinorField &x, int parity, bool dagger, const int *comm_override);
+
+  void ApplyTwistedMassPreconditionedCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                         double a, double b, bool xpay, const ColorSpinorField &x, int parity,
+                                         bool dagger, bool asymmetric, const int *comm_override);
+
+  void ApplyStaggeredCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                         const ColorSpinorField &x, int parity, bool dagger, const int *comm_override);
+
+  void ApplyImprovedStaggeredCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                 const GaugeField &L, double a, const ColorSpinorField &x, int parity, bool dagger,
+                                 const int *comm_override);
+
+  void ApplyCloverCPU(ColorSpinorField &out, const ColorSpinorField &in, const CloverField &A, bool inverse,
+                      int parity);
+
+  void ApplyGammaCPU(ColorSpinorField &out, const ColorSpinorField &in, int d);
+
+  void ApplyTwistGammaCPU(ColorSpinorField &out, const ColorSpinorField &in, int d, double kappa, double mu,
+                          int dagger, QudaTwistGamma5Type type);
+
   /**
      @brief Dslash face packing routine
      @param[out] ghost_buf Array of packed halos, order is [2*dim+dir]
@@ -149,6 +149,42 @@ public:
     */
     void blockReset(std::vector<ColorSpinorField *> &kSpace, int js, int je);
 
+    /**
+       @brief Rotate part of a host kSpace in place,
+       kSpace[num_locked + j] = sum_i array[j * rank + i] kSpace[num_locked + i]
+       for j < n_keep.  The vectors are treated as the columns of a
+       tall-skinny matrix that is multiplied by the rotation one tile
+       of sites at a time, so each vector is read once and no extra
+       vectors are needed.  Tiles are distributed over the host threads.
+       @param[in/out] kSpace The current Krylov space
+       @param[in] array The rotation matrix (column major)
+       @param[in] rank Row rank of array, the number of vectors rotated
+       @param[in] n_keep Number of rotated vectors to keep
+    */
+    void rotateHost(std::vector<ColorSpinorField *> &kSpace, const double *array, int rank, int n_keep);
+
+    /**
+       @brief Rotate part of a host kSpace in place with a complex
+       rotation matrix (see the real variant above)
+       @param[in/out] kSpace The current Krylov space
+       @param[in] array The rotation matrix (column major)
+       @param[in] rank Row rank of array, the number of vectors rotated
+       @param[in] n_keep Number of rotated vectors to keep
+    */
+    void rotateHost(std::vector<ColorSpinorField *> &kSpace, const Complex *array, int rank, int n_keep);
+
+    /**
+       @brief Number of extra vectors to use for a batched Ritz
+       rotation: batched_rotate if it is set, else as many as fit in
+       the free device memory (including those already allocated
+       beyond the Krylov space), but no more than n_keep.  The
+       smallest size over all ranks is returned.
+       @param[in] kSpace The current Krylov space
+       @param[in] n_keep Number of rotated vectors to keep
+       @return The batch size
+    */
+    int rotateBatchSize(const std::vector<ColorSpinorField *> &kSpace, int n_keep) const;
+
     /**
        @brief Deflate a set of source vectors with a given eigenspace
        @param[in] sol The resulting deflated vector set
@@ -274,6 +310,70 @@ public:
     void loadFromFile(const DiracMatrix &mat, std::vector<ColorSpinorField *> &eig_vecs, std::vector<Complex> &evals);
   };
 
+  /**
+     @brief Eigensolver for the symmetric arrow matrix of the thick
+     restarted Lanczos method: a diagonal block whose last row and
+     column (at arrow_pos - 1) hold the arrow, followed by a
+     tridiagonal tail.  The arrow is reduced to tridiagonal form with
+     O(arrow_pos^2) Givens rotations that leave the arrowhead and the
+     tail untouched, the eigenvalues are computed with implicit QL and
+     the eigenvectors of the tridiagonal matrix with inverse iteration,
+     reorthogonalized within clusters of close eigenvalues.  Only the
+     eigenvectors that are requested are rotated back to the basis of
+     the arrow matrix.
+  */
+  class ArrowEigensolver
+  {
+    int dim = 0;
+    int arrow_pos = 0;
+    std::vector<double> rot;   /** Givens rotations (c, s) in order of application */
+    std::vector<double> diag;  /** Diagonal of the tridiagonal matrix */
+    std::vector<double> off;   /** Off diagonal of the tridiagonal matrix */
+    std::vector<double> evals; /** Eigenvalues in ascending order */
+    std::vector<double> evecs; /** Eigenvectors of the tridiagonal matrix, column major */
+
+    /**
+       @brief Reduce the arrow matrix to tridiagonal form
+    */
+    void tridiagonalize(const double *alpha, const double *beta);
+
+    /**
+       @brief Compute the eigenvectors of the tridiagonal matrix
+    */
+    void inverseIteration();
+
+public:
+    /**
+       @brief Compute the eigenvalues and the eigenvectors of the
+       tridiagonal form of the arrow matrix
+       @param[in] alpha Diagonal of the arrow matrix
+       @param[in] beta Arrow (elements 0 to arrow_pos - 2) and
+       off-diagonal (elements arrow_pos - 1 to dim - 2) of the arrow matrix
+       @param[in] dim Dimension of the arrow matrix
+       @param[in] arrow_pos Position of the arrowhead plus one
+    */
+    void compute(const double *alpha, const double *beta, int dim, int arrow_pos);
+
+    /**
+       @return The i-th eigenvalue, in ascending order
+    */
+    double eval(int i) const { return evals[i]; }
+
+    /**
+       @return The last component of the i-th eigenvector, which is
+       not affected by the reduction to tridiagonal form
+    */
+    double lastComponent(int i) const { return evecs[(size_t)dim * i + dim - 1]; }
+
+    /**
+       @brief Rotate the first n eigenvectors back to the basis of the
+       arrow matrix
+       @param[out] vecs Eigenvectors, column major with leading dimension dim
+       @param[in] n Number of eigenvectors
+    */
+    void vectors(double *vecs, int n) const;
+  };
+
   /**
      @brief Thick Restarted Lanczos Method.
   */
@@ -298,6 +398,9 @@ public:
     // Variable size matrix
     std::vector<double> ritz_mat;
 
+    // Eigendecomposition of the arrow matrix
+    ArrowEigensolver arrow_eigensolver;
+
     // Tridiagonal/Arrow matrix, fixed size.
     double *alpha;
     double *beta;
@@ -340,6 +443,83 @@ public:
 
   };
 
+  /**
+     @brief Block Thick Restarted Lanczos Method.  The operator is
+     applied to block_size vectors at a time, and each new block is
+     orthogonalized against the Krylov space with one block inner
+     product (classical Gram-Schmidt, applied twice) and normalized
+     with a Cholesky QR factorization, so a block step needs a
+     fraction 1 / block_size of the global reductions of block_size
+     Lanczos steps.  The projected matrix is block tridiagonal, and
+     after a thick restart the kept Ritz vectors couple to the residual
+     block through a dense block_size x nKeep block.
+  */
+  class BLKTRLM : public EigenSolver
+  {
+
+public:
+    const DiracMatrix &mat;
+    /**
+       @brief Constructor for Block Thick Restarted Eigensolver class
+       @param eig_param The eigensolver parameters
+       @param mat The operator to solve
+       @param profile Time Profile
+    */
+    BLKTRLM(QudaEigParam *eig_param, const DiracMatrix &mat, TimeProfile &profile);
+
+    /**
+       @brief Destructor for Block Thick Restarted Eigensolver class
+    */
+    virtual ~BLKTRLM();
+
+    // Number of vectors in a block
+    int block_size;
+
+    // Projected (block tridiagonal/arrow) matrix, nKr x nKr column major
+    std::vector<Complex> T;
+
+    // Norm of the residual block, block_size x block_size column major
+    std::vector<Complex> beta_last;
+
+    // Ritz values of the projected matrix
+    std::vector<double> ritz;
+
+    // Used to clone vectors and resize arrays.
+    ColorSpinorParam csParam;
+
+    /**
+       @brief Compute eigenpairs
+       @param[in] kSpace Krylov vector space
+       @param[in] evals Computed eigenvalues
+    */
+    void operator()(std::vector<ColorSpinorField *> &kSpace, std::vector<Complex> &evals);
+
+    /**
+       @brief Block Lanczos step: extends the Krylov space by one block
+       @param[in] v Vector space
+       @param[in] j Index of the first vector of the block being computed
+    */
+    void blockLanczosStep(std::vector<ColorSpinorField *> &v, int j);
+
+    /**
+       @brief Orthonormalize a block of vectors in place with
+       Cholesky QR applied twice, in = Q * R
+       @param[in/out] in The block to orthonormalize, overwritten with Q
+       @param[in] out Workspace block of the same size
+       @param[out] R Upper triangular factor (column major)
+    */
+    void orthonormalizeBlock(std::vector<ColorSpinorField *> &in, std::vector<ColorSpinorField *> &out, Complex *R);
+
+    /**
+       @brief Rotate the Krylov space onto the Ritz vectors,
+       v_j = sum_i array[j * nKr + i] v_i for j < n_keep
+       @param[in/out] kSpace The Krylov space
+       @param[in] array The eigenvectors of the projected matrix (column major)
+       @param[in] n_keep Number of Ritz vectors to keep
+    */
+    void rotateRitz(std::vector<ColorSpinorField *> &kSpace, const Complex *array, int n_keep);
+  };
+
   /**
      arpack_solve()
 
@@ -127,6 +127,7 @@ extern "C" {
     QUDA_CA_CGNE_INVERTER,
     QUDA_CA_CGNR_INVERTER,
     QUDA_CA_GCR_INVERTER,
+    QUDA_PIPELINED_CG_INVERTER,
     QUDA_INVALID_INVERTER = QUDA_INVALID_ENUM
   } QudaInverterType;
 
@@ -134,6 +135,7 @@ extern "C" {
     QUDA_EIG_TR_LANCZOS, // Thick restarted lanczos solver
     QUDA_EIG_IR_LANCZOS, // Implicitly Restarted Lanczos solver (not implemented)
     QUDA_EIG_IR_ARNOLDI, // Implicitly Restarted Arnoldi solver (not implemented)
+    QUDA_EIG_BLK_TR_LANCZOS, // Block thick restarted lanczos solver
     QUDA_EIG_INVALID = QUDA_INVALID_ENUM
   } QudaEigType;
 
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <quda_internal.h>
+#include <complex_quda.h>
+
+/**
+   @file fft_quda.h
+   Distributed complex-to-complex FFTs of lattice fields.  The local
+   transforms are batched one-dimensional FFTs of contiguous lines,
+   done by a pluggable backend.  Along a partitioned dimension the
+   lines are first redistributed among the processes of that dimension
+   of the process grid with an all-to-all transpose, so that every
+   process holds complete lines (pencils) of the global lattice, and
+   are transposed back after the transform.
+ */
+
+namespace quda
+{
+
+  /** Sign of the exponent of the transform, as in cuFFT */
+  enum FFTDirection { FFT_FORWARD = -1, FFT_INVERSE = 1 };
+
+  /**
+     Backend for the local transforms of DistributedFFT.  The
+     transforms are unnormalized.
+   */
+  class FFTBackend
+  {
+  public:
+    virtual ~FFTBackend() {}
+
+    /**
+       @brief Transform batch contiguous lines of length n in place
+       @param[in,out] data Lines to transform, in the location of the backend
+       @param[in] n Length of the lines
+       @param[in] batch Number of lines
+       @param[in] direction Sign of the exponent
+    */
+    virtual void execute(complex<double> *data, int n, int batch, FFTDirection direction) = 0;
+    virtual void execute(complex<float> *data, int n, int batch, FFTDirection direction) = 0;
+
+    /**
+       @return Location of the data the backend transforms
+    */
+    virtual QudaFieldLocation Location() const = 0;
+
+    /**
+       @return Name of the backend
+    */
+    virtual const char *Name() const = 0;
+
+    /**
+       @brief Create the default backend for a location: a
+       multithreaded mixed-radix FFT on the host, or cuFFT on the device
+       @param[in] location Location of the data the backend transforms
+    */
+    static FFTBackend *create(QudaFieldLocation location);
+  };
+
+  /**
+     Distributed FFT of host fields.  A field is nField components, each
+     holding the local volume in lexicographical order with x running
+     fastest, and the transform is applied to every component over the
+     selected dimensions of the global lattice.  A backend on the
+     device is applied to lines staged through device memory.
+   */
+  class DistributedFFT
+  {
+    /** Local lattice dimensions */
+    int X[4];
+
+    /** Global lattice dimensions */
+    int N[4];
+
+    /** Which dimensions are transformed */
+    bool transform[4];
+
+    /** Local volume */
+    size_t volume;
+
+    /** Backend of the local transforms */
+    std::unique_ptr<FFTBackend> backend;
+
+    /** Line, send and receive buffers, reused between transforms */
+    std::vector<char> work, send, recv;
+
+    /** Device staging buffer for a device backend */
+    void *work_d;
+    size_t work_d_bytes;
+
+    /**
+       @brief Transform all components along one dimension
+    */
+    template <typename Float> void transformDim(complex<Float> *data, int nField, int d, FFTDirection direction);
+
+    /**
+       @brief Apply the backend to the lines in the work buffer
+    */
+    template <typename Float> void execute(complex<Float> *lines, int n, int batch, FFTDirection direction);
+
+  public:
+    /**
+       @param[in] X Local lattice dimensions
+       @param[in] dims Which of the four dimensions to transform
+       @param[in] backend Backend of the local transforms, owned by the
+       DistributedFFT (nullptr selects the host backend)
+    */
+    DistributedFFT(const int *X, const bool *dims, FFTBackend *backend = nullptr);
+
+    virtual ~DistributedFFT();
+
+    /**
+       @brief Transform a field in place
+       @param[in,out] data Field on the host
+       @param[in] nField Number of components, each of the local volume
+       @param[in] direction Sign of the exponent (the transforms are unnormalized)
+    */
+    template <typename Float> void operator()(complex<Float> *data, int nField, FFTDirection direction);
+
+    /**
+       @return Global lattice dimension d
+    */
+    int GlobalDim(int d) const { return N[d]; }
+
+    /**
+       @return Name of the backend
+    */
+    const char *BackendName() const { return backend->Name(); }
+  };
+
+  /**
+     @brief Create the cuFFT backend of DistributedFFT
+  */
+  FFTBackend *createCUFFTBackend();
+
+} // namespace quda
@@ -641,6 +641,14 @@ namespace quda {
     */
     void exchangeExtendedGhost(const int *R, TimeProfile &profile, bool no_comms_fill=false);
 
+    /**
+       @brief Free the persistent halo exchange buffers and message
+       handles shared by all host gauge fields.  Extended exchanges
+       cache a plan per (local volume, R, geometry, precision) on
+       first use, so repeated exchanges do not allocate.
+    */
+    static void freeGhostBuffer(void);
+
     /**
      * Generic gauge field copy
      * @param[in] src Source from which we are copying
@@ -758,6 +766,21 @@ namespace quda {
   */
   uint64_t Checksum(const GaugeField &u, bool mini=false);
 
+  /**
+     @brief Compute the SciDAC-style CRC32 checksum of a gauge field.
+     A CRC32 is computed for each site over the links in canonical
+     order (direction, row, column, real/imaginary) and combined by
+     XOR after rotating by the global lexicographical site index
+     modulo 29 and 31.  The result is independent of the field
+     order, thread count and process grid, but sensitive to links
+     being permuted between sites.  Device fields are first copied to
+     the host.
+     @param[in] u The gauge field we are checksumming
+     @return Checksum, with the modulo-29 sum in the upper 32 bits and
+     the modulo-31 sum in the lower 32 bits
+  */
+  uint64_t ChecksumCRC32(const GaugeField &u);
+
   /**
      @brief Helper function for determining if the reconstruct of the fields is the same.
      @param[in] a Input field
@@ -12,6 +12,27 @@ namespace quda
    */
   void gaugeObservables(GaugeField &u, QudaGaugeObservableParam &param, TimeProfile &profile);
 
+  /**
+     @brief Free the persistent workspace of gaugeObservables (the
+     charge density buffer and failure counter), which is otherwise
+     reused across calls.  Called by endQuda.
+  */
+  void freeGaugeObservablesWorkspace();
+
+  /**
+     @brief Compute the plaquette, field energy and topological charge
+     in a single pass over the extended gauge field.  The clover-leaf
+     field strength is formed at each site on the fly, so no Fmunu
+     field is needed.
+     @param[out] plaq The total, spatial and temporal plaquette
+     @param[out] energy The total, spatial and temporal field energy
+     @param[out] qcharge The total topological charge
+     @param[out] qdensity The topological charge at each lattice site
+     (at the location of u), or nullptr if not required
+     @param[in] u The extended gauge field, with exchanged halo
+  */
+  void computeGaugeObservables(double plaq[3], double energy[3], double &qcharge, void *qdensity, const GaugeField &u);
+
   /**
    * @brief Project the input gauge field onto the SU(3) group.  This
    * is a destructive operation.  The number of link failures is
@@ -109,6 +130,27 @@ namespace quda
   */
   void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, double epsilon, QudaWFlowType wflow_type);
 
+  /**
+     @brief Apply a Wilson Flow step together with the embedded
+     second-order integrator of Fritzsch and Ramos
+     (https://arxiv.org/abs/1301.4388), whose deviation from the
+     third-order update estimates the local error of the step.  The
+     input field is left unchanged, so a step that is rejected can be
+     repeated with a smaller step size.  On exit from this routine,
+     the output field will have been exchanged.
+     @param[out] out Output smeared field
+     @param[out] mid Intermediate field W2 (extended like out)
+     @param[in] temp Temp space
+     @param[in] err Temp space for the error estimate
+     @param[in] in Input gauge field
+     @param[in] epsilon Step size
+     @param[in] wflow_type Wilson (1x1) or Symanzik improved (2x1) staples
+     @return The largest deviation of a link element of the embedded
+     update from the third-order update
+  */
+  double WFlowStepEmbedded(GaugeField &out, GaugeField &mid, GaugeField &temp, GaugeField &err, const GaugeField &in,
+                           double epsilon, QudaWFlowType wflow_type);
+
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
    * @param[in,out] data, quda gauge field
@@ -179,4 +221,53 @@ namespace quda
   */
   void computeQChargeDensity(double energy[3], double &qcharge, void *qdensity, const GaugeField &Fmunu);
 
+  /**
+     @brief Host implementations of the smearing routines and
+     observables above, which are called by them when the fields are
+     QUDA_CPU_FIELD_LOCATION.  The fields must be QDP ordered without
+     reconstruction, and the smeared fields extended as on the device.
+  */
+  void APEStepCPU(GaugeField &out, GaugeField &in, double alpha);
+  void STOUTStepCPU(GaugeField &out, GaugeField &in, double rho);
+  void OvrImpSTOUTStepCPU(GaugeField &out, GaugeField &in, double rho, double epsilon);
+
+  /**
+     @brief Host Wilson flow step: W1 is written to out, W2 to mid and
+     the updated field to out, with err holding the embedded error
+     estimate if non-null.  mid may alias in.
+  */
+  void WFlowStepCPU(GaugeField &out, GaugeField &mid, GaugeField &temp, GaugeField *err, const GaugeField &in,
+                    double epsilon, QudaWFlowType wflow_type);
+  double3 plaquetteCPU(const GaugeField &U);
+  void computeFmunuCPU(GaugeField &Fmunu, const GaugeField &gauge);
+  void computeQChargeCPU(double energy[3], double &qcharge, void *qdensity, const GaugeField &Fmunu);
+
+  /**
+     @return The number of links that failed the SU(3) projection
+  */
+  int projectSU3CPU(GaugeField &U, double tol);
+
+  void computeGaugeObservablesCPU(double plaq[3], double energy[3], double &qcharge, void *qdensity,
+                                  const GaugeField &u);
+
+  /**
+     @brief Host Fourier accelerated gauge fixing, with the parameters
+     of gaugefixingFFT.  Unlike the device version it supports
+     partitioned lattices, for which the field must have a ghost zone
+     (QUDA_GHOST_EXCHANGE_PAD).
+     @return The final value of theta
+  */
+  double gaugefixingFFTCPU(GaugeField &data, int gauge_dir, int Nsteps, int verbose_interval, double alpha,
+                           int autotune, double tolerance, int stopWtheta);
+
+  /**
+     @brief Host gauge observables, with the plaquette, field energy
+     and topological charge (density) computed by
+     computeGaugeObservablesCPU
+     @param[in] u Gauge field upon which we are measuring
+     @param[in,out] param Parameter struct that defines which
+     observables we are making and the resulting observables
+  */
+  void gaugeObservablesCPU(GaugeField &u, QudaGaugeObservableParam &param);
+
 } // namespace quda
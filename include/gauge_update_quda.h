@@ -15,6 +15,15 @@ namespace quda {
   void updateGaugeField(GaugeField &out, double dt, const GaugeField& in, 
 			const GaugeField& mom, bool conj_mom, bool exact);
 
+  /**
+     @brief Host implementation of updateGaugeField, which it calls
+     for QUDA_CPU_FIELD_LOCATION fields.  The gauge fields are MILC or
+     QDP ordered without reconstruction and the momentum MILC or QDP
+     ordered with QUDA_RECONSTRUCT_10; out may alias in.
+   */
+  void updateGaugeFieldCPU(GaugeField &out, double dt, const GaugeField &in, const GaugeField &mom, bool conj_mom,
+                           bool exact);
+
 } // namespace quda
 
 #endif // _GAUGE_UPDATE_QUDA_H_
@@ -0,0 +1,168 @@
+#pragma once
+
+#ifdef __CUDACC_RTC__
+
+namespace quda
+{
+  namespace host
+  {
+    // dummy declarations that can safely be parsed by nvrtc
+    int thread_count();
+    template <typename T> struct plus;
+    template <typename T> struct maximum;
+    template <typename T> struct bit_xor;
+    template <typename F> void parallel_for(int n, F &&f, int chunk = 0);
+    template <typename F> void parallel_for(int nParity, int volumeCB, F &&f, int chunk = 0);
+    template <typename T, typename F, typename R> T parallel_reduce(int n, T init, F &&f, R r);
+    template <typename T, typename F, typename R> T parallel_reduce(int nParity, int volumeCB, T init, F &&f, R r);
+  } // namespace host
+} // namespace quda
+
+#else
+
+#include <vector>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+   @file host_parallel.h
+
+   Host execution backend for QUDA_CPU_FIELD_LOCATION kernels.  Work
+   is distributed over the OpenMP thread team, which the runtime keeps
+   alive between parallel regions (and which can be pinned to cores by
+   bindHostThreads()), so launching a host kernel does not create any
+   threads.  Kernels are written as a functor over a site index, or
+   over (parity, x_cb), and either use a static schedule or a dynamic
+   schedule with a given chunk size.  The chunk size of kernels
+   launched from a Tunable is autotuned (see Tunable::tuneHostChunk).
+ */
+
+namespace quda
+{
+
+  namespace host
+  {
+
+    /**
+       @return The number of threads used by the host parallel_for
+    */
+    inline int thread_count()
+    {
+#ifdef _OPENMP
+      return omp_get_max_threads();
+#else
+      return 1;
+#endif
+    }
+
+    /**
+       @brief Number of elements per block in parallel_reduce.  This
+       is fixed rather than derived from the thread count, so that the
+       reduction tree, and hence the rounding, does not depend on the
+       number of threads.
+    */
+    constexpr int reduce_block = 256;
+
+    template <typename T> struct plus {
+      T operator()(const T &a, const T &b) const { return a + b; }
+    };
+
+    template <typename T> struct maximum {
+      T operator()(const T &a, const T &b) const { return a > b ? a : b; }
+    };
+
+    template <typename T> struct bit_xor {
+      T operator()(const T &a, const T &b) const { return a ^ b; }
+    };
+
+    /**
+       @brief Apply f(i) for i in [0, n) over the host threads
+       @param[in] n Number of elements
+       @param[in] f Functor applied to each element
+       @param[in] chunk Chunk size of a dynamic schedule (0 selects a
+       static schedule)
+    */
+    template <typename F> void parallel_for(int n, F &&f, int chunk = 0)
+    {
+      if (chunk > 0) {
+#pragma omp parallel for schedule(dynamic, chunk)
+        for (int i = 0; i < n; i++) f(i);
+      } else {
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; i++) f(i);
+      }
+    }
+
+    /**
+       @brief Apply f(parity, x_cb) over the sites of a field.  Parity
+       runs slowest so that a static schedule gives each thread a
+       contiguous range of sites.
+       @param[in] nParity Number of parities
+       @param[in] volumeCB Checkerboarded volume
+       @param[in] f Functor applied to each site
+       @param[in] chunk Chunk size of a dynamic schedule (0 selects a
+       static schedule)
+    */
+    template <typename F> void parallel_for(int nParity, int volumeCB, F &&f, int chunk = 0)
+    {
+      parallel_for(
+        nParity * volumeCB, [&](int i) { f(i / volumeCB, i % volumeCB); }, chunk);
+    }
+
+    /**
+       @brief Deterministic parallel reduction of f(i) for i in [0, n).
+       The elements are reduced serially within blocks of reduce_block
+       elements, and the block partials are then combined with a
+       pairwise tree in a fixed order, so the result is bitwise
+       reproducible for any number of threads.
+       @param[in] n Number of elements
+       @param[in] init Initial value (identity of the reduction)
+       @param[in] f Functor returning the value of each element
+       @param[in] r Binary reduction operator
+       @return The reduced value
+    */
+    template <typename T, typename F, typename R> T parallel_reduce(int n, T init, F &&f, R r)
+    {
+      const int nblock = (n + reduce_block - 1) / reduce_block;
+      std::vector<T> partial(nblock, init);
+
+#pragma omp parallel for schedule(static)
+      for (int b = 0; b < nblock; b++) {
+        const int end = std::min(n, (b + 1) * reduce_block);
+        T sum = init;
+        for (int i = b * reduce_block; i < end; i++) sum = r(sum, f(i));
+        partial[b] = sum;
+      }
+
+      for (int stride = 1; stride < nblock; stride *= 2) {
+        for (int b = 0; b + stride < nblock; b += 2 * stride) partial[b] = r(partial[b], partial[b + stride]);
+      }
+
+      return nblock > 0 ? partial[0] : init;
+    }
+
+    /**
+       @brief Deterministic parallel reduction of f(parity, x_cb) over
+       the sites of a field (see parallel_reduce above)
+       @param[in] nParity Number of parities
+       @param[in] volumeCB Checkerboarded volume
+       @param[in] init Initial value (identity of the reduction)
+       @param[in] f Functor returning the value of each site
+       @param[in] r Binary reduction operator
+       @return The reduced value
+    */
+    template <typename T, typename F, typename R>
+    T parallel_reduce(int nParity, int volumeCB, T init, F &&f, R r)
+    {
+      return parallel_reduce(
+        nParity * volumeCB, init, [&](int i) { return f(i / volumeCB, i % volumeCB); }, r);
+    }
+
+  } // namespace host
+
+} // namespace quda
+
+#endif
@@ -0,0 +1,563 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <host_parallel.h>
+
+/**
+   @file host_su3.h
+
+   Batched SU(3) kernels for host code.  Sites are processed in tiles
+   of W matrices (or color vectors) in structure-of-arrays layout: the
+   real and imaginary parts of each element are stored contiguously
+   over the W lanes of the tile, so the lane loops of the kernels
+   vectorize with the SIMD width of the machine.  W defaults to the
+   number of elements of T in a 512-bit register.
+
+   The library has three layers:
+   - tile kernels (mul_nn, mat_vec, exponentiate, ...), acting on whole tiles;
+   - array kernels, which take arrays of n matrices of 18 reals each
+     (row-major, real and imaginary parts interleaved, the layout of
+     Matrix<complex<T>,3> and of the MILC su3_matrix), gather them
+     into tiles, and distribute the tiles over the host threads;
+   - site kernels, which apply a tile kernel to a single matrix with a
+     tile of width 1, for code that visits the sites one at a time.
+     They accept any storage precision, and their output may alias
+     their inputs.
+
+   The header only depends on host_parallel.h, so that the reference
+   code of the tests can use it alongside its own complex types.
+ */
+
+namespace quda
+{
+
+  namespace host
+  {
+
+    /**
+       @brief The default tile width: the number of T in a 512-bit register
+    */
+    template <typename T> struct simd_width {
+      static constexpr int value = 64 / sizeof(T);
+    };
+
+    /**
+       A tile of W 3x3 complex matrices in structure-of-arrays layout,
+       with element i = 3 * row + column
+    */
+    template <typename T, int W = simd_width<T>::value> struct SU3Tile {
+      static constexpr int width = W;
+      alignas(64) T re[9][W];
+      alignas(64) T im[9][W];
+
+      /**
+         @brief Load a lane from 18 reals in the Matrix<complex<T>,3> layout
+      */
+      template <typename U> void load(int lane, const U *m)
+      {
+        for (int i = 0; i < 9; i++) {
+          re[i][lane] = m[2 * i + 0];
+          im[i][lane] = m[2 * i + 1];
+        }
+      }
+
+      /**
+         @brief Store a lane to 18 reals in the Matrix<complex<T>,3> layout
+      */
+      template <typename U> void store(int lane, U *m) const
+      {
+        for (int i = 0; i < 9; i++) {
+          m[2 * i + 0] = re[i][lane];
+          m[2 * i + 1] = im[i][lane];
+        }
+      }
+
+      /**
+         @brief Set a lane from a Matrix<complex<T>,3>, or any matrix
+         with a linear element accessor m(i)
+      */
+      template <typename Mat> void set(int lane, const Mat &m)
+      {
+        for (int i = 0; i < 9; i++) {
+          re[i][lane] = m(i).real();
+          im[i][lane] = m(i).imag();
+        }
+      }
+
+      template <typename Mat> void get(int lane, Mat &m) const
+      {
+        for (int i = 0; i < 9; i++) m(i) = {re[i][lane], im[i][lane]};
+      }
+    };
+
+    /**
+       A tile of W color vectors in structure-of-arrays layout
+    */
+    template <typename T, int W = simd_width<T>::value> struct ColorTile {
+      static constexpr int width = W;
+      alignas(64) T re[3][W];
+      alignas(64) T im[3][W];
+
+      /**
+         @brief Load a lane from 6 reals, real and imaginary parts interleaved
+      */
+      template <typename U> void load(int lane, const U *v)
+      {
+        for (int i = 0; i < 3; i++) {
+          re[i][lane] = v[2 * i + 0];
+          im[i][lane] = v[2 * i + 1];
+        }
+      }
+
+      template <typename U> void store(int lane, U *v) const
+      {
+        for (int i = 0; i < 3; i++) {
+          v[2 * i + 0] = re[i][lane];
+          v[2 * i + 1] = im[i][lane];
+        }
+      }
+    };
+
+    /**
+       Nominal floating-point operations per site of each kernel, used
+       to report their throughput.  A transcendental function counts
+       as one operation.
+    */
+    struct su3_flops {
+      static constexpr int mul = 198;
+      static constexpr int mat_vec = 66;
+      static constexpr int project = 42;
+      static constexpr int exponentiate = 476;
+      static constexpr int reunitarize = 111;
+    };
+
+    /**
+       @brief c = a b.  c must not alias a or b.
+    */
+    template <typename T, int W> inline void mul_nn(SU3Tile<T, W> &c, const SU3Tile<T, W> &a, const SU3Tile<T, W> &b)
+    {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+#pragma omp simd
+          for (int l = 0; l < W; l++) {
+            T x = 0, y = 0;
+            for (int k = 0; k < 3; k++) {
+              x += a.re[3 * i + k][l] * b.re[3 * k + j][l] - a.im[3 * i + k][l] * b.im[3 * k + j][l];
+              y += a.re[3 * i + k][l] * b.im[3 * k + j][l] + a.im[3 * i + k][l] * b.re[3 * k + j][l];
+            }
+            c.re[3 * i + j][l] = x;
+            c.im[3 * i + j][l] = y;
+          }
+        }
+      }
+    }
+
+    /**
+       @brief c = a b^dagger.  c must not alias a or b.
+    */
+    template <typename T, int W> inline void mul_na(SU3Tile<T, W> &c, const SU3Tile<T, W> &a, const SU3Tile<T, W> &b)
+    {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+#pragma omp simd
+          for (int l = 0; l < W; l++) {
+            T x = 0, y = 0;
+            for (int k = 0; k < 3; k++) {
+              x += a.re[3 * i + k][l] * b.re[3 * j + k][l] + a.im[3 * i + k][l] * b.im[3 * j + k][l];
+              y += a.im[3 * i + k][l] * b.re[3 * j + k][l] - a.re[3 * i + k][l] * b.im[3 * j + k][l];
+            }
+            c.re[3 * i + j][l] = x;
+            c.im[3 * i + j][l] = y;
+          }
+        }
+      }
+    }
+
+    /**
+       @brief c = a^dagger b.  c must not alias a or b.
+    */
+    template <typename T, int W> inline void mul_an(SU3Tile<T, W> &c, const SU3Tile<T, W> &a, const SU3Tile<T, W> &b)
+    {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+#pragma omp simd
+          for (int l = 0; l < W; l++) {
+            T x = 0, y = 0;
+            for (int k = 0; k < 3; k++) {
+              x += a.re[3 * k + i][l] * b.re[3 * k + j][l] + a.im[3 * k + i][l] * b.im[3 * k + j][l];
+              y += a.re[3 * k + i][l] * b.im[3 * k + j][l] - a.im[3 * k + i][l] * b.re[3 * k + j][l];
+            }
+            c.re[3 * i + j][l] = x;
+            c.im[3 * i + j][l] = y;
+          }
+        }
+      }
+    }
+
+    /**
+       @brief y = m x.  y must not alias x.
+    */
+    template <typename T, int W>
+    inline void mat_vec(ColorTile<T, W> &y, const SU3Tile<T, W> &m, const ColorTile<T, W> &x)
+    {
+      for (int i = 0; i < 3; i++) {
+#pragma omp simd
+        for (int l = 0; l < W; l++) {
+          T a = 0, b = 0;
+          for (int k = 0; k < 3; k++) {
+            a += m.re[3 * i + k][l] * x.re[k][l] - m.im[3 * i + k][l] * x.im[k][l];
+            b += m.re[3 * i + k][l] * x.im[k][l] + m.im[3 * i + k][l] * x.re[k][l];
+          }
+          y.re[i][l] = a;
+          y.im[i][l] = b;
+        }
+      }
+    }
+
+    /**
+       @brief y = m^dagger x.  y must not alias x.
+    */
+    template <typename T, int W>
+    inline void adj_mat_vec(ColorTile<T, W> &y, const SU3Tile<T, W> &m, const ColorTile<T, W> &x)
+    {
+      for (int i = 0; i < 3; i++) {
+#pragma omp simd
+        for (int l = 0; l < W; l++) {
+          T a = 0, b = 0;
+          for (int k = 0; k < 3; k++) {
+            a += m.re[3 * k + i][l] * x.re[k][l] + m.im[3 * k + i][l] * x.im[k][l];
+            b += m.re[3 * k + i][l] * x.im[k][l] - m.im[3 * k + i][l] * x.re[k][l];
+          }
+          y.re[i][l] = a;
+          y.im[i][l] = b;
+        }
+      }
+    }
+
+    /**
+       @brief Project onto the traceless anti-hermitian matrices, in
+       place, as makeAntiHerm: m <- (m - m^dagger) / 2 - i Im tr(m) / 3
+    */
+    template <typename T, int W> inline void project(SU3Tile<T, W> &m)
+    {
+#pragma omp simd
+      for (int l = 0; l < W; l++) {
+        const T trace = (m.im[0][l] + m.im[4][l] + m.im[8][l]) / static_cast<T>(3.0);
+        for (int i = 0; i < 3; i++) {
+          for (int j = i + 1; j < 3; j++) {
+            const T x = static_cast<T>(0.5) * (m.re[3 * i + j][l] - m.re[3 * j + i][l]);
+            const T y = static_cast<T>(0.5) * (m.im[3 * i + j][l] + m.im[3 * j + i][l]);
+            m.re[3 * i + j][l] = x;
+            m.im[3 * i + j][l] = y;
+            m.re[3 * j + i][l] = -x;
+            m.im[3 * j + i][l] = y;
+          }
+          m.re[4 * i][l] = 0.0;
+          m.im[4 * i][l] -= trace;
+        }
+      }
+    }
+
+    /**
+       @brief e = exp(iQ) of the traceless hermitian Q by the
+       Cayley-Hamilton theorem, as exponentiate_iQ (hep-lat/0311018),
+       with its branches evaluated per lane.  e must not alias Q.
+    */
+    template <typename T, int W> inline void exponentiate(SU3Tile<T, W> &e, const SU3Tile<T, W> &Q)
+    {
+      SU3Tile<T, W> Q2;
+      mul_nn(Q2, Q, Q);
+
+      alignas(64) T f[3][2][W];
+#pragma omp simd
+      for (int l = 0; l < W; l++) {
+        // c0 = det(Q), which is real for hermitian Q
+        auto mul_re = [&](int a, int b) { return Q.re[a][l] * Q.re[b][l] - Q.im[a][l] * Q.im[b][l]; };
+        auto mul_im = [&](int a, int b) { return Q.re[a][l] * Q.im[b][l] + Q.im[a][l] * Q.re[b][l]; };
+        auto minor_re = [&](int a, int b, int c, int d) { return mul_re(a, b) - mul_re(c, d); };
+        auto minor_im = [&](int a, int b, int c, int d) { return mul_im(a, b) - mul_im(c, d); };
+        auto term = [&](int a, T m_re, T m_im) { return Q.re[a][l] * m_re - Q.im[a][l] * m_im; };
+        const T c0 = term(0, minor_re(4, 8, 7, 5), minor_im(4, 8, 7, 5)) - term(1, minor_re(3, 8, 5, 6), minor_im(3, 8, 5, 6))
+          + term(2, minor_re(3, 7, 4, 6), minor_im(3, 7, 4, 6));
+        // c1 = tr(Q^2) / 2
+        const T c1 = static_cast<T>(0.5) * (Q2.re[0][l] + Q2.re[4][l] + Q2.re[8][l]);
+
+        const T inv3 = static_cast<T>(1.0 / 3.0);
+        const T sqrt_c1_inv3 = std::sqrt(c1 * inv3);
+        const T c0_max = 2 * (c1 * inv3 * sqrt_c1_inv3);
+        const T theta = std::acos(std::abs(c0) / c0_max); // [34] fj are computed for |c0|
+        T u = std::cos(theta * inv3) * sqrt_c1_inv3;
+        T w = std::sin(theta * inv3) * std::sqrt(c1);
+
+        const T u_sq = u * u;
+        const T w_sq = w * w;
+        const T denom_inv = static_cast<T>(1.0) / (9 * u_sq - w_sq);
+        const T exp_iu_re = std::cos(u);
+        const T exp_iu_im = std::sin(u);
+        const T exp_2iu_re = exp_iu_re * exp_iu_re - exp_iu_im * exp_iu_im;
+        const T exp_2iu_im = 2 * exp_iu_re * exp_iu_im;
+        const T cos_w = std::cos(w);
+        const T sinc_w = (w < static_cast<T>(0.05) && w > static_cast<T>(-0.05)) ?
+          1 - (w_sq / 6) * (1 - (w_sq * static_cast<T>(0.05)) * (1 - (w_sq / 42) * (1 - (w_sq / 72)))) :
+          std::sin(w) / w;
+        const T sign = c0 < 0 ? -1 : 1;
+
+        f[0][0][l] = ((u_sq - w_sq) * exp_2iu_re + 8 * u_sq * cos_w * exp_iu_re
+                      + 2 * u * (3 * u_sq + w_sq) * sinc_w * exp_iu_im)
+          * denom_inv;
+        f[0][1][l] = sign
+          * ((u_sq - w_sq) * exp_2iu_im - 8 * u_sq * cos_w * exp_iu_im
+             + 2 * u * (3 * u_sq + w_sq) * sinc_w * exp_iu_re)
+          * denom_inv;
+        f[1][0][l] = sign * (2 * u * exp_2iu_re - 2 * u * cos_w * exp_iu_re + (3 * u_sq - w_sq) * sinc_w * exp_iu_im)
+          * denom_inv;
+        f[1][1][l] = (2 * u * exp_2iu_im + 2 * u * cos_w * exp_iu_im + (3 * u_sq - w_sq) * sinc_w * exp_iu_re)
+          * denom_inv;
+        f[2][0][l] = (exp_2iu_re - cos_w * exp_iu_re - 3 * u * sinc_w * exp_iu_im) * denom_inv;
+        f[2][1][l] = sign * (exp_2iu_im + cos_w * exp_iu_im - 3 * u * sinc_w * exp_iu_re) * denom_inv;
+      }
+
+      // e = f0 + f1 Q + f2 Q^2
+      for (int i = 0; i < 9; i++) {
+#pragma omp simd
+        for (int l = 0; l < W; l++) {
+          T x = f[1][0][l] * Q.re[i][l] - f[1][1][l] * Q.im[i][l] + f[2][0][l] * Q2.re[i][l] - f[2][1][l] * Q2.im[i][l];
+          T y = f[1][0][l] * Q.im[i][l] + f[1][1][l] * Q.re[i][l] + f[2][0][l] * Q2.im[i][l] + f[2][1][l] * Q2.re[i][l];
+          if (i % 4 == 0) {
+            x += f[0][0][l];
+            y += f[0][1][l];
+          }
+          e.re[i][l] = x;
+          e.im[i][l] = y;
+        }
+      }
+    }
+
+    /**
+       @brief Reunitarize in place: the first two rows are
+       orthonormalized by Gram-Schmidt and the third set to the
+       conjugate of their cross product
+    */
+    template <typename T, int W> inline void reunitarize(SU3Tile<T, W> &m)
+    {
+#pragma omp simd
+      for (int l = 0; l < W; l++) {
+        T n0 = 0;
+        for (int k = 0; k < 3; k++) n0 += m.re[k][l] * m.re[k][l] + m.im[k][l] * m.im[k][l];
+        n0 = 1 / std::sqrt(n0);
+        for (int k = 0; k < 3; k++) {
+          m.re[k][l] *= n0;
+          m.im[k][l] *= n0;
+        }
+
+        // row 1 -= (row 0^dagger row 1) row 0
+        T p_re = 0, p_im = 0;
+        for (int k = 0; k < 3; k++) {
+          p_re += m.re[k][l] * m.re[3 + k][l] + m.im[k][l] * m.im[3 + k][l];
+          p_im += m.re[k][l] * m.im[3 + k][l] - m.im[k][l] * m.re[3 + k][l];
+        }
+        T n1 = 0;
+        for (int k = 0; k < 3; k++) {
+          m.re[3 + k][l] -= p_re * m.re[k][l] - p_im * m.im[k][l];
+          m.im[3 + k][l] -= p_re * m.im[k][l] + p_im * m.re[k][l];
+          n1 += m.re[3 + k][l] * m.re[3 + k][l] + m.im[3 + k][l] * m.im[3 + k][l];
+        }
+        n1 = 1 / std::sqrt(n1);
+        for (int k = 0; k < 3; k++) {
+          m.re[3 + k][l] *= n1;
+          m.im[3 + k][l] *= n1;
+        }
+
+        // row 2 = conj(row 0 x row 1)
+        for (int k = 0; k < 3; k++) {
+          const int a = (k + 1) % 3, b = (k + 2) % 3;
+          m.re[6 + k][l] = m.re[a][l] * m.re[3 + b][l] - m.im[a][l] * m.im[3 + b][l] - m.re[b][l] * m.re[3 + a][l]
+            + m.im[b][l] * m.im[3 + a][l];
+          m.im[6 + k][l] = -(m.re[a][l] * m.im[3 + b][l] + m.im[a][l] * m.re[3 + b][l] - m.re[b][l] * m.im[3 + a][l]
+                             - m.im[b][l] * m.re[3 + a][l]);
+        }
+      }
+    }
+
+    /**
+       @brief Apply a kernel to n sites in tiles over the host threads.
+       load(tiles, lane, site) fills a lane of the input tiles,
+       kernel(tiles) computes the tile, and store(tiles, lane, site)
+       writes a lane back.  The unused lanes of the last tile repeat
+       its last site, so the kernel never sees uninitialized data.
+    */
+    template <typename Tiles, typename Load, typename Kernel, typename Store>
+    void batch(int n, Load &&load, Kernel &&kernel, Store &&store)
+    {
+      constexpr int W = Tiles::width;
+      parallel_for((n + W - 1) / W, [&](int t) {
+        Tiles tiles;
+        const int begin = t * W;
+        const int lanes = std::min(W, n - begin);
+        for (int l = 0; l < W; l++) load(tiles, l, begin + std::min(l, lanes - 1));
+        kernel(tiles);
+        for (int l = 0; l < lanes; l++) store(tiles, l, begin + l);
+      });
+    }
+
+    /**
+       The tiles of the array kernels: two inputs and an output
+    */
+    template <typename T, int W = simd_width<T>::value> struct MatrixTiles {
+      static constexpr int width = W;
+      SU3Tile<T, W> a, b, c;
+    };
+
+    template <typename T, int W = simd_width<T>::value> struct VectorTiles {
+      static constexpr int width = W;
+      SU3Tile<T, W> m;
+      ColorTile<T, W> x, y;
+    };
+
+    /**
+       @brief c = op(a, b) over arrays of n matrices
+    */
+    template <typename T, typename Op> inline void batch_binary(int n, T *c, const T *a, const T *b, Op op)
+    {
+      using Tiles = MatrixTiles<T>;
+      batch<Tiles>(
+        n,
+        [&](Tiles &t, int l, int i) {
+          t.a.load(l, a + 18 * static_cast<size_t>(i));
+          t.b.load(l, b + 18 * static_cast<size_t>(i));
+        },
+        [&](Tiles &t) { op(t.c, t.a, t.b); }, [&](Tiles &t, int l, int i) { t.c.store(l, c + 18 * static_cast<size_t>(i)); });
+    }
+
+    /**
+       @brief c = op(a) over arrays of n matrices; c may alias a
+    */
+    template <typename T, typename Op> inline void batch_unary(int n, T *c, const T *a, Op op)
+    {
+      using Tiles = MatrixTiles<T>;
+      batch<Tiles>(
+        n, [&](Tiles &t, int l, int i) { t.a.load(l, a + 18 * static_cast<size_t>(i)); }, [&](Tiles &t) { op(t.c, t.a); },
+        [&](Tiles &t, int l, int i) { t.c.store(l, c + 18 * static_cast<size_t>(i)); });
+    }
+
+    /**
+       @brief y = op(m, x) over arrays of n matrices and color vectors
+    */
+    template <typename T, typename Op> inline void batch_vector(int n, T *y, const T *m, const T *x, Op op)
+    {
+      using Tiles = VectorTiles<T>;
+      batch<Tiles>(
+        n,
+        [&](Tiles &t, int l, int i) {
+          t.m.load(l, m + 18 * static_cast<size_t>(i));
+          t.x.load(l, x + 6 * static_cast<size_t>(i));
+        },
+        [&](Tiles &t) { op(t.y, t.m, t.x); }, [&](Tiles &t, int l, int i) { t.y.store(l, y + 6 * static_cast<size_t>(i)); });
+    }
+
+    template <typename T> inline void mul_nn(int n, T *c, const T *a, const T *b)
+    {
+      batch_binary(n, c, a, b, [](SU3Tile<T> &c, const SU3Tile<T> &a, const SU3Tile<T> &b) { mul_nn(c, a, b); });
+    }
+
+    template <typename T> inline void mul_na(int n, T *c, const T *a, const T *b)
+    {
+      batch_binary(n, c, a, b, [](SU3Tile<T> &c, const SU3Tile<T> &a, const SU3Tile<T> &b) { mul_na(c, a, b); });
+    }
+
+    template <typename T> inline void mul_an(int n, T *c, const T *a, const T *b)
+    {
+      batch_binary(n, c, a, b, [](SU3Tile<T> &c, const SU3Tile<T> &a, const SU3Tile<T> &b) { mul_an(c, a, b); });
+    }
+
+    template <typename T> inline void mat_vec(int n, T *y, const T *m, const T *x)
+    {
+      batch_vector(n, y, m, x, [](ColorTile<T> &y, const SU3Tile<T> &m, const ColorTile<T> &x) { mat_vec(y, m, x); });
+    }
+
+    template <typename T> inline void adj_mat_vec(int n, T *y, const T *m, const T *x)
+    {
+      batch_vector(n, y, m, x,
+                   [](ColorTile<T> &y, const SU3Tile<T> &m, const ColorTile<T> &x) { adj_mat_vec(y, m, x); });
+    }
+
+    template <typename T> inline void project(int n, T *c, const T *a)
+    {
+      batch_unary(n, c, a, [](SU3Tile<T> &c, SU3Tile<T> &a) {
+        project(a);
+        c = a;
+      });
+    }
+
+    template <typename T> inline void exponentiate(int n, T *c, const T *a)
+    {
+      batch_unary(n, c, a, [](SU3Tile<T> &c, const SU3Tile<T> &a) { exponentiate(c, a); });
+    }
+
+    template <typename T> inline void reunitarize(int n, T *c, const T *a)
+    {
+      batch_unary(n, c, a, [](SU3Tile<T> &c, SU3Tile<T> &a) {
+        reunitarize(a);
+        c = a;
+      });
+    }
+
+    /**
+       @brief Site kernels: c = a b, a b^dagger and a^dagger b of single
+       matrices stored as 18 reals, computed in the precision of c
+    */
+    template <typename T, typename U, typename V> inline void mul_nn(T *c, const U *a, const V *b)
+    {
+      SU3Tile<T, 1> A, B, C;
+      A.load(0, a);
+      B.load(0, b);
+      mul_nn(C, A, B);
+      C.store(0, c);
+    }
+
+    template <typename T, typename U, typename V> inline void mul_na(T *c, const U *a, const V *b)
+    {
+      SU3Tile<T, 1> A, B, C;
+      A.load(0, a);
+      B.load(0, b);
+      mul_na(C, A, B);
+      C.store(0, c);
+    }
+
+    template <typename T, typename U, typename V> inline void mul_an(T *c, const U *a, const V *b)
+    {
+      SU3Tile<T, 1> A, B, C;
+      A.load(0, a);
+      B.load(0, b);
+      mul_an(C, A, B);
+      C.store(0, c);
+    }
+
+    /**
+       @brief Site kernels: y = m x and m^dagger x of a single matrix and
+       color vector, computed in the precision of y
+    */
+    template <typename T, typename U, typename V> inline void mat_vec(T *y, const U *m, const V *x)
+    {
+      SU3Tile<T, 1> M;
+      ColorTile<T, 1> X, Y;
+      M.load(0, m);
+      X.load(0, x);
+      mat_vec(Y, M, X);
+      Y.store(0, y);
+    }
+
+    template <typename T, typename U, typename V> inline void adj_mat_vec(T *y, const U *m, const V *x)
+    {
+      SU3Tile<T, 1> M;
+      ColorTile<T, 1> X, Y;
+      M.load(0, m);
+      X.load(0, x);
+      adj_mat_vec(Y, M, X);
+      Y.store(0, y);
+    }
+
+  } // namespace host
+
+} // namespace quda
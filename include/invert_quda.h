@@ -664,6 +664,29 @@ namespace quda {
 
 
 
+  /**
+     @brief Pipelined CG (Ghysels and Vanroose): the two inner products
+     of each iteration are merged into a single reduction, halving the
+     number of global synchronizations per iteration compared to CG,
+     at the cost of three extra vector recurrences.  Mixed precision
+     uses reliable updates with residual replacement.
+   */
+  class PipelinedCG : public Solver {
+
+  private:
+    const DiracMatrix &mat;
+    const DiracMatrix &matSloppy;
+    // pointers to fields to avoid multiple creation overhead
+    ColorSpinorField *yp, *rp, *tmpp, *rSp, *xSp, *wSp, *pSp, *sSp, *zSp, *qSp, *tmpSp, *tmp2Sp;
+    bool init;
+
+  public:
+    PipelinedCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile);
+    virtual ~PipelinedCG();
+
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
+  };
+
   class CG3NE : public Solver {
 
   private:
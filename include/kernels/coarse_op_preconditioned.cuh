@@ -1,5 +1,6 @@
 #include <gauge_field_order.h>
 #include <index_helper.cuh>
+#include <host_parallel.h>
 
 namespace quda {
 
@@ -90,21 +91,22 @@ namespace quda {
     return yHatMax;
   }
 
-  template <bool compute_max_only, typename Arg> void CalculateYhatCPU(Arg &arg)
+  template <bool compute_max_only, typename Arg> void CalculateYhatCPU(Arg &arg, int chunk)
   {
-    typename Arg::Float max = 0.0;
-    for (int d=0; d<4; d++) {
-      for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
-        for (int x_cb = 0; x_cb < arg.Y.VolumeCB(); x_cb++) {
-          for (int i = 0; i < Arg::n; i++)
-            for (int j = 0; j < Arg::n; j++) {
-              typename Arg::Float max_x = computeYhat<compute_max_only>(arg, d, x_cb, parity, i, j);
-              if (compute_max_only) max = max > max_x ? max : max_x;
-            }
-        }
-      } //parity
-    } // dimension
+    using Float = typename Arg::Float;
+    // d runs slowest, then parity, to match the site loop of the GPU kernel
+    Float max = host::parallel_reduce(
+      4 * 2, arg.Y.VolumeCB(), static_cast<Float>(0.0),
+      [&](int d_parity, int x_cb) {
+        Float max = 0.0;
+        for (int i = 0; i < Arg::n; i++)
+          for (int j = 0; j < Arg::n; j++) {
+            Float max_x = computeYhat<compute_max_only>(arg, d_parity / 2, x_cb, d_parity % 2, i, j);
+            if (compute_max_only) max = max > max_x ? max : max_x;
+          }
+        return max;
+      },
+      host::maximum<Float>());
     if (compute_max_only) *arg.max_h = max;
   }
 
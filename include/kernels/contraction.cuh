@@ -5,6 +5,8 @@
 #include <quda_matrix.h>
 #include <matrix_field.h>
 #include <su3_project.cuh>
+#include <cub_helper.cuh>
+#include <atomic.cuh>
 
 namespace quda
 {
@@ -62,32 +64,18 @@ namespace quda
     arg.s.save(A, x_cb, parity);
   }
 
-  template <typename real, typename Arg> __global__ void computeDegrandRossiContraction(Arg arg)
+  /**
+     @brief Spin contraction of the color-contracted elementals with the
+     16 Degrand-Rossi gamma matrices, in the layout of enum_quda.h
+     @param[out] A Contractions, G_idx = 4*rho + tau
+     @param[in] spin_elem Color inner products <x_mu | y_nu>
+  */
+  template <typename real>
+  __device__ __host__ inline void degrandRossiContract(complex<real> A[16], const complex<real> spin_elem[4][4])
   {
-    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
-    int parity = threadIdx.y + blockIdx.y * blockDim.y;
-    const int nSpin = arg.nSpin;
-    const int nColor = arg.nColor;
-
-    if (x_cb >= arg.threads) return;
-
-    typedef ColorSpinor<real, nColor, nSpin> Vector;
-
-    Vector x = arg.x(x_cb, parity);
-    Vector y = arg.y(x_cb, parity);
-
     complex<real> I(0.0, 1.0);
-    complex<real> spin_elem[nSpin][nSpin];
     complex<real> result_local(0.0, 0.0);
 
-    // Color contract: <\phi(x)_{\mu} | \phi(y)_{\nu}>
-    // The Bra is conjugated
-    for (int mu = 0; mu < nSpin; mu++) {
-      for (int nu = 0; nu < nSpin; nu++) { spin_elem[mu][nu] = innerProduct(x, y, mu, nu); }
-    }
-
-    complex<real> A[nSpin * nSpin];
-
     // Spin contract: <\phi(x)_{\mu} \Gamma_{mu,nu}^{rho,tau} \phi(y)_{\nu}>
     // The rho index runs slowest.
     // Layout is defined in enum_quda.h: G_idx = 4*rho + tau
@@ -228,7 +216,153 @@ namespace quda
     result_local += spin_elem[2][2];
     result_local += spin_elem[3][3];
     A[G_idx++] = result_local;
+  }
+
+  template <typename real, typename Arg> __global__ void computeDegrandRossiContraction(Arg arg)
+  {
+    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y + blockIdx.y * blockDim.y;
+    const int nSpin = arg.nSpin;
+    const int nColor = arg.nColor;
+
+    if (x_cb >= arg.threads) return;
+
+    typedef ColorSpinor<real, nColor, nSpin> Vector;
+
+    Vector x = arg.x(x_cb, parity);
+    Vector y = arg.y(x_cb, parity);
+
+    complex<real> spin_elem[nSpin][nSpin];
+
+    // Color contract: <\phi(x)_{\mu} | \phi(y)_{\nu}>
+    // The Bra is conjugated
+    for (int mu = 0; mu < nSpin; mu++) {
+      for (int nu = 0; nu < nSpin; nu++) { spin_elem[mu][nu] = innerProduct(x, y, mu, nu); }
+    }
+
+    complex<real> A[nSpin * nSpin];
+    degrandRossiContract(A, spin_elem);
 
     arg.s.save(A, x_cb, parity);
   }
+
+  /**
+     @brief Contract the spinors at one site, as the open spin
+     (computeColorContraction) or Degrand-Rossi
+     (computeDegrandRossiContraction) contractions
+  */
+  template <typename real, typename Vector>
+  __device__ __host__ inline void contractSite(complex<real> A[16], const Vector &x, const Vector &y,
+                                               QudaContractType cType)
+  {
+    complex<real> spin_elem[4][4];
+    for (int mu = 0; mu < 4; mu++)
+      for (int nu = 0; nu < 4; nu++) spin_elem[mu][nu] = innerProduct(x, y, mu, nu);
+
+    if (cType == QUDA_CONTRACT_TYPE_DR) {
+      degrandRossiContract(A, spin_elem);
+    } else {
+      for (int mu = 0; mu < 4; mu++)
+        for (int nu = 0; nu < 4; nu++) A[4 * mu + nu] = spin_elem[mu][nu];
+    }
+  }
+
+  /**
+     @brief The phase exp(-i p.x) of the spatial momentum p = 2 pi mom / N
+     @param[in] mom Momentum in units of 2 pi / N
+     @param[in] x Global spatial coordinates
+     @param[in] N Global lattice dimensions
+  */
+  __device__ __host__ inline complex<double> momentumPhase(const int mom[3], const int x[3], const int N[3])
+  {
+    double theta = 0.0;
+    for (int j = 0; j < 3; j++) theta += ((mom[j] * x[j]) % N[j]) / (double)N[j];
+    theta *= -2.0 * M_PI;
+    return complex<double>(cos(theta), sin(theta));
+  }
+
+  template <typename real_> struct ContractionMomArg {
+    using real = real_;
+    static constexpr int nSpin = 4;
+    static constexpr int nColor = 3;
+    static constexpr bool spin_project = true;
+    static constexpr bool spinor_direct_load = false; // false means texture load
+    typedef typename colorspinor_mapper<real, nSpin, nColor, spin_project, spinor_direct_load>::type F;
+
+    int threads; // number of active threads required, the checkerboarded volume of a time slice
+    int X[4];    // grid dimensions
+    int N[4];    // global grid dimensions
+    int offset[4]; // global coordinates of the local origin
+    QudaContractType cType;
+    int n_mom;
+    const int *mom; // n_mom spatial momenta, in device memory
+    double2 *result; // X[3] x n_mom x 16 correlators, in device memory
+
+    F x;
+    F y;
+
+    ContractionMomArg(const ColorSpinorField &x, const ColorSpinorField &y, QudaContractType cType, const int *mom,
+                      int n_mom, double2 *result) :
+      threads(x.VolumeCB() / x.X()[3]),
+      cType(cType),
+      n_mom(n_mom),
+      mom(mom),
+      result(result),
+      x(x),
+      y(y)
+    {
+      for (int dir = 0; dir < 4; dir++) {
+        X[dir] = x.X()[dir];
+        N[dir] = X[dir] * comm_dim(dir);
+        offset[dir] = X[dir] * comm_coord(dir);
+      }
+    }
+  };
+
+  /**
+     @brief Momentum-projected, time-sliced contraction.  Block z
+     handles time slice z; each thread contracts one site, and for each
+     momentum the phased contractions of the block are reduced and
+     added to the correlator of the time slice.
+  */
+  template <int blockSize, typename Arg> __global__ void computeMomentumContraction(Arg arg)
+  {
+    using real = typename Arg::real;
+    using reduce_t = vector_type<double2, 16>;
+    typedef ColorSpinor<real, Arg::nColor, Arg::nSpin> Vector;
+
+    int s_cb = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y;
+    int t = blockIdx.z;
+    bool active = s_cb < arg.threads;
+
+    complex<real> A[16];
+    int x[4] = {0, 0, 0, 0};
+    if (active) {
+      int x_cb = t * arg.threads + s_cb;
+      getCoords(x, x_cb, arg.X, parity);
+      for (int dir = 0; dir < 3; dir++) x[dir] += arg.offset[dir];
+      Vector xv = arg.x(x_cb, parity);
+      Vector yv = arg.y(x_cb, parity);
+      contractSite(A, xv, yv, arg.cType);
+    }
+
+    typedef cub::BlockReduce<reduce_t, blockSize, cub::BLOCK_REDUCE_WARP_REDUCTIONS, 2> BlockReduce;
+    __shared__ typename BlockReduce::TempStorage cub_tmp;
+
+    for (int m = 0; m < arg.n_mom; m++) {
+      reduce_t v;
+      if (active) {
+        complex<double> phase = momentumPhase(arg.mom + 3 * m, x, arg.N);
+        for (int i = 0; i < 16; i++) {
+          complex<double> a = phase * complex<double>(A[i].real(), A[i].imag());
+          v[i] = make_double2(a.real(), a.imag());
+        }
+      }
+      reduce_t sum = BlockReduce(cub_tmp).Sum(v);
+      if (threadIdx.x == 0 && threadIdx.y == 0)
+        for (int i = 0; i < 16; i++) atomicAdd(arg.result + (t * arg.n_mom + m) * 16 + i, sum[i]);
+      __syncthreads(); // cub_tmp is reused by the next momentum
+    }
+  }
 } // namespace quda
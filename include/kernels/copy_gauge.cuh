@@ -1,5 +1,6 @@
 #include <gauge_field_order.h>
 #include <quda_matrix.h>
+#include <host_parallel.h>
 
 namespace quda {
 
@@ -29,31 +30,28 @@ namespace quda {
      Generic CPU gauge reordering and packing
   */
   template <typename FloatOut, typename FloatIn, int length, typename Arg>
-  void copyGauge(Arg &arg) {
+  void copyGauge(Arg &arg, int chunk = 0) {
     typedef typename mapper<FloatIn>::type RegTypeIn;
     typedef typename mapper<FloatOut>::type RegTypeOut;
     constexpr int nColor = Ncolor(length);
 
-    for (int parity=0; parity<2; parity++) {
-
-      for (int d=0; d<arg.geometry; d++) {
-	for (int x=0; x<arg.volume/2; x++) {
+    // parity_d = parity*geometry + d, as for the CUDA kernel
+    host::parallel_for(2 * arg.geometry, arg.volume / 2, [&](int parity_d, int x) {
+      int parity = parity_d / arg.geometry;
+      int d = parity_d % arg.geometry;
 #ifdef FINE_GRAINED_ACCESS
-	  for (int i=0; i<nColor; i++)
-	    for (int j=0; j<nColor; j++) {
-	      arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
-	    }
+      for (int i=0; i<nColor; i++)
+        for (int j=0; j<nColor; j++) {
+          arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
+        }
 #else
-	  Matrix<complex<RegTypeIn>, nColor> in;
-	  Matrix<complex<RegTypeOut>, nColor> out;
-          in = arg.in(d, x, parity);
-          out = in;
-	  arg.out(d, x, parity) = out;
+      Matrix<complex<RegTypeIn>, nColor> in;
+      Matrix<complex<RegTypeOut>, nColor> out;
+      in = arg.in(d, x, parity);
+      out = in;
+      arg.out(d, x, parity) = out;
 #endif
-	}
-      }
-
-    }
+    }, chunk);
   }
 
   /**
@@ -64,28 +62,24 @@ namespace quda {
     typedef typename mapper<Float>::type RegType;
     constexpr int nColor = Ncolor(length);
 
-    for (int parity=0; parity<2; parity++) {
-
-      for (int d=0; d<arg.geometry; d++) {
-	for (int x=0; x<arg.volume/2; x++) {
+    host::parallel_for(2 * arg.geometry, arg.volume / 2, [&](int parity_d, int x) {
+      int parity = parity_d / arg.geometry;
+      int d = parity_d % arg.geometry;
 #ifdef FINE_GRAINED_ACCESS
-	  for (int i=0; i<nColor; i++)
-	    for (int j=0; j<nColor; j++) {
-              complex<Float> u = arg.in(d, parity, x, i, j);
-	      if (isnan(u.real()))
-	        errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, 2*(i*Ncolor(length)+j));
-	      if (isnan(u.imag()))
-		errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, 2*(i*Ncolor(length)+j+1));
-            }
+      for (int i=0; i<nColor; i++)
+        for (int j=0; j<nColor; j++) {
+          complex<Float> u = arg.in(d, parity, x, i, j);
+          if (isnan(u.real()))
+            errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, 2*(i*Ncolor(length)+j));
+          if (isnan(u.imag()))
+            errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, 2*(i*Ncolor(length)+j+1));
+        }
 #else
-	  Matrix<complex<RegType>, nColor> u = arg.in(d, x, parity);
-	  for (int i=0; i<length/2; i++)
-	    if (isnan(u(i).real()) || isnan(u(i).imag())) errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, i);
+      Matrix<complex<RegType>, nColor> u = arg.in(d, x, parity);
+      for (int i=0; i<length/2; i++)
+        if (isnan(u(i).real()) || isnan(u(i).imag())) errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, i);
 #endif
-	}
-      }
-
-    }
+    });
   }
 
   /**
@@ -123,7 +117,7 @@ namespace quda {
      Generic CPU gauge ghost reordering and packing
   */
   template <typename FloatOut, typename FloatIn, int length, typename Arg>
-  void copyGhost(Arg &arg) {
+  void copyGhost(Arg &arg, int chunk = 0) {
     typedef typename mapper<FloatIn>::type RegTypeIn;
     typedef typename mapper<FloatOut>::type RegTypeOut;
     constexpr int nColor = Ncolor(length);
@@ -131,7 +125,7 @@ namespace quda {
     for (int parity=0; parity<2; parity++) {
 
       for (int d=0; d<arg.nDim; d++) {
-        for (int x=0; x<arg.faceVolumeCB[d]; x++) {
+        host::parallel_for(arg.faceVolumeCB[d], [&](int x) {
 #ifdef FINE_GRAINED_ACCESS
           for (int i=0; i<nColor; i++)
             for (int j=0; j<nColor; j++)
@@ -143,7 +137,7 @@ namespace quda {
           out = in;
           arg.out.Ghost(d+arg.out_offset, x, parity) = out;
 #endif
-        }
+        }, chunk);
       }
 
     }
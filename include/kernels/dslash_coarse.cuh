@@ -130,10 +130,10 @@ namespace quda {
 		  int col = s_col*Nc + c_col + color_offset;
 		  if (!dagger)
 		    out[color_local] += arg.Y(d+4, parity, x_cb, row, col)
-		      * arg.inA.Ghost(d, 1, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col+color_offset);
+		      * arg.inA.Ghost(d, 1, their_spinor_parity, ghost_idx, s_col, c_col+color_offset);
 		  else
 		    out[color_local] += arg.Y(d, parity, x_cb, row, col)
-		      * arg.inA.Ghost(d, 1, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col+color_offset);
+		      * arg.inA.Ghost(d, 1, their_spinor_parity, ghost_idx, s_col, c_col+color_offset);
 		}
 	      }
 	    }
@@ -182,7 +182,9 @@ namespace quda {
 	const int gauge_idx = back_idx;
 	if ( arg.commDim[d] && (coord[d] - arg.nFace < 0) ) {
 	  if (doHalo<type>()) {
+            // the spinor ghost holds every source, the link ghost is 4-d
             const int ghost_idx = ghostFaceIndex<0, 5>(coord, arg.dim, d, arg.nFace);
+            const int link_ghost_idx = ghostFaceIndex<0, 4>(coord, arg.dim, d, arg.nFace);
 #pragma unroll
 	    for (int color_local=0; color_local<Mc; color_local++) {
 	      int c_row = color_block + color_local;
@@ -193,11 +195,11 @@ namespace quda {
 		for (int c_col=0; c_col<Nc; c_col+=color_stride) {
 		  int col = s_col*Nc + c_col + color_offset;
 		  if (!dagger)
-		    out[color_local] += conj(arg.Y.Ghost(d, 1-parity, ghost_idx, col, row))
-		      * arg.inA.Ghost(d, 0, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col+color_offset);
+		    out[color_local] += conj(arg.Y.Ghost(d, 1-parity, link_ghost_idx, col, row))
+		      * arg.inA.Ghost(d, 0, their_spinor_parity, ghost_idx, s_col, c_col+color_offset);
 		  else
-		    out[color_local] += conj(arg.Y.Ghost(d+4, 1-parity, ghost_idx, col, row))
-		      * arg.inA.Ghost(d, 0, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col+color_offset);
+		    out[color_local] += conj(arg.Y.Ghost(d+4, 1-parity, link_ghost_idx, col, row))
+		      * arg.inA.Ghost(d, 0, their_spinor_parity, ghost_idx, s_col, c_col+color_offset);
 		}
 	    }
 	  }
@@ -389,16 +391,19 @@ namespace quda {
 
     const int color_offset = lane_id / vector_site_width;
 
-    // for full fields set parity from y thread index else use arg setting
-#if 0  // disable multi-src since this has a measurable impact on single src performance
-    int paritySrc = blockDim.y*blockIdx.y + threadIdx.y;
-    if (paritySrc >= arg.nParity * arg.dim[4]) return;
-    const int src_idx = (arg.nParity == 2) ? paritySrc / 2 : paritySrc; // maybe want to swap order or source and parity for improved locality of same parity
-    const int parity = (arg.nParity == 2) ? paritySrc % 2 : arg.parity;
-#else
-    const int src_idx = 0;
-    const int parity = (arg.nParity == 2) ? blockDim.y*blockIdx.y + threadIdx.y : arg.parity;
-#endif
+    // for full fields set parity from y thread index else use arg setting.
+    // Multiple sources (the fifth dimension) run along y as well, so
+    // that the threads of all sources at a site share the link loads.
+    // The source decomposition is skipped for a single source since
+    // it has a measurable impact on single src performance.
+    const int paritySrc = blockDim.y*blockIdx.y + threadIdx.y;
+    int src_idx = 0;
+    int parity = (arg.nParity == 2) ? paritySrc : arg.parity;
+    if (arg.dim[4] > 1) {
+      if (paritySrc >= arg.nParity * arg.dim[4]) return;
+      src_idx = (arg.nParity == 2) ? paritySrc / 2 : paritySrc;
+      parity = (arg.nParity == 2) ? paritySrc % 2 : arg.parity;
+    }
 
     // z thread dimension is (( s*(Nc/Mc) + color_block )*dim_thread_split + dim)*2 + dir
     int sMd = blockDim.z*blockIdx.z + threadIdx.z;
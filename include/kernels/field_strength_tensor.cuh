@@ -1,3 +1,5 @@
+#pragma once
+
 #include <gauge_field_order.h>
 #include <index_helper.cuh>
 #include <quda_matrix.h>
@@ -5,14 +7,17 @@
 namespace quda
 {
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_ > struct FmunuArg
+  template <typename Float_, int nColor_, QudaReconstructType recon_, QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct FmunuArg
   {
     using Float = Float_;
     static constexpr int nColor = nColor_;
     static_assert(nColor == 3, "Only nColor=3 enabled at this time");
     static constexpr QudaReconstructType recon = recon_;
-    typedef typename gauge_mapper<Float,recon>::type G;
-    typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type F;
+    typedef typename gauge_mapper<Float, recon, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                  QUDA_GHOST_EXCHANGE_INVALID, false, order>::type G;
+    typedef typename gauge_mapper<Float, QUDA_RECONSTRUCT_NO, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                  QUDA_GHOST_EXCHANGE_INVALID, false, order>::type F;
 
     G u;
     F f;
@@ -33,20 +38,21 @@ namespace quda
     }
   };
 
+  /**
+     @brief Compute the clover-leaf field strength F_{mu,nu} at a site
+     @param[in] x Extended coordinates of the site
+     @param[in] X Extended lattice dimensions
+     @param[in] parity Site parity
+     @param[out] plaq Real trace of the first leaf, which is the
+     plaquette at x in the (mu, nu) plane
+     @return The field strength
+  */
   template <int mu, int nu, typename Arg>
-  __device__ __host__ __forceinline__ void computeFmunuCore(Arg &arg, int idx, int parity)
+  __device__ __host__ __forceinline__ Matrix<complex<typename Arg::Float>, 3>
+  computeFmunuLeaves(Arg &arg, const int x[4], const int X[4], int parity, double &plaq)
   {
     typedef Matrix<complex<typename Arg::Float>, 3> Link;
 
-    int x[4];
-    auto &X = arg.X;
-
-    getCoords(x, idx, X, parity);
-    for (int dir = 0; dir < 4; ++dir) {
-      x[dir] += arg.border[dir];
-      X[dir] += 2 * arg.border[dir];
-    }
-
     Link F;
     { // U(x,mu) U(x+mu,nu) U[dagger](x+nu,mu) U[dagger](x,nu)
 
@@ -69,6 +75,7 @@ namespace quda
 
       // compute plaquette
       F = U1 * U2 * conj(U3) * conj(U4);
+      plaq = getTrace(F).real();
     }
 
     { // U(x,nu) U[dagger](x+nu-mu,mu) U[dagger](x-mu,nu) U(x-mu, mu)
@@ -167,9 +174,26 @@ namespace quda
       F *= static_cast<typename Arg::Float>(0.125); // 18 real multiplications
       // 36 floating point operations here
     }
-    
+
+    return F;
+  }
+
+  template <int mu, int nu, typename Arg>
+  __device__ __host__ __forceinline__ void computeFmunuCore(Arg &arg, int idx, int parity)
+  {
+    int x[4];
+    int X[4];
+    for (int dir = 0; dir < 4; ++dir) X[dir] = arg.X[dir];
+
+    getCoords(x, idx, X, parity);
+    for (int dir = 0; dir < 4; ++dir) {
+      x[dir] += arg.border[dir];
+      X[dir] += 2 * arg.border[dir];
+    }
+
+    double plaq;
     constexpr int munu_idx = (mu * (mu - 1)) / 2 + nu; // lower-triangular indexing
-    arg.f(munu_idx, idx, parity) = F;
+    arg.f(munu_idx, idx, parity) = computeFmunuLeaves<mu, nu>(arg, x, X, parity, plaq);
   }
 
   template <typename Arg> __global__ void computeFmunuKernel(Arg arg)
@@ -190,25 +214,4 @@ namespace quda
     }
   }
 
-  template <typename Arg> void computeFmunuCPU(Arg &arg)
-  {
-    for (int parity = 0; parity < 2; parity++) {
-      for (int x_cb = 0; x_cb < arg.threads; x_cb++) {
-        for (int mu = 0; mu < 4; mu++) {
-          for (int nu = 0; nu < mu; nu++) {
-            int mu_nu = (mu * (mu - 1)) / 2 + nu;
-            switch (mu_nu) { // F[1,0], F[2,0], F[2,1], F[3,0], F[3,1], F[3,2]
-            case 0: computeFmunuCore<1, 0>(arg, x_cb, parity); break;
-            case 1: computeFmunuCore<2, 0>(arg, x_cb, parity); break;
-            case 2: computeFmunuCore<2, 1>(arg, x_cb, parity); break;
-            case 3: computeFmunuCore<3, 0>(arg, x_cb, parity); break;
-            case 4: computeFmunuCore<3, 1>(arg, x_cb, parity); break;
-            case 5: computeFmunuCore<3, 2>(arg, x_cb, parity); break;
-            }
-          }
-        }
-      }
-    }
-  }
-
 } // namespace quda
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <gauge_field_order.h>
 #include <index_helper.cuh>
 #include <quda_matrix.h>
@@ -10,13 +12,16 @@ namespace quda
 #define  DOUBLE_TOL	1e-15
 #define  SINGLE_TOL	2e-6
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_, int apeDim_> struct GaugeAPEArg {
+  template <typename Float_, int nColor_, QudaReconstructType recon_, int apeDim_,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct GaugeAPEArg {
     using Float = Float_;
     static constexpr int nColor = nColor_;
     static_assert(nColor == 3, "Only nColor=3 enabled at this time");
     static constexpr QudaReconstructType recon = recon_;
     static constexpr int apeDim = apeDim_;
-    typedef typename gauge_mapper<Float,recon>::type Gauge;
+    typedef typename gauge_mapper<Float, recon, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                  QUDA_GHOST_EXCHANGE_INVALID, false, order>::type Gauge;
 
     Gauge out;
     const Gauge in;
@@ -43,13 +48,8 @@ namespace quda
     }
   };
   
-  template <typename Arg> __global__ void computeAPEStep(Arg arg)
+  template <typename Arg> __host__ __device__ inline void computeAPEStepCore(Arg &arg, int idx, int parity, int dir)
   {
-    int idx = threadIdx.x + blockIdx.x * blockDim.x;
-    int parity = threadIdx.y + blockIdx.y * blockDim.y;
-    int dir = threadIdx.z + blockIdx.z * blockDim.z;
-    if (idx >= arg.threads) return;
-    if (dir >= Arg::apeDim) return;
     using real = typename Arg::Float;
     typedef complex<real> Complex;
     typedef Matrix<complex<real>, Arg::nColor> Link;
@@ -81,4 +81,15 @@ namespace quda
     
     arg.out(dir, linkIndexShift(x, dx, X), parity) = U;
   }
+
+  template <typename Arg> __global__ void computeAPEStep(Arg arg)
+  {
+    int idx = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y + blockIdx.y * blockDim.y;
+    int dir = threadIdx.z + blockIdx.z * blockDim.z;
+    if (idx >= arg.threads) return;
+    if (dir >= Arg::apeDim) return;
+
+    computeAPEStepCore(arg, idx, parity, dir);
+  }
 } // namespace quda
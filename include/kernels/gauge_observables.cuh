@@ -0,0 +1,109 @@
+#pragma once
+
+#include <gauge_field_order.h>
+#include <index_helper.cuh>
+#include <quda_matrix.h>
+#include <cub_helper.cuh>
+#include <kernels/field_strength_tensor.cuh>
+#include <kernels/gauge_qcharge.cuh>
+
+namespace quda
+{
+
+  /**
+     Reduction of the fused observables: the spatial and temporal
+     plaquette, the spatial and temporal field energy, and the
+     topological charge (all unnormalized)
+  */
+  using GaugeObservablesReduce = vector_type<double, 5>;
+
+  template <typename Float_, int nColor_, QudaReconstructType recon_, bool density_ = false,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct GaugeObservablesArg : public ReduceArg<GaugeObservablesReduce> {
+    using Float = Float_;
+    static constexpr int nColor = nColor_;
+    static_assert(nColor == 3, "Only nColor=3 enabled at this time");
+    static constexpr QudaReconstructType recon = recon_;
+    static constexpr bool density = density_;
+    typedef typename gauge_mapper<Float, recon, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                  QUDA_GHOST_EXCHANGE_INVALID, false, order>::type G;
+
+    G u;
+    Float *qDensity;
+
+    int threads; // number of active threads required
+    int X[4];    // grid dimensions
+    int border[4];
+
+    GaugeObservablesArg(const GaugeField &u, Float *qDensity = nullptr) :
+      ReduceArg<GaugeObservablesReduce>(),
+      u(u),
+      qDensity(qDensity),
+      threads(1)
+    {
+      for (int dir = 0; dir < 4; ++dir) {
+        border[dir] = u.R()[dir];
+        X[dir] = u.X()[dir] - border[dir] * 2;
+        threads *= X[dir];
+      }
+      threads /= 2;
+    }
+  };
+
+  /**
+     @brief Compute the observables at a site of the extended field.
+     The clover-leaf field strength is formed in registers, and the
+     plaquette is the trace of its first leaf, so the field strength
+     tensor is never stored.
+  */
+  template <typename Arg>
+  __device__ __host__ inline GaugeObservablesReduce gaugeObservablesCore(Arg &arg, int x_cb, int parity)
+  {
+    using Link = Matrix<complex<typename Arg::Float>, Arg::nColor>;
+
+    int x[4];
+    int X[4];
+    for (int dr = 0; dr < 4; ++dr) X[dr] = arg.X[dr];
+    getCoords(x, x_cb, X, parity);
+    for (int dr = 0; dr < 4; ++dr) {
+      x[dr] += arg.border[dr];
+      X[dr] += 2 * arg.border[dr];
+    }
+
+    // F[Y,X], F[Z,X], F[Z,Y], F[T,X], F[T,Y], F[T,Z] and the matching plaquettes
+    Link F[6];
+    double p[6];
+    F[0] = computeFmunuLeaves<1, 0>(arg, x, X, parity, p[0]);
+    F[1] = computeFmunuLeaves<2, 0>(arg, x, X, parity, p[1]);
+    F[2] = computeFmunuLeaves<2, 1>(arg, x, X, parity, p[2]);
+    F[3] = computeFmunuLeaves<3, 0>(arg, x, X, parity, p[3]);
+    F[4] = computeFmunuLeaves<3, 1>(arg, x, X, parity, p[4]);
+    F[5] = computeFmunuLeaves<3, 2>(arg, x, X, parity, p[5]);
+
+    double3 E = qChargeCore(F);
+    if (Arg::density) arg.qDensity[x_cb + parity * arg.threads] = E.z;
+
+    GaugeObservablesReduce obs;
+    obs[0] = p[0] + p[1] + p[2];
+    obs[1] = p[3] + p[4] + p[5];
+    obs[2] = E.x;
+    obs[3] = E.y;
+    obs[4] = E.z;
+    return obs;
+  }
+
+  template <int blockSize, typename Arg> __global__ void gaugeObservablesKernel(Arg arg)
+  {
+    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y;
+
+    GaugeObservablesReduce obs;
+    while (x_cb < arg.threads) {
+      obs += gaugeObservablesCore(arg, x_cb, parity);
+      x_cb += blockDim.x * gridDim.x;
+    }
+
+    reduce2d<blockSize, 2>(arg, obs);
+  }
+
+} // namespace quda
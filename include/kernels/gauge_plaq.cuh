@@ -1,3 +1,5 @@
+#pragma once
+
 #include <quda_matrix.h>
 #include <gauge_field_order.h>
 #include <launch_kernel.cuh>
@@ -6,13 +8,14 @@
 
 namespace quda {
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_>
+  template <typename Float_, int nColor_, QudaReconstructType recon_, QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
   struct GaugePlaqArg : public ReduceArg<double2> {
     using Float = Float_;
     static constexpr int nColor = nColor_;
     static_assert(nColor == 3, "Only nColor=3 enabled at this time");
     static constexpr QudaReconstructType recon = recon_;
-    typedef typename gauge_mapper<Float,recon>::type Gauge;
+    typedef typename gauge_mapper<Float, recon, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                  QUDA_GHOST_EXCHANGE_INVALID, false, order>::type Gauge;
 
     int threads; // number of active threads required
     int E[4]; // extended grid dimensions
@@ -36,7 +39,7 @@ namespace quda {
   };
 
   template<typename Arg>
-  __device__ inline double plaquette(Arg &arg, int x[], int parity, int mu, int nu) {
+  __device__ __host__ inline double plaquette(Arg &arg, int x[], int parity, int mu, int nu) {
     typedef Matrix<complex<typename Arg::Float>,3> Link;
 
     int dx[4] = {0, 0, 0, 0};
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <gauge_field_order.h>
 #include <index_helper.cuh>
 #include <cub_helper.cuh>
@@ -5,15 +7,17 @@
 namespace quda
 {
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_, bool density_ = false> struct QChargeArg :
-    public ReduceArg<double3>
+  template <typename Float_, int nColor_, QudaReconstructType recon_, bool density_ = false,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct QChargeArg : public ReduceArg<double3>
   {
     using Float = Float_;
     static constexpr int nColor = nColor_;
     static_assert(nColor == 3, "Only nColor=3 enabled at this time");
     static constexpr QudaReconstructType recon = recon_;
     static constexpr bool density = density_;
-    typedef typename gauge_mapper<Float,recon>::type F;
+    typedef typename gauge_mapper<Float, recon, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                  QUDA_GHOST_EXCHANGE_INVALID, false, order>::type F;
 
     int threads; // number of active threads required
     F f;
@@ -28,19 +32,59 @@ namespace quda
     }
   };
 
+  /**
+     @brief Field energy and topological charge density at a site
+     @param[in] F The field strength F[Y,X], F[Z,X], F[Z,Y], F[T,X], F[T,Y], F[T,Z]
+     @return The spatial and temporal field energy (unnormalized) and
+     the charge density
+  */
+  template <typename real, int nColor>
+  __device__ __host__ inline double3 qChargeCore(const Matrix<complex<real>, nColor> F[6])
+  {
+    using Link = Matrix<complex<real>, nColor>;
+    constexpr real q_norm = static_cast<real>(-1.0 / (4*M_PI*M_PI));
+    constexpr real n_inv = static_cast<real>(1.0 / nColor);
+
+    double3 E = make_double3(0.0, 0.0, 0.0);
+
+    // first compute the field energy
+    Link iden;
+    setIdentity(&iden);
+#pragma unroll
+    for (int i=0; i<6; i++) {
+      // Make traceless
+      auto tmp = F[i] - n_inv * getTrace(F[i]) * iden;
+
+      // Sum trace of square, normalise in .cu
+      if (i<3) E.x -= getTrace(tmp * tmp).real(); //spatial
+      else     E.y -= getTrace(tmp * tmp).real(); //temporal
+    }
+
+    // now compute topological charge
+    double Q_idx = 0.0;
+    double Qi[3] = {0.0,0.0,0.0};
+    // unroll computation
+#pragma unroll
+    for (int i=0; i<3; i++) {
+      Qi[i] = getTrace(F[i] * F[5 - i]).real();
+    }
+
+    // apply correct levi-civita symbol
+    for (int i=0; i<3; i++) i%2 == 0 ? Q_idx += Qi[i]: Q_idx -= Qi[i];
+    E.z = Q_idx * q_norm;
+    return E;
+  }
+
   // Core routine for computing the topological charge from the field strength
   template <int blockSize, typename Arg> __global__ void qChargeComputeKernel(Arg arg)
   {
     using real = typename Arg::Float;
     using Link = Matrix<complex<real>, Arg::nColor>;
-    constexpr real q_norm = static_cast<real>(-1.0 / (4*M_PI*M_PI));
-    constexpr real n_inv = static_cast<real>(1.0 / Arg::nColor);
 
     int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
     int parity = threadIdx.y;
 
     double3 E = make_double3(0.0, 0.0, 0.0);
-    double &Q = E.z;
 
     while (x_cb < arg.threads) {
       // Load the field-strength tensor from global memory
@@ -49,32 +93,11 @@ namespace quda
       Link F[] = {arg.f(0, x_cb, parity), arg.f(1, x_cb, parity), arg.f(2, x_cb, parity),
 		  arg.f(3, x_cb, parity), arg.f(4, x_cb, parity), arg.f(5, x_cb, parity)};
 
-      // first compute the field energy
-      Link iden;
-      setIdentity(&iden);
-#pragma unroll
-      for (int i=0; i<6; i++) {
-	// Make traceless
-	auto tmp = F[i] - n_inv * getTrace(F[i]) * iden;
-
-	// Sum trace of square, normalise in .cu
-	if (i<3) E.x -= getTrace(tmp * tmp).real(); //spatial
-	else     E.y -= getTrace(tmp * tmp).real(); //temporal
-      }
-
-      // now compute topological charge
-      double Q_idx = 0.0;
-      double Qi[3] = {0.0,0.0,0.0};
-      // unroll computation
-#pragma unroll
-      for (int i=0; i<3; i++) {
-	Qi[i] = getTrace(F[i] * F[5 - i]).real();
-      }
-
-      // apply correct levi-civita symbol
-      for (int i=0; i<3; i++) i%2 == 0 ? Q_idx += Qi[i]: Q_idx -= Qi[i];
-      Q += Q_idx * q_norm;
-      if (Arg::density) arg.qDensity[x_cb + parity * arg.threads] = Q_idx * q_norm;
+      double3 E_idx = qChargeCore(F);
+      E.x += E_idx.x;
+      E.y += E_idx.y;
+      E.z += E_idx.z;
+      if (Arg::density) arg.qDensity[x_cb + parity * arg.threads] = E_idx.z;
 
       x_cb += blockDim.x * gridDim.x;
     }
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <gauge_field_order.h>
 #include <index_helper.cuh>
 #include <quda_matrix.h>
@@ -7,13 +9,16 @@
 namespace quda
 {
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_, int stoutDim_> struct GaugeSTOUTArg {
+  template <typename Float_, int nColor_, QudaReconstructType recon_, int stoutDim_,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
+  struct GaugeSTOUTArg {
     using Float = Float_;
     static constexpr int nColor = nColor_;
     static_assert(nColor == 3, "Only nColor=3 enabled at this time");
     static constexpr QudaReconstructType recon = recon_;
     static constexpr int stoutDim = stoutDim_;
-    typedef typename gauge_mapper<Float,recon>::type Gauge;
+    typedef typename gauge_mapper<Float, recon, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                  QUDA_GHOST_EXCHANGE_INVALID, false, order>::type Gauge;
 
     Gauge out;
     const Gauge in;
@@ -40,13 +45,8 @@ namespace quda
     }
   };
 
-  template <typename Arg> __global__ void computeSTOUTStep(Arg arg)
+  template <typename Arg> __host__ __device__ inline void computeSTOUTStepCore(Arg &arg, int idx, int parity, int dir)
   {
-    int idx = threadIdx.x + blockIdx.x * blockDim.x;
-    int parity = threadIdx.y + blockIdx.y * blockDim.y;
-    int dir = threadIdx.z + blockIdx.z * blockDim.z;
-    if (idx >= arg.threads) return;
-    if (dir >= Arg::stoutDim) return;
     using real = typename Arg::Float;
     typedef complex<real> Complex;
     typedef Matrix<complex<real>, Arg::nColor> Link;
@@ -102,12 +102,8 @@ namespace quda
     printf("expiQ*u test %d %d %.15e\n", idx, dir, error);    
 #endif
   }
-  
-  
-  //------------------------//
-  // Over-Improved routines //
-  //------------------------//
-  template <typename Arg> __global__ void computeOvrImpSTOUTStep(Arg arg)
+
+  template <typename Arg> __global__ void computeSTOUTStep(Arg arg)
   {
     int idx = threadIdx.x + blockIdx.x * blockDim.x;
     int parity = threadIdx.y + blockIdx.y * blockDim.y;
@@ -115,6 +111,16 @@ namespace quda
     if (idx >= arg.threads) return;
     if (dir >= Arg::stoutDim) return;
 
+    computeSTOUTStepCore(arg, idx, parity, dir);
+  }
+  
+  
+  //------------------------//
+  // Over-Improved routines //
+  //------------------------//
+  template <typename Arg>
+  __host__ __device__ inline void computeOvrImpSTOUTStepCore(Arg &arg, int idx, int parity, int dir)
+  {
     using real = typename Arg::Float;
     typedef complex<real> Complex;
     typedef Matrix<complex<real>, Arg::nColor> Link;
@@ -176,4 +182,15 @@ namespace quda
     printf("expiQ*u test %d %d %.15e\n", idx, dir, error);    
 #endif
   }
+
+  template <typename Arg> __global__ void computeOvrImpSTOUTStep(Arg arg)
+  {
+    int idx = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y + blockIdx.y * blockDim.y;
+    int dir = threadIdx.z + blockIdx.z * blockDim.z;
+    if (idx >= arg.threads) return;
+    if (dir >= Arg::stoutDim) return;
+
+    computeOvrImpSTOUTStepCore(arg, idx, parity, dir);
+  }
 } // namespace quda
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <gauge_field_order.h>
 #include <index_helper.cuh>
 #include <quda_matrix.h>
@@ -13,18 +15,22 @@ namespace quda
     WFLOW_STEP_VT,
   };
 
-  template <typename Float_, int nColor_, QudaReconstructType recon_, int wflow_dim_>
+  template <typename Float_, int nColor_, QudaReconstructType recon_, int wflow_dim_,
+            QudaGaugeFieldOrder order = QUDA_NATIVE_GAUGE_ORDER>
   struct GaugeWFlowArg {
     using Float = Float_;
     static constexpr int nColor = nColor_;
     static_assert(nColor == 3, "Only nColor=3 enabled at this time");
     static constexpr QudaReconstructType recon = recon_;
     static constexpr int wflow_dim = wflow_dim_;
-    typedef typename gauge_mapper<Float,recon>::type Gauge;
-    typedef typename gauge_mapper<Float,QUDA_RECONSTRUCT_NO>::type Matrix; // temp field not on the manifold
+    typedef typename gauge_mapper<Float, recon, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                  QUDA_GHOST_EXCHANGE_INVALID, false, order>::type Gauge;
+    typedef typename gauge_mapper<Float, QUDA_RECONSTRUCT_NO, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                                  QUDA_GHOST_EXCHANGE_INVALID, false, order>::type Matrix; // temp field not on the manifold
 
     Gauge out;
     Matrix temp;
+    Matrix err; // Z0, then the embedded error estimate, if embedded
     const Gauge in;
 
     int threads; // number of active threads required
@@ -36,17 +42,21 @@ namespace quda
     const Float coeff2x1;
     const QudaWFlowType wflow_type;
     const WFlowStepType step_type;
+    const bool embedded;
 
-    GaugeWFlowArg(GaugeField &out, GaugeField &temp, const GaugeField &in, const Float epsilon, const QudaWFlowType wflow_type, const WFlowStepType step_type) :
+    GaugeWFlowArg(GaugeField &out, GaugeField &temp, GaugeField *err, const GaugeField &in, const Float epsilon,
+                  const QudaWFlowType wflow_type, const WFlowStepType step_type) :
       out(out),
       in(in),
       temp(temp),
+      err(err ? *err : temp),
       threads(1),
       coeff1x1(5.0/3.0),
       coeff2x1(-1.0/12.0),
       epsilon(epsilon),
       wflow_type(wflow_type),
-      step_type(step_type)
+      step_type(step_type),
+      embedded(err != nullptr)
     {
       for (int dir = 0; dir < 4; ++dir) {
         border[dir] = in.R()[dir];
@@ -90,6 +100,7 @@ namespace quda
     U = arg.in(dir, linkIndex(x, arg.E), parity);
     Z0 *= conj(U);
     arg.temp(dir, x_cb, parity) = Z0;
+    if (arg.embedded) arg.err(dir, x_cb, parity) = Z0;
     Z0 *= (1.0 / 4.0) * arg.epsilon;
     return Z0;
   }
@@ -126,19 +137,36 @@ namespace quda
     return Z2;
   }
 
+  /**
+     @brief Difference between the third-order update and the
+     embedded second-order update exp(epsilon (2 Z1 - Z0)) W0 of
+     Fritzsch and Ramos (https://arxiv.org/abs/1301.4388), which
+     starting from W2 reads exp(epsilon (5/4 (8/9 Z1 - 17/36 Z0) - 3/16 Z0)) W2
+  */
+  template <typename Link, typename Arg>
+  __host__ __device__ inline auto computeEmbeddedError(Arg &arg, const Link &V, const Link &W2, const int parity,
+                                                       const int x_cb, const int dir)
+  {
+    using real = typename Arg::Float;
+    complex<real> im(0.0, -1.0);
+
+    Link Z0 = arg.err(dir, x_cb, parity);
+    Link Z1 = arg.temp(dir, x_cb, parity);
+    Link Z = (5.0 / 4.0) * Z1 - (3.0 / 16.0) * Z0;
+    Z *= arg.epsilon;
+    makeAntiHerm(Z);
+    Z = im * Z;
+    return V - exponentiate_iQ(Z) * W2;
+  }
+
   // Wilson Flow as defined in https://arxiv.org/abs/1006.4518v3
-  template <QudaWFlowType wflow_type, WFlowStepType step_type, typename Arg> __global__ void computeWFlowStep(Arg arg)
+  template <QudaWFlowType wflow_type, WFlowStepType step_type, typename Arg>
+  __host__ __device__ inline void computeWFlowStepCore(Arg &arg, int x_cb, int parity, int dir)
   {
     using real = typename Arg::Float;
     using Link = Matrix<complex<real>, Arg::nColor>;
     complex<real> im(0.0,-1.0);
 
-    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
-    int parity = threadIdx.y + blockIdx.y * blockDim.y;
-    int dir = threadIdx.z + blockIdx.z * blockDim.z;
-    if (x_cb >= arg.threads) return;
-    if (dir >= Arg::wflow_dim) return;
-
     //Get stacetime and local coords
     int x[4];
     getCoords(x, x_cb, arg.X, parity);
@@ -154,8 +182,21 @@ namespace quda
     // Compute anti-hermitian projection of Z, exponentiate, update U
     makeAntiHerm(Z);
     Z = im * Z;
-    U = exponentiate_iQ(Z) * U;
-    arg.out(dir, linkIndex(x, arg.E), parity) = U;
+    Link V = exponentiate_iQ(Z) * U;
+    arg.out(dir, linkIndex(x, arg.E), parity) = V;
+
+    if (step_type == WFLOW_STEP_VT && arg.embedded) arg.err(dir, x_cb, parity) = computeEmbeddedError(arg, V, U, parity, x_cb, dir);
+  }
+
+  template <QudaWFlowType wflow_type, WFlowStepType step_type, typename Arg> __global__ void computeWFlowStep(Arg arg)
+  {
+    int x_cb = threadIdx.x + blockIdx.x * blockDim.x;
+    int parity = threadIdx.y + blockIdx.y * blockDim.y;
+    int dir = threadIdx.z + blockIdx.z * blockDim.z;
+    if (x_cb >= arg.threads) return;
+    if (dir >= Arg::wflow_dim) return;
+
+    computeWFlowStepCore<wflow_type, step_type>(arg, x_cb, parity, dir);
   }
 
 } // namespace quda
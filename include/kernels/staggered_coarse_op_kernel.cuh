@@ -3,6 +3,7 @@
 #include <multigrid_helper.cuh>
 #include <index_helper.cuh>
 #include <gamma.cuh>
+#include <host_parallel.h>
 
 namespace quda {
 
@@ -115,18 +116,15 @@ namespace quda {
   }
 
   template<typename Float, int fineColor, int coarseSpin, int coarseColor, typename Arg>
-  void ComputeStaggeredVUVCPU(Arg arg)
+  void ComputeStaggeredVUVCPU(Arg arg, int chunk)
   {
-    for (int parity=0; parity<2; parity++) {
-#pragma omp parallel for
-      for (int x_cb=0; x_cb<arg.fineVolumeCB; x_cb++) { // Loop over fine volume
-        for (int ic_f=0; ic_f<fineColor; ic_f++) {
-          for (int jc_f=0; jc_f<fineColor; jc_f++) {
-            ComputeStaggeredVUV<Float,fineColor,coarseSpin,coarseColor>(arg, parity, x_cb, ic_f, jc_f);
-          } // coarse color columns
-        } // coarse color rows
-      } // c/b volume
-    } // parity
+    host::parallel_for(2, arg.fineVolumeCB, [&](int parity, int x_cb) { // Loop over fine volume
+      for (int ic_f=0; ic_f<fineColor; ic_f++) {
+        for (int jc_f=0; jc_f<fineColor; jc_f++) {
+          ComputeStaggeredVUV<Float,fineColor,coarseSpin,coarseColor>(arg, parity, x_cb, ic_f, jc_f);
+        } // coarse color columns
+      } // coarse color rows
+    }, chunk);
   }
 
   template<typename Float, int fineColor, int coarseSpin, int coarseColor, typename Arg>
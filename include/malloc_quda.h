@@ -30,6 +30,11 @@ namespace quda {
    */
   long host_allocated_peak();
 
+  /**
+     @return number of host allocations made so far
+   */
+  long host_allocation_count();
+
   /**
      @return are we using managed memory for device allocations
   */
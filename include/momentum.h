@@ -10,6 +10,14 @@ namespace quda {
    */
   double computeMomAction(const GaugeField &mom);
 
+  /**
+     @brief Host implementation of computeMomAction, which it calls
+     for a QUDA_CPU_FIELD_LOCATION field in MILC or QDP order
+     @param mom Momentum field
+     @return Momentum action contribution
+   */
+  double computeMomActionCPU(const GaugeField &mom);
+
   /**
      Update the momentum field from the force field
 
@@ -102,6 +102,12 @@ namespace quda {
     /** Whether or not this is a staggered solve or not */
     bool is_staggered;
 
+    /** Whether to restore this level from a hierarchy checkpoint rather than running the setup */
+    bool load_checkpoint;
+
+    /** Fingerprint of the hierarchy checkpoint to restore */
+    uint64_t checkpoint_fingerprint;
+
     /**
        This is top level instantiation done when we start creating the multigrid operator.
      */
@@ -128,7 +134,9 @@ namespace quda {
       smoother_solve_type(param.smoother_solve_type[level]),
       location(param.location[level]),
       setup_location(param.setup_location[level]),
-      is_staggered(param.is_staggered == QUDA_BOOLEAN_YES)
+      is_staggered(param.is_staggered == QUDA_BOOLEAN_YES),
+      load_checkpoint(false),
+      checkpoint_fingerprint(0)
     {
       // set the block size
       for (int i = 0; i < QUDA_MAX_DIM; i++) geoBlockSize[i] = param.geo_block_size[level][i];
@@ -162,7 +170,9 @@ namespace quda {
       smoother_solve_type(param.mg_global.smoother_solve_type[level]),
       location(param.mg_global.location[level]),
       setup_location(param.mg_global.setup_location[level]),
-      is_staggered(param.is_staggered == QUDA_BOOLEAN_YES)
+      is_staggered(param.is_staggered == QUDA_BOOLEAN_YES),
+      load_checkpoint(param.load_checkpoint),
+      checkpoint_fingerprint(param.checkpoint_fingerprint)
     {
       // set the block size
       for (int i = 0; i < QUDA_MAX_DIM; i++) geoBlockSize[i] = param.mg_global.geo_block_size[level][i];
@@ -172,6 +182,97 @@ namespace quda {
     }
   };
 
+  /**
+     Refresh controller for a hierarchy that is updated as the gauge
+     field evolves, e.g., in HMC.  It compares the mean outer iteration
+     count, and the mean coarse-solve time per outer iteration, of the
+     solves between two updates with those of the first interval after
+     the last null-space refresh.  Until either has grown by more than
+     the allowed factor, an update only rebuilds the coarse operators
+     with the existing transfer operators.
+   */
+  struct MGRefreshPolicy {
+    /** Relative growth of the solve cost that triggers a refresh */
+    double growth;
+
+    /** Number of outer solves since the last update */
+    int n_solve;
+
+    /** Sum of the outer iteration counts since the last update */
+    double iter;
+
+    /** Time spent in the top-level coarse solves since the last update */
+    double coarse_secs;
+
+    /** Whether the baseline following the last refresh has been set */
+    bool baseline_set;
+
+    /** Mean outer iteration count following the last refresh */
+    double baseline_iter;
+
+    /** Mean coarse-solve time per outer iteration following the last refresh */
+    double baseline_coarse_secs;
+
+    /** Time taken by the last refresh of the null-space vectors,
+        zero until one has been timed */
+    double refresh_secs;
+
+    /** Time taken by the rebuilds done before a refresh was timed */
+    double pending_secs;
+
+    /** Number of rebuilds done before a refresh was timed */
+    int n_pending;
+
+    /** Refresh time saved by the coarse-operator-only rebuilds */
+    double secs_saved;
+
+    /** Number of refreshes and rebuilds done */
+    int n_refresh, n_rebuild;
+
+    MGRefreshPolicy() :
+      growth(0.0),
+      n_solve(0),
+      iter(0.0),
+      coarse_secs(0.0),
+      baseline_set(false),
+      baseline_iter(0.0),
+      baseline_coarse_secs(0.0),
+      refresh_secs(0.0),
+      pending_secs(0.0),
+      n_pending(0),
+      secs_saved(0.0),
+      n_refresh(0),
+      n_rebuild(0)
+    {
+    }
+
+    /**
+       @brief Record an outer solve
+       @param[in] iter Outer iteration count of the solve
+    */
+    void recordSolve(int iter) { n_solve++; this->iter += iter; }
+
+    /**
+       @brief Decide whether the next update should refresh the
+       null-space vectors.  The first interval after a refresh sets
+       the baseline, and an interval without solves gives no reason to
+       refresh.
+       @return Whether to refresh
+    */
+    bool refresh();
+
+    /**
+       @brief Record an update of the hierarchy and start a new
+       interval.  A rebuild saves the time of the last refresh less
+       its own; the initial setup also allocates and tunes, so
+       rebuilds done before a refresh has been timed are only
+       credited once it has.
+       @param[in] refreshed Whether the null-space vectors were refreshed
+       @param[in] secs Time taken by the update
+    */
+    void update(bool refreshed, double secs);
+  };
+
   /**
      Adaptive Multigrid solver
    */
@@ -271,6 +372,12 @@ namespace quda {
     /** Parallel hyper-cubic random number generator for generating null-space vectors */
     RNG *rng;
 
+    /** Refresh controller, only used on the top level */
+    MGRefreshPolicy refresh_policy;
+
+    /** Whether the refresh controller is enabled */
+    bool adaptive_refresh;
+
     /**
        @brief Helper function called on entry to each MG function
        @param[in] level The level we working on
@@ -303,11 +410,55 @@ public:
      */
     void reset(bool refresh=false);
 
+    /**
+       @brief Update the hierarchy after the fine-grid operator has
+       changed.  With adaptive refresh the refresh controller decides
+       whether to refresh the null-space vectors or only rebuild the
+       coarse operators, otherwise the null space is always refreshed.
+       @return Whether the null-space vectors were refreshed
+    */
+    bool update();
+
+    /**
+       @brief Record an outer solve preconditioned by this hierarchy
+       with the refresh controller
+       @param[in] iter Outer iteration count of the solve
+    */
+    void recordSolve(int iter);
+
+    /**
+       @return Refresh time saved so far by coarse-operator-only rebuilds
+    */
+    double refreshSecsSaved() const { return refresh_policy.secs_saved; }
+
     /**
        @brief Dump the null-space vectors to disk.  Will recurse dumping all levels.
     */
     void dumpNullVectors() const;
 
+    /**
+       @brief Write a checkpoint of the hierarchy, holding the
+       null-space vectors, the block-orthonormal basis of the transfer
+       operator and the coarse links of every level, which a later
+       MG instance can restore instead of running the setup.  Will
+       recurse writing all levels.
+       @param[in] prefix Filename prefix of the checkpoint
+       @param[in] fingerprint Fingerprint of the gauge field and of the
+       parameters that define the hierarchy
+    */
+    void saveCheckpoint(const char *prefix, uint64_t fingerprint) const;
+
+    /**
+       @brief Check that a hierarchy checkpoint exists for every level
+       on every process and that it matches the fingerprint
+       @param[in] prefix Filename prefix of the checkpoint
+       @param[in] n_level Number of levels in the hierarchy
+       @param[in] fingerprint Fingerprint of the gauge field and of the
+       parameters that define the hierarchy
+       @return Whether the checkpoint can be restored
+    */
+    static bool checkpointMatches(const char *prefix, int n_level, uint64_t fingerprint);
+
     /**
        @brief Create the smoothers
     */
@@ -320,8 +471,10 @@ public:
 
     /**
        @brief Create the coarse dirac operator
+       @param[in] compute_links Whether to compute the coarse links, or
+       only allocate them to be restored from a hierarchy checkpoint
     */
-    void createCoarseDirac();
+    void createCoarseDirac(bool compute_links = true);
 
     /**
        @brief Create the solver wrapper
@@ -342,10 +495,22 @@ public:
        3. The emulated coarse Dirac operator matches the native one: D_c = R D P
        4. The preconditioned operator was correctly formulated: \hat{D}_c - X^{-1} D_c
        5. The normal operator is indeed normal: im(<x|D^\dag D|x>) < epsilon
+       6. On batched setup levels, the multi-source operator and the
+          batched relaxation match their one-vector counterparts
        @param recursively[in] Whether or not to recursively verify coarser levels, default false
      */
     void verify(bool recursively = false);
 
+    /**
+       @brief Verify the batched null-space setup of this level.  The
+       operator applied to a five-dimensional field of setup_batch_size
+       random sources must match its application to each source alone,
+       and relaxNullVectorsBatched must match the same relaxation run
+       one vector at a time.
+       @param tol[in] Tolerance of the L2 relative deviations
+    */
+    void verifyBatched(double tol);
+
     /**
        This applies the V-cycle to the residual vector returning the residual vector
        @param out The solution vector
@@ -372,6 +537,20 @@ public:
     */
     void generateNullVectors(std::vector<ColorSpinorField*> &B, bool refresh=false);
 
+    /**
+       @brief Relax the null-space vectors in batches with
+       minimal-residual iterations.  Each batch is held in a
+       five-dimensional field so the coarse operator is applied to the
+       whole batch at once, and each vector stops updating once it has
+       converged.  A batch of one relaxes the vectors one at a time
+       with four-dimensional fields.
+       @param B Null-space vectors to relax
+       @param maxiter Maximum number of iterations per vector
+       @param tol Residual reduction at which a vector has converged
+       @param batch Batch size (0 uses setup_batch_size of this level)
+    */
+    void relaxNullVectorsBatched(std::vector<ColorSpinorField *> &B, int maxiter, double tol, int batch = 0);
+
     /**
        @brief Generate lowest eigenvectors
     */
@@ -428,7 +607,7 @@ public:
      even-odd preconditioned and we coarsen the full operator.
    */
   void CoarseOp(GaugeField &Y, GaugeField &X, const Transfer &T,
-		const cudaGaugeField &gauge, const cudaCloverField *clover,
+		const GaugeField &gauge, const CloverField *clover,
 		double kappa, double mu, double mu_factor, QudaDiracType dirac, QudaMatPCType matpc);
 
   /**
@@ -442,7 +621,7 @@ public:
      operator we are constructing the coarse grid operator from.
      For staggered, should always be QUDA_MATPC_INVALID.
    */
-  void StaggeredCoarseOp(GaugeField &Y, GaugeField &X, const Transfer &T, const cudaGaugeField &gauge, double mass,
+  void StaggeredCoarseOp(GaugeField &Y, GaugeField &X, const Transfer &T, const GaugeField &gauge, double mass,
                          QudaDiracType dirac, QudaMatPCType matpc);
 
   /**
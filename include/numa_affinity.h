@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 
 /**
  * sets the cpu affinity of the calling process to the affinity mask reported by nvidia-smi topo
@@ -8,3 +9,59 @@
  * @return          0 if numa affinity was set
  */
 int setNumaAffinityNVML(int deviceid);
+
+/**
+ * sets the cpu affinity of the calling process to the cpus of the NUMA node the device is attached
+ * to, as reported by /sys/bus/pci/devices/<bus id>/numa_node.  The new mask is the intersection with
+ * the current affinity mask, so any binding applied by the job launcher is respected.  If the
+ * launcher has not restricted the process within the node, the cpus of the node are split evenly
+ * between the ranks on this host whose devices are attached to the same node.  This is collective
+ * over all ranks, whether or not the node of the device is known.
+ * @param  deviceid gpu to determine affinity for
+ * @return          0 if numa affinity was set
+ */
+int setNumaAffinitySysfs(int deviceid);
+
+/**
+ * @return the number of NUMA nodes reported by /sys/devices/system/node (1 if unavailable)
+ */
+int numaNodeCount();
+
+/**
+ * @return the NUMA node the given cpu belongs to (0 if unavailable)
+ */
+int numaNodeOfCpu(int cpu);
+
+/**
+ * binds each OpenMP thread of the calling process to a single cpu of its affinity mask.  The cpus
+ * are ordered by NUMA node, so that contiguous blocks of threads (as used by a static schedule)
+ * reside on the same node.  This is a no-op if OpenMP is not enabled.  initQudaDevice only calls
+ * this when the environment variable QUDA_ENABLE_THREAD_BINDING=1 is set.
+ * @return the number of threads bound
+ */
+int bindHostThreads();
+
+/**
+ * Host page placement policies
+ */
+enum NumaPlacement {
+  NUMA_PLACEMENT_NONE,      // pages are placed wherever they are first touched
+  NUMA_PLACEMENT_LOCAL,     // contiguous blocks of pages are touched by the thread that owns them under a static schedule
+  NUMA_PLACEMENT_INTERLEAVE // pages are touched round robin over the threads
+};
+
+/**
+ * @return the placement policy applied to large host allocations, as set by the environment
+ * variable QUDA_NUMA_PLACEMENT=local/interleave/none (default none, so that placement is opt-in)
+ */
+NumaPlacement numaPlacement();
+
+/**
+ * touches every page of a freshly allocated buffer from the thread pool, so that its pages are
+ * placed according to the placement policy.  Buffers smaller than a few pages per thread are left
+ * untouched.
+ * @param ptr       buffer to place
+ * @param bytes     size of the buffer
+ * @param placement policy to apply
+ */
+void numaFirstTouch(void *ptr, size_t bytes, NumaPlacement placement);
@@ -440,8 +440,11 @@ extern "C" {
     int check_interval;
     /** For IRLM/IRAM, quit after n restarts **/
     int max_restarts;
-    /** For the Ritz rotation, the maximal number of extra vectors the solver may allocate **/
+    /** For the Ritz rotation, the maximal number of extra vectors the solver may allocate (0 selects the number
+        from the free device memory; host fields are rotated in place) **/
     int batched_rotate;
+    /** For the block TRLM, the number of vectors the operator is applied to at once **/
+    int block_size;
 
     /** In the test function, cross check the device result against ARPACK **/
     QudaBoolean arpack_check;
@@ -533,6 +536,13 @@ extern "C" {
     /** Maximum number of iterations for refreshing the null-space vectors */
     int setup_maxiter_refresh[QUDA_MAX_MG_LEVEL];
 
+    /** Number of null-space vectors relaxed together with a multi-source
+        operator application on coarse levels (1 relaxes each vector with
+        its own setup solve).  Batches are relaxed with minimal-residual
+        iterations, so only levels above 0 with the MR setup solver are
+        batched */
+    int setup_batch_size[QUDA_MAX_MG_LEVEL];
+
     /** Basis to use for CA-CGN(E/R) setup */
     QudaCABasis setup_ca_basis[QUDA_MAX_MG_LEVEL];
 
@@ -653,6 +663,45 @@ extern "C" {
     /** Filename prefix for where to save the null-space vectors */
     char vec_outfile[QUDA_MAX_MG_LEVEL][256];
 
+    /** Whether to restore the hierarchy (null-space vectors, transfer
+        operators and coarse links) from a checkpoint, skipping the
+        setup if the checkpoint matches the gauge field and parameters */
+    QudaBoolean checkpoint_load;
+
+    /** Filename prefix of the hierarchy checkpoint to restore */
+    char checkpoint_infile[256];
+
+    /** Whether dumpMultigridQuda writes a hierarchy checkpoint */
+    QudaBoolean checkpoint_store;
+
+    /** Filename prefix of the hierarchy checkpoint to write */
+    char checkpoint_outfile[256];
+
+    /** Whether newMultigridQuda restored the hierarchy from the
+        checkpoint rather than running the setup (output) */
+    QudaBoolean checkpoint_restored;
+
+    /** Whether updateMultigridQuda decides itself between refreshing
+        the null-space vectors and only rebuilding the coarse operators
+        with the existing transfer operators, based on the outer
+        iteration counts and coarse-solve times observed since the last
+        refresh */
+    QudaBoolean adaptive_refresh;
+
+    /** Relative growth of the mean outer iteration count, or of the
+        mean coarse-solve time per outer iteration, over its value
+        after the last refresh that triggers a null-space refresh */
+    double refresh_growth;
+
+    /** Whether the last call to updateMultigridQuda refreshed the
+        null-space vectors (output) */
+    QudaBoolean refreshed;
+
+    /** Time saved so far by coarse-operator-only rebuilds over
+        null-space refreshes, counted once a refresh has been timed
+        (output) */
+    double refresh_secs_saved;
+
     /** Whether to use and initial guess during coarse grid deflation */
     QudaBoolean coarse_guess;
 
@@ -754,7 +803,10 @@ extern "C" {
    *               QMP, the existing logical topology is used if it's been
    *               declared.  With MPI or as a fallback with QMP, the default
    *               ordering is lexicographical with the fourth ("t") index
-   *               varying fastest.
+   *               varying fastest.  If QUDA_ENABLE_NODE_RANK_MAP=1 is set,
+   *               the default ordering instead packs the ranks sharing a
+   *               node into compact sub-blocks of the grid to minimize
+   *               inter-node communication (see comm_node_rank_from_coords).
    *
    * @param fdata  Pointer to any data required by "func" (may be NULL)
    *
@@ -994,11 +1046,14 @@ extern "C" {
   void updateMultigridQuda(void *mg_instance, QudaMultigridParam *param);
 
   /**
-   * @brief Dump the null-space vectors to disk
+   * @brief Dump the null-space vectors to disk, and if
+   * QudaMultigridParam::checkpoint_store is set, a checkpoint of the
+   * full hierarchy that newMultigridQuda can restore
    * @param[in] mg_instance Pointer to the instance of multigrid_solver
    * @param[in] param Contains all metadata regarding host and device
    * storage and solver parameters (QudaMultigridParam::vec_outfile
-   * sets the output filename prefix).
+   * and QudaMultigridParam::checkpoint_outfile set the output filename
+   * prefixes).
    */
   void dumpMultigridQuda(void *mg_instance, QudaMultigridParam *param);
 
@@ -1289,6 +1344,25 @@ extern "C" {
    */
   void performWFlownStep(unsigned int n_steps, double step_size, int meas_interval, QudaWFlowType wflow_type);
 
+  /**
+   * Performs Wilson Flow on gaugePrecise with an adaptive step size
+   * and stores it in gaugeSmeared.  The local error of each step is
+   * estimated with an embedded second-order integrator, and the step
+   * size is adjusted to keep it below tol.  Steps are shortened to
+   * land exactly on the measurement times.  A step with a non-finite
+   * error estimate is rejected, and the flow is aborted if the step
+   * size collapses or too many steps in a row are rejected.
+   * @param n_meas Number of measurement times
+   * @param meas_times Flow times at which to measure the Q charge and
+   * field energy, in increasing order; the flow stops at the last one
+   * @param step_size Initial step size, and the step size of the fixed
+   * step flow the saved steps are reported against
+   * @param tol Tolerance on the largest deviation of a link per step
+   * @param wflow_type 1x1 Wilson or 2x1 Symanzik flow type
+   */
+  void performWFlowAdaptive(int n_meas, const double *meas_times, double step_size, double tol,
+                            QudaWFlowType wflow_type);
+
   /**
    * @brief Calculates a variety of gauge-field observables.  If a
    * smeared gauge field is presently loaded (in gaugeSmeared) the
@@ -1311,6 +1385,23 @@ extern "C" {
   void contractQuda(const void *x, const void *y, void *result, const QudaContractType cType, QudaInvertParam *param,
                     const int *X);
 
+  /**
+   * Public function to perform momentum-projected, time-sliced color
+   * contractions of the host spinors x and y.  Only the correlators are
+   * returned, rather than the contraction at every lattice site.
+   * @param[in] x pointer to host data
+   * @param[in] y pointer to host data
+   * @param[out] result pointer to the Nt x n_mom x 16 double-precision
+   * complex correlators, with Nt the global temporal extent
+   * @param[in] cType Which type of contraction (open, degrand-rossi, etc)
+   * @param[in] mom n_mom spatial momenta (px, py, pz), in units of 2 pi / L
+   * @param[in] n_mom Number of momenta
+   * @param[in] param meta data for construction of ColorSpinorFields.
+   * @param[in] X spacetime data for construction of ColorSpinorFields.
+   */
+  void contractMomentumQuda(const void *x, const void *y, void *result, const QudaContractType cType, const int *mom,
+                            int n_mom, QudaInvertParam *param, const int *X);
+
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
    * @param[in,out] gauge, gauge field to be fixed
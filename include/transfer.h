@@ -155,6 +155,8 @@ namespace quda {
      */
     TimeProfile &profile;
 
+    friend class HierarchyCheckpoint;
+
   public:
       /**
        * The constructor for Transfer
@@ -167,9 +169,11 @@ namespace quda {
        * @param parity For single-parity fields are these QUDA_EVEN_PARITY or QUDA_ODD_PARITY
        * @param null_precision The precision to store the null-space basis vectors in
        * @param enable_gpu Whether to enable this to run on GPU (as well as CPU)
+       * @param block_ortho Whether to block orthogonalize the null-space
+       * vectors, or leave the basis to be restored from a hierarchy checkpoint
        */
       Transfer(const std::vector<ColorSpinorField *> &B, int Nvec, int NblockOrtho, int *geo_bs, int spin_bs,
-               QudaPrecision null_precision, TimeProfile &profile);
+               QudaPrecision null_precision, TimeProfile &profile, bool block_ortho = true);
 
       /** The destructor for Transfer */
       virtual ~Transfer();
@@ -193,6 +197,22 @@ namespace quda {
        */
       void R(ColorSpinorField &out, const ColorSpinorField &in) const;
 
+      /**
+       * Apply the prolongator to a set of vectors.  On the host the
+       * vectors are prolongated in a single pass over the null space.
+       * @param out The resulting fields on the fine lattice
+       * @param in The input fields on the coarse lattice
+       */
+      void P(std::vector<ColorSpinorField *> &out, const std::vector<ColorSpinorField *> &in) const;
+
+      /**
+       * Apply the restrictor to a set of vectors.  On the host the
+       * vectors are restricted in a single pass over the null space.
+       * @param out The resulting fields on the coarse lattice
+       * @param in The input fields on the fine lattice
+       */
+      void R(std::vector<ColorSpinorField *> &out, const std::vector<ColorSpinorField *> &in) const;
+
       /**
        * @brief The precision of the packed null-space vectors
        */
@@ -298,6 +318,22 @@ namespace quda {
 		  int Nvec, const int *fine_to_coarse, const int * const *spin_map,
 		  int parity=QUDA_INVALID_PARITY);
 
+  /**
+     @brief Apply the prolongation operator to a set of vectors.  On
+     the host, each element of v is loaded once and applied to all of
+     the vectors.
+     @param[out] out Resulting fine grid fields
+     @param[in] in Input fields on coarse grid
+     @param[in] v Matrix field containing the null-space components
+     @param[in] Nvec Number of null-space components
+     @param[in] fine_to_coarse Fine-to-coarse lookup table (linear indices)
+     @param[in] spin_map Spin blocking lookup table
+     @param[in] parity of the output fine fields (if single parity output fields)
+   */
+  void Prolongate(std::vector<ColorSpinorField *> &out, const std::vector<ColorSpinorField *> &in,
+                  const ColorSpinorField &v, int Nvec, const int *fine_to_coarse, const int *const *spin_map,
+                  int parity = QUDA_INVALID_PARITY);
+
   /**
      @brief Apply the restriction operator
      @param[out] out Resulting coarsened field
@@ -312,6 +348,24 @@ namespace quda {
 		int Nvec, const int *fine_to_coarse, const int *coarse_to_fine, const int * const *spin_map,
 		int parity=QUDA_INVALID_PARITY);
 
+  /**
+     @brief Apply the restriction operator to a set of vectors.  On
+     the host, threads are assigned to aggregates (using
+     coarse_to_fine), so the restriction is race free, and each
+     element of v is loaded once and applied to all of the vectors.
+     @param[out] out Resulting coarsened fields
+     @param[in] in Input fields on fine grid
+     @param[in] v Matrix field containing the null-space components
+     @param[in] Nvec Number of null-space components
+     @param[in] fine_to_coarse Fine-to-coarse lookup table (linear indices)
+     @param[in] coarse_to_fine Coarse-to-fine lookup table (linear indices)
+     @param[in] spin_map Spin blocking lookup table
+     @param[in] parity of the input fine fields (if single parity input fields)
+   */
+  void Restrict(std::vector<ColorSpinorField *> &out, const std::vector<ColorSpinorField *> &in,
+                const ColorSpinorField &v, int Nvec, const int *fine_to_coarse, const int *coarse_to_fine,
+                const int *const *spin_map, int parity = QUDA_INVALID_PARITY);
+
   /**
      @brief Apply the unitary "prolongation" operator for Kahler-Dirac preconditioning
      @param[out] out Resulting fine grid field
@@ -11,6 +11,7 @@
 
 #include <tune_key.h>
 #include <quda_internal.h>
+#include <host_parallel.h>
 
 namespace quda {
 
@@ -290,6 +291,7 @@ namespace quda {
 
       TuneKey key = tuneKey();
       if (use_managed_memory()) strcat(key.aux, ",managed");
+      if (tuneHostChunk() && !strstr(key.aux, ",omp_threads=")) strcat(key.aux, getOmpThreadStr());
       // if key is present in cache then already tuned
       return getTuneCache().find(key) != getTuneCache().end();
     }
@@ -306,8 +308,13 @@ namespace quda {
     virtual std::string paramString(const TuneParam &param) const
       {
 	std::stringstream ps;
-	ps << param;
-	return ps.str();
+        if (tuneHostChunk()) {
+          if (param.block.x == 0) ps << "chunk=static";
+          else ps << "chunk=" << param.block.x;
+        } else {
+          ps << param;
+        }
+        return ps.str();
       }
 
     virtual std::string perfString(float time) const
@@ -320,6 +327,46 @@ namespace quda {
 	return ss.str();
       }
 
+    /**
+       @brief Whether this instance launches a host kernel.  In this
+       case the autotuner only tunes the chunk size of the host
+       parallel_for, which is carried in param.block.x, with 0
+       denoting a static schedule.
+    */
+    virtual bool tuneHostChunk() const { return false; }
+
+    /**
+       @return The smallest chunk size tried when tuning a host kernel
+    */
+    virtual unsigned int hostChunkMin() const { return 16; }
+
+    /**
+       @brief Initialize the launch parameters of a host kernel: a
+       static schedule is tried first, and is also the default when
+       tuning is disabled.
+    */
+    virtual void initHostTuneParam(TuneParam &param) const
+    {
+      param.block = dim3(0, 1, 1);
+      param.grid = dim3(1, 1, 1);
+      param.shared_bytes = 0;
+    }
+
+    /**
+       @brief Step the chunk size of a host kernel through powers of
+       two, up to the chunk size of the static schedule
+    */
+    virtual bool advanceHostTuneParam(TuneParam &param) const
+    {
+      const unsigned int max_chunk = (minThreads() + host::thread_count() - 1) / host::thread_count();
+      param.block.x = param.block.x == 0 ? hostChunkMin() : 2 * param.block.x;
+      if (param.block.x > max_chunk) {
+        param.block.x = 0;
+        return false;
+      }
+      return true;
+    }
+
     virtual void initTuneParam(TuneParam &param) const
     {
       const unsigned int max_threads = deviceProp.maxThreadsDim[0];
@@ -362,6 +409,8 @@ namespace quda {
      */
     void checkLaunchParam(TuneParam &param) {
 
+      if (tuneHostChunk()) return; // host kernels only carry the chunk size
+
       if (param.block.x*param.block.y*param.block.z > (unsigned)deviceProp.maxThreadsPerBlock)
         errorQuda("Requested block size %dx%dx%d=%d greater than hardware limit %d",
                   param.block.x, param.block.y, param.block.z, param.block.x*param.block.y*param.block.z, deviceProp.maxThreadsPerBlock);
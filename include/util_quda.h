@@ -53,8 +53,8 @@ bool getRankVerbosity();
 char *getPrintBuffer();
 
 /**
-   @brief Returns a string of the form
-   ",omp_threads=$OMP_NUM_THREADS", which can be used for storing the
+   @brief Returns a string of the form ",omp_threads=N", where N is
+   the number of host threads, which can be used for storing the
    number of OMP threads for CPU functions recorded in the tune cache.
    @return Returns the string
 */
@@ -12,6 +12,7 @@
 
 #include <jitify_helper.cuh>
 #include <kernels/blas_core.cuh>
+#include <host_parallel.h>
 
 namespace quda {
 
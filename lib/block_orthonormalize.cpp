@@ -0,0 +1,100 @@
+#include <vector>
+#include <algorithm>
+
+#include <Eigen/Dense>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <util_quda.h>
+
+/**
+   Block classical Gram-Schmidt with reorthogonalization (BCGS2), see
+   J. L. Barlow and A. Smoktunowicz, "Reorthogonalized block classical
+   Gram-Schmidt", Numer. Math. 123 (2013) 395.  The intra-block
+   orthonormalization is done with Cholesky QR, and the Gram matrix of
+   the projected block is obtained from that of the unprojected block
+   through the Pythagorean identity (BCGS-PIP), so that the projection
+   and the Gram matrix come from a single multi-reduction.
+*/
+
+namespace quda {
+
+  namespace blas {
+
+    using RowMajorMatrixXcd = Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    // squared norm, relative to the largest squared norm of the block, below which a vector is
+    // considered to be linearly dependent on the preceding ones
+    static constexpr double dependence_tol = 1e-16;
+
+    int blockOrthonormalize(std::vector<ColorSpinorField *> &v, int block_size, double *loss)
+    {
+      const int n = v.size();
+      if (n == 0) errorQuda("vector.size() == 0");
+      if (block_size <= 0 || block_size > n) block_size = n;
+
+      int reductions = 0;
+      for (int s = 0; s < n; s += block_size) {
+        const int e = std::min(s + block_size, n);
+        const int k = e - s;
+        std::vector<ColorSpinorField *> Q(v.begin(), v.begin() + s);
+        std::vector<ColorSpinorField *> X(v.begin() + s, v.begin() + e);
+        std::vector<ColorSpinorField *> QX(v.begin(), v.begin() + e);
+
+        for (int pass = 0; pass < 2; pass++) {
+          // C = [Q X]^dag X, the top s rows are the projection H = Q^dag X, the rest is X^dag X
+          RowMajorMatrixXcd C(e, k);
+          cDotProduct(C.data(), QX, X);
+          reductions++;
+
+          RowMajorMatrixXcd G = C.bottomRows(k);
+          if (s > 0) {
+            RowMajorMatrixXcd H = -C.topRows(s);
+            caxpy(H.data(), Q, X); // X -= Q H
+            G -= H.adjoint() * H;  // (X - Q H)^dag (X - Q H) = X^dag X - H^dag H
+          }
+
+          // G = L L^dag, and X <- X L^-dag
+          Eigen::LLT<RowMajorMatrixXcd> llt(G);
+          const double scale = G.diagonal().real().maxCoeff();
+          int rank = llt.info() == Eigen::Success ? k : 0;
+          for (int j = 0; j < rank; j++)
+            if (std::norm(llt.matrixLLT()(j, j)) <= dependence_tol * scale) rank = j;
+
+          if (rank < k) {
+            // in the first pass the Pythagorean Gram matrix may be
+            // spoiled by cancellation, so defer to the second pass,
+            // where it is computed from the projected block
+            if (pass == 0) continue;
+            errorQuda("Cannot normalize %d vector", s + rank);
+          }
+
+          RowMajorMatrixXcd Rinv = llt.matrixU().solve(RowMajorMatrixXcd::Identity(k, k));
+
+          // apply the upper triangular Rinv in place, last column
+          // first, so that the columns it reads are not yet updated
+          for (int j = k - 1; j >= 0; j--) {
+            ax(Rinv(j, j).real(), *X[j]);
+            if (j == 0) continue;
+            std::vector<ColorSpinorField *> Xi(X.begin(), X.begin() + j);
+            std::vector<ColorSpinorField *> Xj {X[j]};
+            std::vector<Complex> a(j);
+            for (int i = 0; i < j; i++) a[i] = Rinv(i, j);
+            caxpy(a.data(), Xi, Xj);
+          }
+        }
+      }
+
+      if (loss) {
+        RowMajorMatrixXcd G(n, n);
+        cDotProduct(G.data(), v, v);
+        *loss = (G - RowMajorMatrixXcd::Identity(n, n)).norm();
+      }
+
+      return reductions;
+    }
+
+  } // namespace blas
+
+} // namespace quda
@@ -161,6 +161,7 @@ void printQudaEigParam(QudaEigParam *param) {
   P(nKr, 0);
   P(nConv, 0);
   P(batched_rotate, 0);
+  P(block_size, 1);
   P(tol, 0.0);
   P(check_interval, 0);
   P(max_restarts, 0);
@@ -185,6 +186,7 @@ void printQudaEigParam(QudaEigParam *param) {
   P(nKr, INVALID_INT);
   P(nConv, INVALID_INT);
   P(batched_rotate, INVALID_INT);
+  P(block_size, INVALID_INT);
   P(tol, INVALID_DOUBLE);
   P(check_interval, INVALID_INT);
   P(max_restarts, INVALID_INT);
@@ -674,10 +676,12 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
     P(setup_tol[i], 5e-6);
     P(setup_maxiter[i], 500);
     P(setup_maxiter_refresh[i], 0);
+    P(setup_batch_size[i], 1);
 #else
     P(setup_tol[i], INVALID_DOUBLE);
     P(setup_maxiter[i], INVALID_INT);
     P(setup_maxiter_refresh[i], INVALID_INT);
+    P(setup_batch_size[i], INVALID_INT);
 #endif
 
 #ifdef INIT_PARAM
@@ -798,11 +802,19 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
   P(run_oblique_proj_check, QUDA_BOOLEAN_FALSE);
   P(coarse_guess, QUDA_BOOLEAN_FALSE);
   P(preserve_deflation, QUDA_BOOLEAN_FALSE);
+  P(checkpoint_load, QUDA_BOOLEAN_FALSE);
+  P(checkpoint_store, QUDA_BOOLEAN_FALSE);
+  P(adaptive_refresh, QUDA_BOOLEAN_FALSE);
+  P(refresh_growth, 1.25);
 #else
   P(run_low_mode_check, QUDA_BOOLEAN_INVALID);
   P(run_oblique_proj_check, QUDA_BOOLEAN_INVALID);
   P(coarse_guess, QUDA_BOOLEAN_INVALID);
   P(preserve_deflation, QUDA_BOOLEAN_INVALID);
+  P(checkpoint_load, QUDA_BOOLEAN_INVALID);
+  P(checkpoint_store, QUDA_BOOLEAN_INVALID);
+  P(adaptive_refresh, QUDA_BOOLEAN_INVALID);
+  P(refresh_growth, INVALID_DOUBLE);
 #endif
 
   for (int i = 0; i < n_level - 1; i++) {
@@ -818,9 +830,15 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
 #ifdef INIT_PARAM
   P(gflops, 0.0);
   P(secs, 0.0);
+  P(refreshed, QUDA_BOOLEAN_FALSE);
+  P(refresh_secs_saved, 0.0);
+  P(checkpoint_restored, QUDA_BOOLEAN_FALSE);
 #elif defined(PRINT_PARAM)
   P(gflops, INVALID_DOUBLE);
   P(secs, INVALID_DOUBLE);
+  P(refreshed, QUDA_BOOLEAN_INVALID);
+  P(refresh_secs_saved, INVALID_DOUBLE);
+  P(checkpoint_restored, QUDA_BOOLEAN_INVALID);
 #endif
 
 #ifdef INIT_PARAM
@@ -1,4 +1,13 @@
+#include <cstring>
+#include <vector>
+
 #include <gauge_field_order.h>
+#include <color_spinor_field.h>
+#include <color_spinor_field_order.h>
+#include <clover_field.h>
+#include <clover_field_order.h>
+#include <index_helper.cuh>
+#include <host_parallel.h>
 #include <cub_helper.cuh>
 
 namespace quda {
@@ -22,12 +31,14 @@ namespace quda {
   template <typename Arg>
   uint64_t ChecksumCPU(const Arg &arg)
   {
-    uint64_t checksum_ = 0;
-    for (int parity=0; parity<2; parity++)
-      for (int x_cb=0; x_cb<arg.volumeCB; x_cb++)
-	for (int d=0; d<arg.U.geometry; d++)
-	  checksum_ ^= siteChecksum(arg, d, parity, x_cb);
-    return checksum_;
+    return host::parallel_reduce(2, arg.volumeCB, static_cast<uint64_t>(0),
+                                 [&](int parity, int x_cb) {
+                                   uint64_t checksum_ = 0;
+                                   for (int d = 0; d < arg.U.geometry; d++)
+                                     checksum_ ^= siteChecksum(arg, d, parity, x_cb);
+                                   return checksum_;
+                                 },
+                                 host::bit_xor<uint64_t>());
   }
 
   template <typename T, int Nc>
@@ -84,4 +95,311 @@ namespace quda {
     return checksum;
   }
 
+  /**
+     Lookup tables for the slicing-by-8 CRC32 (reflected polynomial
+     0xEDB88320, as used by zlib and the SciDAC checksum)
+  */
+  struct CRC32Table {
+    uint32_t t[8][256];
+    CRC32Table()
+    {
+      for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        t[0][i] = c;
+      }
+      for (uint32_t i = 0; i < 256; i++)
+        for (int s = 1; s < 8; s++) t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xff];
+    }
+  };
+
+  static const CRC32Table &crc32Table()
+  {
+    static const CRC32Table table;
+    return table;
+  }
+
+  /**
+     CRC32 of a byte buffer, consuming eight bytes per step (assumes a
+     little-endian host)
+  */
+  inline uint32_t crc32(const char *data, size_t bytes, const CRC32Table &T)
+  {
+    uint32_t crc = 0xFFFFFFFFu;
+    auto p = reinterpret_cast<const unsigned char *>(data);
+    for (; bytes >= 8; bytes -= 8, p += 8) {
+      uint32_t lo, hi;
+      memcpy(&lo, p, 4);
+      memcpy(&hi, p + 4, 4);
+      lo ^= crc;
+      crc = T.t[7][lo & 0xff] ^ T.t[6][(lo >> 8) & 0xff] ^ T.t[5][(lo >> 16) & 0xff] ^ T.t[4][lo >> 24]
+        ^ T.t[3][hi & 0xff] ^ T.t[2][(hi >> 8) & 0xff] ^ T.t[1][(hi >> 16) & 0xff] ^ T.t[0][hi >> 24];
+    }
+    while (bytes--) crc = T.t[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+  }
+
+  inline uint32_t rotl32(uint32_t x, int n) { return n ? (x << n) | (x >> (32 - n)) : x; }
+
+  /**
+     Host driver for the CRC32 checksums.  The functor record(buffer,
+     parity, x_cb) writes the canonical record of a site into buffer,
+     and the site CRCs are combined by XOR after rotation by the
+     global lexicographical site index (x fastest, fifth dimension
+     slowest) modulo 29 and 31.
+     @param[in] X Local (full) lattice dimensions
+     @param[in] Ls Length of the fifth dimension (1 for 4-d fields)
+     @param[in] nParity Number of parities stored in the field
+     @param[in] parity Parity of the sites if nParity = 1
+     @param[in] record_bytes Size of the site record
+     @param[in] record Functor that fills the site record
+   */
+  template <typename Record>
+  uint64_t ChecksumCRC32CPU(const int X[4], int Ls, int nParity, int parity, size_t record_bytes, Record record)
+  {
+    const CRC32Table &table = crc32Table();
+    const int volumeCB4 = X[0] * X[1] * X[2] * X[3] / 2;
+
+    int L[4], offset[4];
+    for (int d = 0; d < 4; d++) {
+      L[d] = X[d] * comm_dim(d);
+      offset[d] = X[d] * comm_coord(d);
+    }
+
+    const int sitesCB = Ls * volumeCB4; // checkerboarded sites including the fifth dimension
+
+    // the two sums are packed into the upper and lower words, which are reduced independently by the XOR
+    uint64_t checksum = host::parallel_reduce(
+      nParity, sitesCB, static_cast<uint64_t>(0),
+      [&](int p, int x_cb) {
+        thread_local std::vector<char> buffer;
+        buffer.resize(record_bytes);
+
+        const int s = x_cb / volumeCB4;
+        int x[4];
+        getCoords(x, x_cb % volumeCB4, X, nParity == 2 ? p : parity);
+        uint64_t r = s;
+        for (int d = 3; d >= 0; d--) r = r * L[d] + x[d] + offset[d];
+
+        record(buffer.data(), p, x_cb);
+        const uint32_t crc = crc32(buffer.data(), record_bytes, table);
+        return (static_cast<uint64_t>(rotl32(crc, r % 29)) << 32) | rotl32(crc, r % 31);
+      },
+      host::bit_xor<uint64_t>());
+    comm_allreduce_xor(&checksum);
+    return checksum;
+  }
+
+  template <typename Float, int nColor, QudaGaugeFieldOrder order>
+  uint64_t ChecksumCRC32(const GaugeField &u)
+  {
+    typedef typename gauge_order_mapper<Float, order, nColor>::type G;
+    typedef typename mapper<Float>::type real;
+    const G U(u);
+    const int geometry = u.Geometry();
+    auto record = [&](char *buffer, int parity, int x_cb) {
+      Float *r = reinterpret_cast<Float *>(buffer);
+      for (int d = 0; d < geometry; d++) {
+        const Matrix<complex<real>, nColor> m = U(d, x_cb, parity);
+        for (int i = 0; i < nColor; i++) {
+          for (int j = 0; j < nColor; j++) {
+            *r++ = m(i, j).real();
+            *r++ = m(i, j).imag();
+          }
+        }
+      }
+    };
+
+    const int X[4] = {u.X()[0], u.X()[1], u.X()[2], u.X()[3]};
+    return ChecksumCRC32CPU(X, 1, 2, 0, geometry * nColor * nColor * 2 * sizeof(Float), record);
+  }
+
+  template <typename Float, int nColor> uint64_t ChecksumCRC32(const GaugeField &u)
+  {
+    uint64_t checksum = 0;
+    switch (u.Order()) {
+    case QUDA_QDP_GAUGE_ORDER: checksum = ChecksumCRC32<Float, nColor, QUDA_QDP_GAUGE_ORDER>(u); break;
+    case QUDA_QDPJIT_GAUGE_ORDER: checksum = ChecksumCRC32<Float, nColor, QUDA_QDPJIT_GAUGE_ORDER>(u); break;
+    case QUDA_MILC_GAUGE_ORDER: checksum = ChecksumCRC32<Float, nColor, QUDA_MILC_GAUGE_ORDER>(u); break;
+    case QUDA_BQCD_GAUGE_ORDER: checksum = ChecksumCRC32<Float, nColor, QUDA_BQCD_GAUGE_ORDER>(u); break;
+    case QUDA_TIFR_GAUGE_ORDER: checksum = ChecksumCRC32<Float, nColor, QUDA_TIFR_GAUGE_ORDER>(u); break;
+    case QUDA_TIFR_PADDED_GAUGE_ORDER: checksum = ChecksumCRC32<Float, nColor, QUDA_TIFR_PADDED_GAUGE_ORDER>(u); break;
+    default: errorQuda("Checksum not implemented for order %d", u.Order());
+    }
+    return checksum;
+  }
+
+  uint64_t ChecksumCRC32(const GaugeField &u)
+  {
+    if (u.GhostExchange() == QUDA_GHOST_EXCHANGE_EXTENDED) errorQuda("Extended gauge fields not supported");
+    if (u.Ncolor() != 3) errorQuda("Unsupported nColor = %d", u.Ncolor());
+
+    if (u.Location() == QUDA_CUDA_FIELD_LOCATION) {
+      GaugeFieldParam param(u);
+      param.order = QUDA_QDP_GAUGE_ORDER;
+      param.reconstruct = QUDA_RECONSTRUCT_NO;
+      param.create = QUDA_NULL_FIELD_CREATE;
+      param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+      param.pad = 0;
+      if (param.Precision() < QUDA_SINGLE_PRECISION) param.setPrecision(QUDA_SINGLE_PRECISION);
+      cpuGaugeField u_host(param);
+      u_host.copy(u);
+      return ChecksumCRC32(u_host);
+    }
+
+    uint64_t checksum = 0;
+    switch (u.Precision()) {
+    case QUDA_DOUBLE_PRECISION: checksum = ChecksumCRC32<double, 3>(u); break;
+    case QUDA_SINGLE_PRECISION: checksum = ChecksumCRC32<float, 3>(u); break;
+    default: errorQuda("Unsupported precision = %d", u.Precision());
+    }
+    return checksum;
+  }
+
+  template <typename Float, int nSpin, int nColor, QudaFieldOrder order>
+  uint64_t ChecksumCRC32(const ColorSpinorField &v)
+  {
+    const colorspinor::FieldOrderCB<Float, nSpin, nColor, 1, order> V(v);
+    auto record = [&](char *buffer, int parity, int x_cb) {
+      Float *r = reinterpret_cast<Float *>(buffer);
+      for (int s = 0; s < nSpin; s++) {
+        for (int c = 0; c < nColor; c++) {
+          const complex<Float> z = V(parity, x_cb, s, c);
+          *r++ = z.real();
+          *r++ = z.imag();
+        }
+      }
+    };
+
+    // single-parity fields have a checkerboarded x dimension
+    const int X[4] = {v.X(0) * (v.SiteSubset() == QUDA_PARITY_SITE_SUBSET ? 2 : 1), v.X(1), v.X(2), v.X(3)};
+    const int Ls = v.Ndim() == 5 ? v.X(4) : 1;
+    const int parity = v.SuggestedParity() == QUDA_ODD_PARITY ? 1 : 0;
+    return ChecksumCRC32CPU(X, Ls, v.SiteSubset(), parity, nSpin * nColor * 2 * sizeof(Float), record);
+  }
+
+  template <typename Float, int nSpin, QudaFieldOrder order> uint64_t ChecksumCRC32(const ColorSpinorField &v)
+  {
+    uint64_t checksum = 0;
+    if (v.Ncolor() == 3) {
+      checksum = ChecksumCRC32<Float, nSpin, 3, order>(v);
+#ifdef GPU_MULTIGRID
+    } else if (v.Ncolor() == 24) {
+      checksum = ChecksumCRC32<Float, nSpin, 24, order>(v);
+    } else if (v.Ncolor() == 32) {
+      checksum = ChecksumCRC32<Float, nSpin, 32, order>(v);
+#endif
+    } else {
+      errorQuda("Unsupported nColor = %d", v.Ncolor());
+    }
+    return checksum;
+  }
+
+  template <typename Float> uint64_t ChecksumCRC32(const ColorSpinorField &v)
+  {
+    constexpr QudaFieldOrder order = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    uint64_t checksum = 0;
+    if (v.Nspin() == 4) {
+#ifdef NSPIN4
+      checksum = ChecksumCRC32<Float, 4, order>(v);
+#else
+      errorQuda("nSpin=4 not enabled for this build");
+#endif
+    } else if (v.Nspin() == 2) {
+#ifdef NSPIN2
+      checksum = ChecksumCRC32<Float, 2, order>(v);
+#else
+      errorQuda("nSpin=2 not enabled for this build");
+#endif
+    } else if (v.Nspin() == 1) {
+#ifdef NSPIN1
+      checksum = ChecksumCRC32<Float, 1, order>(v);
+#else
+      errorQuda("nSpin=1 not enabled for this build");
+#endif
+    } else {
+      errorQuda("Unsupported nSpin = %d", v.Nspin());
+    }
+    return checksum;
+  }
+
+  uint64_t ChecksumCRC32(const ColorSpinorField &v)
+  {
+    // device fields and other host orders are reordered into a host copy
+    if (v.Location() == QUDA_CUDA_FIELD_LOCATION || v.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
+      ColorSpinorParam param(v);
+      param.location = QUDA_CPU_FIELD_LOCATION;
+      param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+      param.create = QUDA_NULL_FIELD_CREATE;
+      param.setPrecision(v.Precision() == QUDA_DOUBLE_PRECISION ? QUDA_DOUBLE_PRECISION : QUDA_SINGLE_PRECISION);
+      cpuColorSpinorField v_host(param);
+      v_host = v;
+      return ChecksumCRC32(v_host);
+    }
+
+    uint64_t checksum = 0;
+    switch (v.Precision()) {
+    case QUDA_DOUBLE_PRECISION: checksum = ChecksumCRC32<double>(v); break;
+    case QUDA_SINGLE_PRECISION: checksum = ChecksumCRC32<float>(v); break;
+    default: errorQuda("Unsupported precision = %d", v.Precision());
+    }
+    return checksum;
+  }
+
+  template <typename Float> uint64_t ChecksumCRC32(const CloverField &clover, bool inverse)
+  {
+    constexpr int nColor = 3;
+    constexpr int nSpin = 4;
+    constexpr int N = nColor * nSpin / 2;
+    const clover::FieldOrder<Float, nColor, nSpin, QUDA_PACKED_CLOVER_ORDER> A(const_cast<CloverField &>(clover),
+                                                                                inverse);
+    auto record = [&](char *buffer, int parity, int x_cb) {
+      Float *r = reinterpret_cast<Float *>(buffer);
+      for (int ch = 0; ch < 2; ch++) {
+        for (int row = 0; row < N; row++) {
+          for (int col = 0; col <= row; col++) {
+            const int s_row = 2 * ch + row / nColor, c_row = row % nColor;
+            const int s_col = 2 * ch + col / nColor, c_col = col % nColor;
+            const complex<Float> z = A(parity, x_cb, s_row, s_col, c_row, c_col);
+            *r++ = z.real();
+            if (col < row) *r++ = z.imag();
+          }
+        }
+      }
+    };
+
+    const int X[4] = {clover.X()[0], clover.X()[1], clover.X()[2], clover.X()[3]};
+    return ChecksumCRC32CPU(X, 1, 2, 0, 2 * N * N * sizeof(Float), record);
+  }
+
+  uint64_t ChecksumCRC32(const CloverField &clover, bool inverse)
+  {
+    if (!clover.V(inverse)) errorQuda("Clover field %s not allocated", inverse ? "inverse" : "direct");
+
+    // device fields and other host orders are reordered into a packed host copy
+    if (clover.Location() == QUDA_CUDA_FIELD_LOCATION || clover.Order() != QUDA_PACKED_CLOVER_ORDER) {
+      CloverFieldParam param(clover);
+      param.order = QUDA_PACKED_CLOVER_ORDER;
+      param.create = QUDA_NULL_FIELD_CREATE;
+      param.direct = clover.V(false) ? true : false;
+      param.inverse = clover.V(true) ? true : false;
+      param.pad = 0;
+      if (param.Precision() < QUDA_SINGLE_PRECISION) param.setPrecision(QUDA_SINGLE_PRECISION);
+      cpuCloverField clover_host(param);
+      if (clover.Location() == QUDA_CUDA_FIELD_LOCATION)
+        static_cast<const cudaCloverField &>(clover).saveCPUField(clover_host);
+      else
+        copyGenericClover(clover_host, clover, inverse, QUDA_CPU_FIELD_LOCATION);
+      return ChecksumCRC32(clover_host, inverse);
+    }
+
+    uint64_t checksum = 0;
+    switch (clover.Precision()) {
+    case QUDA_DOUBLE_PRECISION: checksum = ChecksumCRC32<double>(clover, inverse); break;
+    case QUDA_SINGLE_PRECISION: checksum = ChecksumCRC32<float>(clover, inverse); break;
+    default: errorQuda("Unsupported precision = %d", clover.Precision());
+    }
+    return checksum;
+  }
+
 }
@@ -189,9 +189,14 @@ namespace quda {
   //Calculates the coarse color matrix and puts the result in Y.
   //N.B. Assumes Y, X have been allocated.
   void CoarseOp(GaugeField &Y, GaugeField &X, const Transfer &T,
-		const cudaGaugeField &gauge, const cudaCloverField *clover,
+		const GaugeField &fine_gauge, const CloverField *fine_clover,
 		double kappa, double mu, double mu_factor, QudaDiracType dirac, QudaMatPCType matpc)
   {
+    if (fine_gauge.Location() != QUDA_CUDA_FIELD_LOCATION || (fine_clover && fine_clover->Location() != QUDA_CUDA_FIELD_LOCATION))
+      errorQuda("Coarse-operator construction requires device fine-grid fields");
+    const cudaGaugeField &gauge = static_cast<const cudaGaugeField &>(fine_gauge);
+    const cudaCloverField *clover = static_cast<const cudaCloverField *>(fine_clover);
+
     QudaPrecision precision = Y.Precision();
     QudaFieldLocation location = checkLocation(Y, X);
 
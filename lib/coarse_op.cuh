@@ -36,15 +36,15 @@ namespace quda {
     {
       if (type == COMPUTE_UV) {
         if (arg.dir == QUDA_BACKWARDS) {
-          if      (arg.dim==0) ComputeUVCPU<from_coarse,Float,0,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==1) ComputeUVCPU<from_coarse,Float,1,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==2) ComputeUVCPU<from_coarse,Float,2,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==3) ComputeUVCPU<from_coarse,Float,3,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
+          if      (arg.dim==0) ComputeUVCPU<from_coarse,Float,0,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==1) ComputeUVCPU<from_coarse,Float,1,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==2) ComputeUVCPU<from_coarse,Float,2,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==3) ComputeUVCPU<from_coarse,Float,3,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
         } else if (arg.dir == QUDA_FORWARDS) {
-          if      (arg.dim==0) ComputeUVCPU<from_coarse,Float,0,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==1) ComputeUVCPU<from_coarse,Float,1,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==2) ComputeUVCPU<from_coarse,Float,2,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==3) ComputeUVCPU<from_coarse,Float,3,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
+          if      (arg.dim==0) ComputeUVCPU<from_coarse,Float,0,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==1) ComputeUVCPU<from_coarse,Float,1,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==2) ComputeUVCPU<from_coarse,Float,2,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==3) ComputeUVCPU<from_coarse,Float,3,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
         } else {
           errorQuda("Undefined direction %d", arg.dir);
         }
@@ -52,7 +52,7 @@ namespace quda {
         if (from_coarse) errorQuda("ComputeAV should only be called from the fine grid");
 
 #if defined(GPU_CLOVER_DIRAC) && !defined(COARSECOARSE)
-        ComputeAVCPU<Float,fineSpin,fineColor,coarseColor>(arg);
+        ComputeAVCPU<Float,fineSpin,fineColor,coarseColor>(arg, tp.block.x);
 #else
         errorQuda("Clover dslash has not been built");
 #endif
@@ -61,7 +61,7 @@ namespace quda {
         if (from_coarse) errorQuda("ComputeTMAV should only be called from the fine grid");
 
 #if defined(GPU_TWISTED_MASS_DIRAC) && !defined(COARSECOARSE)
-        ComputeTMAVCPU<Float,fineSpin,fineColor,coarseColor>(arg);
+        ComputeTMAVCPU<Float,fineSpin,fineColor,coarseColor>(arg, tp.block.x);
 #else
         errorQuda("Twisted mass dslash has not been built");
 #endif
@@ -70,7 +70,7 @@ namespace quda {
         if (from_coarse) errorQuda("ComputeTMCAV should only be called from the fine grid");
 
 #if defined(GPU_TWISTED_CLOVER_DIRAC) && !defined(COARSECOARSE)
-        ComputeTMCAVCPU<Float,fineSpin,fineColor,coarseColor>(arg);
+        ComputeTMCAVCPU<Float,fineSpin,fineColor,coarseColor>(arg, tp.block.x);
 #else
         errorQuda("Twisted clover dslash has not been built");
 #endif
@@ -79,7 +79,7 @@ namespace quda {
         if (from_coarse) errorQuda("ComputeInvCloverMax should only be called from the fine grid");
 
 #if defined(DYNAMIC_CLOVER) && !defined(COARSECOARSE)
-        ComputeCloverInvMaxCPU<Float, false>(arg);
+        ComputeCloverInvMaxCPU<Float, false>(arg, tp.block.x);
 #else
         errorQuda("ComputeInvCloverMax only enabled with dynamic clover");
 #endif
@@ -88,37 +88,37 @@ namespace quda {
         if (from_coarse) errorQuda("ComputeInvCloverMax should only be called from the fine grid");
 
 #if defined(DYNAMIC_CLOVER) && !defined(COARSECOARSE)
-        ComputeCloverInvMaxCPU<Float, true>(arg);
+        ComputeCloverInvMaxCPU<Float, true>(arg, tp.block.x);
 #else
         errorQuda("ComputeInvCloverMax only enabled with dynamic clover");
 #endif
 
       } else if (type == COMPUTE_VUV) {
         if (arg.dir == QUDA_BACKWARDS) {
-          if      (arg.dim==0) ComputeVUVCPU<from_coarse,Float,0,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==1) ComputeVUVCPU<from_coarse,Float,1,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==2) ComputeVUVCPU<from_coarse,Float,2,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==3) ComputeVUVCPU<from_coarse,Float,3,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
+          if      (arg.dim==0) ComputeVUVCPU<from_coarse,Float,0,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==1) ComputeVUVCPU<from_coarse,Float,1,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==2) ComputeVUVCPU<from_coarse,Float,2,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==3) ComputeVUVCPU<from_coarse,Float,3,QUDA_BACKWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
         } else if (arg.dir == QUDA_FORWARDS) {
-          if      (arg.dim==0) ComputeVUVCPU<from_coarse,Float,0,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==1) ComputeVUVCPU<from_coarse,Float,1,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==2) ComputeVUVCPU<from_coarse,Float,2,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
-          else if (arg.dim==3) ComputeVUVCPU<from_coarse,Float,3,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg);
+          if      (arg.dim==0) ComputeVUVCPU<from_coarse,Float,0,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==1) ComputeVUVCPU<from_coarse,Float,1,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==2) ComputeVUVCPU<from_coarse,Float,2,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
+          else if (arg.dim==3) ComputeVUVCPU<from_coarse,Float,3,QUDA_FORWARDS,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
         } else {
           errorQuda("Undefined direction %d", arg.dir);
         }
       } else if (type == COMPUTE_COARSE_CLOVER) {
-        ComputeCoarseCloverCPU<from_coarse,Float,fineSpin,coarseSpin,fineColor,coarseColor>(arg);
+        ComputeCoarseCloverCPU<from_coarse,Float,fineSpin,coarseSpin,fineColor,coarseColor>(arg, tp.block.x);
       } else if (type == COMPUTE_REVERSE_Y) {
-        ComputeYReverseCPU<Float,coarseSpin,coarseColor>(arg);
+        ComputeYReverseCPU<Float,coarseSpin,coarseColor>(arg, tp.block.x);
       } else if (type == COMPUTE_DIAGONAL) {
-        AddCoarseDiagonalCPU<Float,coarseSpin,coarseColor>(arg);
+        AddCoarseDiagonalCPU<Float,coarseSpin,coarseColor>(arg, tp.block.x);
       } else if (type == COMPUTE_TMDIAGONAL) {
-        AddCoarseTmDiagonalCPU<Float,coarseSpin,coarseColor>(arg);
+        AddCoarseTmDiagonalCPU<Float,coarseSpin,coarseColor>(arg, tp.block.x);
       } else if (type == COMPUTE_CONVERT) {
-        ConvertCPU<Float,coarseSpin,coarseColor>(arg);
+        ConvertCPU<Float,coarseSpin,coarseColor>(arg, tp.block.x);
       } else if (type == COMPUTE_RESCALE) {
-        RescaleYCPU<Float,coarseSpin,coarseColor>(arg);
+        RescaleYCPU<Float,coarseSpin,coarseColor>(arg, tp.block.x);
       } else {
         errorQuda("Undefined compute type %d", type);
       }
@@ -676,6 +676,8 @@ namespace quda {
       return ( (!arg.shared_atomic && !from_coarse && type == COMPUTE_VUV) || type == COMPUTE_COARSE_CLOVER) ? false : Tunable::advanceSharedBytes(param);
     }
 
+    bool tuneHostChunk() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+
     bool advanceTuneParam(TuneParam &param) const {
       // only do autotuning if we have device fields
       if (meta.Location() == QUDA_CUDA_FIELD_LOCATION && Y.MemType() == QUDA_MEMORY_DEVICE) return Tunable::advanceTuneParam(param);
@@ -18,9 +18,9 @@ namespace quda {
     Launch(Arg &arg, CUresult &error, bool compute_max_only, TuneParam &tp, const cudaStream_t &stream)
     {
       if (compute_max_only)
-        CalculateYhatCPU<true, Arg>(arg);
+        CalculateYhatCPU<true, Arg>(arg, tp.block.x);
       else
-        CalculateYhatCPU<false, Arg>(arg);
+        CalculateYhatCPU<false, Arg>(arg, tp.block.x);
     }
   };
 
@@ -115,6 +115,8 @@ namespace quda {
     // no locality in this kernel so no point in shared-memory tuning
     bool advanceSharedBytes(TuneParam &param) const { return false; }
 
+    bool tuneHostChunk() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+
     bool advanceTuneParam(TuneParam &param) const {
       if (meta.Location() == QUDA_CUDA_FIELD_LOCATION && meta.MemType() == QUDA_MEMORY_DEVICE) return Tunable::advanceTuneParam(param);
       else return false;
@@ -1,5 +1,9 @@
 #include <unistd.h> // for gethostname()
 #include <assert.h>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <map>
 
 #include <quda_internal.h>
 #include <comm_quda.h>
@@ -148,6 +152,205 @@ void comm_destroy_topology(Topology *topo)
   host_free(topo);
 }
 
+/**
+ * Fill the grid points, visited in the given order, with the ranks of
+ * each node in turn.
+ */
+static void fill_node_layout(const std::vector<int> &order, const std::vector<std::vector<int>> &node_ranks,
+                             int *rank_of_grid)
+{
+  size_t k = 0;
+  for (auto &ranks : node_ranks)
+    for (auto r : ranks) rank_of_grid[order[k++]] = r;
+}
+
+int comm_node_map_layout(int ndim, const int *dims, const int *local_dims, int nranks, const int *node_of_rank,
+                         int *rank_of_grid, int *block)
+{
+  if (ndim > QUDA_MAX_DIM) errorQuda("ndim exceeds QUDA_MAX_DIM");
+
+  // ranks belonging to each node in ascending order
+  int nodes = 0;
+  for (int r = 0; r < nranks; r++) nodes = std::max(nodes, node_of_rank[r] + 1);
+  std::vector<std::vector<int>> node_ranks(nodes);
+  for (int r = 0; r < nranks; r++) node_ranks[node_of_rank[r]].push_back(r);
+
+  const int ranks_per_node = nranks / nodes;
+  for (auto &n : node_ranks)
+    if ((int)n.size() != ranks_per_node) return 0;
+
+  std::vector<int> order(nranks);
+  std::vector<int> candidate(nranks);
+  bool found = false;
+  double best_inter = 0.0;
+
+  auto try_candidate = [&](const int *shape) {
+    fill_node_layout(order, node_ranks, candidate.data());
+    double intra, inter;
+    comm_node_map_surface(ndim, dims, local_dims, candidate.data(), node_of_rank, &intra, &inter);
+    if (!found || inter < best_inter) {
+      std::copy(candidate.begin(), candidate.end(), rank_of_grid);
+      for (int i = 0; i < ndim; i++) block[i] = shape[i];
+      best_inter = inter;
+      found = true;
+    }
+  };
+
+  // search all sub-block shapes that tile the grid and hold exactly ranks_per_node ranks
+  int b[QUDA_MAX_DIM];
+  for (int i = 0; i < ndim; i++) b[i] = 1;
+  while (true) {
+    int volume = 1;
+    bool tiles = true;
+    for (int i = 0; i < ndim; i++) {
+      volume *= b[i];
+      if (dims[i] % b[i] != 0) tiles = false;
+    }
+
+    if (tiles && volume == ranks_per_node) {
+      // the n-th sub-block holds node n, and its ranks fill the sub-block, both in lexicographical order
+      int nblocks[QUDA_MAX_DIM];
+      for (int i = 0; i < ndim; i++) nblocks[i] = dims[i] / b[i];
+      for (int n = 0, k = 0; n < nodes; n++) {
+        for (int j = 0; j < ranks_per_node; j++, k++) {
+          int x[QUDA_MAX_DIM];
+          for (int i = ndim - 1, n_rem = n, j_rem = j; i >= 0; i--) {
+            x[i] = (n_rem % nblocks[i]) * b[i] + j_rem % b[i];
+            n_rem /= nblocks[i];
+            j_rem /= b[i];
+          }
+          order[k] = index(ndim, dims, x);
+        }
+      }
+      try_candidate(b);
+    }
+
+    // advance b over [1,dims[i]] with the last dimension running fastest
+    int i = ndim - 1;
+    for (; i >= 0; i--) {
+      if (b[i] < dims[i]) {
+        b[i]++;
+        break;
+      }
+      b[i] = 1;
+    }
+    if (i < 0) break;
+  }
+
+  // for awkward rank counts per node a non-rectangular lexicographical fill can do better
+  const int lex_shape[QUDA_MAX_DIM] = {};
+  for (int k = 0; k < nranks; k++) order[k] = k; // t fastest
+  try_candidate(lex_shape);
+
+  // advance_coords runs the last index fastest, so x fastest follows from reversing the dimensions
+  int rdims[QUDA_MAX_DIM], x[QUDA_MAX_DIM];
+  for (int i = 0; i < ndim; i++) {
+    rdims[i] = dims[ndim - 1 - i];
+    x[i] = 0;
+  }
+  int k = 0;
+  do {
+    int y[QUDA_MAX_DIM];
+    for (int i = 0; i < ndim; i++) y[i] = x[ndim - 1 - i];
+    order[k++] = index(ndim, dims, y);
+  } while (advance_coords(ndim, rdims, x));
+  try_candidate(lex_shape);
+
+  return 1;
+}
+
+void comm_node_map_surface(int ndim, const int *dims, const int *local_dims, const int *rank_of_grid,
+                           const int *node_of_rank, double *intra_node, double *inter_node)
+{
+  *intra_node = 0.0;
+  *inter_node = 0.0;
+
+  int x[QUDA_MAX_DIM];
+  for (int i = 0; i < QUDA_MAX_DIM; i++) x[i] = 0;
+
+  do {
+    const int node = node_of_rank[rank_of_grid[index(ndim, dims, x)]];
+    for (int i = 0; i < ndim; i++) {
+      if (dims[i] == 1) continue;
+      double face = 1.0;
+      for (int j = 0; j < ndim; j++)
+        if (j != i) face *= (local_dims ? local_dims[j] : 1);
+
+      for (int dir = -1; dir <= 1; dir += 2) {
+        int y[QUDA_MAX_DIM];
+        for (int j = 0; j < ndim; j++) y[j] = x[j];
+        y[i] = (x[i] + dir + dims[i]) % dims[i];
+        if (node_of_rank[rank_of_grid[index(ndim, dims, y)]] == node)
+          *intra_node += face;
+        else
+          *inter_node += face;
+      }
+    }
+  } while (advance_coords(ndim, dims, x));
+}
+
+int comm_node_rank_from_coords(const int *coords, void *fdata)
+{
+  auto *md = static_cast<CommNodeMapData *>(fdata);
+  static std::vector<int> rank_of_grid;
+  static std::vector<int> grid_key;
+
+  // the table is rebuilt whenever the process grid changes
+  std::vector<int> key = {comm_size(), md->ndim};
+  for (int i = 0; i < md->ndim; i++) {
+    key.push_back(md->dims[i]);
+    key.push_back(md->local_dims[i]);
+  }
+
+  // the first call for a grid is collective: all processes build the same table
+  if (key != grid_key) {
+    grid_key = key;
+    const int nranks = comm_size();
+    char *hostname_recv_buf = (char *)safe_malloc(128 * nranks);
+    comm_gather_hostname(hostname_recv_buf);
+
+    std::map<std::string, int> node_id;
+    std::vector<int> node_of_rank(nranks);
+    for (int r = 0; r < nranks; r++) {
+      std::string host(&hostname_recv_buf[128 * r], strnlen(&hostname_recv_buf[128 * r], 128));
+      auto it = node_id.find(host);
+      if (it == node_id.end()) it = node_id.insert(std::make_pair(host, (int)node_id.size())).first;
+      node_of_rank[r] = it->second;
+    }
+    host_free(hostname_recv_buf);
+
+    bool use_local_dims = true;
+    for (int i = 0; i < md->ndim; i++)
+      if (md->local_dims[i] <= 0) use_local_dims = false;
+
+    rank_of_grid.resize(nranks);
+    int block[QUDA_MAX_DIM];
+    if (comm_node_map_layout(md->ndim, md->dims, use_local_dims ? md->local_dims : nullptr, nranks, node_of_rank.data(),
+                             rank_of_grid.data(), block)) {
+      if (getVerbosity() >= QUDA_VERBOSE) {
+        if (block[0] > 0) {
+          std::string shape = std::to_string(block[0]);
+          for (int i = 1; i < md->ndim; i++) shape += "x" + std::to_string(block[i]);
+          printfQuda("Node-aware rank map: %d nodes with sub-block %s\n", (int)node_id.size(), shape.c_str());
+        } else {
+          printfQuda("Node-aware rank map: %d nodes with lexicographical fill\n", (int)node_id.size());
+        }
+      }
+    } else {
+      warningQuda("Node-aware rank map not possible for %d ranks on %d nodes, using lexicographical map", nranks,
+                  (int)node_id.size());
+      int x[QUDA_MAX_DIM];
+      for (int i = 0; i < QUDA_MAX_DIM; i++) x[i] = 0;
+      do {
+        int idx = index(md->ndim, md->dims, x);
+        rank_of_grid[idx] = idx;
+      } while (advance_coords(md->ndim, md->dims, x));
+    }
+  }
+
+  return rank_of_grid[index(md->ndim, md->dims, coords)];
+}
+
 static int gpuid = -1;
 
 int comm_gpuid(void) { return gpuid; }
@@ -3,6 +3,7 @@
 #include <cstring>
 #include <algorithm>
 #include <numeric>
+#include <vector>
 #include <mpi.h>
 #include <quda_internal.h>
 #include <comm_quda.h>
@@ -321,6 +322,37 @@ void comm_broadcast(void *data, size_t nbytes)
   MPI_CHECK(MPI_Bcast(data, (int)nbytes, MPI_BYTE, 0, MPI_COMM_HANDLE));
 }
 
+void comm_alltoall_dim(void *recv, const void *send, size_t nbytes, int dim)
+{
+  Topology *topo = comm_default_topology();
+  const int ndim = comm_ndim(topo);
+  const int n = comm_dim(dim);
+  const int me = comm_coord(dim);
+
+  // tags above the range used by the displaced message handles, so
+  // the all-to-all cannot match a message posted by a halo exchange
+  const int tag = 2 * pow(4 * max_displacement, ndim) + dim;
+
+  int coords[QUDA_MAX_DIM];
+  for (int i = 0; i < ndim; i++) coords[i] = comm_coords(topo)[i];
+
+  std::vector<MPI_Request> request;
+  for (int j = 0; j < n; j++) {
+    if (j == me) continue;
+    coords[dim] = j;
+    int peer = comm_rank_from_coords(topo, coords);
+    request.emplace_back();
+    MPI_CHECK(MPI_Irecv(static_cast<char *>(recv) + j * nbytes, nbytes, MPI_BYTE, peer, tag, MPI_COMM_HANDLE,
+                        &request.back()));
+    request.emplace_back();
+    MPI_CHECK(MPI_Isend(static_cast<const char *>(send) + j * nbytes, nbytes, MPI_BYTE, peer, tag, MPI_COMM_HANDLE,
+                        &request.back()));
+  }
+  memcpy(static_cast<char *>(recv) + me * nbytes, static_cast<const char *>(send) + me * nbytes, nbytes);
+
+  MPI_CHECK(MPI_Waitall(request.size(), request.data(), MPI_STATUSES_IGNORE));
+}
+
 void comm_barrier(void) { MPI_CHECK(MPI_Barrier(MPI_COMM_HANDLE)); }
 
 void comm_abort_(int status)
@@ -1,6 +1,8 @@
 #include <qmp.h>
 #include <algorithm>
 #include <numeric>
+#include <vector>
+#include <cstring>
 #include <quda_internal.h>
 #include <comm_quda.h>
 #include <mpi_comm_handle.h>
@@ -297,6 +299,42 @@ void comm_broadcast(void *data, size_t nbytes)
 }
 
 
+void comm_alltoall_dim(void *recv, const void *send, size_t nbytes, int dim)
+{
+  Topology *topo = comm_default_topology();
+  const int ndim = comm_ndim(topo);
+  const int n = comm_dim(dim);
+  const int me = comm_coord(dim);
+
+  int coords[QUDA_MAX_DIM];
+  for (int i = 0; i < ndim; i++) coords[i] = comm_coords(topo)[i];
+
+  std::vector<QMP_msgmem_t> mem;
+  std::vector<QMP_msghandle_t> handle;
+  for (int j = 0; j < n; j++) {
+    if (j == me) continue;
+    coords[dim] = j;
+    int peer = comm_rank_from_coords(topo, coords);
+
+    mem.push_back(QMP_declare_msgmem(static_cast<char *>(recv) + j * nbytes, nbytes));
+    if (mem.back() == NULL) errorQuda("Unable to allocate QMP message memory");
+    handle.push_back(QMP_declare_receive_from(mem.back(), peer, 0));
+    if (handle.back() == NULL) errorQuda("Unable to allocate QMP message handle");
+
+    mem.push_back(QMP_declare_msgmem(static_cast<char *>(const_cast<void *>(send)) + j * nbytes, nbytes));
+    if (mem.back() == NULL) errorQuda("Unable to allocate QMP message memory");
+    handle.push_back(QMP_declare_send_to(mem.back(), peer, 0));
+    if (handle.back() == NULL) errorQuda("Unable to allocate QMP message handle");
+  }
+
+  for (auto &h : handle) QMP_CHECK(QMP_start(h));
+  memcpy(static_cast<char *>(recv) + me * nbytes, static_cast<const char *>(send) + me * nbytes, nbytes);
+  for (auto &h : handle) QMP_CHECK(QMP_wait(h));
+
+  for (auto &h : handle) QMP_free_msghandle(h);
+  for (auto &m : mem) QMP_free_msgmem(m);
+}
+
 void comm_barrier(void)
 {
   QMP_CHECK( QMP_barrier() );
@@ -61,6 +61,8 @@ void comm_allreduce_xor(uint64_t *data) {}
 
 void comm_broadcast(void *data, size_t nbytes) {}
 
+void comm_alltoall_dim(void *recv, const void *send, size_t nbytes, int dim) { memcpy(recv, send, nbytes); }
+
 void comm_barrier(void) {}
 
 void comm_abort_(int status) {
@@ -1,3 +1,6 @@
+#include <vector>
+#include <algorithm>
+
 #include <tune_quda.h>
 #include <quda_internal.h>
 #include <color_spinor_field.h>
@@ -6,6 +9,8 @@
 #include <contract_quda.h>
 #include <jitify_helper.cuh>
 #include <kernels/contraction.cuh>
+#include <launch_kernel.cuh>
+#include <host_parallel.h>
 
 namespace quda {
 
@@ -102,7 +107,208 @@ public:
     qudaDeviceSynchronize();
   }
 
+  template <typename Arg> class MomentumContraction : TunableLocalParity
+  {
+    Arg &arg;
+    const ColorSpinorField &x;
+
+    bool tuneGridDim() const { return false; }
+    unsigned int minThreads() const { return arg.threads; }
+
+    // one block in z per time slice
+    void setGridZ(TuneParam &param) const { param.grid.z = arg.X[3]; }
+
+  public:
+    MomentumContraction(Arg &arg, const ColorSpinorField &x) : TunableLocalParity(), arg(arg), x(x)
+    {
+      switch (arg.cType) {
+      case QUDA_CONTRACT_TYPE_OPEN: strcat(aux, "open,"); break;
+      case QUDA_CONTRACT_TYPE_DR: strcat(aux, "degrand-rossi,"); break;
+      default: errorQuda("Unexpected contraction type %d", arg.cType);
+      }
+      strcat(aux, x.AuxString());
+      char n_mom[16];
+      sprintf(n_mom, ",n_mom=%d", arg.n_mom);
+      strcat(aux, n_mom);
+#ifdef JITIFY
+      create_jitify_program("kernels/contraction.cuh");
+#endif
+    }
+
+    void apply(const cudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      // the correlators are accumulated, so clear them before every launch (including while tuning)
+      cudaMemsetAsync(arg.result, 0, arg.X[3] * arg.n_mom * 16 * sizeof(double2), stream);
+#ifdef JITIFY
+      using namespace jitify::reflection;
+      jitify_error = program->kernel("quda::computeMomentumContraction")
+                       .instantiate((int)tp.block.x, Type<Arg>())
+                       .configure(tp.grid, tp.block, tp.shared_bytes, stream)
+                       .launch(arg);
+#else
+      LAUNCH_KERNEL_LOCAL_PARITY(computeMomentumContraction, (*this), tp, stream, arg, Arg);
 #endif
+    }
+
+    bool advanceBlockDim(TuneParam &param) const
+    {
+      bool rtn = TunableLocalParity::advanceBlockDim(param);
+      setGridZ(param);
+      return rtn;
+    }
+
+    void initTuneParam(TuneParam &param) const
+    {
+      TunableLocalParity::initTuneParam(param);
+      setGridZ(param);
+    }
+
+    void defaultTuneParam(TuneParam &param) const
+    {
+      TunableLocalParity::defaultTuneParam(param);
+      setGridZ(param);
+    }
+
+    TuneKey tuneKey() const { return TuneKey(x.VolString(), typeid(*this).name(), aux); }
+
+    long long flops() const
+    {
+      long long site = arg.cType == QUDA_CONTRACT_TYPE_OPEN ? 16 * 3 * 6ll : (16 * 3 * 6ll) + (16 * (4 + 12));
+      return (site + arg.n_mom * (16 * 6ll + 20)) * x.Volume();
+    }
+
+    long long bytes() const { return 2 * x.Bytes(); }
+  };
+
+  template <typename real>
+  void contract_momentum_quda(const ColorSpinorField &x, const ColorSpinorField &y, complex<double> *result,
+                              const QudaContractType cType, const int *mom, int n_mom)
+  {
+    size_t result_bytes = x.X()[3] * n_mom * 16 * sizeof(double2);
+    auto result_d = static_cast<double2 *>(pool_device_malloc(result_bytes));
+    auto mom_d = static_cast<int *>(pool_device_malloc(3 * n_mom * sizeof(int)));
+    qudaMemcpy(mom_d, mom, 3 * n_mom * sizeof(int), cudaMemcpyHostToDevice);
+
+    ContractionMomArg<real> arg(x, y, cType, mom_d, n_mom, result_d);
+    MomentumContraction<decltype(arg)> contraction(arg, x);
+    contraction.apply(0);
+    qudaMemcpy(result, result_d, result_bytes, cudaMemcpyDeviceToHost);
+
+    pool_device_free(mom_d);
+    pool_device_free(result_d);
+  }
+
+#endif
+
+  /**
+     @brief Host momentum-projected contraction.  The tasks are the
+     pairs of local time slices and blocks of momenta, each of which
+     sums over its time slice in a fixed order, so the result does not
+     depend on the thread count.
+  */
+  template <typename real>
+  void contract_momentum_cpu(const ColorSpinorField &x, const ColorSpinorField &y, complex<double> *result,
+                             const QudaContractType cType, const int *mom, int n_mom)
+  {
+    using F = colorspinor::FieldOrderCB<real, 4, 3, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER>;
+    using Vector = ColorSpinor<real, 3, 4>;
+    if (x.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER || y.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+      errorQuda("Unsupported field order x=%d y=%d", x.FieldOrder(), y.FieldOrder());
+    const F xf(x), yf(y);
+
+    int X[4], N[3], offset[3];
+    for (int d = 0; d < 4; d++) X[d] = x.X()[d];
+    for (int d = 0; d < 3; d++) {
+      N[d] = X[d] * comm_dim(d);
+      offset[d] = X[d] * comm_coord(d);
+    }
+    const int slice_cb = x.VolumeCB() / X[3];
+
+    constexpr int mom_block = 8; // momenta per task, amortizing the contraction
+    const int n_block = (n_mom + mom_block - 1) / mom_block;
+
+    host::parallel_for(X[3] * n_block, [&](int task) {
+      const int t = task / n_block;
+      const int m0 = (task % n_block) * mom_block;
+      const int m1 = std::min(m0 + mom_block, n_mom);
+      complex<double> *r = result + (t * n_mom + m0) * 16;
+      std::fill(r, r + (m1 - m0) * 16, complex<double>(0.0, 0.0));
+
+      for (int parity = 0; parity < 2; parity++) {
+        for (int s_cb = 0; s_cb < slice_cb; s_cb++) {
+          int x_cb = t * slice_cb + s_cb;
+          int c[4];
+          getCoords(c, x_cb, X, parity);
+          for (int d = 0; d < 3; d++) c[d] += offset[d];
+
+          Vector xv, yv;
+          for (int s = 0; s < 4; s++)
+            for (int col = 0; col < 3; col++) {
+              xv(s, col) = xf(parity, x_cb, s, col);
+              yv(s, col) = yf(parity, x_cb, s, col);
+            }
+          complex<real> A[16];
+          contractSite(A, xv, yv, cType);
+
+          for (int m = m0; m < m1; m++) {
+            complex<double> phase = momentumPhase(mom + 3 * m, c, N);
+            for (int i = 0; i < 16; i++)
+              r[(m - m0) * 16 + i] += phase * complex<double>(A[i].real(), A[i].imag());
+          }
+        }
+      }
+    });
+  }
+
+  void contractMomentumQuda(const ColorSpinorField &x, const ColorSpinorField &y, void *result,
+                            const QudaContractType cType, const int *mom, int n_mom)
+  {
+    checkPrecision(x, y);
+
+    if (x.GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS || y.GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS)
+      errorQuda("Unexpected gamma basis x=%d y=%d", x.GammaBasis(), y.GammaBasis());
+    if (x.Ncolor() != 3 || y.Ncolor() != 3) errorQuda("Unexpected number of colors x=%d y=%d", x.Ncolor(), y.Ncolor());
+    if (x.Nspin() != 4 || y.Nspin() != 4) errorQuda("Unexpected number of spins x=%d y=%d", x.Nspin(), y.Nspin());
+    if (x.SiteSubset() != QUDA_FULL_SITE_SUBSET) errorQuda("Full fields are required");
+    if (cType != QUDA_CONTRACT_TYPE_OPEN && cType != QUDA_CONTRACT_TYPE_DR)
+      errorQuda("Unexpected contraction type %d", cType);
+    if (n_mom <= 0) errorQuda("Invalid number of momenta %d", n_mom);
+
+    // correlators of the local time slices
+    const int Nt = x.X()[3];
+    std::vector<complex<double>> local(Nt * n_mom * 16);
+
+    if (x.Location() == QUDA_CPU_FIELD_LOCATION) {
+      if (x.Precision() == QUDA_SINGLE_PRECISION) {
+        contract_momentum_cpu<float>(x, y, local.data(), cType, mom, n_mom);
+      } else if (x.Precision() == QUDA_DOUBLE_PRECISION) {
+        contract_momentum_cpu<double>(x, y, local.data(), cType, mom, n_mom);
+      } else {
+        errorQuda("Precision %d not supported", x.Precision());
+      }
+    } else {
+#ifdef GPU_CONTRACT
+      if (x.Precision() == QUDA_SINGLE_PRECISION) {
+        contract_momentum_quda<float>(x, y, local.data(), cType, mom, n_mom);
+      } else if (x.Precision() == QUDA_DOUBLE_PRECISION) {
+        contract_momentum_quda<double>(x, y, local.data(), cType, mom, n_mom);
+      } else {
+        errorQuda("Precision %d not supported", x.Precision());
+      }
+#else
+      errorQuda("Contraction code has not been built");
+#endif
+    }
+
+    // place the local time slices in the global correlators and sum
+    // over the processes
+    const size_t slice = n_mom * 16;
+    auto out = static_cast<complex<double> *>(result);
+    std::fill(out, out + Nt * comm_dim(3) * slice, complex<double>(0.0, 0.0));
+    std::copy(local.begin(), local.end(), out + comm_coord(3) * Nt * slice);
+    comm_allreduce_array(reinterpret_cast<double *>(out), 2 * Nt * comm_dim(3) * slice);
+  }
 
   void contractQuda(const ColorSpinorField &x, const ColorSpinorField &y, void *result, const QudaContractType cType)
   {
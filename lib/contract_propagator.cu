@@ -0,0 +1,313 @@
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <contract_quda.h>
+#include <kernels/contraction.cuh>
+#include <host_parallel.h>
+
+/**
+   Propagator-level contraction engine.  Rather than contracting pairs
+   of propagator columns one at a time, all 24 columns of the two
+   propagators are loaded at each site, and every requested meson and
+   baryon correlator is formed there and accumulated, with its momentum
+   phases, into the correlators of the time slice.
+
+   The mesons are formed from the color-diagonal spin elementals
+   P[j'][j][i'][i] = sum_{a,b} conj(S2_{j'b}(i',a)) S1_{jb}(i,a)
+   of the site, which are shared by all gamma structures, each of which
+   is then a sparse sum over the nonzero entries of its spin weights.
+   The baryons are evaluated by the explicit epsilon-tensor sums, again
+   restricted to the nonzero spin entries of the diquark and projector
+   matrices.
+ */
+
+namespace quda
+{
+
+  void contractionGamma(complex<double> gamma[4][4], QudaContractGamma g)
+  {
+    if (g < QUDA_CONTRACT_GAMMA_I || g > QUDA_CONTRACT_GAMMA_S34) errorQuda("Invalid contraction gamma %d", g);
+    // the Degrand-Rossi contraction of the unit elemental e_{mu nu} is Gamma[mu][nu]
+    for (int mu = 0; mu < 4; mu++) {
+      for (int nu = 0; nu < 4; nu++) {
+        complex<double> e[4][4] = {};
+        e[mu][nu] = 1.0;
+        complex<double> A[16];
+        degrandRossiContract(A, e);
+        gamma[mu][nu] = A[g];
+      }
+    }
+  }
+
+  namespace
+  {
+
+    using SpinMatrix = complex<double>[4][4];
+
+    void multiply(SpinMatrix c, const SpinMatrix a, const SpinMatrix b)
+    {
+      for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++) {
+          c[i][j] = 0.0;
+          for (int k = 0; k < 4; k++) c[i][j] += a[i][k] * b[k][j];
+        }
+    }
+
+    /** A nonzero entry of a product of spin matrices */
+    struct SpinTerm {
+      int i, j, k, l;
+      complex<double> w;
+    };
+
+    /** A nonzero entry of a spin matrix */
+    struct SpinEntry {
+      int i, j;
+      complex<double> w;
+    };
+
+    std::vector<SpinEntry> nonzero(const SpinMatrix m)
+    {
+      std::vector<SpinEntry> entries;
+      for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+          if (norm(m[i][j]) > 0.0) entries.push_back({i, j, m[i][j]});
+      return entries;
+    }
+
+    /**
+       @brief Terms W_src[j][j'] W_snk[i'][i] P[j'][j][i'][i] of the meson
+       tr[G_snk S1 G_src g5 S2^dag g5], with W_src = G_src g5 and W_snk = g5 G_snk
+    */
+    std::vector<SpinTerm> mesonTerms(const MesonContraction &m)
+    {
+      SpinMatrix g5, snk, src, w_src, w_snk;
+      contractionGamma(g5, QUDA_CONTRACT_GAMMA_G5);
+      contractionGamma(snk, m.snk);
+      contractionGamma(src, m.src);
+      multiply(w_src, src, g5);
+      multiply(w_snk, g5, snk);
+
+      std::vector<SpinTerm> terms;
+      for (auto &s : nonzero(w_src))
+        for (auto &k : nonzero(w_snk)) terms.push_back({s.j, s.i, k.i, k.j, s.w * k.w});
+      return terms;
+    }
+
+    /** Nonzero entries of the matrices of a baryon correlator */
+    struct BaryonTerms {
+      std::vector<SpinEntry> dq;    // C G
+      std::vector<SpinEntry> dqbar; // g4 (C G)^dag g4
+      std::vector<SpinEntry> proj;  // P
+    };
+
+    BaryonTerms baryonTerms(const BaryonContraction &b)
+    {
+      SpinMatrix g2, g4, g, C, dq, dq_dag, tmp, dqbar;
+      contractionGamma(g2, QUDA_CONTRACT_GAMMA_G2);
+      contractionGamma(g4, QUDA_CONTRACT_GAMMA_G4);
+      contractionGamma(g, b.diquark);
+      multiply(C, g4, g2);
+      multiply(dq, C, g);
+      for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++) dq_dag[i][j] = conj(dq[j][i]);
+      multiply(tmp, g4, dq_dag);
+      multiply(dqbar, tmp, g4);
+      return {nonzero(dq), nonzero(dqbar), nonzero(b.projector)};
+    }
+
+    /** The permutations of (0, 1, 2) and their signs, for the epsilon tensor */
+    constexpr int eps[6][4] = {{0, 1, 2, 1}, {1, 2, 0, 1}, {2, 0, 1, 1}, {0, 2, 1, -1}, {2, 1, 0, -1}, {1, 0, 2, -1}};
+
+    /**
+       A propagator at one site: S[col][spin][color], with column
+       3 * source spin + source color
+    */
+    using SiteProp = complex<double>[12][4][3];
+
+    /** S^{aa'}_{kk'} */
+    inline const complex<double> &prop(const SiteProp &S, int k, int a, int kp, int ap) { return S[3 * kp + ap][k][a]; }
+
+    complex<double> baryonSite(const BaryonTerms &t, const SiteProp &S1, const SiteProp &S2)
+    {
+      complex<double> sum = 0.0;
+      for (auto &e : eps) {
+        const int a = e[0], b = e[1], c = e[2];
+        for (auto &ep : eps) {
+          const int ap = ep[0], bp = ep[1], cp = ep[2];
+          complex<double> color = 0.0;
+          for (auto &dq : t.dq) {
+            const int i = dq.i, j = dq.j;
+            for (auto &dqb : t.dqbar) {
+              const int jp = dqb.i, ip = dqb.j;
+              complex<double> w = dq.w * dqb.w * prop(S2, j, c, jp, cp);
+              if (norm(w) == 0.0) continue;
+              complex<double> spin = 0.0;
+              for (auto &p : t.proj) {
+                const int kp = p.i, k = p.j;
+                spin += p.w
+                  * (prop(S1, k, a, kp, ap) * prop(S1, i, b, ip, bp) - prop(S1, k, a, ip, bp) * prop(S1, i, b, kp, ap));
+              }
+              color += w * spin;
+            }
+          }
+          sum += static_cast<double>(e[3] * ep[3]) * color;
+        }
+      }
+      return sum;
+    }
+
+    template <typename real>
+    void contractPropagators(const std::vector<ColorSpinorField *> &S1, const std::vector<ColorSpinorField *> &S2,
+                             const std::vector<MesonContraction> &mesons,
+                             const std::vector<BaryonContraction> &baryons, const int *mom, int n_mom,
+                             std::vector<complex<double>> &local)
+    {
+      using F = colorspinor::FieldOrderCB<real, 4, 3, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER>;
+      std::vector<F> s1, s2;
+      for (int col = 0; col < 12; col++) {
+        s1.emplace_back(*S1[col]);
+        s2.emplace_back(*S2[col]);
+      }
+
+      std::vector<std::vector<SpinTerm>> meson_terms;
+      for (auto &m : mesons) meson_terms.push_back(mesonTerms(m));
+      std::vector<BaryonTerms> baryon_terms;
+      for (auto &b : baryons) baryon_terms.push_back(baryonTerms(b));
+
+      const ColorSpinorField &meta = *S1[0];
+      int X[4], N[3], offset[3];
+      for (int d = 0; d < 4; d++) X[d] = meta.X()[d];
+      for (int d = 0; d < 3; d++) {
+        N[d] = X[d] * comm_dim(d);
+        offset[d] = X[d] * comm_coord(d);
+      }
+      const int slice_cb = meta.VolumeCB() / X[3];
+      const int n_meson = mesons.size();
+      const int n_corr = n_meson + baryons.size();
+
+      // each task sums a fixed chunk of a time slice into its own
+      // partial correlators, which are then summed in order, so the
+      // result does not depend on the thread count
+      const int n_chunk = std::min(2 * slice_cb, 16);
+      const int chunk = (2 * slice_cb + n_chunk - 1) / n_chunk;
+      std::vector<complex<double>> partial(X[3] * n_chunk * n_mom * n_corr);
+
+      host::parallel_for(X[3] * n_chunk, [&](int task) {
+        const int t = task / n_chunk;
+        complex<double> *r = partial.data() + task * n_mom * n_corr;
+        std::fill(r, r + n_mom * n_corr, complex<double>(0.0, 0.0));
+
+        SiteProp P1, P2;
+        complex<double> P[4][4][4][4];
+        std::vector<complex<double>> site(n_corr);
+
+        const int begin = (task % n_chunk) * chunk;
+        const int end = std::min(begin + chunk, 2 * slice_cb);
+        for (int s = begin; s < end; s++) {
+          const int parity = s / slice_cb;
+          const int x_cb = t * slice_cb + s % slice_cb;
+          int x[4];
+          getCoords(x, x_cb, X, parity);
+          for (int d = 0; d < 3; d++) x[d] += offset[d];
+
+          for (int col = 0; col < 12; col++)
+            for (int spin = 0; spin < 4; spin++)
+              for (int c = 0; c < 3; c++) {
+                complex<real> a = s1[col](parity, x_cb, spin, c);
+                complex<real> b = s2[col](parity, x_cb, spin, c);
+                P1[col][spin][c] = complex<double>(a.real(), a.imag());
+                P2[col][spin][c] = complex<double>(b.real(), b.imag());
+              }
+
+          if (n_meson > 0) {
+            for (int jp = 0; jp < 4; jp++)
+              for (int j = 0; j < 4; j++)
+                for (int ip = 0; ip < 4; ip++)
+                  for (int i = 0; i < 4; i++) {
+                    complex<double> sum = 0.0;
+                    for (int b = 0; b < 3; b++)
+                      for (int a = 0; a < 3; a++) sum += conj(P2[3 * jp + b][ip][a]) * P1[3 * j + b][i][a];
+                    P[jp][j][ip][i] = sum;
+                  }
+          }
+
+          for (int m = 0; m < n_meson; m++) {
+            complex<double> sum = 0.0;
+            for (auto &term : meson_terms[m]) sum += term.w * P[term.i][term.j][term.k][term.l];
+            site[m] = sum;
+          }
+          for (size_t b = 0; b < baryon_terms.size(); b++) site[n_meson + b] = baryonSite(baryon_terms[b], P1, P2);
+
+          for (int p = 0; p < n_mom; p++) {
+            complex<double> phase = momentumPhase(mom + 3 * p, x, N);
+            for (int k = 0; k < n_corr; k++) r[p * n_corr + k] += phase * site[k];
+          }
+        }
+      });
+
+      for (int t = 0; t < X[3]; t++)
+        for (int c = 0; c < n_chunk; c++)
+          for (int i = 0; i < n_mom * n_corr; i++)
+            local[t * n_mom * n_corr + i] += partial[(t * n_chunk + c) * n_mom * n_corr + i];
+    }
+
+  } // namespace
+
+  void contractPropagatorsQuda(const std::vector<ColorSpinorField *> &S1, const std::vector<ColorSpinorField *> &S2,
+                               const std::vector<MesonContraction> &mesons,
+                               const std::vector<BaryonContraction> &baryons, const int *mom, int n_mom,
+                               std::vector<complex<double>> &meson_result,
+                               std::vector<complex<double>> &baryon_result)
+  {
+    if (S1.size() != 12 || S2.size() != 12) errorQuda("Propagators need 12 columns, not %lu and %lu", S1.size(), S2.size());
+    if (n_mom <= 0) errorQuda("Invalid number of momenta %d", n_mom);
+
+    const ColorSpinorField &meta = *S1[0];
+    for (auto S : {&S1, &S2}) {
+      for (auto f : *S) {
+        checkPrecision(meta, *f);
+        if (f->Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Propagator contractions require host fields");
+        if (f->GammaBasis() != QUDA_DEGRAND_ROSSI_GAMMA_BASIS) errorQuda("Unexpected gamma basis %d", f->GammaBasis());
+        if (f->Ncolor() != 3 || f->Nspin() != 4)
+          errorQuda("Unexpected number of colors %d or spins %d", f->Ncolor(), f->Nspin());
+        if (f->SiteSubset() != QUDA_FULL_SITE_SUBSET) errorQuda("Full fields are required");
+        if (f->FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) errorQuda("Unsupported field order %d", f->FieldOrder());
+        for (int d = 0; d < 4; d++)
+          if (f->X()[d] != meta.X()[d]) errorQuda("Propagator columns have different dimensions");
+      }
+    }
+
+    const int Nt = meta.X()[3];
+    const int n_corr = mesons.size() + baryons.size();
+    std::vector<complex<double>> local(Nt * n_mom * n_corr);
+
+    if (meta.Precision() == QUDA_DOUBLE_PRECISION) {
+      contractPropagators<double>(S1, S2, mesons, baryons, mom, n_mom, local);
+    } else if (meta.Precision() == QUDA_SINGLE_PRECISION) {
+      contractPropagators<float>(S1, S2, mesons, baryons, mom, n_mom, local);
+    } else {
+      errorQuda("Precision %d not supported", meta.Precision());
+    }
+
+    // place the local time slices in the global correlators and sum
+    // over the processes
+    const int slice = n_mom * n_corr;
+    std::vector<complex<double>> global(Nt * comm_dim(3) * slice, complex<double>(0.0, 0.0));
+    std::copy(local.begin(), local.end(), global.begin() + comm_coord(3) * Nt * slice);
+    comm_allreduce_array(reinterpret_cast<double *>(global.data()), 2 * global.size());
+
+    const int Nt_global = Nt * comm_dim(3);
+    meson_result.resize(Nt_global * n_mom * mesons.size());
+    baryon_result.resize(Nt_global * n_mom * baryons.size());
+    for (int t = 0; t < Nt_global; t++)
+      for (int p = 0; p < n_mom; p++) {
+        const complex<double> *g = global.data() + (t * n_mom + p) * n_corr;
+        for (size_t m = 0; m < mesons.size(); m++) meson_result[(t * n_mom + p) * mesons.size() + m] = g[m];
+        for (size_t b = 0; b < baryons.size(); b++)
+          baryon_result[(t * n_mom + p) * baryons.size() + b] = g[mesons.size() + b];
+      }
+  }
+
+} // namespace quda
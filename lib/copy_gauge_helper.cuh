@@ -27,6 +27,8 @@ namespace quda {
       return location == QUDA_CUDA_FIELD_LOCATION ? TunableVectorYZ::advanceTuneParam(param) : false;
     }
 
+    bool tuneHostChunk() const { return location == QUDA_CPU_FIELD_LOCATION; }
+
 public:
     CopyGauge(Arg &arg, const GaugeField &out, const GaugeField &in, QudaFieldLocation location)
 #ifndef FINE_GRAINED_ACCESS
@@ -83,9 +85,9 @@ public:
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (location == QUDA_CPU_FIELD_LOCATION) {
         if (!is_ghost) {
-          copyGauge<FloatOut, FloatIn, length>(arg);
+          copyGauge<FloatOut, FloatIn, length>(arg, tp.block.x);
         } else {
-          copyGhost<FloatOut, FloatIn, length>(arg);
+          copyGhost<FloatOut, FloatIn, length>(arg, tp.block.x);
         }
       } else if (location == QUDA_CUDA_FIELD_LOCATION) {
 #ifdef JITIFY
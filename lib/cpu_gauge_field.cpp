@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <string.h>
 #include <typeinfo>
+#include <vector>
 
 namespace quda {
 
@@ -131,6 +132,102 @@ namespace quda {
     }
   }
 
+  // Persistent send buffers for exchangeGhost and injectGhost, grown
+  // as needed and shared between all host gauge fields
+  static void *ghost_send_buffer[2 * QUDA_MAX_DIM] = {};
+  static size_t ghost_send_bytes[2 * QUDA_MAX_DIM] = {};
+
+  static void *ghostSendBuffer(int d, size_t bytes)
+  {
+    if (bytes > ghost_send_bytes[d]) {
+      if (ghost_send_buffer[d]) host_free(ghost_send_buffer[d]);
+      ghost_send_buffer[d] = safe_malloc(bytes);
+      ghost_send_bytes[d] = bytes;
+    }
+    return ghost_send_buffer[d];
+  }
+
+  /**
+     A persistent extended halo exchange: the face buffers and the
+     message handles (MPI persistent requests) for a given local
+     volume, halo depth, geometry, and precision, created on first
+     use so that subsequent exchanges do not allocate.
+  */
+  struct ExtendedExchangePlan {
+    int nDim;
+    int X[QUDA_MAX_DIM] = {};
+    int R[QUDA_MAX_DIM] = {};
+    QudaFieldGeometry geometry;
+    int nInternal;
+    QudaPrecision precision;
+
+    size_t bytes[QUDA_MAX_DIM] = {};
+    void *send[QUDA_MAX_DIM] = {};
+    void *recv[QUDA_MAX_DIM] = {};
+    MsgHandle *mh_recv_back[QUDA_MAX_DIM] = {};
+    MsgHandle *mh_recv_fwd[QUDA_MAX_DIM] = {};
+    MsgHandle *mh_send_back[QUDA_MAX_DIM] = {};
+    MsgHandle *mh_send_fwd[QUDA_MAX_DIM] = {};
+
+    ExtendedExchangePlan(const GaugeField &u, const int *R_, const int *surface, int nInternal) :
+      nDim(u.Ndim()), geometry(u.Geometry()), nInternal(nInternal), precision(u.Precision())
+    {
+      for (int d = 0; d < nDim; d++) {
+        X[d] = u.X()[d];
+        R[d] = R_[d];
+
+        // buffers cover both the partitioned and the no_comms_fill cases
+        if (!(comm_dim_partitioned(d) || R[d])) continue;
+        // store both parities and directions in each
+        bytes[d] = surface[d] * R[d] * geometry * nInternal * precision;
+        send[d] = safe_malloc(2 * bytes[d]);
+        recv[d] = safe_malloc(2 * bytes[d]);
+
+        if (comm_dim_partitioned(d)) {
+          mh_recv_back[d] = comm_declare_receive_relative(recv[d], d, -1, bytes[d]);
+          mh_recv_fwd[d] = comm_declare_receive_relative(static_cast<char *>(recv[d]) + bytes[d], d, +1, bytes[d]);
+          mh_send_back[d] = comm_declare_send_relative(send[d], d, -1, bytes[d]);
+          mh_send_fwd[d] = comm_declare_send_relative(static_cast<char *>(send[d]) + bytes[d], d, +1, bytes[d]);
+        }
+      }
+    }
+
+    ~ExtendedExchangePlan()
+    {
+      for (int d = 0; d < nDim; d++) {
+        if (mh_send_fwd[d]) comm_free(mh_send_fwd[d]);
+        if (mh_send_back[d]) comm_free(mh_send_back[d]);
+        if (mh_recv_back[d]) comm_free(mh_recv_back[d]);
+        if (mh_recv_fwd[d]) comm_free(mh_recv_fwd[d]);
+        if (send[d]) host_free(send[d]);
+        if (recv[d]) host_free(recv[d]);
+      }
+    }
+
+    bool match(const GaugeField &u, const int *R_, int nInternal_) const
+    {
+      if (u.Ndim() != nDim || u.Geometry() != geometry || nInternal_ != nInternal || u.Precision() != precision)
+        return false;
+      for (int d = 0; d < nDim; d++)
+        if (u.X()[d] != X[d] || R_[d] != R[d]) return false;
+      return true;
+    }
+  };
+
+  static std::vector<ExtendedExchangePlan *> extended_plans;
+
+  void cpuGaugeField::freeGhostBuffer(void)
+  {
+    for (auto &plan : extended_plans) delete plan;
+    extended_plans.clear();
+
+    for (int d = 0; d < 2 * QUDA_MAX_DIM; d++) {
+      if (ghost_send_buffer[d]) host_free(ghost_send_buffer[d]);
+      ghost_send_buffer[d] = nullptr;
+      ghost_send_bytes[d] = 0;
+    }
+  }
+
   // This does the exchange of the gauge field ghost zone and places it
   // into the ghost array.
   void cpuGaugeField::exchangeGhost(QudaLinkDirection link_direction) {
@@ -142,8 +239,8 @@ namespace quda {
 
     void *send[2*QUDA_MAX_DIM];
     for (int d=0; d<nDim; d++) {
-      send[d] = safe_malloc(nFace*surface[d]*nInternal*precision);
-      if (geometry == QUDA_COARSE_GEOMETRY) send[d+4] = safe_malloc(nFace*surface[d]*nInternal*precision);
+      send[d] = ghostSendBuffer(d, nFace * surface[d] * nInternal * precision);
+      if (geometry == QUDA_COARSE_GEOMETRY) send[d + 4] = ghostSendBuffer(d + 4, nFace * surface[d] * nInternal * precision);
     }
 
     if (link_direction == QUDA_LINK_BACKWARDS || link_direction == QUDA_LINK_BIDIRECTIONAL) {
@@ -159,8 +256,6 @@ namespace quda {
       extractGaugeGhost(*this, send, true, nDim);
       exchange(ghost+nDim, send+nDim, QUDA_FORWARDS);
     }
-
-    for (int d=0; d<geometry; d++) host_free(send[d]);
   }
 
   // This does the opposite of exchangeGhost and sends back the ghost
@@ -174,76 +269,60 @@ namespace quda {
       errorQuda("link_direction = %d not supported", link_direction);
 
     void *recv[2*QUDA_MAX_DIM];
-    for (int d=0; d<nDim; d++) recv[d] = safe_malloc(nFace*surface[d]*nInternal*precision);
+    for (int d = 0; d < nDim; d++) recv[d] = ghostSendBuffer(d, nFace * surface[d] * nInternal * precision);
 
     // communicate between nodes
     exchange(recv, ghost, QUDA_BACKWARDS);
 
     // get the links into contiguous buffers
     extractGaugeGhost(*this, recv, false);
-
-    for (int d=0; d<nDim; d++) host_free(recv[d]);
   }
 
   void cpuGaugeField::exchangeExtendedGhost(const int *R, bool no_comms_fill) {
-    
-    void *send[QUDA_MAX_DIM];
-    void *recv[QUDA_MAX_DIM];
-    size_t bytes[QUDA_MAX_DIM];
-    // store both parities and directions in each
-    for (int d=0; d<nDim; d++) {
-      if (!(comm_dim_partitioned(d) || (no_comms_fill && R[d])) ) continue;
-      bytes[d] = surface[d] * R[d] * geometry * nInternal * precision;
-      send[d] = safe_malloc(2 * bytes[d]);
-      recv[d] = safe_malloc(2 * bytes[d]);
+
+    ExtendedExchangePlan *plan = nullptr;
+    for (auto &p : extended_plans) {
+      if (p->match(*this, R, nInternal)) {
+        plan = p;
+        break;
+      }
+    }
+    if (!plan) {
+      plan = new ExtendedExchangePlan(*this, R, surface, nInternal);
+      extended_plans.push_back(plan);
     }
 
+    // dimensions are done in turn, since the faces of later
+    // dimensions include the halos of earlier ones
     for (int d=0; d<nDim; d++) {
       if (!(comm_dim_partitioned(d) || (no_comms_fill && R[d])) ) continue;
+      void **send = plan->send;
+      void **recv = plan->recv;
+      size_t bytes = plan->bytes[d];
+
       //extract into a contiguous buffer
       extractExtendedGaugeGhost(*this, d, R, send, true);
 
       if (comm_dim_partitioned(d)) {
 	// do the exchange
-	MsgHandle *mh_recv_back;
-	MsgHandle *mh_recv_fwd;
-	MsgHandle *mh_send_fwd;
-	MsgHandle *mh_send_back;
-	
-	mh_recv_back = comm_declare_receive_relative(recv[d], d, -1, bytes[d]);
-	mh_recv_fwd  = comm_declare_receive_relative(((char*)recv[d])+bytes[d], d, +1, bytes[d]);
-	mh_send_back = comm_declare_send_relative(send[d], d, -1, bytes[d]);
-	mh_send_fwd  = comm_declare_send_relative(((char*)send[d])+bytes[d], d, +1, bytes[d]);
-	
-	comm_start(mh_recv_back);
-	comm_start(mh_recv_fwd);
-	comm_start(mh_send_fwd);
-	comm_start(mh_send_back);
-	
-	comm_wait(mh_send_fwd);
-	comm_wait(mh_send_back);
-	comm_wait(mh_recv_back);
-	comm_wait(mh_recv_fwd);
-	
-	comm_free(mh_send_fwd);
-	comm_free(mh_send_back);
-	comm_free(mh_recv_back);
-	comm_free(mh_recv_fwd);
+	comm_start(plan->mh_recv_back[d]);
+	comm_start(plan->mh_recv_fwd[d]);
+	comm_start(plan->mh_send_fwd[d]);
+	comm_start(plan->mh_send_back[d]);
+
+	comm_wait(plan->mh_send_fwd[d]);
+	comm_wait(plan->mh_send_back[d]);
+	comm_wait(plan->mh_recv_back[d]);
+	comm_wait(plan->mh_recv_fwd[d]);
       } else {
-	memcpy(static_cast<char*>(recv[d])+bytes[d], send[d], bytes[d]);
-	memcpy(recv[d], static_cast<char*>(send[d])+bytes[d], bytes[d]);
+	memcpy(static_cast<char*>(recv[d])+bytes, send[d], bytes);
+	memcpy(recv[d], static_cast<char*>(send[d])+bytes, bytes);
       }      
 
       // inject back into the gauge field
       extractExtendedGaugeGhost(*this, d, R, recv, false);
     }
 
-    for (int d=0; d<nDim; d++) {
-      if (!(comm_dim_partitioned(d) || (no_comms_fill && R[d])) ) continue;
-      host_free(send[d]);
-      host_free(recv[d]);
-    }
-
   }
 
   void cpuGaugeField::exchangeExtendedGhost(const int *R, TimeProfile &profile, bool no_comms_fill) {
@@ -4,7 +4,7 @@
 
 namespace quda {
 
-  DiracCoarse::DiracCoarse(const DiracParam &param, bool gpu_setup, bool mapped) :
+  DiracCoarse::DiracCoarse(const DiracParam &param, bool gpu_setup, bool mapped, bool compute_links) :
     Dirac(param),
     mass(param.mass),
     mu(param.mu),
@@ -27,7 +27,7 @@ namespace quda {
     init_cpu(!gpu_setup),
     mapped(mapped)
   {
-    initializeCoarse();
+    initializeCoarse(compute_links);
   }
 
   DiracCoarse::DiracCoarse(const DiracParam &param, cpuGaugeField *Y_h, cpuGaugeField *X_h, cpuGaugeField *Xinv_h,
@@ -187,30 +187,35 @@ namespace quda {
     else     Xinv_h = new cpuGaugeField(gParam);
   }
 
-  void DiracCoarse::initializeCoarse()
+  void DiracCoarse::initializeCoarse(bool compute_links)
   {
     createY(gpu_setup, mapped);
 
-    if (gpu_setup) dirac->createCoarseOp(*Y_d,*X_d,*transfer,kappa,mass,Mu(),MuFactor());
-    else dirac->createCoarseOp(*Y_h,*X_h,*transfer,kappa,mass,Mu(),MuFactor());
+    if (compute_links) {
+      if (gpu_setup) dirac->createCoarseOp(*Y_d,*X_d,*transfer,kappa,mass,Mu(),MuFactor());
+      else dirac->createCoarseOp(*Y_h,*X_h,*transfer,kappa,mass,Mu(),MuFactor());
 
-    // save the intermediate tunecache after the UV and VUV tune
-    saveTuneCache();
+      // save the intermediate tunecache after the UV and VUV tune
+      saveTuneCache();
+    }
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("About to build the preconditioned coarse clover\n");
 
     createYhat(gpu_setup);
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Finished building the preconditioned coarse clover\n");
-    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("About to create the preconditioned coarse op\n");
 
-    if (gpu_setup) createPreconditionedCoarseOp(*Yhat_d,*Xinv_d,*Y_d,*X_d);
-    else createPreconditionedCoarseOp(*Yhat_h,*Xinv_h,*Y_h,*X_h);
+    if (compute_links) {
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("About to create the preconditioned coarse op\n");
+
+      if (gpu_setup) createPreconditionedCoarseOp(*Yhat_d,*Xinv_d,*Y_d,*X_d);
+      else createPreconditionedCoarseOp(*Yhat_h,*Xinv_h,*Y_h,*X_h);
 
-    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Finished creating the preconditioned coarse op\n");
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Finished creating the preconditioned coarse op\n");
 
-    // save the intermediate tunecache after the Yhat tune
-    saveTuneCache();
+      // save the intermediate tunecache after the Yhat tune
+      saveTuneCache();
+    }
 
     if (gpu_setup) {
       enable_gpu = true;
@@ -0,0 +1,909 @@
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <clover_field.h>
+#include <dslash_quda.h>
+#include <tune_quda.h>
+#include <color_spinor_field_order.h>
+#include <gauge_field_order.h>
+#include <clover_field_order.h>
+#include <color_spinor.h>
+#include <index_helper.cuh>
+#include <linalg.cuh>
+#include <host_parallel.h>
+
+/**
+   Host implementations of the Wilson, Wilson-clover, twisted-mass and
+   (improved) staggered operators.  These are called by the Apply*
+   drivers when the fields reside on the host, so that the Dirac
+   classes, and hence the solvers, can be run on cpuColorSpinorFields.
+
+   The stencils follow the conventions of the device kernels
+   (include/kernels/dslash_*.cuh), so a host and device application of
+   the same operator agree to rounding:
+   - spinors are in SPACE_SPIN_COLOR order, and Wilson-type spinors
+     must be in the UKQCD gamma basis used internally
+   - gauge fields are in QDP order without reconstruction, and
+     staggered links have the phases (and boundary condition) applied
+   - clover fields are in PACKED order, with the internal normalization
+     and chiral basis
+
+   When a dimension is partitioned, the spinor halo is exchanged with
+   exchangeGhost, and the backward links are read from the ghost zone
+   of the gauge field, which must have been exchanged beforehand
+   (GaugeField::exchangeGhost).  Switching off communication of a
+   partitioned dimension with comm_override drops the hops that cross
+   the boundary, as with the device kernels.
+ */
+
+namespace quda
+{
+
+  /**
+     @brief Parameter struct for the site-local host operators
+     @tparam Float Storage and compute precision (double or float)
+     @tparam nSpin_ Number of spin components
+     @tparam nColor_ Number of colors
+  */
+  template <typename Float, int nSpin_, int nColor_> struct SpinorCPUArg {
+    static constexpr int nSpin = nSpin_;
+    static constexpr int nColor = nColor_;
+    using real = Float;
+    using F = colorspinor::FieldOrderCB<Float, nSpin, nColor, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER>;
+    using G = gauge::FieldOrder<Float, nColor, 1, QUDA_QDP_GAUGE_ORDER>;
+    using Vector = ColorSpinor<real, nColor, nSpin>;
+    using Link = Matrix<complex<real>, nColor>;
+
+    F out;            /** output field */
+    const F in;       /** input field */
+    const F x;        /** accumulation field */
+    const real a;     /** scale factor */
+    const int parity; /** destination parity (single-parity fields) */
+    const int nParity;
+    const int volumeCB;
+    const bool dagger;
+
+    SpinorCPUArg(ColorSpinorField &out, const ColorSpinorField &in, double a, const ColorSpinorField &x, int parity,
+                 bool dagger, int nFace = 1) :
+      out(out),
+      in(in, nFace),
+      x(x),
+      a(a),
+      parity(parity),
+      nParity(out.SiteSubset()),
+      volumeCB(out.VolumeCB()),
+      dagger(dagger)
+    {
+    }
+  };
+
+  /**
+     @brief Parameter struct shared by the host stencils
+  */
+  template <typename Float, int nSpin, int nColor> struct DslashCPUArg : SpinorCPUArg<Float, nSpin, nColor> {
+    using G = typename SpinorCPUArg<Float, nSpin, nColor>::G;
+    const G U;        /** gauge field */
+    const int nFace;  /** depth of the spinor halo */
+    const int nFaceU; /** depth of the gauge-field halo */
+    int X[4];         /** local lattice dimensions */
+    bool ghostDim[4]; /** whether a dimension is partitioned */
+    bool commDim[4];  /** whether we communicate in a dimension */
+
+    DslashCPUArg(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                 const ColorSpinorField &x, int parity, bool dagger, const int *comm_override, int nFace) :
+      SpinorCPUArg<Float, nSpin, nColor>(out, in, a, x, parity, dagger, nFace),
+      U(const_cast<GaugeField &>(U)),
+      nFace(nFace),
+      nFaceU(U.Nface())
+    {
+      for (int d = 0; d < 4; d++) {
+        X[d] = U.X()[d];
+        ghostDim[d] = comm_dim_partitioned(d);
+        commDim[d] = ghostDim[d] && comm_override[d];
+      }
+    }
+  };
+
+  template <typename Arg>
+  inline typename Arg::Vector loadSpinor(const typename Arg::F &f, int x_cb, int parity)
+  {
+    typename Arg::Vector v;
+    for (int s = 0; s < Arg::nSpin; s++)
+      for (int c = 0; c < Arg::nColor; c++) v(s, c) = f(parity, x_cb, s, c);
+    return v;
+  }
+
+  template <typename Arg>
+  inline typename Arg::Vector loadGhost(const typename Arg::F &f, int d, int dir, int ghost_idx, int parity)
+  {
+    typename Arg::Vector v;
+    for (int s = 0; s < Arg::nSpin; s++)
+      for (int c = 0; c < Arg::nColor; c++) v(s, c) = f.Ghost(d, dir, parity, ghost_idx, s, c);
+    return v;
+  }
+
+  template <typename Arg>
+  inline void saveSpinor(typename Arg::F &f, const typename Arg::Vector &v, int x_cb, int parity)
+  {
+    for (int s = 0; s < Arg::nSpin; s++)
+      for (int c = 0; c < Arg::nColor; c++) f(parity, x_cb, s, c) = v(s, c);
+  }
+
+  template <typename Arg> inline typename Arg::Link loadLink(const typename Arg::G &g, int d, int x_cb, int parity)
+  {
+    typename Arg::Link U;
+    for (int i = 0; i < Arg::nColor; i++)
+      for (int j = 0; j < Arg::nColor; j++) U(i, j) = g(d, parity, x_cb, i, j);
+    return U;
+  }
+
+  template <typename Arg>
+  inline typename Arg::Link loadGhostLink(const typename Arg::G &g, int d, int ghost_idx, int parity)
+  {
+    typename Arg::Link U;
+    for (int i = 0; i < Arg::nColor; i++)
+      for (int j = 0; j < Arg::nColor; j++) U(i, j) = g.Ghost(d, parity, ghost_idx, i, j);
+    return U;
+  }
+
+  enum HopType { HOP_BULK, HOP_HALO, HOP_NONE };
+
+  /**
+     @brief Compute the index of the site dist sites away from coord in
+     dimension d, wrapping periodically if d is not partitioned
+     @param[out] idx Checkerboard index of the neighbor, or its index
+     in a halo of depth nFace (as packed by genericPackGhost)
+     @return Whether the neighbor is local, in the halo, or is dropped
+     since we do not communicate in this dimension
+  */
+  template <typename Arg> inline HopType hop(const Arg &arg, const int coord[4], int d, int dist, int nFace, int &idx)
+  {
+    int y[4] = {coord[0], coord[1], coord[2], coord[3]};
+    y[d] += dist;
+    if (y[d] < 0 || y[d] >= arg.X[d]) {
+      if (arg.ghostDim[d]) {
+        if (!arg.commDim[d]) return HOP_NONE;
+        y[d] = y[d] < 0 ? y[d] + nFace : y[d] - arg.X[d]; // depth into the halo
+        idx = ghostFaceIndex<0>(y, arg.X, d, nFace);
+        return HOP_HALO;
+      }
+      y[d] = (y[d] + arg.X[d]) % arg.X[d];
+    }
+    idx = linkIndex(y, arg.X);
+    return HOP_BULK;
+  }
+
+  /**
+     @brief Apply the Wilson hopping term to the site x_cb
+     @param[in] twist Transformation applied to each neighbor before
+     the hop (used by the symmetric twisted-mass dagger operator)
+  */
+  template <typename Arg, typename Twist>
+  inline typename Arg::Vector applyWilsonCPU(const Arg &arg, const int coord[4], int x_cb, int parity,
+                                             const Twist &twist)
+  {
+    using Vector = typename Arg::Vector;
+    using Link = typename Arg::Link;
+    const int their_spinor_parity = arg.nParity == 2 ? 1 - parity : 0;
+    Vector out;
+
+    for (int d = 0; d < 4; d++) {
+      { // forward gather
+        const int proj_dir = arg.dagger ? +1 : -1;
+        int idx;
+        const HopType type = hop(arg, coord, d, +1, arg.nFace, idx);
+        if (type != HOP_NONE) {
+          const Link U = loadLink<Arg>(arg.U, d, x_cb, parity);
+          const Vector in = twist(type == HOP_BULK ? loadSpinor<Arg>(arg.in, idx, their_spinor_parity) :
+                                                     loadGhost<Arg>(arg.in, d, 1, idx, their_spinor_parity));
+          out += (U * in.project(d, proj_dir)).reconstruct(d, proj_dir);
+        }
+      }
+
+      { // backward gather
+        const int proj_dir = arg.dagger ? -1 : +1;
+        int idx;
+        const HopType type = hop(arg, coord, d, -1, arg.nFace, idx);
+        if (type != HOP_NONE) {
+          int gauge_idx = idx;
+          if (type == HOP_HALO) hop(arg, coord, d, -1, arg.nFaceU, gauge_idx);
+          const Link U = type == HOP_BULK ? loadLink<Arg>(arg.U, d, gauge_idx, 1 - parity) :
+                                            loadGhostLink<Arg>(arg.U, d, gauge_idx, 1 - parity);
+          const Vector in = twist(type == HOP_BULK ? loadSpinor<Arg>(arg.in, idx, their_spinor_parity) :
+                                                     loadGhost<Arg>(arg.in, d, 0, idx, their_spinor_parity));
+          out += (conj(U) * in.project(d, proj_dir)).reconstruct(d, proj_dir);
+        }
+      }
+    }
+
+    return out;
+  }
+
+  /**
+     @brief Apply the clover matrix (or its inverse) to a spinor, in
+     the same manner as the device kernels
+  */
+  template <typename real, int nColor, typename C>
+  inline ColorSpinor<real, nColor, 4> applyCloverCPU(const C &A, ColorSpinor<real, nColor, 4> in, int x_cb,
+                                                     int parity, bool dynamic_inverse)
+  {
+    using namespace linalg; // for Cholesky
+    constexpr int N = 2 * nColor;
+    ColorSpinor<real, nColor, 4> out;
+
+    in.toRel(); // change to chiral basis here
+
+    for (int chirality = 0; chirality < 2; chirality++) {
+      HMatrix<real, N> M;
+      for (int i = 0; i < N; i++)
+        for (int j = 0; j <= i; j++)
+          M(i, j) = A(parity, x_cb, 2 * chirality + i / nColor, 2 * chirality + j / nColor, i % nColor, j % nColor);
+
+      ColorSpinor<real, nColor, 2> chi = in.chiral_project(chirality);
+      if (dynamic_inverse) {
+        Cholesky<HMatrix, real, N> cholesky(M);
+        chi = static_cast<real>(0.25) * cholesky.backward(cholesky.forward(chi));
+      } else {
+        chi = M * chi;
+      }
+      out += chi.chiral_reconstruct(chirality);
+    }
+
+    out.toNonRel(); // change basis back
+    return out;
+  }
+
+  /**
+     @brief Host site loop shared by all operators.  Op is a functor
+     acting on (parity, x_cb), where parity is the index into the
+     output field.  The chunk size of the schedule is autotuned.
+  */
+  template <typename Op> class DslashCPU : public Tunable
+  {
+    Op &op;
+    const ColorSpinorField &out;
+    const ColorSpinorField &in;
+    const long long flops_;
+    const long long bytes_;
+
+    unsigned int sharedBytesPerThread() const { return 0; }
+    unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+    bool tuneGridDim() const { return false; }
+    unsigned int minThreads() const { return out.SiteSubset() * out.VolumeCB(); }
+
+  public:
+    DslashCPU(Op &op, const ColorSpinorField &out, const ColorSpinorField &in, long long flops, long long bytes,
+              const int *comm_override = nullptr) :
+      op(op),
+      out(out),
+      in(in),
+      flops_(flops),
+      bytes_(bytes)
+    {
+      strcpy(aux, out.AuxString());
+      if (op.dagger) strcat(aux, ",dagger");
+      if (op.xpay) strcat(aux, ",xpay");
+      if (comm_override) strcat(aux, comm_dim_partitioned_string(comm_override));
+    }
+
+    void apply(const cudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      host::parallel_for(out.SiteSubset(), out.VolumeCB(), op, tp.block.x);
+    }
+
+    char *Aux() { return aux; }
+
+    bool tuneHostChunk() const { return true; }
+    TuneKey tuneKey() const { return TuneKey(in.VolString(), typeid(op).name(), aux); }
+
+    void preTune() { out.backup(); }
+    void postTune() { out.restore(); }
+
+    long long flops() const { return flops_; }
+    long long bytes() const { return bytes_; }
+  };
+
+  /**
+     out = x + a * D * in (a = 0 gives out = D * in)
+  */
+  template <typename Arg> struct WilsonCPU {
+    Arg &arg;
+    const bool dagger;
+    const bool xpay;
+    WilsonCPU(Arg &arg) : arg(arg), dagger(arg.dagger), xpay(arg.a != 0.0) {}
+
+    void operator()(int spinor_parity, int x_cb) const
+    {
+      const int parity = arg.nParity == 2 ? spinor_parity : arg.parity;
+      int coord[4];
+      getCoords(coord, x_cb, arg.X, parity);
+      auto out = applyWilsonCPU(arg, coord, x_cb, parity, [](const typename Arg::Vector &v) { return v; });
+      if (xpay) out = loadSpinor<Arg>(arg.x, x_cb, spinor_parity) + arg.a * out;
+      saveSpinor<Arg>(arg.out, out, x_cb, spinor_parity);
+    }
+  };
+
+
+  /**
+     @brief Clover-field accessor for the host operators
+  */
+  template <typename Float, int nColor> struct CloverCPUField {
+    static constexpr bool dynamic_clover = dynamic_clover_inverse();
+    using C = clover::FieldOrder<Float, nColor, 4, QUDA_PACKED_CLOVER_ORDER>;
+    const C A;                  /** clover field (or its inverse) */
+    const bool dynamic_inverse; /** whether we invert the clover field on the fly */
+
+    CloverCPUField(const CloverField &A, bool inverse) :
+      A(const_cast<CloverField &>(A), inverse && !dynamic_clover),
+      dynamic_inverse(inverse && dynamic_clover)
+    {
+    }
+  };
+
+  template <typename Float, int nColor>
+  struct WilsonCloverCPUArg : DslashCPUArg<Float, 4, nColor>, CloverCPUField<Float, nColor> {
+    WilsonCloverCPUArg(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, const CloverField &A,
+                       bool inverse, double a, const ColorSpinorField &x, int parity, bool dagger,
+                       const int *comm_override) :
+      DslashCPUArg<Float, 4, nColor>(out, in, U, a, x, parity, dagger, comm_override, 1),
+      CloverCPUField<Float, nColor>(A, inverse)
+    {
+    }
+  };
+
+  template <typename Float, int nColor>
+  struct CloverCPUArg : SpinorCPUArg<Float, 4, nColor>, CloverCPUField<Float, nColor> {
+    CloverCPUArg(ColorSpinorField &out, const ColorSpinorField &in, const CloverField &A, bool inverse, int parity) :
+      SpinorCPUArg<Float, 4, nColor>(out, in, 0.0, in, parity, false),
+      CloverCPUField<Float, nColor>(A, inverse)
+    {
+    }
+  };
+
+  /**
+     out = A * x + a * D * in
+  */
+  template <typename Arg> struct WilsonCloverCPU {
+    Arg &arg;
+    const bool dagger;
+    const bool xpay = true;
+    WilsonCloverCPU(Arg &arg) : arg(arg), dagger(arg.dagger) {}
+
+    void operator()(int spinor_parity, int x_cb) const
+    {
+      const int parity = arg.nParity == 2 ? spinor_parity : arg.parity;
+      int coord[4];
+      getCoords(coord, x_cb, arg.X, parity);
+      auto out = applyWilsonCPU(arg, coord, x_cb, parity, [](const typename Arg::Vector &v) { return v; });
+      auto Ax = applyCloverCPU<typename Arg::real, Arg::nColor>(arg.A, loadSpinor<Arg>(arg.x, x_cb, spinor_parity),
+                                                                x_cb, parity, false);
+      saveSpinor<Arg>(arg.out, Ax + arg.a * out, x_cb, spinor_parity);
+    }
+  };
+
+  /**
+     out = A^{-1} * D * in, or out = x + a * A^{-1} * D * in if a is non-zero
+  */
+  template <typename Arg> struct WilsonCloverPreconditionedCPU {
+    Arg &arg;
+    const bool dagger;
+    const bool xpay;
+    WilsonCloverPreconditionedCPU(Arg &arg) : arg(arg), dagger(arg.dagger), xpay(arg.a != 0.0) {}
+
+    void operator()(int spinor_parity, int x_cb) const
+    {
+      const int parity = arg.nParity == 2 ? spinor_parity : arg.parity;
+      int coord[4];
+      getCoords(coord, x_cb, arg.X, parity);
+      auto out = applyWilsonCPU(arg, coord, x_cb, parity, [](const typename Arg::Vector &v) { return v; });
+      out = applyCloverCPU<typename Arg::real, Arg::nColor>(arg.A, out, x_cb, parity, arg.dynamic_inverse);
+      if (xpay) out = loadSpinor<Arg>(arg.x, x_cb, spinor_parity) + arg.a * out;
+      saveSpinor<Arg>(arg.out, out, x_cb, spinor_parity);
+    }
+  };
+
+  /**
+     out = A * in or out = A^{-1} * in
+  */
+  template <typename Arg> struct CloverCPU {
+    Arg &arg;
+    const bool dagger = false;
+    const bool xpay = false;
+    CloverCPU(Arg &arg) : arg(arg) {}
+
+    void operator()(int spinor_parity, int x_cb) const
+    {
+      const int parity = arg.nParity == 2 ? spinor_parity : arg.parity;
+      auto out = applyCloverCPU<typename Arg::real, Arg::nColor>(arg.A, loadSpinor<Arg>(arg.in, x_cb, spinor_parity),
+                                                                 x_cb, parity, arg.dynamic_inverse);
+      saveSpinor<Arg>(arg.out, out, x_cb, spinor_parity);
+    }
+  };
+
+  template <typename Float, int nColor> struct TwistedMassCPUArg : DslashCPUArg<Float, 4, nColor> {
+    const Float b;         /** twist factor (sign flipped for the dagger operator) */
+    const bool xpay;       /** whether to accumulate onto x (preconditioned operator) */
+    const bool asymmetric; /** whether this is the asymmetric preconditioned operator */
+
+    TwistedMassCPUArg(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a, double b,
+                      bool xpay, const ColorSpinorField &x, int parity, bool dagger, bool asymmetric,
+                      const int *comm_override) :
+      DslashCPUArg<Float, 4, nColor>(out, in, U, a, x, parity, dagger, comm_override, 1),
+      b(dagger ? -b : b),
+      xpay(xpay),
+      asymmetric(asymmetric)
+    {
+    }
+  };
+
+  /**
+     out = a * D * in + (1 + i*b*gamma_5) * x
+  */
+  template <typename Arg> struct TwistedMassCPU {
+    Arg &arg;
+    const bool dagger;
+    const bool xpay = true;
+    TwistedMassCPU(Arg &arg) : arg(arg), dagger(arg.dagger) {}
+
+    void operator()(int spinor_parity, int x_cb) const
+    {
+      const int parity = arg.nParity == 2 ? spinor_parity : arg.parity;
+      int coord[4];
+      getCoords(coord, x_cb, arg.X, parity);
+      auto out = applyWilsonCPU(arg, coord, x_cb, parity, [](const typename Arg::Vector &v) { return v; });
+      auto x = loadSpinor<Arg>(arg.x, x_cb, spinor_parity);
+      x += arg.b * x.igamma(4);
+      saveSpinor<Arg>(arg.out, x + arg.a * out, x_cb, spinor_parity);
+    }
+  };
+
+  /**
+     out = a * (1 + i*b*gamma_5) * D * in (+ x), or for the symmetric
+     dagger operator out = D^dagger * a * (1 + i*b*gamma_5) * in (+ x)
+  */
+  template <typename Arg> struct TwistedMassPreconditionedCPU {
+    Arg &arg;
+    const bool dagger;
+    const bool xpay;
+    TwistedMassPreconditionedCPU(Arg &arg) : arg(arg), dagger(arg.dagger), xpay(arg.xpay) {}
+
+    void operator()(int spinor_parity, int x_cb) const
+    {
+      using Vector = typename Arg::Vector;
+      const int parity = arg.nParity == 2 ? spinor_parity : arg.parity;
+      int coord[4];
+      getCoords(coord, x_cb, arg.X, parity);
+
+      Vector out;
+      if (!dagger || arg.asymmetric) {
+        out = applyWilsonCPU(arg, coord, x_cb, parity, [](const Vector &v) { return v; });
+        out = arg.a * (out + arg.b * out.igamma(4));
+      } else { // twist the neighbors before the hop
+        const auto a = arg.a;
+        const auto b = arg.b;
+        out = applyWilsonCPU(arg, coord, x_cb, parity, [=](Vector v) { return a * (v + b * v.igamma(4)); });
+      }
+      if (xpay) out += loadSpinor<Arg>(arg.x, x_cb, spinor_parity);
+      saveSpinor<Arg>(arg.out, out, x_cb, spinor_parity);
+    }
+  };
+
+  /**
+     out = gamma_d * in
+  */
+  template <typename Arg> struct GammaCPU {
+    Arg &arg;
+    const int d;
+    const bool dagger = false;
+    const bool xpay = false;
+    GammaCPU(Arg &arg, int d) : arg(arg), d(d) {}
+
+    void operator()(int spinor_parity, int x_cb) const
+    {
+      auto in = loadSpinor<Arg>(arg.in, x_cb, spinor_parity);
+      saveSpinor<Arg>(arg.out, in.gamma(d), x_cb, spinor_parity);
+    }
+  };
+
+  /**
+     out = a * (1 + i*b*gamma_d) * in
+  */
+  template <typename Arg> struct TwistGammaCPU {
+    Arg &arg;
+    const int d;
+    const typename Arg::real b;
+    const bool dagger = false;
+    const bool xpay = false;
+    TwistGammaCPU(Arg &arg, int d, double b) : arg(arg), d(d), b(b) {}
+
+    void operator()(int spinor_parity, int x_cb) const
+    {
+      auto in = loadSpinor<Arg>(arg.in, x_cb, spinor_parity);
+      saveSpinor<Arg>(arg.out, arg.a * (in + b * in.igamma(d)), x_cb, spinor_parity);
+    }
+  };
+
+  template <typename Float, int nColor, bool improved> struct StaggeredCPUArg : DslashCPUArg<Float, 1, nColor> {
+    using G = typename DslashCPUArg<Float, 1, nColor>::G;
+    const G L;        /** long links (improved operator only) */
+    const int nFaceL; /** depth of the long-link halo */
+
+    StaggeredCPUArg(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, const GaugeField &L,
+                    double a, const ColorSpinorField &x, int parity, bool dagger, const int *comm_override) :
+      DslashCPUArg<Float, 1, nColor>(out, in, U, a, x, parity, dagger, comm_override, improved ? 3 : 1),
+      L(const_cast<GaugeField &>(L)),
+      nFaceL(L.Nface())
+    {
+    }
+  };
+
+  /**
+     out = D * in (out = -D * in for the dagger), or out = a * x - D * in
+     if a is non-zero, where D includes the three-hop long-link term for
+     the improved operator
+  */
+  template <typename Arg, bool improved> struct StaggeredCPU {
+    Arg &arg;
+    const bool dagger;
+    const bool xpay;
+    StaggeredCPU(Arg &arg) : arg(arg), dagger(arg.dagger), xpay(arg.a != 0.0) {}
+
+    inline void gather(typename Arg::Vector &out, const typename Arg::G &U, int nFaceU, const int coord[4], int x_cb,
+                       int parity, int d, int n) const
+    {
+      using Vector = typename Arg::Vector;
+      using Link = typename Arg::Link;
+      const int their_spinor_parity = arg.nParity == 2 ? 1 - parity : 0;
+      int idx;
+
+      // forward gather
+      HopType type = hop(arg, coord, d, +n, arg.nFace, idx);
+      if (type != HOP_NONE) {
+        const Link V = loadLink<Arg>(U, d, x_cb, parity);
+        const Vector in = type == HOP_BULK ? loadSpinor<Arg>(arg.in, idx, their_spinor_parity) :
+                                             loadGhost<Arg>(arg.in, d, 1, idx, their_spinor_parity);
+        out += V * in;
+      }
+
+      // backward gather
+      type = hop(arg, coord, d, -n, arg.nFace, idx);
+      if (type != HOP_NONE) {
+        int gauge_idx = idx;
+        if (type == HOP_HALO) hop(arg, coord, d, -n, nFaceU, gauge_idx);
+        const Link V = type == HOP_BULK ? loadLink<Arg>(U, d, gauge_idx, 1 - parity) :
+                                          loadGhostLink<Arg>(U, d, gauge_idx, 1 - parity);
+        const Vector in = type == HOP_BULK ? loadSpinor<Arg>(arg.in, idx, their_spinor_parity) :
+                                             loadGhost<Arg>(arg.in, d, 0, idx, their_spinor_parity);
+        out -= conj(V) * in;
+      }
+    }
+
+    void operator()(int spinor_parity, int x_cb) const
+    {
+      using Vector = typename Arg::Vector;
+      const int parity = arg.nParity == 2 ? spinor_parity : arg.parity;
+      int coord[4];
+      getCoords(coord, x_cb, arg.X, parity);
+
+      Vector out;
+      for (int d = 0; d < 4; d++) {
+        gather(out, arg.U, arg.nFaceU, coord, x_cb, parity, d, 1);
+        if (improved) gather(out, arg.L, arg.nFaceL, coord, x_cb, parity, d, 3);
+      }
+
+      if (dagger) out *= static_cast<typename Arg::real>(-1.0);
+      if (xpay) out = arg.a * loadSpinor<Arg>(arg.x, x_cb, spinor_parity) - out;
+      saveSpinor<Arg>(arg.out, out, x_cb, spinor_parity);
+    }
+  };
+
+  /**
+     @brief Check the color-spinor fields are supported by the host operators
+  */
+  static void checkHostFields(const ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &x,
+                              bool stencil = true)
+  {
+    if (stencil && in.V() == out.V()) errorQuda("Aliasing pointers");
+    if (out.Ncolor() != 3) errorQuda("Unsupported number of colors %d", out.Ncolor());
+    // staggered fields carry a trivial fifth (source) dimension
+    if (out.Ndim() != 4 && !(out.Ndim() == 5 && out.X(4) == 1))
+      errorQuda("Unsupported number of dimensions %d", out.Ndim());
+    checkPrecision(out, in, x);
+    for (auto f : {&out, &in, &x}) {
+      if (f->FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+        errorQuda("Unsupported field order %d for host operator", f->FieldOrder());
+      if (f->Nspin() == 4 && f->GammaBasis() != QUDA_UKQCD_GAMMA_BASIS)
+        errorQuda("Unsupported gamma basis %d for host operator", f->GammaBasis());
+    }
+  }
+
+  /**
+     @brief Check the gauge field is supported by the host operators
+  */
+  static void checkHostFields(const GaugeField &U, const int *comm_override)
+  {
+    if (U.Order() != QUDA_QDP_GAUGE_ORDER) errorQuda("Unsupported gauge order %d for host operator", U.Order());
+    for (int d = 0; d < 4; d++)
+      if (comm_dim_partitioned(d) && comm_override[d] && U.GhostExchange() != QUDA_GHOST_EXCHANGE_PAD)
+        errorQuda("Host operator requires the gauge-field ghost zone in partitioned dimension %d", d);
+  }
+
+  /**
+     @brief Exchange the halo of the input field if we communicate in
+     any dimension
+  */
+  static void exchangeHostGhost(const ColorSpinorField &in, int parity, int nFace, bool dagger, const int *comm_override)
+  {
+    bool comms = false;
+    for (int d = 0; d < 4; d++) comms = comms || (comm_dim_partitioned(d) && comm_override[d]);
+    if (comms)
+      in.exchangeGhost((QudaParity)(in.SiteSubset() == QUDA_PARITY_SITE_SUBSET ? (1 - parity) : 0), nFace, dagger);
+  }
+
+  /**
+     @brief Instantiate a host operator on the precision of the field
+  */
+  template <template <typename> class Apply, typename... Args>
+  static void instantiateCPU(const ColorSpinorField &in, Args &&... args)
+  {
+    if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+#if QUDA_PRECISION & 8
+      Apply<double>(args...);
+#else
+      errorQuda("QUDA_PRECISION=%d does not enable double precision", QUDA_PRECISION);
+#endif
+    } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
+#if QUDA_PRECISION & 4
+      Apply<float>(args...);
+#else
+      errorQuda("QUDA_PRECISION=%d does not enable single precision", QUDA_PRECISION);
+#endif
+    } else {
+      errorQuda("Unsupported precision %d for host operator", in.Precision());
+    }
+  }
+
+  /**
+     @return Bytes moved by a stencil with the given number of hops
+     per site (each hop reads a neighbor and a link)
+  */
+  static long long stencilBytes(const ColorSpinorField &out, const GaugeField &U, int hops, bool xpay)
+  {
+    const long long sites = out.SiteSubset() * out.VolumeCB();
+    const long long site_bytes = out.Bytes() / sites;
+    const long long link_bytes = 2 * U.Ncolor() * U.Ncolor() * U.Precision();
+    return sites * ((hops + 1 + (xpay ? 1 : 0)) * site_bytes + hops * link_bytes);
+  }
+
+  template <typename Float> struct WilsonCPUApply {
+    WilsonCPUApply(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                   const ColorSpinorField &x, int parity, bool dagger, const int *comm_override)
+    {
+      DslashCPUArg<Float, 4, 3> arg(out, in, U, a, x, parity, dagger, comm_override, 1);
+      WilsonCPU<decltype(arg)> op(arg);
+      const long long sites = out.SiteSubset() * out.VolumeCB();
+      DslashCPU<decltype(op)> dslash(op, out, in, (1320ll + (op.xpay ? 48ll : 0ll)) * sites,
+                                     stencilBytes(out, U, 8, op.xpay), comm_override);
+      dslash.apply(0);
+    }
+  };
+
+  void ApplyWilsonCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                      const ColorSpinorField &x, int parity, bool dagger, const int *comm_override)
+  {
+    checkHostFields(out, in, x);
+    checkHostFields(U, comm_override);
+    exchangeHostGhost(in, parity, 1, dagger, comm_override);
+    instantiateCPU<WilsonCPUApply>(in, out, in, U, a, x, parity, dagger, comm_override);
+  }
+
+  template <typename Float> struct WilsonCloverCPUApply {
+    WilsonCloverCPUApply(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                         const CloverField &A, double a, const ColorSpinorField &x, int parity, bool dagger,
+                         const int *comm_override)
+    {
+      WilsonCloverCPUArg<Float, 3> arg(out, in, U, A, false, a, x, parity, dagger, comm_override);
+      WilsonCloverCPU<decltype(arg)> op(arg);
+      const long long sites = out.SiteSubset() * out.VolumeCB();
+      DslashCPU<decltype(op)> dslash(op, out, in, (1320ll + 504ll + 48ll) * sites,
+                                     stencilBytes(out, U, 8, true) + A.Bytes() / (3 - out.SiteSubset()),
+                                     comm_override);
+      dslash.apply(0);
+    }
+  };
+
+  void ApplyWilsonCloverCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                            const CloverField &A, double a, const ColorSpinorField &x, int parity, bool dagger,
+                            const int *comm_override)
+  {
+    checkHostFields(out, in, x);
+    checkHostFields(U, comm_override);
+    if (A.Order() != QUDA_PACKED_CLOVER_ORDER) errorQuda("Unsupported clover order %d for host operator", A.Order());
+    exchangeHostGhost(in, parity, 1, dagger, comm_override);
+    instantiateCPU<WilsonCloverCPUApply>(in, out, in, U, A, a, x, parity, dagger, comm_override);
+  }
+
+  template <typename Float> struct WilsonCloverPreconditionedCPUApply {
+    WilsonCloverPreconditionedCPUApply(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                       const CloverField &A, double a, const ColorSpinorField &x, int parity,
+                                       bool dagger, const int *comm_override)
+    {
+      WilsonCloverCPUArg<Float, 3> arg(out, in, U, A, true, a, x, parity, dagger, comm_override);
+      WilsonCloverPreconditionedCPU<decltype(arg)> op(arg);
+      const long long sites = out.SiteSubset() * out.VolumeCB();
+      DslashCPU<decltype(op)> dslash(op, out, in, (1320ll + 504ll + (op.xpay ? 48ll : 0ll)) * sites,
+                                     stencilBytes(out, U, 8, op.xpay) + A.Bytes() / (3 - out.SiteSubset()),
+                                     comm_override);
+      dslash.apply(0);
+    }
+  };
+
+  void ApplyWilsonCloverPreconditionedCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                          const CloverField &A, double a, const ColorSpinorField &x, int parity,
+                                          bool dagger, const int *comm_override)
+  {
+    checkHostFields(out, in, x);
+    checkHostFields(U, comm_override);
+    if (A.Order() != QUDA_PACKED_CLOVER_ORDER) errorQuda("Unsupported clover order %d for host operator", A.Order());
+    if (!dynamic_clover_inverse() && !A.V(true)) errorQuda("Clover inverse has not been computed");
+    exchangeHostGhost(in, parity, 1, dagger, comm_override);
+    instantiateCPU<WilsonCloverPreconditionedCPUApply>(in, out, in, U, A, a, x, parity, dagger, comm_override);
+  }
+
+  template <typename Float> struct CloverCPUApply {
+    CloverCPUApply(ColorSpinorField &out, const ColorSpinorField &in, const CloverField &A, bool inverse, int parity)
+    {
+      CloverCPUArg<Float, 3> arg(out, in, A, inverse, parity);
+      CloverCPU<decltype(arg)> op(arg);
+      const long long sites = out.SiteSubset() * out.VolumeCB();
+      DslashCPU<decltype(op)> dslash(op, out, in, 504ll * sites,
+                                     in.Bytes() + out.Bytes() + A.Bytes() / (3 - out.SiteSubset()));
+      dslash.apply(0);
+    }
+  };
+
+  void ApplyCloverCPU(ColorSpinorField &out, const ColorSpinorField &in, const CloverField &A, bool inverse,
+                      int parity)
+  {
+    checkHostFields(out, in, in, false); // site-local, so aliasing is allowed
+    if (A.Order() != QUDA_PACKED_CLOVER_ORDER) errorQuda("Unsupported clover order %d for host operator", A.Order());
+    if (inverse && !dynamic_clover_inverse() && !A.V(true)) errorQuda("Clover inverse has not been computed");
+    instantiateCPU<CloverCPUApply>(in, out, in, A, inverse, parity);
+  }
+
+  template <typename Float> struct TwistedMassCPUApply {
+    TwistedMassCPUApply(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a, double b,
+                        const ColorSpinorField &x, int parity, bool dagger, const int *comm_override)
+    {
+      TwistedMassCPUArg<Float, 3> arg(out, in, U, a, b, true, x, parity, dagger, false, comm_override);
+      TwistedMassCPU<decltype(arg)> op(arg);
+      const long long sites = out.SiteSubset() * out.VolumeCB();
+      DslashCPU<decltype(op)> dslash(op, out, in, (1320ll + 96ll) * sites, stencilBytes(out, U, 8, true),
+                                     comm_override);
+      dslash.apply(0);
+    }
+  };
+
+  void ApplyTwistedMassCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                           double b, const ColorSpinorField &x, int parity, bool dagger, const int *comm_override)
+  {
+    checkHostFields(out, in, x);
+    checkHostFields(U, comm_override);
+    if (in.TwistFlavor() != QUDA_TWIST_SINGLET) errorQuda("Unsupported twist flavor %d for host operator", in.TwistFlavor());
+    exchangeHostGhost(in, parity, 1, dagger, comm_override);
+    instantiateCPU<TwistedMassCPUApply>(in, out, in, U, a, b, x, parity, dagger, comm_override);
+  }
+
+  template <typename Float> struct TwistedMassPreconditionedCPUApply {
+    TwistedMassPreconditionedCPUApply(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                                      double b, bool xpay, const ColorSpinorField &x, int parity, bool dagger,
+                                      bool asymmetric, const int *comm_override)
+    {
+      TwistedMassCPUArg<Float, 3> arg(out, in, U, a, b, xpay, x, parity, dagger, asymmetric, comm_override);
+      TwistedMassPreconditionedCPU<decltype(arg)> op(arg);
+      const long long sites = out.SiteSubset() * out.VolumeCB();
+      const long long twist_flops = (!dagger || asymmetric) ? 96ll : 8 * 96ll;
+      DslashCPU<decltype(op)> dslash(op, out, in, (1320ll + twist_flops + (xpay ? 48ll : 0ll)) * sites,
+                                     stencilBytes(out, U, 8, xpay), comm_override);
+      if (asymmetric) strcat(dslash.Aux(), ",asymmetric");
+      dslash.apply(0);
+    }
+  };
+
+  void ApplyTwistedMassPreconditionedCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                         double a, double b, bool xpay, const ColorSpinorField &x, int parity,
+                                         bool dagger, bool asymmetric, const int *comm_override)
+  {
+    checkHostFields(out, in, x);
+    checkHostFields(U, comm_override);
+    if (in.TwistFlavor() != QUDA_TWIST_SINGLET) errorQuda("Unsupported twist flavor %d for host operator", in.TwistFlavor());
+    exchangeHostGhost(in, parity, 1, dagger, comm_override);
+    instantiateCPU<TwistedMassPreconditionedCPUApply>(in, out, in, U, a, b, xpay, x, parity, dagger, asymmetric,
+                                                      comm_override);
+  }
+
+  template <typename Float> struct GammaCPUApply {
+    GammaCPUApply(ColorSpinorField &out, const ColorSpinorField &in, int d)
+    {
+      SpinorCPUArg<Float, 4, 3> arg(out, in, 0.0, in, 0, false);
+      GammaCPU<decltype(arg)> op(arg, d);
+      DslashCPU<decltype(op)> gamma(op, out, in, 0, in.Bytes() + out.Bytes());
+      gamma.apply(0);
+    }
+  };
+
+  void ApplyGammaCPU(ColorSpinorField &out, const ColorSpinorField &in, int d)
+  {
+    checkHostFields(out, in, in, false); // site-local, so aliasing is allowed
+    instantiateCPU<GammaCPUApply>(in, out, in, d);
+  }
+
+  template <typename Float> struct TwistGammaCPUApply {
+    TwistGammaCPUApply(ColorSpinorField &out, const ColorSpinorField &in, int d, double a, double b)
+    {
+      SpinorCPUArg<Float, 4, 3> arg(out, in, a, in, 0, false);
+      TwistGammaCPU<decltype(arg)> op(arg, d, b);
+      DslashCPU<decltype(op)> gamma(op, out, in, 72ll * out.SiteSubset() * out.VolumeCB(), in.Bytes() + out.Bytes());
+      gamma.apply(0);
+    }
+  };
+
+  void ApplyTwistGammaCPU(ColorSpinorField &out, const ColorSpinorField &in, int d, double kappa, double mu,
+                          int dagger, QudaTwistGamma5Type type)
+  {
+    checkHostFields(out, in, in, false); // site-local, so aliasing is allowed
+    if (in.TwistFlavor() != QUDA_TWIST_SINGLET) errorQuda("Unsupported twist flavor %d for host operator", in.TwistFlavor());
+
+    double a = 0.0, b = 0.0;
+    if (type == QUDA_TWIST_GAMMA5_DIRECT) {
+      b = 2.0 * kappa * mu;
+      a = 1.0;
+    } else if (type == QUDA_TWIST_GAMMA5_INVERSE) {
+      b = -2.0 * kappa * mu;
+      a = 1.0 / (1.0 + b * b);
+    } else {
+      errorQuda("Unsupported twist type %d", type);
+    }
+    if (dagger) b *= -1.0;
+
+    instantiateCPU<TwistGammaCPUApply>(in, out, in, d, a, b);
+  }
+
+  template <typename Float, bool improved> struct StaggeredCPUApply {
+    StaggeredCPUApply(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, const GaugeField &L,
+                      double a, const ColorSpinorField &x, int parity, bool dagger, const int *comm_override)
+    {
+      StaggeredCPUArg<Float, 3, improved> arg(out, in, U, L, a, x, parity, dagger, comm_override);
+      StaggeredCPU<decltype(arg), improved> op(arg);
+      const long long sites = out.SiteSubset() * out.VolumeCB();
+      const int hops = improved ? 16 : 8;
+      DslashCPU<decltype(op)> dslash(op, out, in, ((improved ? 1146ll : 570ll) + (op.xpay ? 12ll : 0ll)) * sites,
+                                     stencilBytes(out, U, hops, op.xpay), comm_override);
+      dslash.apply(0);
+    }
+  };
+
+  template <typename Float> using NaiveStaggeredCPUApply = StaggeredCPUApply<Float, false>;
+  template <typename Float> using ImprovedStaggeredCPUApply = StaggeredCPUApply<Float, true>;
+
+  void ApplyStaggeredCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U, double a,
+                         const ColorSpinorField &x, int parity, bool dagger, const int *comm_override)
+  {
+    checkHostFields(out, in, x);
+    checkHostFields(U, comm_override);
+    exchangeHostGhost(in, parity, 1, dagger, comm_override);
+    instantiateCPU<NaiveStaggeredCPUApply>(in, out, in, U, U, a, x, parity, dagger, comm_override);
+  }
+
+  void ApplyImprovedStaggeredCPU(ColorSpinorField &out, const ColorSpinorField &in, const GaugeField &U,
+                                 const GaugeField &L, double a, const ColorSpinorField &x, int parity, bool dagger,
+                                 const int *comm_override)
+  {
+    checkHostFields(out, in, x);
+    checkHostFields(U, comm_override);
+    checkHostFields(L, comm_override);
+    exchangeHostGhost(in, parity, 3, dagger, comm_override);
+    instantiateCPU<ImprovedStaggeredCPUApply>(in, out, in, U, L, a, x, parity, dagger, comm_override);
+  }
+
+} // namespace quda
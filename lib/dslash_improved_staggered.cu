@@ -178,7 +178,10 @@ namespace quda
     checkPrecision(out, in, U, L);
 
     // check all locations match
-    checkLocation(out, in, U, L);
+    if (checkLocation(out, in, U, L) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyImprovedStaggeredCPU(out, in, U, L, a, x, parity, dagger, comm_override);
+      return;
+    }
 
     for (int i = 0; i < 4; i++) {
       if (comm_dim_partitioned(i) && (U.X()[i] < 6)) {
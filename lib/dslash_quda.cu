@@ -220,21 +220,6 @@ namespace quda {
     }
   };
 
-  // CPU kernel for applying the gamma matrix to a colorspinor
-  template <typename Float, int nColor, typename Arg>
-  void gammaCPU(Arg arg)
-  {
-    typedef typename mapper<Float>::type RegType;
-    for (int parity= 0; parity < arg.nParity; parity++) {
-
-      for (int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
-	ColorSpinor<RegType,nColor,4> in = arg.in(x_cb, parity);
-	arg.out(x_cb, parity) = in.gamma(arg.d);
-      } // 4-d volumeCB
-    } // parity
-
-  }
-
   // GPU Kernel for applying the gamma matrix to a colorspinor
   template <typename Float, int nColor, int d, typename Arg>
   __global__ void gammaGPU(Arg arg)
@@ -270,14 +255,10 @@ namespace quda {
     virtual ~Gamma() { }
 
     void apply(const cudaStream_t &stream) {
-      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
-	gammaCPU<Float,nColor>(arg);
-      } else {
-        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-	switch (arg.d) {
-	case 4: gammaGPU<Float,nColor,4> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg); break;
-	default: errorQuda("%d not instantiated", arg.d);
-	}
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      switch (arg.d) {
+      case 4: gammaGPU<Float,nColor,4> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg); break;
+      default: errorQuda("%d not instantiated", arg.d);
       }
     }
 
@@ -312,7 +293,10 @@ namespace quda {
   void ApplyGamma(ColorSpinorField &out, const ColorSpinorField &in, int d)
   {
     checkPrecision(out, in);    // check all precisions match
-    checkLocation(out, in);     // check all locations match
+    if (checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyGammaCPU(out, in, d);
+      return;
+    }
 
     if (in.Precision() == QUDA_DOUBLE_PRECISION) {
       ApplyGamma<double>(out, in, d);
@@ -327,27 +311,6 @@ namespace quda {
     }
   }
 
-  // CPU kernel for applying the gamma matrix to a colorspinor
-  template <bool doublet, typename Float, int nColor, typename Arg>
-  void twistGammaCPU(Arg arg)
-  {
-    typedef typename mapper<Float>::type RegType;
-    for (int parity= 0; parity < arg.nParity; parity++) {
-      for (int x_cb = 0; x_cb < arg.volumeCB; x_cb++) { // 4-d volume
-	if (!doublet) {
-	  ColorSpinor<RegType,nColor,4> in = arg.in(x_cb, parity);
-          arg.out(x_cb, parity) = arg.a * (in + arg.b * in.igamma(arg.d));
-        } else {
-	  ColorSpinor<RegType,nColor,4> in_1 = arg.in(x_cb+0*arg.volumeCB, parity);
-	  ColorSpinor<RegType,nColor,4> in_2 = arg.in(x_cb+1*arg.volumeCB, parity);
-          arg.out(x_cb + 0 * arg.volumeCB, parity) = arg.a * (in_1 + arg.b * in_1.igamma(arg.d) + arg.c * in_2);
-          arg.out(x_cb + 1 * arg.volumeCB, parity) = arg.a * (in_2 - arg.b * in_2.igamma(arg.d) + arg.c * in_1);
-        }
-      } // 4-d volumeCB
-    } // parity
-
-  }
-
   // GPU Kernel for applying the gamma matrix to a colorspinor
   template <bool doublet, typename Float, int nColor, int d, typename Arg>
   __global__ void twistGammaGPU(Arg arg)
@@ -388,22 +351,17 @@ namespace quda {
     virtual ~TwistGamma() { }
 
     void apply(const cudaStream_t &stream) {
-      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
-	if (arg.doublet) twistGammaCPU<true,Float,nColor>(arg);
-	twistGammaCPU<false,Float,nColor>(arg);
-      } else {
-        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-	if (arg.doublet)
-	  switch (arg.d) {
-	  case 4: twistGammaGPU<true,Float,nColor,4> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg); break;
-	  default: errorQuda("%d not instantiated", arg.d);
-	  }
-	else
-	  switch (arg.d) {
-	  case 4: twistGammaGPU<false,Float,nColor,4> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg); break;
-	  default: errorQuda("%d not instantiated", arg.d);
-	  }
-      }
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      if (arg.doublet)
+        switch (arg.d) {
+        case 4: twistGammaGPU<true,Float,nColor,4> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg); break;
+        default: errorQuda("%d not instantiated", arg.d);
+        }
+      else
+        switch (arg.d) {
+        case 4: twistGammaGPU<false,Float,nColor,4> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg); break;
+        default: errorQuda("%d not instantiated", arg.d);
+        }
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
@@ -438,9 +396,13 @@ namespace quda {
   void ApplyTwistGamma(ColorSpinorField &out, const ColorSpinorField &in, int d, double kappa, double mu, double epsilon, int dagger, QudaTwistGamma5Type type)
   {
     checkPrecision(out, in);    // check all precisions match
-    checkLocation(out, in);     // check all locations match
 
 #ifdef GPU_TWISTED_MASS_DIRAC
+    if (checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyTwistGammaCPU(out, in, d, kappa, mu, dagger, type);
+      return;
+    }
+
     if (in.Precision() == QUDA_DOUBLE_PRECISION) {
       ApplyTwistGamma<double>(out, in, d, kappa, mu, epsilon, dagger, type);
     } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
@@ -548,14 +510,6 @@ namespace quda {
     arg.out(x_cb, spinor_parity) = out;
   }
 
-  template <typename Float, int nSpin, int nColor, typename Arg>
-  void cloverCPU(Arg &arg) {
-    for (int parity=0; parity<arg.nParity; parity++) {
-      parity = (arg.nParity == 2) ? parity : arg.parity;
-      for (int x_cb=0; x_cb<arg.volumeCB; x_cb++) cloverApply<Float,nSpin,nColor>(arg, x_cb, parity);
-    }
-  }
-
   template <typename Float, int nSpin, int nColor, typename Arg>
   __global__ void cloverGPU(Arg arg) {
     int x_cb = blockIdx.x*blockDim.x + threadIdx.x;
@@ -587,11 +541,7 @@ namespace quda {
     void apply(const cudaStream_t &stream)
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-      if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
-	cloverCPU<Float,nSpin,nColor>(arg);
-      } else {
-	cloverGPU<Float,nSpin,nColor> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
-      }
+      cloverGPU<Float,nSpin,nColor> <<<tp.grid,tp.block,tp.shared_bytes,stream>>>(arg);
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
@@ -635,9 +585,13 @@ namespace quda {
   void ApplyClover(ColorSpinorField &out, const ColorSpinorField &in, const CloverField &clover, bool inverse, int parity)
   {
     checkPrecision(out, clover, in);    // check all precisions match
-    checkLocation(out, clover, in);     // check all locations match
 
 #ifdef GPU_CLOVER_DIRAC
+    if (checkLocation(out, clover, in) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyCloverCPU(out, in, clover, inverse, parity);
+      return;
+    }
+
     if (in.Precision() == QUDA_DOUBLE_PRECISION) {
       ApplyClover<double>(out, in, clover, inverse, parity);
     } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
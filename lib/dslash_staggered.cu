@@ -103,7 +103,10 @@ namespace quda
     checkPrecision(out, in, U);
 
     // check all locations match
-    checkLocation(out, in, U);
+    if (checkLocation(out, in, U) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyStaggeredCPU(out, in, U, a, x, parity, dagger, comm_override);
+      return;
+    }
 
     instantiate<StaggeredApply, StaggeredReconstruct>(out, in, U, a, x, parity, dagger, comm_override, profile);
 #else
@@ -81,7 +81,10 @@ namespace quda
     checkPrecision(out, in, U);
 
     // check all locations match
-    checkLocation(out, in, U);
+    if (checkLocation(out, in, U) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyTwistedMassCPU(out, in, U, a, b, x, parity, dagger, comm_override);
+      return;
+    }
 
     instantiate<TwistedMassApply>(out, in, U, a, b, x, parity, dagger, comm_override, profile);
 #else
@@ -114,7 +114,10 @@ namespace quda
     checkPrecision(out, in, U);
 
     // check all locations match
-    checkLocation(out, in, U);
+    if (checkLocation(out, in, U) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyTwistedMassPreconditionedCPU(out, in, U, a, b, xpay, x, parity, dagger, asymmetric, comm_override);
+      return;
+    }
 
     // with symmetric dagger operator we must use kernel packing
     if (dagger && !asymmetric) pushKernelPackT(true);
@@ -63,7 +63,10 @@ namespace quda
     checkPrecision(out, in, U);
 
     // check all locations match
-    checkLocation(out, in, U);
+    if (checkLocation(out, in, U) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyWilsonCPU(out, in, U, a, x, parity, dagger, comm_override);
+      return;
+    }
 
     instantiate<WilsonApply, WilsonReconstruct>(out, in, U, a, x, parity, dagger, comm_override, profile);
 #else
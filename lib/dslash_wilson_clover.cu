@@ -114,7 +114,10 @@ namespace quda
     checkPrecision(out, in, U, A);
 
     // check all locations match
-    checkLocation(out, in, U, A);
+    if (checkLocation(out, in, U, A) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyWilsonCloverCPU(out, in, U, A, a, x, parity, dagger, comm_override);
+      return;
+    }
 
     instantiate<WilsonCloverApply>(out, in, U, A, a, x, parity, dagger, comm_override, profile);
 #else
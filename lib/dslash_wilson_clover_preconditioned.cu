@@ -141,7 +141,10 @@ namespace quda
     checkPrecision(out, in, U, A);
 
     // check all locations match
-    checkLocation(out, in, U, A);
+    if (checkLocation(out, in, U, A) == QUDA_CPU_FIELD_LOCATION) {
+      ApplyWilsonCloverPreconditionedCPU(out, in, U, A, a, x, parity, dagger, comm_override);
+      return;
+    }
 
     instantiate<WilsonCloverPreconditionedApply>(out, in, U, A, a, x, parity, dagger, comm_override, profile);
 #else
@@ -0,0 +1,274 @@
+#include <math.h>
+#include <float.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <atomic>
+
+#include <quda_internal.h>
+#include <eigensolve_quda.h>
+#include <host_parallel.h>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/Dense>
+
+namespace quda
+{
+
+  using namespace Eigen;
+
+  void ArrowEigensolver::compute(const double *alpha, const double *beta, int dim, int arrow_pos)
+  {
+    if (arrow_pos < 1 || arrow_pos > dim) errorQuda("Invalid arrow position %d for dimension %d", arrow_pos, dim);
+    this->dim = dim;
+    this->arrow_pos = arrow_pos;
+
+    tridiagonalize(alpha, beta);
+
+    // eigenvalues of the tridiagonal matrix with implicit QL, O(dim^2)
+    VectorXd d = Map<VectorXd>(diag.data(), dim);
+    VectorXd e = Map<VectorXd>(off.data(), dim - 1);
+    SelfAdjointEigenSolver<MatrixXd> eigensolver;
+    eigensolver.computeFromTridiagonal(d, e, EigenvaluesOnly);
+    if (eigensolver.info() != Success) errorQuda("Tridiagonal eigensolver failed to converge");
+    evals.resize(dim);
+    for (int i = 0; i < dim; i++) evals[i] = eigensolver.eigenvalues()[i];
+
+    inverseIteration();
+  }
+
+  /**
+     The arrow block is reduced following Rutishauser, Kahan, Pal and
+     Walker (see Gragg and Harrod, Numer. Math. 44 (1984) 317).  The
+     working matrix W starts as the arrowhead alone, and the diagonal
+     elements of the block are appended one at a time, each coupled to
+     the arrowhead only.  The coupling is chased down the band with
+     rotations in the planes (p + 1, m), which never touch the
+     arrowhead.  Reversing the order of W gives the leading block of
+     the tridiagonal matrix, with the arrowhead left at arrow_pos - 1,
+     so it still couples to the tail through beta[arrow_pos - 1].
+  */
+  void ArrowEigensolver::tridiagonalize(const double *alpha, const double *beta)
+  {
+    const int k = arrow_pos;
+    std::vector<double> w_diag(k), w_off(std::max(k - 1, 1)), spike(k);
+
+    rot.clear();
+    rot.reserve((size_t)k * k);
+
+    w_diag[0] = alpha[k - 1];
+    for (int m = 1; m < k; m++) {
+      w_diag[m] = alpha[m - 1];
+      for (int i = 0; i < m; i++) spike[i] = 0.0;
+      spike[0] = beta[m - 1];
+
+      for (int p = 0; p < m - 1; p++) {
+        // rotate in the plane (a, m) to zero W(p, m)
+        const int a = p + 1;
+        const double r = hypot(w_off[p], spike[p]);
+        const double c = r > 0.0 ? w_off[p] / r : 1.0;
+        const double s = r > 0.0 ? spike[p] / r : 0.0;
+        rot.push_back(c);
+        rot.push_back(s);
+
+        w_off[p] = r;
+        spike[p] = 0.0;
+
+        const double waa = w_diag[a], wbb = w_diag[m], wab = spike[a];
+        w_diag[a] = c * c * waa + 2.0 * c * s * wab + s * s * wbb;
+        w_diag[m] = s * s * waa - 2.0 * c * s * wab + c * c * wbb;
+        spike[a] = c * s * (wbb - waa) + (c * c - s * s) * wab;
+
+        if (a + 1 < m) {
+          const double wqa = w_off[a], wqb = spike[a + 1];
+          w_off[a] = c * wqa + s * wqb;
+          spike[a + 1] = -s * wqa + c * wqb;
+        }
+      }
+      w_off[m - 1] = spike[m - 1];
+    }
+
+    diag.resize(dim);
+    off.resize(std::max(dim - 1, 0));
+    for (int i = 0; i < k; i++) diag[k - 1 - i] = w_diag[i];
+    for (int i = 0; i < k - 1; i++) off[k - 2 - i] = w_off[i];
+    for (int i = k; i < dim; i++) diag[i] = alpha[i];
+    for (int i = k - 1; i < dim - 1; i++) off[i] = beta[i];
+  }
+
+  /**
+     Inverse iteration for the eigenvectors of the tridiagonal matrix
+     following LAPACK dstein: eigenvalues closer than 1e-3 |T| form a
+     cluster, whose members are perturbed apart and orthogonalized
+     against each other with classical Gram-Schmidt (applied twice)
+     after every solve.  Each vector is iterated until its residual
+     |(T - lambda) z| drops below 10 n eps |T|, for at most max_iter
+     solves.  Clusters are independent and are distributed over the
+     host threads.  The start vectors are seeded by the eigenvalue
+     index, so the result is reproducible.
+  */
+  void ArrowEigensolver::inverseIteration()
+  {
+    const int n = dim;
+    evecs.resize((size_t)n * n);
+
+    double norm = 0.0;
+    for (int i = 0; i < n; i++) {
+      double row = fabs(diag[i]) + (i > 0 ? fabs(off[i - 1]) : 0.0) + (i < n - 1 ? fabs(off[i]) : 0.0);
+      norm = std::max(norm, row);
+    }
+    const double ortol = 1e-3 * norm;
+    const double tiny = std::max(DBL_EPSILON * norm, DBL_MIN);
+
+    std::vector<int> cluster = {0};
+    for (int j = 1; j < n; j++)
+      if (evals[j] - evals[j - 1] > ortol) cluster.push_back(j);
+    cluster.push_back(n);
+
+    const double res_tol = 10.0 * n * DBL_EPSILON * norm;
+    const int max_iter = 10;
+    std::atomic<int> n_unconverged(0);
+    std::atomic<double> max_res(0.0);
+
+    host::parallel_for(
+      cluster.size() - 1,
+      [&](int c) {
+        std::vector<double> u0(n), u1(n), u2(n), l(n), x(n);
+        std::vector<char> pivot(n);
+
+        double lambda_prev = 0.0;
+        for (int j = cluster[c]; j < cluster[c + 1]; j++) {
+          // perturb coincident eigenvalues apart
+          double lambda = evals[j];
+          if (j > cluster[c]) {
+            const double pertol = 10.0 * fabs(DBL_EPSILON * lambda);
+            if (lambda - lambda_prev < pertol) lambda = lambda_prev + pertol;
+          }
+          lambda_prev = lambda;
+
+          // LU factorization of T - lambda with partial pivoting
+          for (int i = 0; i < n; i++) {
+            u0[i] = diag[i] - lambda;
+            u1[i] = i < n - 1 ? off[i] : 0.0;
+            u2[i] = 0.0;
+          }
+          for (int i = 0; i < n - 1; i++) {
+            if (fabs(u0[i]) >= fabs(off[i])) {
+              if (u0[i] == 0.0) u0[i] = tiny;
+              l[i] = off[i] / u0[i];
+              u0[i + 1] -= l[i] * u1[i];
+              pivot[i] = false;
+            } else {
+              l[i] = u0[i] / off[i];
+              u0[i] = off[i];
+              const double tmp = u0[i + 1];
+              u0[i + 1] = u1[i] - l[i] * tmp;
+              if (i < n - 2) {
+                u2[i] = u1[i + 1];
+                u1[i + 1] = -l[i] * u2[i];
+              }
+              u1[i] = tmp;
+              pivot[i] = true;
+            }
+          }
+          for (int i = 0; i < n; i++)
+            if (fabs(u0[i]) < tiny) u0[i] = u0[i] < 0.0 ? -tiny : tiny;
+
+          std::mt19937 rng(j);
+          std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+          for (int i = 0; i < n; i++) x[i] = uniform(rng);
+
+          double *z = evecs.data() + (size_t)n * j;
+          double res = 0.0;
+          for (int it = 0; it < max_iter; it++) {
+            // scale the right hand side to avoid overflow
+            double x_norm = 0.0;
+            for (int i = 0; i < n; i++) x_norm = std::max(x_norm, fabs(x[i]));
+            for (int i = 0; i < n; i++) x[i] /= x_norm;
+
+            // solve (T - lambda) z = x
+            for (int i = 0; i < n - 1; i++) {
+              if (pivot[i]) std::swap(x[i], x[i + 1]);
+              x[i + 1] -= l[i] * x[i];
+            }
+            for (int i = n - 1; i >= 0; i--) {
+              double sum = x[i];
+              if (i < n - 1) sum -= u1[i] * x[i + 1];
+              if (i < n - 2) sum -= u2[i] * x[i + 2];
+              x[i] = sum / u0[i];
+            }
+
+            // orthogonalize against the previous members of the cluster (CGS2)
+            if (j > cluster[c]) {
+              Map<const MatrixXd> V(evecs.data() + (size_t)n * cluster[c], n, j - cluster[c]);
+              Map<VectorXd> x_(x.data(), n);
+              for (int k = 0; k < 2; k++) x_ -= V * (V.transpose() * x_).eval();
+            }
+
+            double x2 = 0.0;
+            for (int i = 0; i < n; i++) x2 += x[i] * x[i];
+            const double inv = 1.0 / sqrt(x2);
+            for (int i = 0; i < n; i++) x[i] *= inv;
+
+            // residual of the unperturbed eigenvalue
+            double r2 = 0.0;
+            for (int i = 0; i < n; i++) {
+              double r = (diag[i] - evals[j]) * x[i];
+              if (i > 0) r += off[i - 1] * x[i - 1];
+              if (i < n - 1) r += off[i] * x[i + 1];
+              r2 += r * r;
+            }
+            res = sqrt(r2);
+            if (res <= res_tol) break;
+          }
+
+          if (res > res_tol) {
+            n_unconverged++;
+            double prev = max_res.load();
+            while (res > prev && !max_res.compare_exchange_weak(prev, res)) { }
+          }
+          for (int i = 0; i < n; i++) z[i] = x[i];
+        }
+      },
+      1);
+
+    if (n_unconverged > 0)
+      warningQuda("Inverse iteration reached %d iterations for %d of %d eigenvectors, largest residual %e > %e",
+                  max_iter, n_unconverged.load(), n, max_res.load(), res_tol);
+  }
+
+  void ArrowEigensolver::vectors(double *vecs, int n) const
+  {
+    if (n > dim) errorQuda("Requested %d eigenvectors of a %d dimensional matrix", n, dim);
+    const int k = arrow_pos;
+
+    host::parallel_for(n, [&](int j) {
+      const double *z = evecs.data() + (size_t)dim * j;
+      double *y = vecs + (size_t)dim * j;
+
+      // the arrowhead and the tail are not rotated
+      for (int i = k - 1; i < dim; i++) y[i] = z[i];
+
+      // coordinates of the reduced block in the working basis, whose
+      // slot m > 0 was initialized with element m - 1 of the block
+      std::vector<double> u(k);
+      for (int i = 0; i < k; i++) u[i] = z[k - 1 - i];
+
+      // undo the rotations in reverse order
+      size_t r = rot.size();
+      for (int m = k - 1; m >= 1; m--) {
+        for (int p = m - 2; p >= 0; p--) {
+          const double s = rot[--r];
+          const double c = rot[--r];
+          const int a = p + 1;
+          const double ua = u[a], ub = u[m];
+          u[a] = c * ua - s * ub;
+          u[m] = s * ua + c * ub;
+        }
+      }
+
+      for (int i = 0; i < k - 1; i++) y[i] = u[i + 1];
+    });
+  }
+
+} // namespace quda
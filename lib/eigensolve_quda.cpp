@@ -4,6 +4,7 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <type_traits>
 
 #include <quda_internal.h>
 #include <eigensolve_quda.h>
@@ -11,6 +12,7 @@
 #include <color_spinor_field.h>
 #include <blas_quda.h>
 #include <util_quda.h>
+#include <host_parallel.h>
 
 #include <Eigen/Eigenvalues>
 #include <Eigen/Dense>
@@ -105,6 +107,10 @@ namespace quda
       if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating TR Lanczos eigensolver\n");
       eig_solver = new TRLM(eig_param, mat, profile);
       break;
+    case QUDA_EIG_BLK_TR_LANCZOS:
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating Block TR Lanczos eigensolver\n");
+      eig_solver = new BLKTRLM(eig_param, mat, profile);
+      break;
     default: errorQuda("Invalid eig solver type");
     }
     return eig_solver;
@@ -332,6 +338,99 @@ namespace quda
     }
   }
 
+  /**
+     @brief Bytes of the cache-resident tile of the host rotation: each
+     thread multiplies a tile of sites of all input vectors, stored
+     together with the tile of the output, by the rotation matrix.
+  */
+  constexpr size_t rotate_tile_bytes = 256 * 1024;
+
+  template <typename Float, typename Coeff>
+  static void rotateTiles(std::vector<Float *> &v, size_t length, const Coeff *array, int rank, int n_keep)
+  {
+    using Mat = Matrix<Coeff, Dynamic, Dynamic>;
+    Map<const Mat> rot(array, rank, n_keep);
+
+    // number of elements per tile, rounded to the SIMD width
+    size_t tile = rotate_tile_bytes / ((rank + n_keep) * sizeof(Coeff));
+    tile = std::min(std::max(tile - tile % 16, (size_t)16), length);
+    const int n_tile = (length + tile - 1) / tile;
+
+    host::parallel_for(n_tile, [&](int t) {
+      const size_t begin = t * tile;
+      const size_t size = std::min(tile, length - begin);
+      Mat in(size, rank);
+      for (int i = 0; i < rank; i++)
+        for (size_t k = 0; k < size; k++) in(k, i) = v[i][begin + k];
+
+      // every input of this tile has been read, so it can be overwritten
+      Mat out = in * rot;
+      for (int j = 0; j < n_keep; j++)
+        for (size_t k = 0; k < size; k++) v[j][begin + k] = out(k, j);
+    });
+  }
+
+  template <typename Float, typename Coeff>
+  static void rotateFields(std::vector<ColorSpinorField *> &kSpace, int offset, const Coeff *array, int rank, int n_keep)
+  {
+    ColorSpinorField &v0 = *kSpace[offset];
+    if (v0.FieldOrder() == QUDA_QDPJIT_FIELD_ORDER) errorQuda("Host rotation not supported for QDPJIT field order");
+
+    // a complex rotation acts on the (real, imaginary) pairs of the fields
+    using Element = typename std::conditional<std::is_same<Coeff, Complex>::value, std::complex<Float>, Float>::type;
+    std::vector<Element *> v(rank);
+    for (int i = 0; i < rank; i++) v[i] = static_cast<Element *>(kSpace[offset + i]->V());
+    rotateTiles(v, v0.Length() / (sizeof(Element) / sizeof(Float)), array, rank, n_keep);
+  }
+
+  template <typename Coeff>
+  static void rotateHostFields(std::vector<ColorSpinorField *> &kSpace, int offset, const Coeff *array, int rank, int n_keep)
+  {
+    if (n_keep > rank) errorQuda("Cannot keep %d vectors from a rotation of %d", n_keep, rank);
+    ColorSpinorField &v0 = *kSpace[offset];
+    if (v0.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Host rotation requires host fields");
+
+    switch (v0.Precision()) {
+    case QUDA_DOUBLE_PRECISION: rotateFields<double>(kSpace, offset, array, rank, n_keep); break;
+    case QUDA_SINGLE_PRECISION: rotateFields<float>(kSpace, offset, array, rank, n_keep); break;
+    default: errorQuda("Invalid precision %d", v0.Precision());
+    }
+  }
+
+  void EigenSolver::rotateHost(std::vector<ColorSpinorField *> &kSpace, const double *array, int rank, int n_keep)
+  {
+    rotateHostFields(kSpace, num_locked, array, rank, n_keep);
+  }
+
+  void EigenSolver::rotateHost(std::vector<ColorSpinorField *> &kSpace, const Complex *array, int rank, int n_keep)
+  {
+    rotateHostFields(kSpace, num_locked, array, rank, n_keep);
+  }
+
+  int EigenSolver::rotateBatchSize(const std::vector<ColorSpinorField *> &kSpace, int n_keep) const
+  {
+    if (batched_rotate > 0) return std::min(batched_rotate, n_keep);
+
+    // vectors already allocated beyond the Krylov space are reused
+    const int allocated = std::max((int)kSpace.size() - (nKr + 1), 0);
+
+    // leave a tenth of the device memory for the operator and the blas workspace
+    size_t free_bytes = 0, total_bytes = 0;
+    cudaMemGetInfo(&free_bytes, &total_bytes);
+    const size_t reserve = total_bytes / 10;
+    const size_t vec_bytes = kSpace[0]->Bytes() + kSpace[0]->NormBytes();
+    const int fit = free_bytes > reserve ? (free_bytes - reserve) / vec_bytes : 0;
+
+    // the free memory differs between ranks, but all ranks must batch the rotation the same way
+    double batch = std::max(std::min(allocated + fit, n_keep), 1);
+    comm_allreduce_min(&batch);
+    const int batch_size = static_cast<int>(batch);
+    if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+      printfQuda("Ritz rotation batch size %d (%d allocated, %d fit in %lu free bytes)\n", batch_size, allocated, fit,
+                 free_bytes);
+    return batch_size;
+  }
+
   void EigenSolver::computeSVD(const DiracMatrix &mat, std::vector<ColorSpinorField *> &evecs, std::vector<Complex> &evals)
   {
     if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Computing SVD of M\n");
@@ -1050,11 +1149,6 @@ namespace quda
     profile.TPSTART(QUDA_PROFILE_EIGEN);
     int dim = nKr - num_locked;
 
-    // Eigen objects
-    MatrixXd A = MatrixXd::Zero(dim, dim);
-    ritz_mat.resize(dim * dim);
-    for (int i = 0; i < dim * dim; i++) ritz_mat[i] = 0.0;
-
     // Invert the spectrum due to chebyshev
     if (reverse) {
       for (int i = num_locked; i < nKr - 1; i++) {
@@ -1064,39 +1158,15 @@ namespace quda
       alpha[nKr - 1] *= -1.0;
     }
 
-    // Construct arrow mat A_{dim,dim}
-    for (int i = 0; i < dim; i++) {
-
-      // alpha populates the diagonal
-      A(i, i) = alpha[i + num_locked];
-    }
-
-    for (int i = 0; i < arrow_pos - 1; i++) {
-
-      // beta populates the arrow
-      A(i, arrow_pos - 1) = beta[i + num_locked];
-      A(arrow_pos - 1, i) = beta[i + num_locked];
-    }
-
-    for (int i = arrow_pos - 1; i < dim - 1; i++) {
-
-      // beta populates the sub-diagonal
-      A(i, i + 1) = beta[i + num_locked];
-      A(i + 1, i) = beta[i + num_locked];
-    }
-
-    // Eigensolve the arrow matrix
-    SelfAdjointEigenSolver<MatrixXd> eigensolver;
-    eigensolver.compute(A);
-
-    // repopulate ritz matrix
-    for (int i = 0; i < dim; i++)
-      for (int j = 0; j < dim; j++) ritz_mat[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
+    // Eigensolve the arrow matrix A_{dim,dim}.  Only the eigenvalues
+    // and the last components of the eigenvectors are needed here, the
+    // Ritz vectors that are kept are formed in computeKeptRitz
+    arrow_eigensolver.compute(alpha + num_locked, beta + num_locked, dim, arrow_pos);
 
     for (int i = 0; i < dim; i++) {
-      residua[i + num_locked] = fabs(beta[nKr - 1] * eigensolver.eigenvectors().col(i)[dim - 1]);
+      residua[i + num_locked] = fabs(beta[nKr - 1] * arrow_eigensolver.lastComponent(i));
       // Update the alpha array
-      alpha[i + num_locked] = eigensolver.eigenvalues()[i];
+      alpha[i + num_locked] = arrow_eigensolver.eval(i);
     }
 
     // Put spectrum back in order
@@ -1112,11 +1182,25 @@ namespace quda
     int offset = nKr + 1;
     int dim = nKr - num_locked;
 
+    // Populate the Ritz matrix with the eigenvectors we keep
+    profile.TPSTART(QUDA_PROFILE_EIGEN);
+    ritz_mat.resize(dim * iter_keep);
+    arrow_eigensolver.vectors(ritz_mat.data(), iter_keep);
+    profile.TPSTOP(QUDA_PROFILE_EIGEN);
+
     // Multi-BLAS friendly array to store part of Ritz matrix we want
     double *ritz_mat_keep = (double *)safe_malloc((dim * iter_keep) * sizeof(double));
 
-    // If we have memory availible, do the entire rotation
-    if (batched_rotate <= 0 || batched_rotate >= iter_keep) {
+    // Host fields are rotated in place, otherwise batch the rotation to fit in memory
+    bool host = kSpace[0]->Location() == QUDA_CPU_FIELD_LOCATION;
+    int batch_size = host ? iter_keep : rotateBatchSize(kSpace, iter_keep);
+
+    if (host) {
+      profile.TPSTART(QUDA_PROFILE_COMPUTE);
+      rotateHost(kSpace, ritz_mat.data(), dim, iter_keep);
+      profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    } else if (batch_size >= iter_keep) {
+      // If we have memory availible, do the entire rotation
       if ((int)kSpace.size() < offset + iter_keep) {
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Resizing kSpace to %d vectors\n", offset + iter_keep);
         kSpace.reserve(offset + iter_keep);
@@ -1151,7 +1235,6 @@ namespace quda
     } else {
 
       // Do batched rotation to save on memory
-      int batch_size = batched_rotate;
       int full_batches = iter_keep / batch_size;
       int batch_size_r = iter_keep % batch_size;
       bool do_batch_remainder = (batch_size_r != 0 ? true : false);
@@ -1259,4 +1342,331 @@ namespace quda
 
     host_free(ritz_mat_keep);
   }
+
+  // Block Thick Restarted Lanczos Method constructor
+  BLKTRLM::BLKTRLM(QudaEigParam *eig_param, const DiracMatrix &mat, TimeProfile &profile) :
+    EigenSolver(eig_param, profile),
+    mat(mat),
+    block_size(eig_param->block_size)
+  {
+    bool profile_running = profile.isRunning(QUDA_PROFILE_INIT);
+    if (!profile_running) profile.TPSTART(QUDA_PROFILE_INIT);
+
+    // Block thick restart specific checks
+    if (block_size < 1) errorQuda("Invalid block size %d", block_size);
+    if (nKr % block_size != 0) errorQuda("nKr=%d must be a multiple of the block size %d\n", nKr, block_size);
+    if (nKr < nEv + 2 * block_size)
+      errorQuda("nKr=%d must be greater than nEv+2*block_size=%d\n", nKr, nEv + 2 * block_size);
+
+    if (!(eig_param->spectrum == QUDA_SPECTRUM_LR_EIG || eig_param->spectrum == QUDA_SPECTRUM_SR_EIG)) {
+      errorQuda("Only real spectrum type (LR or SR) can be passed to the Block TR Lanczos solver");
+    }
+
+    // Projected matrix
+    T.resize((size_t)nKr * nKr, 0.0);
+    beta_last.resize(block_size * block_size, 0.0);
+    ritz.resize(nKr, 0.0);
+
+    if (!profile_running) profile.TPSTOP(QUDA_PROFILE_INIT);
+  }
+
+  void BLKTRLM::operator()(std::vector<ColorSpinorField *> &kSpace, std::vector<Complex> &evals)
+  {
+    // Check to see if we are loading eigenvectors
+    if (strcmp(eig_param->vec_infile, "") != 0) {
+      printfQuda("Loading evecs from file name %s\n", eig_param->vec_infile);
+      loadFromFile(mat, kSpace, evals);
+      return;
+    }
+
+    const int b = block_size;
+
+    // Increase Krylov space to nKr+block_size vectors, create the residual block
+    ColorSpinorParam csParamClone(*kSpace[0]);
+    csParam = csParamClone;
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    kSpace.reserve(nKr + b);
+    for (int i = kSpace.size(); i < nKr + b; i++) kSpace.push_back(ColorSpinorField::Create(csParam));
+    for (int i = 0; i < b; i++) r.push_back(ColorSpinorField::Create(csParam));
+    evals.resize(nConv, 0.0);
+
+    // The initial block is the initial guess, if any, completed with random vectors
+    auto random = [](ColorSpinorField &v, int seed) {
+      if (v.Location() == QUDA_CPU_FIELD_LOCATION) {
+        v.Source(QUDA_RANDOM_SOURCE);
+      } else {
+        RNG rng(v, seed);
+        rng.Init();
+        spinorNoise(v, rng, QUDA_NOISE_UNIFORM);
+        rng.Release();
+      }
+    };
+    if (blas::norm2(*kSpace[0]) == 0.0) {
+      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Initial residual is zero. Populating with rands.\n");
+      random(*kSpace[0], 1234);
+    }
+    for (int i = 1; i < b; i++) random(*kSpace[i], 1234 + i);
+
+    // Check for Chebyshev maximum estimation
+    if (eig_param->use_poly_acc && eig_param->a_max <= 0.0) {
+      eig_param->a_max = estimateChebyOpMax(mat, *r[0], *kSpace[nKr]);
+      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Chebyshev maximum estimate: %e.\n", eig_param->a_max);
+    }
+
+    {
+      std::vector<ColorSpinorField *> v0(kSpace.begin(), kSpace.begin() + b);
+      std::vector<Complex> R(b * b);
+      orthonormalizeBlock(v0, r, R.data());
+    }
+
+    // Begin BLKTRLM Eigensolver computation
+    //---------------------------------------------------------------------------
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      printfQuda("********************************\n");
+      printfQuda("**** START BLKTRLM SOLUTION ****\n");
+      printfQuda("********************************\n");
+    }
+
+    // Print Eigensolver params
+    if (getVerbosity() >= QUDA_VERBOSE) {
+      printfQuda("spectrum %s\n", spectrum);
+      printfQuda("tol %.4e\n", tol);
+      printfQuda("nConv %d\n", nConv);
+      printfQuda("nEv %d\n", nEv);
+      printfQuda("nKr %d\n", nKr);
+      printfQuda("block size %d\n", b);
+      if (eig_param->use_poly_acc) {
+        printfQuda("polyDeg %d\n", eig_param->poly_deg);
+        printfQuda("a-min %f\n", eig_param->a_min);
+        printfQuda("a-max %f\n", eig_param->a_max);
+      }
+    }
+
+    double mat_norm = 0.0;
+    Map<MatrixXcd> T_(T.data(), nKr, nKr);
+    Map<MatrixXcd> B(beta_last.data(), b, b);
+
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    // Loop over restart iterations.
+    while (restart_iter < max_restarts && !converged) {
+
+      for (int step = num_keep; step < nKr; step += b) blockLanczosStep(kSpace, step);
+      iter += (nKr - num_keep);
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printfQuda("Restart %d complete\n", restart_iter + 1);
+
+      // Eigendecomposition of the projected matrix, inverted so that
+      // the wanted end of the spectrum comes first
+      profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+      profile.TPSTART(QUDA_PROFILE_EIGEN);
+      MatrixXcd Tm = 0.5 * (T_ + T_.adjoint());
+      if (reverse) Tm = -Tm;
+      SelfAdjointEigenSolver<MatrixXcd> eigensolver(Tm);
+      if (eigensolver.info() != Success) errorQuda("Eigendecomposition of the projected matrix failed");
+      const MatrixXcd &Y = eigensolver.eigenvectors();
+
+      // The residual of Ritz vector i is r_last * beta_last * Y(nKr - b:nKr, i)
+      MatrixXcd S = B * Y.bottomRows(b);
+      for (int i = 0; i < nKr; i++) {
+        ritz[i] = reverse ? -eigensolver.eigenvalues()[i] : eigensolver.eigenvalues()[i];
+        residua[i] = S.col(i).norm();
+        mat_norm = std::max(mat_norm, fabs(ritz[i]));
+      }
+      profile.TPSTOP(QUDA_PROFILE_EIGEN);
+      profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+      // Convergence check
+      num_converged = 0;
+      while (num_converged < nKr && residua[num_converged] < tol * mat_norm) num_converged++;
+
+      if (num_converged >= nConv) {
+        rotateRitz(kSpace, Y.data(), nConv);
+        converged = true;
+      } else {
+        // Keep the converged vectors and half of the others, leaving room for whole blocks
+        num_keep = std::max(num_converged + (nKr - num_converged) / 2, nEv);
+        num_keep = std::min(((num_keep + b - 1) / b) * b, nKr - b);
+        rotateRitz(kSpace, Y.data(), num_keep);
+
+        // The residual block follows the kept Ritz vectors
+        for (int i = 0; i < b; i++) std::swap(kSpace[num_keep + i], kSpace[nKr + i]);
+
+        // The kept Ritz values couple to the residual block through S
+        T_.setZero();
+        for (int i = 0; i < num_keep; i++) T_(i, i) = ritz[i];
+        T_.block(num_keep, 0, b, num_keep) = S.leftCols(num_keep);
+        T_.block(0, num_keep, num_keep, b) = S.leftCols(num_keep).adjoint();
+      }
+
+      if (getVerbosity() >= QUDA_VERBOSE) {
+        printfQuda("%04d converged eigenvalues at restart iter %04d\n", num_converged, restart_iter + 1);
+      }
+
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
+        printfQuda("num_converged = %d\n", num_converged);
+        printfQuda("num_keep = %d\n", num_keep);
+        for (int i = 0; i < nKr; i++) {
+          printfQuda("Ritz[%d] = %.16e residual[%d] = %.16e\n", i, ritz[i], i, residua[i]);
+        }
+      }
+
+      restart_iter++;
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+      printfQuda("kSpace size at convergence/max restarts = %d\n", (int)kSpace.size());
+    // Prune the Krylov space back to size when passed to eigensolver
+    for (unsigned int i = nConv; i < kSpace.size(); i++) { delete kSpace[i]; }
+    kSpace.resize(nConv);
+
+    // Post computation report
+    //---------------------------------------------------------------------------
+    if (!converged) {
+      if (eig_param->require_convergence) {
+        errorQuda("BLKTRLM failed to compute the requested %d vectors with a %d search space, %d Krylov space and "
+                  "block size %d in %d restart steps. Exiting.",
+                  nConv, nEv, nKr, b, max_restarts);
+      } else {
+        warningQuda("BLKTRLM failed to compute the requested %d vectors with a %d search space, %d Krylov space and "
+                    "block size %d in %d restart steps. Continuing with current lanczos factorisation.",
+                    nConv, nEv, nKr, b, max_restarts);
+      }
+    } else {
+      if (getVerbosity() >= QUDA_SUMMARIZE) {
+        printfQuda("BLKTRLM computed the requested %d vectors in %d restart steps and %d OP*x operations.\n", nConv,
+                   restart_iter, iter);
+
+        // Dump all Ritz values and residua
+        for (int i = 0; i < nConv; i++) {
+          printfQuda("RitzValue[%04d]: (%+.16e, %+.16e) residual %.16e\n", i, ritz[i], 0.0, residua[i]);
+        }
+      }
+
+      // Compute eigenvalues
+      computeEvals(mat, kSpace, evals);
+    }
+
+    // Local clean-up
+    for (auto &v : r) delete v;
+    r.clear();
+
+    // Only save if outfile is defined
+    if (strcmp(eig_param->vec_outfile, "") != 0) {
+      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("saving eigenvectors\n");
+      const QudaParity mat_parity = impliedParityFromMatPC(mat.getMatPCType());
+      for (int i = 0; i < nConv; i++) kSpace[i]->setSuggestedParity(mat_parity);
+      saveVectors(kSpace, eig_param->vec_outfile);
+    }
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      printfQuda("********************************\n");
+      printfQuda("***** END BLKTRLM SOLUTION *****\n");
+      printfQuda("********************************\n");
+    }
+
+    mat.flops();
+  }
+
+  // Destructor
+  BLKTRLM::~BLKTRLM() { }
+
+  // Block Thick Restart Member functions
+  //---------------------------------------------------------------------------
+  void BLKTRLM::blockLanczosStep(std::vector<ColorSpinorField *> &v, int j)
+  {
+    const int b = block_size;
+
+    // r_i = A * v_{j+i}
+    for (int i = 0; i < b; i++) chebyOp(mat, *r[i], *v[j + i]);
+
+    // Orthogonalise the block against the Krylov space (CGS2), one
+    // block inner product per pass.  The projections onto the current
+    // block accumulate its diagonal block of the projected matrix.
+    std::vector<ColorSpinorField *> v_(v.begin(), v.begin() + j + b);
+    std::vector<Complex> h((size_t)(j + b) * b);
+    MatrixXcd alpha = MatrixXcd::Zero(b, b);
+    for (int k = 0; k < 2; k++) {
+      // h_li = v_l^dag r_i
+      blas::cDotProduct(h.data(), v_, r);
+      for (int l = 0; l < b; l++)
+        for (int i = 0; i < b; i++) alpha(l, i) += h[(j + l) * b + i];
+
+      // r_i = r_i - sum_l h_li v_l
+      for (auto &h_ : h) h_ = -h_;
+      blas::caxpy(h.data(), v_, r);
+    }
+
+    Map<MatrixXcd> T_(T.data(), nKr, nKr);
+    T_.block(j, j, b, b) = 0.5 * (alpha + alpha.adjoint());
+
+    // v_{j+b} beta = r
+    std::vector<ColorSpinorField *> v_next(v.begin() + j + b, v.begin() + j + 2 * b);
+    std::vector<Complex> R(b * b);
+    orthonormalizeBlock(r, v_next, R.data());
+    for (int i = 0; i < b; i++) std::swap(v[j + b + i], r[i]);
+
+    Map<MatrixXcd> beta(R.data(), b, b);
+    if (j + b < nKr) {
+      T_.block(j + b, j, b, b) = beta;
+      T_.block(j, j + b, b, b) = beta.adjoint();
+    } else {
+      beta_last = R;
+    }
+  }
+
+  void BLKTRLM::orthonormalizeBlock(std::vector<ColorSpinorField *> &in, std::vector<ColorSpinorField *> &out,
+                                    Complex *R)
+  {
+    const int b = in.size();
+    using RowMatrixXcd = Matrix<Complex, Dynamic, Dynamic, RowMajor>;
+    std::vector<Complex> gram(b * b), coeff(b * b);
+    Map<MatrixXcd> R_(R, b, b);
+    R_.setIdentity();
+
+    // the second pass restores the orthogonality lost to the
+    // conditioning of the Gram matrix in the first
+    for (int k = 0; k < 2; k++) {
+      std::vector<ColorSpinorField *> &x = k == 0 ? in : out;
+      std::vector<ColorSpinorField *> &y = k == 0 ? out : in;
+
+      // G_ij = x_i^dag x_j = U^dag U
+      blas::cDotProduct(gram.data(), x, x);
+      LLT<MatrixXcd> cholesky(Map<RowMatrixXcd>(gram.data(), b, b));
+      if (cholesky.info() != Success) errorQuda("Cholesky factorization of a rank deficient block of %d vectors", b);
+      MatrixXcd U = cholesky.matrixU();
+
+      // y = x U^{-1}
+      Map<RowMatrixXcd>(coeff.data(), b, b) = U.triangularView<Upper>().solve(MatrixXcd::Identity(b, b));
+      for (auto &v : y) blas::zero(*v);
+      blas::caxpy(coeff.data(), x, y);
+
+      R_ = (U * R_).eval();
+    }
+  }
+
+  void BLKTRLM::rotateRitz(std::vector<ColorSpinorField *> &kSpace, const Complex *array, int n_keep)
+  {
+    // host fields are rotated in place
+    if (kSpace[0]->Location() == QUDA_CPU_FIELD_LOCATION) {
+      rotateHost(kSpace, array, nKr, n_keep);
+      return;
+    }
+
+    // device fields are rotated into extra vectors beyond the residual block
+    const int offset = nKr + block_size;
+    for (int i = kSpace.size(); i < offset + n_keep; i++) kSpace.push_back(ColorSpinorField::Create(csParam));
+    std::vector<ColorSpinorField *> vecs(kSpace.begin(), kSpace.begin() + nKr);
+    std::vector<ColorSpinorField *> kept(kSpace.begin() + offset, kSpace.begin() + offset + n_keep);
+
+    // MultiBLAS coefficients are row major
+    std::vector<Complex> a((size_t)nKr * n_keep);
+    for (int i = 0; i < nKr; i++)
+      for (int j = 0; j < n_keep; j++) a[i * n_keep + j] = array[(size_t)j * nKr + i];
+
+    for (auto &v : kept) blas::zero(*v);
+    blas::caxpy(a.data(), vecs, kept);
+    for (int j = 0; j < n_keep; j++) std::swap(kSpace[j], kSpace[offset + j]);
+  }
 } // namespace quda
@@ -99,35 +99,32 @@ namespace quda {
   template <typename Float, int length, int nDim, int dim, typename Order, bool extract>
   void extractGhostEx(ExtractGhostExArg<Order,nDim,dim> arg)
   {
-    for (int parity=0; parity<2; parity++) {
-
-      // the following 4-way loop means this is specialized for 4 dimensions 
+    // the faces (parity, dir) and their layers are independent, so
+    // these are spread over the host threads
+    const int R = arg.R[dim];
+    host::parallel_for(2, 2 * R, [&](int parity, int dir_d) {
       // dir = 0 backwards, dir = 1 forwards
-      for (int dir = 0; dir<2; dir++) {
-
-	int D0 = extract ? dir*arg.X[dim] + (1-dir)*arg.R[dim] : dir*(arg.X[dim] + arg.R[dim]); 
-	  
-	for (int d=D0; d<D0+arg.R[dim]; d++) {
-	  for (int a=arg.A0[dim]; a<arg.A1[dim]; a++) { // loop over the interior surface
-	    for (int b=arg.B0[dim]; b<arg.B1[dim]; b++) { // loop over the interior surface
-	      for (int c=arg.C0[dim]; c<arg.C1[dim]; c++) { // loop over the interior surface
-		for (int g=0; g<arg.order.geometry; g++) {
-
-		  // we only do the extraction for parity we are currently working on
-		  int oddness = (a+b+c+d) & 1;
-		  if (oddness == parity) {
-		    if (extract) extractor<Float,length,dim>(arg, dir, a, b, c, d, g, parity);
-		    else injector<Float,length,dim>(arg, dir, a, b, c, d, g, parity);
-		  } // oddness == parity
-		} // g
-	      } // c
-	    } // b
-	  } // a
-	} // d
-      } // dir
-      
-    } // parity
-
+      int dir = dir_d / R;
+      int D0 = extract ? dir*arg.X[dim] + (1-dir)*arg.R[dim] : dir*(arg.X[dim] + arg.R[dim]);
+      int d = D0 + dir_d % R;
+
+      // the following 4-way loop means this is specialized for 4 dimensions
+      for (int a=arg.A0[dim]; a<arg.A1[dim]; a++) { // loop over the interior surface
+        for (int b=arg.B0[dim]; b<arg.B1[dim]; b++) { // loop over the interior surface
+          for (int c=arg.C0[dim]; c<arg.C1[dim]; c++) { // loop over the interior surface
+            for (int g=0; g<arg.order.geometry; g++) {
+
+              // we only do the extraction for parity we are currently working on
+              int oddness = (a+b+c+d) & 1;
+              if (oddness == parity) {
+                if (extract) extractor<Float,length,dim>(arg, dir, a, b, c, d, g, parity);
+                else injector<Float,length,dim>(arg, dir, a, b, c, d, g, parity);
+              } // oddness == parity
+            } // g
+          } // c
+        } // b
+      } // a
+    });
   }
 
   /**
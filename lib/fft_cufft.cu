@@ -0,0 +1,78 @@
+#include <map>
+#include <tuple>
+
+#include <fft_quda.h>
+
+#ifdef GPU_GAUGE_ALG
+#include <cufft.h>
+#endif
+
+/**
+   cuFFT backend of DistributedFFT: batched one-dimensional in-place
+   transforms of contiguous device lines, with the plans cached by
+   length, batch and precision.
+ */
+
+namespace quda
+{
+
+#ifdef GPU_GAUGE_ALG
+
+#define CUFFT_CHECK(call)                                                                                              \
+  do {                                                                                                                 \
+    cufftResult err = call;                                                                                            \
+    if (err != CUFFT_SUCCESS) errorQuda("cuFFT error %d in %s", err, #call);                                          \
+  } while (0)
+
+  class CUFFTBackend : public FFTBackend
+  {
+    using Key = std::tuple<int, int, cufftType>;
+    std::map<Key, cufftHandle> plans;
+
+    cufftHandle &plan(int n, int batch, cufftType type)
+    {
+      auto key = std::make_tuple(n, batch, type);
+      auto it = plans.find(key);
+      if (it != plans.end()) return it->second;
+      cufftHandle &p = plans[key];
+      CUFFT_CHECK(cufftPlanMany(&p, 1, &n, NULL, 1, 0, NULL, 1, 0, type, batch));
+      return p;
+    }
+
+  public:
+    virtual ~CUFFTBackend()
+    {
+      for (auto &p : plans) CUFFT_CHECK(cufftDestroy(p.second));
+    }
+
+    void execute(complex<double> *data, int n, int batch, FFTDirection direction)
+    {
+      auto p = reinterpret_cast<cufftDoubleComplex *>(data);
+      CUFFT_CHECK(cufftExecZ2Z(plan(n, batch, CUFFT_Z2Z), p, p, direction));
+    }
+
+    void execute(complex<float> *data, int n, int batch, FFTDirection direction)
+    {
+      auto p = reinterpret_cast<cufftComplex *>(data);
+      CUFFT_CHECK(cufftExecC2C(plan(n, batch, CUFFT_C2C), p, p, direction));
+    }
+
+    QudaFieldLocation Location() const { return QUDA_CUDA_FIELD_LOCATION; }
+    const char *Name() const { return "cufft"; }
+  };
+
+  FFTBackend *createCUFFTBackend() { return new CUFFTBackend(); }
+
+#else
+
+  FFTBackend *createCUFFTBackend()
+  {
+    errorQuda("cuFFT backend has not been built (GPU_GAUGE_ALG disabled)");
+    return nullptr;
+  }
+
+#endif
+
+#undef CUFFT_CHECK
+
+} // namespace quda
@@ -0,0 +1,245 @@
+#include <map>
+#include <cmath>
+#include <cstring>
+
+#include <fft_quda.h>
+#include <comm_quda.h>
+#include <host_parallel.h>
+
+/**
+   Distributed FFT engine (see fft_quda.h) and its host backend.  The
+   host backend is a recursive mixed-radix decimation-in-time FFT with
+   a generic radix-p butterfly, after the structure of kissfft, so any
+   lattice extent is supported without padding.  The transforms are
+   done in double precision regardless of the field precision.
+ */
+
+namespace quda
+{
+
+  class HostFFT : public FFTBackend
+  {
+    struct Plan {
+      int n;
+      std::vector<int> factors;                // (radix, remaining length) pairs
+      std::vector<complex<double>> twiddle[2]; // exp(-+ 2 pi i k / n) for the forward and inverse transforms
+      int max_radix;
+    };
+
+    std::map<int, Plan> plans;
+
+    const Plan &plan(int n)
+    {
+      auto it = plans.find(n);
+      if (it != plans.end()) return it->second;
+
+      Plan p;
+      p.n = n;
+      p.max_radix = 1;
+      for (int m = n; m > 1;) {
+        int radix = 2;
+        while (m % radix) radix++;
+        m /= radix;
+        p.factors.push_back(radix);
+        p.factors.push_back(m);
+        p.max_radix = std::max(p.max_radix, radix);
+      }
+      for (int s = 0; s < 2; s++) {
+        p.twiddle[s].resize(n);
+        const double sign = s == 0 ? -1.0 : 1.0;
+        for (int k = 0; k < n; k++)
+          p.twiddle[s][k] = complex<double>(cos(2.0 * M_PI * k / n), sign * sin(2.0 * M_PI * k / n));
+      }
+      return plans[n] = p;
+    }
+
+    /**
+       @brief Transform of the sub-sequence in[0], in[fstride], ...
+       into out, recursing over the factors of the length
+    */
+    static void work(complex<double> *out, const complex<double> *in, int fstride, const int *factors,
+                     const complex<double> *twiddle, int n, complex<double> *scratch)
+    {
+      const int p = factors[0];
+      const int m = factors[1];
+
+      if (m == 1) {
+        for (int k = 0; k < p; k++) out[k] = in[k * fstride];
+      } else {
+        for (int q = 0; q < p; q++) work(out + q * m, in + q * fstride, fstride * p, factors + 2, twiddle, n, scratch);
+      }
+
+      // generic radix-p butterfly
+      for (int u = 0; u < m; u++) {
+        for (int q = 0; q < p; q++) scratch[q] = out[u + q * m];
+        for (int q1 = 0; q1 < p; q1++) {
+          const int k = u + q1 * m;
+          complex<double> sum = scratch[0];
+          int t = 0;
+          for (int q = 1; q < p; q++) {
+            t += fstride * k;
+            if (t >= n) t %= n;
+            sum += scratch[q] * twiddle[t];
+          }
+          out[k] = sum;
+        }
+      }
+    }
+
+    template <typename Float> void executeLines(complex<Float> *data, int n, int batch, FFTDirection direction)
+    {
+      if (n == 1) return;
+      const Plan &p = plan(n);
+      const complex<double> *twiddle = p.twiddle[direction == FFT_FORWARD ? 0 : 1].data();
+
+      host::parallel_for(batch, [&](int b) {
+        thread_local std::vector<complex<double>> in, out, scratch;
+        in.resize(n);
+        out.resize(n);
+        scratch.resize(p.max_radix);
+
+        complex<Float> *line = data + static_cast<size_t>(b) * n;
+        for (int i = 0; i < n; i++) in[i] = complex<double>(line[i].real(), line[i].imag());
+        work(out.data(), in.data(), 1, p.factors.data(), twiddle, n, scratch.data());
+        for (int i = 0; i < n; i++) line[i] = complex<Float>(out[i].real(), out[i].imag());
+      });
+    }
+
+  public:
+    void execute(complex<double> *data, int n, int batch, FFTDirection direction)
+    {
+      executeLines(data, n, batch, direction);
+    }
+
+    void execute(complex<float> *data, int n, int batch, FFTDirection direction)
+    {
+      executeLines(data, n, batch, direction);
+    }
+
+    QudaFieldLocation Location() const { return QUDA_CPU_FIELD_LOCATION; }
+    const char *Name() const { return "host"; }
+  };
+
+  FFTBackend *FFTBackend::create(QudaFieldLocation location)
+  {
+    switch (location) {
+    case QUDA_CPU_FIELD_LOCATION: return new HostFFT();
+    case QUDA_CUDA_FIELD_LOCATION: return createCUFFTBackend();
+    default: errorQuda("Unsupported location %d", location);
+    }
+    return nullptr;
+  }
+
+  DistributedFFT::DistributedFFT(const int *X, const bool *dims, FFTBackend *backend) :
+    volume(1),
+    backend(backend ? backend : FFTBackend::create(QUDA_CPU_FIELD_LOCATION)),
+    work_d(nullptr),
+    work_d_bytes(0)
+  {
+    for (int d = 0; d < 4; d++) {
+      this->X[d] = X[d];
+      N[d] = X[d] * comm_dim(d);
+      transform[d] = dims[d];
+      volume *= X[d];
+    }
+  }
+
+  DistributedFFT::~DistributedFFT()
+  {
+    if (work_d) device_free(work_d);
+  }
+
+  template <typename Float>
+  void DistributedFFT::execute(complex<Float> *lines, int n, int batch, FFTDirection direction)
+  {
+    if (backend->Location() == QUDA_CPU_FIELD_LOCATION) {
+      backend->execute(lines, n, batch, direction);
+      return;
+    }
+
+    const size_t bytes = static_cast<size_t>(n) * batch * sizeof(complex<Float>);
+    if (bytes > work_d_bytes) {
+      if (work_d) device_free(work_d);
+      work_d = device_malloc(bytes);
+      work_d_bytes = bytes;
+    }
+    qudaMemcpy(work_d, lines, bytes, cudaMemcpyHostToDevice);
+    backend->execute(static_cast<complex<Float> *>(work_d), n, batch, direction);
+    qudaMemcpy(lines, work_d, bytes, cudaMemcpyDeviceToHost);
+  }
+
+  template <typename Float>
+  void DistributedFFT::transformDim(complex<Float> *data, int nField, int d, FFTDirection direction)
+  {
+    // the field is viewed as lines along d: site (o, x, i) is at i + inner * (x + X[d] * o)
+    size_t inner = 1, outer = 1;
+    for (int e = 0; e < d; e++) inner *= X[e];
+    for (int e = d + 1; e < 4; e++) outer *= X[e];
+    outer *= nField;
+    const size_t M = inner * outer; // number of lines
+    const int Xd = X[d];
+    const int P = comm_dim(d);
+    const int me = comm_coord(d);
+
+    auto site = [=](size_t l, int x) { return (l % inner) + inner * (x + Xd * (l / inner)); };
+
+    if (P == 1) {
+      work.resize(M * Xd * sizeof(complex<Float>));
+      auto lines = reinterpret_cast<complex<Float> *>(work.data());
+      host::parallel_for(static_cast<int>(M), [&](int l) {
+        for (int x = 0; x < Xd; x++) lines[static_cast<size_t>(l) * Xd + x] = data[site(l, x)];
+      });
+      execute(lines, Xd, static_cast<int>(M), direction);
+      host::parallel_for(static_cast<int>(M), [&](int l) {
+        for (int x = 0; x < Xd; x++) data[site(l, x)] = lines[static_cast<size_t>(l) * Xd + x];
+      });
+      return;
+    }
+
+    // block j of the lines is transformed by the process with
+    // coordinate j in d; the last blocks are padded so all blocks,
+    // and hence all messages, have the same size
+    const size_t chunk = (M + P - 1) / P;
+    const size_t block = chunk * Xd;
+    send.resize(P * block * sizeof(complex<Float>));
+    recv.resize(P * block * sizeof(complex<Float>));
+    work.resize(chunk * P * Xd * sizeof(complex<Float>));
+    auto sendbuf = reinterpret_cast<complex<Float> *>(send.data());
+    auto recvbuf = reinterpret_cast<complex<Float> *>(recv.data());
+    auto lines = reinterpret_cast<complex<Float> *>(work.data());
+    const int Nd = P * Xd;
+
+    // transpose: gather the full lines of block me
+    host::parallel_for(static_cast<int>(P * chunk), [&](int i) {
+      const size_t l = i; // line index, block j = l / chunk
+      for (int x = 0; x < Xd; x++) sendbuf[l * Xd + x] = l < M ? data[site(l, x)] : complex<Float>(0.0, 0.0);
+    });
+    comm_alltoall_dim(recvbuf, sendbuf, block * sizeof(complex<Float>), d);
+    host::parallel_for(static_cast<int>(chunk), [&](int l) {
+      for (int j = 0; j < P; j++)
+        for (int x = 0; x < Xd; x++) lines[l * Nd + j * Xd + x] = recvbuf[j * block + l * Xd + x];
+    });
+
+    execute(lines, Nd, static_cast<int>(chunk), direction);
+
+    // and transpose back
+    host::parallel_for(static_cast<int>(chunk), [&](int l) {
+      for (int j = 0; j < P; j++)
+        for (int x = 0; x < Xd; x++) sendbuf[j * block + l * Xd + x] = lines[l * Nd + j * Xd + x];
+    });
+    comm_alltoall_dim(recvbuf, sendbuf, block * sizeof(complex<Float>), d);
+    host::parallel_for(static_cast<int>(M), [&](int l) {
+      for (int x = 0; x < Xd; x++) data[site(l, x)] = recvbuf[static_cast<size_t>(l) * Xd + x];
+    });
+  }
+
+  template <typename Float> void DistributedFFT::operator()(complex<Float> *data, int nField, FFTDirection direction)
+  {
+    for (int d = 0; d < 4; d++)
+      if (transform[d]) transformDim(data, nField, d, direction);
+  }
+
+  template void DistributedFFT::operator()<double>(complex<double> *, int, FFTDirection);
+  template void DistributedFFT::operator()<float>(complex<float> *, int, FFTDirection);
+
+} // namespace quda
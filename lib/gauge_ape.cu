@@ -1,6 +1,7 @@
 #include <quda_internal.h>
 #include <tune_quda.h>
 #include <gauge_field.h>
+#include <gauge_tools.h>
 
 #include <jitify_helper.cuh>
 #include <kernels/gauge_ape.cuh>
@@ -56,6 +57,11 @@ public:
 
   void APEStep(GaugeField &out, GaugeField& in, double alpha) {
 #ifdef GPU_GAUGE_TOOLS
+    if (checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION) {
+      APEStepCPU(out, in, alpha);
+      return;
+    }
+
     checkPrecision(out, in);
     checkReconstruct(out, in);
 
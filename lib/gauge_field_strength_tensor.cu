@@ -1,5 +1,6 @@
 #include <tune_quda.h>
 #include <gauge_field.h>
+#include <gauge_tools.h>
 
 #include <jitify_helper.cuh>
 #include <kernels/field_strength_tensor.cuh>
@@ -60,6 +61,10 @@ public:
   {
 #ifdef GPU_GAUGE_TOOLS
     checkPrecision(f, u);
+    if (checkLocation(f, u) == QUDA_CPU_FIELD_LOCATION) {
+      computeFmunuCPU(f, u);
+      return;
+    }
     instantiate<Fmunu,ReconstructWilson>(u, f); // u must be first here for correct template instantiation
 #else
     errorQuda("Gauge tools are not built");
@@ -1087,7 +1087,7 @@ namespace quda {
 #ifdef GPU_GAUGE_ALG
 #ifdef MULTI_GPU
     if(comm_dim_partitioned(0) || comm_dim_partitioned(1) || comm_dim_partitioned(2) || comm_dim_partitioned(3))
-      errorQuda("Gauge Fixing with FFTs in multi-GPU support NOT implemented yet!\n");
+      errorQuda("Device gauge fixing with FFTs does not support partitioned lattices, use gaugefixingFFTCPU");
 #endif
     if ( data.Precision() == QUDA_HALF_PRECISION ) {
       errorQuda("Half precision not supported\n");
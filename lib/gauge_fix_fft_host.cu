@@ -0,0 +1,368 @@
+#include <vector>
+#include <cmath>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <gauge_field_order.h>
+#include <index_helper.cuh>
+#include <quda_matrix.h>
+#include <comm_quda.h>
+#include <timer.h>
+#include <fft_quda.h>
+#include <host_parallel.h>
+
+/**
+   Host implementation of the Fourier accelerated steepest descent
+   gauge fixing of gauge_fix_fft.cu, which also runs on partitioned
+   lattices.  The algorithm, the normalization of the quality measures
+   and the stopping criteria are those of the device implementation.
+
+   The transforms of the six independent components of Delta are done
+   by DistributedFFT, which redistributes the lines of a partitioned
+   dimension among the processes of that dimension.  The stencils need
+   the backward links, taken from the gauge-field ghost zone, and the
+   forward face of Delta, which is exchanged here before each update.
+ */
+
+namespace quda
+{
+
+  template <typename Float> struct GaugeFixFFTCPU {
+    using G = gauge::FieldOrder<Float, 3, 1, QUDA_QDP_GAUGE_ORDER>;
+    using Cmplx = complex<Float>;
+    using Link = Matrix<Cmplx, 3>;
+
+    GaugeField &data;
+    const int gauge_dir;
+    int X[4];
+    int V;
+    int volumeCB;
+    bool partitioned[4];
+
+    std::vector<Cmplx> delta;       /** six components of Delta, each of the local volume */
+    std::vector<double> invpsq;     /** normalized 1/p^2 */
+    std::vector<Cmplx> face[4];     /** forward face of Delta in each partitioned dimension */
+    std::vector<Cmplx> send[4];
+
+    /**
+       @return Lexicographical index with x running fastest, as used by the FFT
+    */
+    int fullIndex(const int x[4]) const { return ((x[3] * X[2] + x[2]) * X[1] + x[1]) * X[0] + x[0]; }
+
+    /**
+       @return Lexicographical index of x on the face orthogonal to dimension d
+    */
+    int faceIndex(const int x[4], int d) const
+    {
+      int idx = 0;
+      for (int e = 3; e >= 0; e--)
+        if (e != d) idx = idx * X[e] + x[e];
+      return idx;
+    }
+
+    static Link loadLink(const G &g, int d, int x_cb, int parity)
+    {
+      Link U;
+      for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++) U(i, j) = g(d, parity, x_cb, i, j);
+      return U;
+    }
+
+    static Link loadGhostLink(const G &g, int d, int ghost_idx, int parity)
+    {
+      Link U;
+      for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++) U(i, j) = g.Ghost(d, parity, ghost_idx, i, j);
+      return U;
+    }
+
+    static void reunit(Link &U)
+    {
+      Float t1 = 0.0;
+      for (int c = 0; c < 3; c++) t1 += norm(U(0, c));
+      t1 = (Float)1.0 / sqrt(t1);
+      for (int c = 0; c < 3; c++) U(0, c) *= t1;
+
+      Cmplx t2((Float)0.0, (Float)0.0);
+      for (int c = 0; c < 3; c++) t2 += conj(U(0, c)) * U(1, c);
+      for (int c = 0; c < 3; c++) U(1, c) -= t2 * U(0, c);
+
+      t1 = 0.0;
+      for (int c = 0; c < 3; c++) t1 += norm(U(1, c));
+      t1 = (Float)1.0 / sqrt(t1);
+      for (int c = 0; c < 3; c++) U(1, c) *= t1;
+
+      U(2, 0) = conj(U(0, 1) * U(1, 2) - U(0, 2) * U(1, 1));
+      U(2, 1) = conj(U(0, 2) * U(1, 0) - U(0, 0) * U(1, 2));
+      U(2, 2) = conj(U(0, 0) * U(1, 1) - U(0, 1) * U(1, 0));
+    }
+
+    /**
+       @brief The gauge transformation 1 + alpha/2 Delta, projected on SU(3)
+    */
+    static Link transformation(const Cmplx *de, Float half_alpha)
+    {
+      Link D;
+      D(0, 0) = de[0];
+      D(0, 1) = de[1];
+      D(0, 2) = de[2];
+      D(1, 1) = de[3];
+      D(1, 2) = de[4];
+      D(2, 2) = de[5];
+      D(1, 0) = Cmplx(-D(0, 1).real(), D(0, 1).imag());
+      D(2, 0) = Cmplx(-D(0, 2).real(), D(0, 2).imag());
+      D(2, 1) = Cmplx(-D(1, 2).real(), D(1, 2).imag());
+
+      Link g;
+      setIdentity(&g);
+      g += D * half_alpha;
+      reunit(g);
+      return g;
+    }
+
+    GaugeFixFFTCPU(GaugeField &data, int gauge_dir) :
+      data(data),
+      gauge_dir(gauge_dir == 3 ? 3 : 4),
+      V(data.Volume()),
+      volumeCB(data.VolumeCB()),
+      delta(6 * data.Volume()),
+      invpsq(data.Volume())
+    {
+      for (int d = 0; d < 4; d++) {
+        X[d] = data.X()[d];
+        partitioned[d] = comm_dim_partitioned(d);
+        if (partitioned[d]) {
+          if (data.GhostExchange() != QUDA_GHOST_EXCHANGE_PAD)
+            errorQuda("Host gauge fixing requires the gauge-field ghost zone in partitioned dimension %d", d);
+          face[d].resize(6 * V / X[d]);
+          send[d].resize(6 * V / X[d]);
+        }
+      }
+
+      // pmax^2 / p^2 with the normalization of the forward and inverse transforms
+      double global_volume = 1.0;
+      for (int d = 0; d < 4; d++) global_volume *= X[d] * comm_dim(d);
+      host::parallel_for(2, volumeCB, [&](int parity, int x_cb) {
+        int x[4];
+        getCoords(x, x_cb, X, parity);
+        double sinsq = 0.0;
+        for (int d = 0; d < 4; d++) {
+          double s = sin((comm_coord(d) * X[d] + x[d]) * M_PI / (X[d] * comm_dim(d)));
+          sinsq += s * s;
+        }
+        invpsq[fullIndex(x)] = sinsq > 0.00001 ? 4.0 / (sinsq * global_volume) : 0.0;
+      });
+    }
+
+    /**
+       @brief Compute Delta and the quality measures of the current field
+       @return The gauge functional (x) and theta (y)
+    */
+    double2 quality()
+    {
+      bool comms = false;
+      for (int d = 0; d < 4; d++) comms = comms || partitioned[d];
+      if (comms) data.exchangeGhost(QUDA_LINK_BACKWARDS);
+
+      G g(data);
+      double2 q = host::parallel_reduce(
+        2, volumeCB, make_double2(0.0, 0.0),
+        [&](int parity, int x_cb) {
+          int x[4];
+          getCoords(x, x_cb, X, parity);
+          Link D;
+          setZero(&D);
+          for (int mu = 0; mu < gauge_dir; mu++) D -= loadLink(g, mu, x_cb, parity);
+          double2 r = make_double2(-D(0, 0).real() - D(1, 1).real() - D(2, 2).real(), 0.0);
+
+          for (int mu = 0; mu < gauge_dir; mu++) {
+            if (partitioned[mu] && x[mu] == 0) {
+              int y[4] = {x[0], x[1], x[2], x[3]};
+              y[mu] = 0; // depth into the halo
+              D += loadGhostLink(g, mu, ghostFaceIndex<0>(y, X, mu, 1), 1 - parity);
+            } else {
+              D += loadLink(g, mu, linkIndexM1(x, X, mu), 1 - parity);
+            }
+          }
+          D -= conj(D);
+          SubTraceUnit(D);
+
+          const int idx = fullIndex(x);
+          delta[idx + 0 * V] = D(0, 0);
+          delta[idx + 1 * V] = D(0, 1);
+          delta[idx + 2 * V] = D(0, 2);
+          delta[idx + 3 * V] = D(1, 1);
+          delta[idx + 4 * V] = D(1, 2);
+          delta[idx + 5 * V] = D(2, 2);
+          r.y = getRealTraceUVdagger(D, D);
+          return r;
+        },
+        host::plus<double2>());
+
+      comm_allreduce_array((double *)&q, 2);
+      q.x /= 3.0 * gauge_dir * V * comm_size();
+      q.y /= 3.0 * V * comm_size();
+      return q;
+    }
+
+    /**
+       @brief Exchange the x_d = 0 face of Delta with the backward
+       neighbor, so each process holds the face beyond its forward boundary
+    */
+    void exchangeFace(int d)
+    {
+      const size_t faceVolume = V / X[d];
+      host::parallel_for(static_cast<int>(faceVolume), [&](int f) {
+        int x[4];
+        for (int e = 0, r = f; e < 4; e++) {
+          if (e == d) {
+            x[e] = 0;
+          } else {
+            x[e] = r % X[e];
+            r /= X[e];
+          }
+        }
+        for (int k = 0; k < 6; k++) send[d][6 * f + k] = delta[fullIndex(x) + k * V];
+      });
+
+      const size_t bytes = send[d].size() * sizeof(Cmplx);
+      MsgHandle *mh_recv = comm_declare_receive_relative(face[d].data(), d, +1, bytes);
+      MsgHandle *mh_send = comm_declare_send_relative(send[d].data(), d, -1, bytes);
+      comm_start(mh_recv);
+      comm_start(mh_send);
+      comm_wait(mh_send);
+      comm_wait(mh_recv);
+      comm_free(mh_send);
+      comm_free(mh_recv);
+    }
+
+    /**
+       @brief U_mu(x) -> g(x) U_mu(x) g(x+mu)^dagger
+    */
+    void update(Float half_alpha)
+    {
+      for (int d = 0; d < 4; d++)
+        if (partitioned[d]) exchangeFace(d);
+
+      G g(data);
+      host::parallel_for(2, volumeCB, [&](int parity, int x_cb) {
+        int x[4];
+        getCoords(x, x_cb, X, parity);
+        Cmplx de[6];
+        int idx = fullIndex(x);
+        for (int k = 0; k < 6; k++) de[k] = delta[idx + k * V];
+        const Link gx = transformation(de, half_alpha);
+
+        for (int mu = 0; mu < 4; mu++) {
+          if (partitioned[mu] && x[mu] == X[mu] - 1) {
+            const Cmplx *f = face[mu].data() + 6 * faceIndex(x, mu);
+            for (int k = 0; k < 6; k++) de[k] = f[k];
+          } else {
+            idx = linkNormalIndexP1(x, X, mu);
+            for (int k = 0; k < 6; k++) de[k] = delta[idx + k * V];
+          }
+          const Link gy = transformation(de, half_alpha);
+
+          Link U = gx * loadLink(g, mu, x_cb, parity) * conj(gy);
+          for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++) g(mu, parity, x_cb, i, j) = U(i, j);
+        }
+      });
+    }
+
+    double run(int Nsteps, int verbose_interval, Float alpha, int autotune, double tolerance, int stopWtheta)
+    {
+      Timer timer;
+      timer.Start(__func__, __FILE__, __LINE__);
+
+      printfQuda("\tAlpha parameter of the Steepest Descent Method: %e\n", (double)alpha);
+      printfQuda("\tAuto tune active: %s\n", autotune ? "yes" : "no");
+      printfQuda("\tStop criterium: %e\n", tolerance);
+      printfQuda("\tStop criterium method: %s\n", stopWtheta ? "theta" : "Delta");
+      printfQuda("\tMaximum number of iterations: %d\n", Nsteps);
+      printfQuda("\tPrint convergence results at every %d steps\n", verbose_interval);
+
+      bool dims[4] = {true, true, true, true};
+      DistributedFFT fft(X, dims);
+
+      double2 q = quality();
+      double action0 = q.x;
+      printfQuda("Step: %d\tAction: %.16e\ttheta: %.16e\n", 0, q.x, q.y);
+
+      double diff = 0.0;
+      int iter = 0;
+      for (iter = 0; iter < Nsteps; iter++) {
+        fft(delta.data(), 6, FFT_FORWARD);
+        host::parallel_for(V, [&](int i) {
+          for (int k = 0; k < 6; k++) delta[i + k * V] *= (Float)invpsq[i];
+        });
+        fft(delta.data(), 6, FFT_INVERSE);
+
+        update(0.5 * alpha);
+
+        q = quality();
+        double action = q.x;
+        diff = std::abs(action0 - action);
+        if ((iter % verbose_interval) == (verbose_interval - 1))
+          printfQuda("Step: %d\tAction: %.16e\ttheta: %.16e\tDelta: %.16e\n", iter + 1, q.x, q.y, diff);
+        if (autotune && ((action - action0) < -1e-14)) {
+          if (alpha > 0.01) {
+            alpha = 0.95 * alpha;
+            printfQuda(">>>>>>>>>>>>>> Warning: changing alpha down -> %.4e\n", (double)alpha);
+          }
+        }
+        if (stopWtheta) {
+          if (q.y < tolerance) break;
+        } else {
+          if (diff < tolerance) break;
+        }
+        action0 = action;
+      }
+      if ((iter % verbose_interval) != 0)
+        printfQuda("Step: %d\tAction: %.16e\ttheta: %.16e\tDelta: %.16e\n", iter, q.x, q.y, diff);
+
+      // reunitarize at the end
+      int fails = projectSU3CPU(data, sizeof(Float) == sizeof(double) ? 1e-14 : 1e-6);
+      comm_allreduce_int(&fails);
+      if (fails > 0) errorQuda("Error in the unitarization: %d failures", fails);
+
+      timer.Stop(__func__, __FILE__, __LINE__);
+      if (getVerbosity() > QUDA_SUMMARIZE)
+        printfQuda("Time: %6.6f s (%d steps, FFT backend %s)\n", timer.Last(), iter, fft.BackendName());
+
+      return q.y;
+    }
+  };
+
+  double gaugefixingFFTCPU(GaugeField &data, int gauge_dir, int Nsteps, int verbose_interval, double alpha,
+                           int autotune, double tolerance, int stopWtheta)
+  {
+    if (data.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Host gauge fixing requires a host field");
+    if (data.Order() != QUDA_QDP_GAUGE_ORDER) errorQuda("Unsupported gauge order %d for host gauge fixing", data.Order());
+    if (data.Reconstruct() != QUDA_RECONSTRUCT_NO)
+      errorQuda("Unsupported reconstruct %d for host gauge fixing", data.Reconstruct());
+    if (data.Ncolor() != 3) errorQuda("Unsupported number of colors %d for host gauge fixing", data.Ncolor());
+    if (verbose_interval <= 0) errorQuda("Invalid verbose interval %d", verbose_interval);
+
+    if (data.Precision() == QUDA_DOUBLE_PRECISION) {
+#if QUDA_PRECISION & 8
+      return GaugeFixFFTCPU<double>(data, gauge_dir)
+        .run(Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+#else
+      errorQuda("QUDA_PRECISION=%d does not enable double precision", QUDA_PRECISION);
+#endif
+    } else if (data.Precision() == QUDA_SINGLE_PRECISION) {
+#if QUDA_PRECISION & 4
+      return GaugeFixFFTCPU<float>(data, gauge_dir)
+        .run(Nsteps, verbose_interval, (float)alpha, autotune, tolerance, stopWtheta);
+#else
+      errorQuda("QUDA_PRECISION=%d does not enable single precision", QUDA_PRECISION);
+#endif
+    } else {
+      errorQuda("Precision %d not supported", data.Precision());
+    }
+    return 0.0;
+  }
+
+} // namespace quda
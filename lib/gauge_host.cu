@@ -0,0 +1,738 @@
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <gauge_update_quda.h>
+#include <momentum.h>
+#include <tune_quda.h>
+#include <gauge_field_order.h>
+#include <index_helper.cuh>
+#include <kernels/gauge_ape.cuh>
+#include <kernels/gauge_stout.cuh>
+#include <kernels/gauge_wilson_flow.cuh>
+#include <kernels/gauge_plaq.cuh>
+#include <kernels/field_strength_tensor.cuh>
+#include <kernels/gauge_qcharge.cuh>
+#include <kernels/gauge_observables.cuh>
+#include <host_parallel.h>
+#include <host_su3.h>
+
+/**
+   Host implementations of the APE, stout and over-improved stout
+   smearing, the Wilson flow, and of the gauge observables (plaquette,
+   field strength, field energy and topological charge).  These are
+   called by the public gauge tools when the fields reside on the host,
+   so that smearing and measurement can be run on cpuGaugeFields.
+
+   The site updates are the __host__ __device__ cores of the device
+   kernels (include/kernels/gauge_*.cuh), instantiated with QDP-ordered
+   accessors, so a host and a device application agree to rounding.
+   As on the device, the smeared fields must be extended, with the
+   halo of depth R filled by exchangeExtendedGhost; with R = 0 the
+   stencils wrap periodically, which is only valid when no dimension
+   is partitioned.
+
+   The fused observables (computeGaugeObservablesCPU) use the same
+   single-sweep core as the device, forming the clover-leaf field
+   strength at each site on the fly rather than storing Fmunu.
+
+   The HMC link update and momentum action work on MILC or QDP ordered
+   fields in place, with the ten-real momentum layout of the device,
+   so an integrator can be run on the host fields of the interface
+   without reordering them.  The link update runs on tiles of links
+   with the batched SU(3) kernels of host_su3.h.
+ */
+
+namespace quda
+{
+
+  /**
+     @brief Host site loop shared by the smearing routines.  Op is a
+     functor acting on (parity, x_cb) of the interior of the extended
+     field.  The chunk size of the schedule is autotuned.
+  */
+  template <typename Op> class GaugeCPU : public Tunable
+  {
+    Op &op;
+    const GaugeField &meta;
+    const std::vector<GaugeField *> out; /** fields written by op, backed up while tuning */
+    const int volumeCB;
+    const long long flops_;
+    const long long bytes_;
+
+    unsigned int sharedBytesPerThread() const { return 0; }
+    unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+    bool tuneGridDim() const { return false; }
+    unsigned int minThreads() const { return 2 * volumeCB; }
+
+  public:
+    GaugeCPU(Op &op, const GaugeField &meta, const std::vector<GaugeField *> &out, int volumeCB, const char *aux_,
+             long long flops, long long bytes) :
+      op(op),
+      meta(meta),
+      out(out),
+      volumeCB(volumeCB),
+      flops_(flops),
+      bytes_(bytes)
+    {
+      strcpy(aux, meta.AuxString());
+      strcat(aux, comm_dim_partitioned_string());
+      strcat(aux, aux_);
+    }
+
+    void apply(const cudaStream_t &stream)
+    {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      host::parallel_for(2, volumeCB, op, tp.block.x);
+    }
+
+    bool tuneHostChunk() const { return true; }
+    TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(op).name(), aux); }
+
+    void preTune()
+    {
+      for (auto f : out) dynamic_cast<cpuGaugeField &>(*f).backup();
+    }
+    void postTune()
+    {
+      for (auto f : out) dynamic_cast<cpuGaugeField &>(*f).restore();
+    }
+
+    long long flops() const { return flops_; }
+    long long bytes() const { return bytes_; }
+  };
+
+  /**
+     @brief Check that a field can be used by the host gauge tools
+  */
+  static void checkHostField(const GaugeField &u)
+  {
+    if (u.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Host gauge tools require host fields");
+    if (u.Order() != QUDA_QDP_GAUGE_ORDER) errorQuda("Unsupported gauge order %d for host gauge tools", u.Order());
+    if (u.Reconstruct() != QUDA_RECONSTRUCT_NO)
+      errorQuda("Unsupported reconstruct %d for host gauge tools", u.Reconstruct());
+    if (u.Ncolor() != 3) errorQuda("Unsupported number of colors %d for host gauge tools", u.Ncolor());
+  }
+
+  /**
+     @brief Instantiate Apply<Float> for the precision of the field
+  */
+  template <template <typename> class Apply, typename... Args>
+  static void instantiateCPU(const GaugeField &u, Args &&... args)
+  {
+    if (u.Precision() == QUDA_DOUBLE_PRECISION) {
+#if QUDA_PRECISION & 8
+      Apply<double>(args...);
+#else
+      errorQuda("QUDA_PRECISION=%d does not enable double precision", QUDA_PRECISION);
+#endif
+    } else if (u.Precision() == QUDA_SINGLE_PRECISION) {
+#if QUDA_PRECISION & 4
+      Apply<float>(args...);
+#else
+      errorQuda("QUDA_PRECISION=%d does not enable single precision", QUDA_PRECISION);
+#endif
+    } else {
+      errorQuda("Unsupported precision %d for host gauge tools", u.Precision());
+    }
+  }
+
+  /**
+     @return Bytes of a link of the given precision
+  */
+  template <typename Float> constexpr long long linkBytes() { return 18 * sizeof(Float); }
+
+  template <typename Arg> struct APECPU {
+    Arg &arg;
+    APECPU(Arg &arg) : arg(arg) {}
+
+    void operator()(int parity, int x_cb) const
+    {
+      for (int dir = 0; dir < Arg::apeDim; dir++) computeAPEStepCore(arg, x_cb, parity, dir);
+    }
+  };
+
+  template <typename Float> struct APECPUApply {
+    APECPUApply(GaugeField &out, const GaugeField &in, double alpha)
+    {
+      constexpr int apeDim = 3; // apply APE in space only
+      GaugeAPEArg<Float, 3, QUDA_RECONSTRUCT_NO, apeDim, QUDA_QDP_GAUGE_ORDER> arg(out, in, alpha);
+      APECPU<decltype(arg)> op(arg);
+      GaugeCPU<decltype(op)> ape(op, in, {&out}, arg.threads, ",APE", 2ll * apeDim * (2 + 2 * 4) * 198 * arg.threads,
+                                 2ll * apeDim * (1 + 6 * apeDim + 1) * linkBytes<Float>() * arg.threads);
+      ape.apply(0);
+    }
+  };
+
+  void APEStepCPU(GaugeField &out, GaugeField &in, double alpha)
+  {
+    checkHostField(out);
+    checkHostField(in);
+    checkPrecision(out, in);
+
+    copyExtendedGauge(in, out, QUDA_CPU_FIELD_LOCATION);
+    in.exchangeExtendedGhost(in.R(), false);
+    instantiateCPU<APECPUApply>(in, out, in, alpha);
+    out.exchangeExtendedGhost(out.R(), false);
+  }
+
+  template <typename Arg> struct STOUTCPU {
+    Arg &arg;
+    STOUTCPU(Arg &arg) : arg(arg) {}
+
+    void operator()(int parity, int x_cb) const
+    {
+      for (int dir = 0; dir < Arg::stoutDim; dir++) computeSTOUTStepCore(arg, x_cb, parity, dir);
+    }
+  };
+
+  template <typename Float> struct STOUTCPUApply {
+    STOUTCPUApply(GaugeField &out, const GaugeField &in, double rho)
+    {
+      constexpr int stoutDim = 3; // apply stouting in space only
+      GaugeSTOUTArg<Float, 3, QUDA_RECONSTRUCT_NO, stoutDim, QUDA_QDP_GAUGE_ORDER> arg(out, in, rho);
+      STOUTCPU<decltype(arg)> op(arg);
+      GaugeCPU<decltype(op)> stout(op, in, {&out}, arg.threads, ",STOUT",
+                                   2ll * stoutDim * (2 + 2 * 4) * 198 * arg.threads,
+                                   2ll * stoutDim * (1 + 6 * stoutDim + 1) * linkBytes<Float>() * arg.threads);
+      stout.apply(0);
+    }
+  };
+
+  void STOUTStepCPU(GaugeField &out, GaugeField &in, double rho)
+  {
+    checkHostField(out);
+    checkHostField(in);
+    checkPrecision(out, in);
+
+    copyExtendedGauge(in, out, QUDA_CPU_FIELD_LOCATION);
+    in.exchangeExtendedGhost(in.R(), false);
+    instantiateCPU<STOUTCPUApply>(in, out, in, rho);
+    out.exchangeExtendedGhost(out.R(), false);
+  }
+
+  template <typename Arg> struct OvrImpSTOUTCPU {
+    Arg &arg;
+    OvrImpSTOUTCPU(Arg &arg) : arg(arg) {}
+
+    void operator()(int parity, int x_cb) const
+    {
+      for (int dir = 0; dir < Arg::stoutDim; dir++) computeOvrImpSTOUTStepCore(arg, x_cb, parity, dir);
+    }
+  };
+
+  template <typename Float> struct OvrImpSTOUTCPUApply {
+    OvrImpSTOUTCPUApply(GaugeField &out, const GaugeField &in, double rho, double epsilon)
+    {
+      constexpr int stoutDim = 4; // over-improved stouting in all dims
+      GaugeSTOUTArg<Float, 3, QUDA_RECONSTRUCT_NO, stoutDim, QUDA_QDP_GAUGE_ORDER> arg(out, in, rho, epsilon);
+      OvrImpSTOUTCPU<decltype(arg)> op(arg);
+      GaugeCPU<decltype(op)> stout(op, in, {&out}, arg.threads, ",OvrImpSTOUT",
+                                   2ll * stoutDim * (18 + 2 + 2 * 4) * 198 * arg.threads,
+                                   2ll * stoutDim * (1 + 24 * (stoutDim - 1) + 1) * linkBytes<Float>() * arg.threads);
+      stout.apply(0);
+    }
+  };
+
+  void OvrImpSTOUTStepCPU(GaugeField &out, GaugeField &in, double rho, double epsilon)
+  {
+    checkHostField(out);
+    checkHostField(in);
+    checkPrecision(out, in);
+
+    copyExtendedGauge(in, out, QUDA_CPU_FIELD_LOCATION);
+    in.exchangeExtendedGhost(in.R(), false);
+    instantiateCPU<OvrImpSTOUTCPUApply>(in, out, in, rho, epsilon);
+    out.exchangeExtendedGhost(out.R(), false);
+  }
+
+  template <QudaWFlowType wflow_type, WFlowStepType step_type, typename Arg> struct WFlowCPU {
+    Arg &arg;
+    WFlowCPU(Arg &arg) : arg(arg) {}
+
+    void operator()(int parity, int x_cb) const
+    {
+      for (int dir = 0; dir < Arg::wflow_dim; dir++) computeWFlowStepCore<wflow_type, step_type>(arg, x_cb, parity, dir);
+    }
+  };
+
+  template <QudaWFlowType wflow_type, WFlowStepType step_type, typename Arg>
+  static void wflowStepCPU(Arg &arg, const GaugeField &in, const std::vector<GaugeField *> &out, const char *aux)
+  {
+    constexpr long long mat_flops = 3 * 3 * (8 * 3 - 2);
+    constexpr long long mat_muls = 1 + (wflow_type == QUDA_WFLOW_TYPE_WILSON ? 4 : 28) * (Arg::wflow_dim - 1);
+    constexpr long long links = wflow_type == QUDA_WFLOW_TYPE_WILSON ? 6 : 24;
+    using Float = typename Arg::Float;
+
+    WFlowCPU<wflow_type, step_type, Arg> op(arg);
+    GaugeCPU<decltype(op)> wflow(op, in, out, arg.threads, aux, 2ll * arg.threads * Arg::wflow_dim * mat_muls * mat_flops,
+                                 2ll * arg.threads * Arg::wflow_dim * (1 + (Arg::wflow_dim - 1) * links + 2)
+                                   * linkBytes<Float>());
+    wflow.apply(0);
+  }
+
+  template <typename Float> struct WFlowCPUApply {
+    WFlowCPUApply(GaugeField &out, GaugeField &temp, GaugeField *err, const GaugeField &in, double epsilon,
+                  QudaWFlowType wflow_type, WFlowStepType step_type)
+    {
+      constexpr int wflow_dim = 4; // apply flow in all dims
+      GaugeWFlowArg<Float, 3, QUDA_RECONSTRUCT_NO, wflow_dim, QUDA_QDP_GAUGE_ORDER> arg(out, temp, err, in, epsilon,
+                                                                                         wflow_type, step_type);
+      std::vector<GaugeField *> fields = {&out, &temp};
+      if (err) fields.push_back(err);
+
+      switch (wflow_type) {
+      case QUDA_WFLOW_TYPE_WILSON:
+        switch (step_type) {
+        case WFLOW_STEP_W1: wflowStepCPU<QUDA_WFLOW_TYPE_WILSON, WFLOW_STEP_W1>(arg, in, fields, ",WilsonW1"); break;
+        case WFLOW_STEP_W2: wflowStepCPU<QUDA_WFLOW_TYPE_WILSON, WFLOW_STEP_W2>(arg, in, fields, ",WilsonW2"); break;
+        case WFLOW_STEP_VT: wflowStepCPU<QUDA_WFLOW_TYPE_WILSON, WFLOW_STEP_VT>(arg, in, fields, ",WilsonVT"); break;
+        }
+        break;
+      case QUDA_WFLOW_TYPE_SYMANZIK:
+        switch (step_type) {
+        case WFLOW_STEP_W1: wflowStepCPU<QUDA_WFLOW_TYPE_SYMANZIK, WFLOW_STEP_W1>(arg, in, fields, ",SymanzikW1"); break;
+        case WFLOW_STEP_W2: wflowStepCPU<QUDA_WFLOW_TYPE_SYMANZIK, WFLOW_STEP_W2>(arg, in, fields, ",SymanzikW2"); break;
+        case WFLOW_STEP_VT: wflowStepCPU<QUDA_WFLOW_TYPE_SYMANZIK, WFLOW_STEP_VT>(arg, in, fields, ",SymanzikVT"); break;
+        }
+        break;
+      default: errorQuda("Unknown Wilson Flow type %d", wflow_type);
+      }
+    }
+  };
+
+  void WFlowStepCPU(GaugeField &out, GaugeField &mid, GaugeField &temp, GaugeField *err, const GaugeField &in,
+                    double epsilon, QudaWFlowType wflow_type)
+  {
+    checkHostField(out);
+    checkHostField(mid);
+    checkHostField(temp);
+    checkHostField(in);
+    if (err) checkHostField(*err);
+
+    // Step W1
+    instantiateCPU<WFlowCPUApply>(in, out, temp, err, in, epsilon, wflow_type, WFLOW_STEP_W1);
+    out.exchangeExtendedGhost(out.R(), false);
+
+    // Step W2
+    instantiateCPU<WFlowCPUApply>(in, mid, temp, err, out, epsilon, wflow_type, WFLOW_STEP_W2);
+    mid.exchangeExtendedGhost(mid.R(), false);
+
+    // Step Vt
+    instantiateCPU<WFlowCPUApply>(in, out, temp, err, mid, epsilon, wflow_type, WFLOW_STEP_VT);
+    out.exchangeExtendedGhost(out.R(), false);
+  }
+
+  template <typename Float> struct PlaquetteCPUApply {
+    PlaquetteCPUApply(const GaugeField &U, double2 &plaq)
+    {
+      GaugePlaqArg<Float, 3, QUDA_RECONSTRUCT_NO, QUDA_QDP_GAUGE_ORDER> arg(U);
+      plaq = host::parallel_reduce(
+        2, arg.threads, make_double2(0.0, 0.0),
+        [&](int parity, int x_cb) {
+          int x[4];
+          getCoords(x, x_cb, arg.X, parity);
+          for (int dr = 0; dr < 4; ++dr) x[dr] += arg.border[dr]; // extended grid coordinates
+
+          double2 p = make_double2(0.0, 0.0);
+          for (int mu = 0; mu < 3; mu++) {
+            for (int nu = (mu + 1); nu < 3; nu++) p.x += plaquette(arg, x, parity, mu, nu);
+            p.y += plaquette(arg, x, parity, mu, 3);
+          }
+          return p;
+        },
+        [](const double2 &a, const double2 &b) { return a + b; });
+
+      comm_allreduce_array((double *)&plaq, 2);
+      plaq.x /= 9. * 2 * arg.threads * comm_size();
+      plaq.y /= 9. * 2 * arg.threads * comm_size();
+    }
+  };
+
+  double3 plaquetteCPU(const GaugeField &U)
+  {
+    checkHostField(U);
+    double2 plq;
+    instantiateCPU<PlaquetteCPUApply>(U, U, plq);
+    return make_double3(0.5 * (plq.x + plq.y), plq.x, plq.y);
+  }
+
+  template <typename Arg> struct FmunuCPU {
+    Arg &arg;
+    FmunuCPU(Arg &arg) : arg(arg) {}
+
+    void operator()(int parity, int x_cb) const
+    {
+      // F[1,0], F[2,0], F[2,1], F[3,0], F[3,1], F[3,2]
+      computeFmunuCore<1, 0>(arg, x_cb, parity);
+      computeFmunuCore<2, 0>(arg, x_cb, parity);
+      computeFmunuCore<2, 1>(arg, x_cb, parity);
+      computeFmunuCore<3, 0>(arg, x_cb, parity);
+      computeFmunuCore<3, 1>(arg, x_cb, parity);
+      computeFmunuCore<3, 2>(arg, x_cb, parity);
+    }
+  };
+
+  template <typename Float> struct FmunuCPUApply {
+    FmunuCPUApply(GaugeField &Fmunu, const GaugeField &u)
+    {
+      FmunuArg<Float, 3, QUDA_RECONSTRUCT_NO, QUDA_QDP_GAUGE_ORDER> arg(Fmunu, u);
+      FmunuCPU<decltype(arg)> op(arg);
+      GaugeCPU<decltype(op)> fmunu(op, u, {&Fmunu}, arg.threads, ",Fmunu", 2ll * arg.threads * 6 * (2430 + 36),
+                                   2ll * arg.threads * 6 * (16 + 1) * linkBytes<Float>());
+      fmunu.apply(0);
+    }
+  };
+
+  void computeFmunuCPU(GaugeField &Fmunu, const GaugeField &u)
+  {
+    checkHostField(Fmunu);
+    checkHostField(u);
+    checkPrecision(Fmunu, u);
+    if (Fmunu.Geometry() != QUDA_TENSOR_GEOMETRY) errorQuda("Fmunu field must have tensor geometry");
+    instantiateCPU<FmunuCPUApply>(u, Fmunu, u);
+  }
+
+  template <typename Float> struct QChargeCPUApply {
+    QChargeCPUApply(const GaugeField &Fmunu, double energy[3], double &qcharge, void *qdensity)
+    {
+      using Link = Matrix<complex<Float>, 3>;
+      QChargeArg<Float, 3, QUDA_RECONSTRUCT_NO, false, QUDA_QDP_GAUGE_ORDER> arg(Fmunu);
+      Float *density = static_cast<Float *>(qdensity);
+
+      double3 E = host::parallel_reduce(
+        2, arg.threads, make_double3(0.0, 0.0, 0.0),
+        [&](int parity, int x_cb) {
+          Link F[6];
+          for (int i = 0; i < 6; i++) F[i] = arg.f(i, x_cb, parity);
+          double3 E_idx = qChargeCore<Float, 3>(F);
+          if (density) density[x_cb + parity * arg.threads] = E_idx.z;
+          return E_idx;
+        },
+        [](const double3 &a, const double3 &b) { return a + b; });
+
+      comm_allreduce_array((double *)&E, 3);
+      energy[1] = E.x / (2.0 * arg.threads * comm_size());
+      energy[2] = E.y / (2.0 * arg.threads * comm_size());
+      energy[0] = energy[1] + energy[2];
+      qcharge = E.z;
+    }
+  };
+
+  void computeQChargeCPU(double energy[3], double &qcharge, void *qdensity, const GaugeField &Fmunu)
+  {
+    checkHostField(Fmunu);
+    instantiateCPU<QChargeCPUApply>(Fmunu, Fmunu, energy, qcharge, qdensity);
+  }
+
+  template <typename Float> struct ProjectSU3CPUApply {
+    ProjectSU3CPUApply(GaugeField &U, double tol, int &fails)
+    {
+      using Link = Matrix<complex<Float>, 3>;
+      typename gauge_mapper<Float, QUDA_RECONSTRUCT_NO, 18, QUDA_STAGGERED_PHASE_NO, gauge::default_huge_alloc,
+                            QUDA_GHOST_EXCHANGE_INVALID, false, QUDA_QDP_GAUGE_ORDER>::type u(U);
+      const Float tol_ = tol;
+
+      fails = host::parallel_reduce(
+        2, U.VolumeCB(), 0,
+        [&](int parity, int x_cb) {
+          int f = 0;
+          for (int mu = 0; mu < 4; mu++) {
+            Link v = u(mu, x_cb, parity);
+            polarSu3<Float>(v, tol_);
+            if (v.isUnitary(tol_) == false) f++;
+            u(mu, x_cb, parity) = v;
+          }
+          return f;
+        },
+        host::plus<int>());
+    }
+  };
+
+  int projectSU3CPU(GaugeField &U, double tol)
+  {
+    checkHostField(U);
+    if (U.StaggeredPhaseApplied()) errorQuda("Cannot project gauge field with staggered phases applied");
+    int fails = 0;
+    instantiateCPU<ProjectSU3CPUApply>(U, U, tol, fails);
+    return fails;
+  }
+
+  template <typename Float> struct GaugeObservablesCPUApply {
+    template <bool density>
+    static GaugeObservablesReduce sweep(const GaugeField &u, void *qdensity, int &threads)
+    {
+      GaugeObservablesArg<Float, 3, QUDA_RECONSTRUCT_NO, density, QUDA_QDP_GAUGE_ORDER> arg(u, static_cast<Float *>(qdensity));
+      threads = arg.threads;
+      return host::parallel_reduce(
+        2, arg.threads, GaugeObservablesReduce(),
+        [&](int parity, int x_cb) { return gaugeObservablesCore(arg, x_cb, parity); },
+        host::plus<GaugeObservablesReduce>());
+    }
+
+    GaugeObservablesCPUApply(const GaugeField &u, double plaq[3], double energy[3], double &qcharge, void *qdensity)
+    {
+      int threads;
+      GaugeObservablesReduce sum = qdensity ? sweep<true>(u, qdensity, threads) : sweep<false>(u, qdensity, threads);
+
+      comm_allreduce_array(sum.data, sum.size());
+      for (int i = 0; i < 2; i++) plaq[i + 1] = sum[i] / (9. * 2 * threads * comm_size());
+      plaq[0] = 0.5 * (plaq[1] + plaq[2]);
+      for (int i = 0; i < 2; i++) energy[i + 1] = sum[i + 2] / (2.0 * threads * comm_size());
+      energy[0] = energy[1] + energy[2];
+      qcharge = sum[4];
+    }
+  };
+
+  void computeGaugeObservablesCPU(double plaq[3], double energy[3], double &qcharge, void *qdensity,
+                                  const GaugeField &u)
+  {
+    checkHostField(u);
+    instantiateCPU<GaugeObservablesCPUApply>(u, u, plaq, energy, qcharge, qdensity);
+  }
+
+  void gaugeObservablesCPU(GaugeField &u, QudaGaugeObservableParam &param)
+  {
+    checkHostField(u);
+    if (param.su_project) {
+      auto tol = u.Precision() == QUDA_DOUBLE_PRECISION ? 1e-14 : 1e-6;
+      int fails = projectSU3CPU(u, tol);
+      if (fails > 0) errorQuda("Error in the SU(3) unitarization: %d failures\n", fails);
+    }
+
+    if (param.compute_qcharge || param.compute_qcharge_density) {
+      if (param.compute_qcharge_density && !param.qcharge_density)
+        errorQuda("Charge density requested, but destination field not defined");
+      // one sweep for the plaquette, energy and charge
+      double plaq[3];
+      computeGaugeObservablesCPU(plaq, param.energy, param.qcharge,
+                                 param.compute_qcharge_density ? param.qcharge_density : nullptr, u);
+      if (param.compute_plaquette)
+        for (int i = 0; i < 3; i++) param.plaquette[i] = plaq[i];
+    } else if (param.compute_plaquette) {
+      double3 plaq = plaquetteCPU(u);
+      param.plaquette[0] = plaq.x;
+      param.plaquette[1] = plaq.y;
+      param.plaquette[2] = plaq.z;
+    }
+  }
+
+  /**
+     @brief Legacy (MILC or QDP) ordered accessor of a host field,
+     reading and writing the field in place
+  */
+  template <typename Float, int length, QudaGaugeFieldOrder order>
+  using HostOrder = typename gauge_mapper<Float, QUDA_RECONSTRUCT_NO, length, QUDA_STAGGERED_PHASE_NO,
+                                          gauge::default_huge_alloc, QUDA_GHOST_EXCHANGE_INVALID, false, order>::type;
+
+  /**
+     @brief Unpack a momentum stored as the ten real numbers of the MILC
+     anti-hermitian layout, as Reconstruct<11> does on the device
+  */
+  template <typename Float> inline Matrix<complex<Float>, 3> unpackMom(const complex<Float> v[5])
+  {
+    Matrix<complex<Float>, 3> m;
+    m(0, 0) = complex<Float>(0.0, v[3].real());
+    m(0, 1) = v[0];
+    m(0, 2) = v[1];
+    m(1, 0) = complex<Float>(-v[0].real(), v[0].imag());
+    m(1, 1) = complex<Float>(0.0, v[3].imag());
+    m(1, 2) = v[2];
+    m(2, 0) = complex<Float>(-v[1].real(), v[1].imag());
+    m(2, 1) = complex<Float>(-v[2].real(), v[2].imag());
+    m(2, 2) = complex<Float>(0.0, v[4].real());
+    return m;
+  }
+
+  static void checkHostMom(const GaugeField &mom)
+  {
+    if (mom.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Host gauge tools require host fields");
+    if (mom.Order() != QUDA_MILC_GAUGE_ORDER && mom.Order() != QUDA_QDP_GAUGE_ORDER)
+      errorQuda("Unsupported momentum order %d for host gauge tools", mom.Order());
+    if (mom.Reconstruct() != QUDA_RECONSTRUCT_10)
+      errorQuda("Unsupported momentum reconstruct %d for host gauge tools", mom.Reconstruct());
+  }
+
+  template <typename Float, QudaGaugeFieldOrder gauge_order, QudaGaugeFieldOrder mom_order> struct UpdateGaugeCPUArg {
+    using real = Float;
+    static constexpr int N = 8; // degree of the exponential expansion, as on the device
+    HostOrder<Float, 18, gauge_order> out;
+    const HostOrder<Float, 18, gauge_order> in;
+    const HostOrder<Float, 10, mom_order> mom;
+    const Float dt;
+    const int threads;
+    UpdateGaugeCPUArg(GaugeField &out, const GaugeField &in, const GaugeField &mom, double dt) :
+      out(out),
+      in(in),
+      mom(mom),
+      dt(dt),
+      threads(in.VolumeCB())
+    {
+    }
+  };
+
+  /**
+     The tiles of the link update: the links, the traceless momenta
+     (times -i dt for the exact exponential), and two work tiles
+  */
+  template <typename real> struct UpdateGaugeTiles {
+    static constexpr int width = host::simd_width<real>::value;
+    host::SU3Tile<real> u, p, e, c;
+  };
+
+  /**
+     @brief Link update U <- exp(dt P) U of updateGaugeField, applied
+     to tiles of (parity, site, direction) with the batched SU(3)
+     kernels.  The exact exponential is the Cayley-Hamilton
+     host::exponentiate, the tiled exponentiate_iQ of the smearing
+     routines, rather than the expsu3 of the device; both are exact,
+     so the host and device updates agree to rounding.
+  */
+  template <bool conj_mom, bool exact, typename Arg> void updateGaugeCPU(Arg &arg)
+  {
+    using real = typename Arg::real;
+    using Link = Matrix<complex<real>, 3>;
+    using Tiles = UpdateGaugeTiles<real>;
+    constexpr int W = Tiles::width;
+    const int volumeCB = arg.threads;
+
+    auto load = [&](Tiles &t, int lane, int i) {
+      const int dir = i % 4, x_cb = (i / 4) % volumeCB, parity = i / (4 * volumeCB);
+      Link U = arg.in(dir, x_cb, parity);
+      complex<real> v[5];
+      arg.mom.load(v, x_cb, dir, parity);
+      Link P = unpackMom(v);
+
+      complex<real> trace = getTrace(P);
+      for (int c = 0; c < 3; c++) P(c, c) -= trace / static_cast<real>(3.0);
+      if (conj_mom) P = conj(P);
+
+      t.u.set(lane, U);
+      // exp(dt P) = exp(iQ) with the hermitian Q = -i dt P
+      t.p.set(lane, exact ? complex<real>(0.0, -arg.dt) * P : P);
+    };
+
+    auto kernel = [&](Tiles &t) {
+      if (exact) {
+        host::exponentiate(t.e, t.p);
+        host::mul_nn(t.c, t.e, t.u);
+      } else {
+        t.c = t.u;
+        for (int r = Arg::N; r > 0; r--) {
+          host::mul_nn(t.e, t.p, t.c);
+          const real a = arg.dt / r;
+          for (int i = 0; i < 9; i++) {
+#pragma omp simd
+            for (int l = 0; l < W; l++) {
+              t.c.re[i][l] = a * t.e.re[i][l] + t.u.re[i][l];
+              t.c.im[i][l] = a * t.e.im[i][l] + t.u.im[i][l];
+            }
+          }
+        }
+      }
+    };
+
+    auto store = [&](const Tiles &t, int lane, int i) {
+      const int dir = i % 4, x_cb = (i / 4) % volumeCB, parity = i / (4 * volumeCB);
+      Link result;
+      t.c.get(lane, result);
+      arg.out(dir, x_cb, parity) = result;
+    };
+
+    host::batch<Tiles>(8 * volumeCB, load, kernel, store);
+  }
+
+  template <typename Float> struct UpdateGaugeCPUApply {
+    template <QudaGaugeFieldOrder gauge_order, QudaGaugeFieldOrder mom_order>
+    static void apply(GaugeField &out, const GaugeField &in, const GaugeField &mom, double dt, bool conj_mom,
+                      bool exact)
+    {
+      UpdateGaugeCPUArg<Float, gauge_order, mom_order> arg(out, in, mom, dt);
+      if (conj_mom) {
+        if (exact) updateGaugeCPU<true, true>(arg);
+        else updateGaugeCPU<true, false>(arg);
+      } else {
+        if (exact) updateGaugeCPU<false, true>(arg);
+        else updateGaugeCPU<false, false>(arg);
+      }
+    }
+
+    template <QudaGaugeFieldOrder gauge_order>
+    static void apply(GaugeField &out, const GaugeField &in, const GaugeField &mom, double dt, bool conj_mom,
+                      bool exact)
+    {
+      if (mom.Order() == QUDA_MILC_GAUGE_ORDER)
+        apply<gauge_order, QUDA_MILC_GAUGE_ORDER>(out, in, mom, dt, conj_mom, exact);
+      else
+        apply<gauge_order, QUDA_QDP_GAUGE_ORDER>(out, in, mom, dt, conj_mom, exact);
+    }
+
+    UpdateGaugeCPUApply(GaugeField &out, const GaugeField &in, const GaugeField &mom, double dt, bool conj_mom,
+                        bool exact)
+    {
+      if (in.Order() == QUDA_MILC_GAUGE_ORDER)
+        apply<QUDA_MILC_GAUGE_ORDER>(out, in, mom, dt, conj_mom, exact);
+      else
+        apply<QUDA_QDP_GAUGE_ORDER>(out, in, mom, dt, conj_mom, exact);
+    }
+  };
+
+  void updateGaugeFieldCPU(GaugeField &out, double dt, const GaugeField &in, const GaugeField &mom, bool conj_mom,
+                           bool exact)
+  {
+    auto check = [](const GaugeField &u) {
+      if (u.Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Host gauge tools require host fields");
+      if (u.Order() != QUDA_MILC_GAUGE_ORDER && u.Order() != QUDA_QDP_GAUGE_ORDER)
+        errorQuda("Unsupported gauge order %d for the host gauge update", u.Order());
+      if (u.Reconstruct() != QUDA_RECONSTRUCT_NO)
+        errorQuda("Unsupported reconstruct %d for host gauge tools", u.Reconstruct());
+      if (u.Ncolor() != 3) errorQuda("Unsupported number of colors %d for host gauge tools", u.Ncolor());
+    };
+    check(out);
+    check(in);
+    checkHostMom(mom);
+    checkPrecision(out, in, mom);
+    if (out.Order() != in.Order()) errorQuda("Gauge orders %d and %d differ", out.Order(), in.Order());
+    if (out.VolumeCB() != in.VolumeCB() || mom.VolumeCB() != in.VolumeCB())
+      errorQuda("Extended fields are not supported by the host gauge update");
+
+    instantiateCPU<UpdateGaugeCPUApply>(in, out, in, mom, dt, conj_mom, exact);
+  }
+
+  template <typename Float> struct MomActionCPUApply {
+    template <QudaGaugeFieldOrder order> static double sweep(const GaugeField &mom)
+    {
+      const HostOrder<Float, 10, order> m(mom);
+      return host::parallel_reduce(
+        2, mom.VolumeCB(), 0.0,
+        [&](int parity, int x_cb) {
+          // as computeMomAction (and MILC): the squares of the
+          // off-diagonal elements and half those of the diagonal
+          double action = 0.0;
+          for (int mu = 0; mu < 4; mu++) {
+            complex<Float> v[5];
+            m.load(v, x_cb, mu, parity);
+            for (int i = 0; i < 3; i++) action += norm(v[i]);
+            action += 0.5 * (v[3].real() * v[3].real() + v[3].imag() * v[3].imag() + v[4].real() * v[4].real());
+            action -= 4.0;
+          }
+          return action;
+        },
+        host::plus<double>());
+    }
+
+    MomActionCPUApply(const GaugeField &mom, double &action)
+    {
+      action = mom.Order() == QUDA_MILC_GAUGE_ORDER ? sweep<QUDA_MILC_GAUGE_ORDER>(mom) : sweep<QUDA_QDP_GAUGE_ORDER>(mom);
+      comm_allreduce(&action);
+    }
+  };
+
+  double computeMomActionCPU(const GaugeField &mom)
+  {
+    checkHostMom(mom);
+    double action = 0.0;
+    instantiateCPU<MomActionCPUApply>(mom, mom, action);
+    return action;
+  }
+
+} // namespace quda
@@ -4,21 +4,69 @@
 namespace quda
 {
 
+  // persistent workspace of gaugeObservables, kept across calls so
+  // that repeated measurements (e.g., during a flow) do not allocate
+  static void *d_qDensity = nullptr;
+  static size_t qDensity_bytes = 0;
+  static int *num_failures_h = nullptr;
+  static int *num_failures_d = nullptr;
+
+  void freeGaugeObservablesWorkspace()
+  {
+    if (d_qDensity) device_free(d_qDensity);
+    d_qDensity = nullptr;
+    qDensity_bytes = 0;
+
+    if (num_failures_h) host_free(num_failures_h);
+    num_failures_h = nullptr;
+    num_failures_d = nullptr;
+  }
+
   void gaugeObservables(GaugeField &u, QudaGaugeObservableParam &param, TimeProfile &profile)
   {
+    if (u.Location() == QUDA_CPU_FIELD_LOCATION) {
+      profile.TPSTART(QUDA_PROFILE_COMPUTE);
+      gaugeObservablesCPU(u, param);
+      profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+      return;
+    }
+
+    const bool fused = param.compute_qcharge || param.compute_qcharge_density;
+    // the density covers the interior of the extended field
+    size_t density_bytes = u.Precision();
+    for (int i = 0; i < 4; i++) density_bytes *= u.X()[i] - 2 * u.R()[i];
+
+    profile.TPSTART(QUDA_PROFILE_INIT);
+    if (param.su_project && !num_failures_h) {
+      num_failures_h = static_cast<int *>(mapped_malloc(sizeof(int)));
+      cudaHostGetDevicePointer(&num_failures_d, num_failures_h, 0);
+    }
+    if (param.compute_qcharge_density) {
+      if (!param.qcharge_density) errorQuda("Charge density requested, but destination field not defined");
+      if (density_bytes > qDensity_bytes) {
+        if (d_qDensity) device_free(d_qDensity);
+        d_qDensity = device_malloc(density_bytes);
+        qDensity_bytes = density_bytes;
+      }
+    }
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+
     profile.TPSTART(QUDA_PROFILE_COMPUTE);
     if (param.su_project) {
-      int *num_failures_h = static_cast<int *>(pool_pinned_malloc(sizeof(int)));
-      int *num_failures_d;
-      cudaHostGetDevicePointer(&num_failures_d, num_failures_h, 0);
       *num_failures_h = 0;
       auto tol = u.Precision() == QUDA_DOUBLE_PRECISION ? 1e-14 : QUDA_SINGLE_PRECISION;
       projectSU3(u, tol, num_failures_d);
       if (*num_failures_h > 0) errorQuda("Error in the SU(3) unitarization: %d failures\n", *num_failures_h);
-      pool_pinned_free(num_failures_h);
     }
 
-    if (param.compute_plaquette) {
+    if (fused) {
+      // plaquette, energy and charge in a single pass, without forming Fmunu
+      double plaq[3];
+      computeGaugeObservables(plaq, param.energy, param.qcharge,
+                              param.compute_qcharge_density ? d_qDensity : nullptr, u);
+      if (param.compute_plaquette)
+        for (int i = 0; i < 3; i++) param.plaquette[i] = plaq[i];
+    } else if (param.compute_plaquette) {
       double3 plaq = plaquette(u);
       param.plaquette[0] = plaq.x;
       param.plaquette[1] = plaq.y;
@@ -26,53 +74,10 @@ namespace quda
     }
     profile.TPSTOP(QUDA_PROFILE_COMPUTE);
 
-    // no point constructing Fmunu unless we are going to use it
-    if (!param.compute_qcharge && !param.compute_qcharge_density) return;
-
-    // create the Fmunu field
-    profile.TPSTART(QUDA_PROFILE_INIT);
-    // u is an extended field we need to shrink for the Fmunu field
-    int x[4];
-    for (int i = 0; i < 4; i++) x[i] = u.X()[i] - 2 * u.R()[i];
-    GaugeFieldParam tensorParam(x, u.Precision(), QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
-    tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
-    tensorParam.order = QUDA_FLOAT2_GAUGE_ORDER;
-    tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
-    cudaGaugeField gaugeFmunu(tensorParam);
-    profile.TPSTOP(QUDA_PROFILE_INIT);
-
-    profile.TPSTART(QUDA_PROFILE_COMPUTE);
-    computeFmunu(gaugeFmunu, u);
-    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
-    profile.TPSTOP(QUDA_PROFILE_TOTAL);
-
-    if (param.compute_qcharge || param.compute_qcharge_density) {
-      profile.TPSTART(QUDA_PROFILE_TOTAL);
-      profile.TPSTART(QUDA_PROFILE_INIT);
-      if (param.compute_qcharge_density && !param.qcharge_density)
-        errorQuda("Charge density requested, but destination field not defined");
-      size_t size = gaugeFmunu.Volume() * gaugeFmunu.Precision();
-      void *d_qDensity = param.compute_qcharge_density ? pool_device_malloc(size) : nullptr;
-      profile.TPSTOP(QUDA_PROFILE_INIT);
-
-      profile.TPSTART(QUDA_PROFILE_COMPUTE);
-
-      if (param.compute_qcharge_density)
-        computeQChargeDensity(param.energy, param.qcharge, d_qDensity, gaugeFmunu);
-      else
-        computeQCharge(param.energy, param.qcharge, gaugeFmunu);
-
-      profile.TPSTOP(QUDA_PROFILE_COMPUTE);
-
-      if (param.compute_qcharge_density) {
-        profile.TPSTART(QUDA_PROFILE_D2H);
-        qudaMemcpy(param.qcharge_density, d_qDensity, size, cudaMemcpyDeviceToHost);
-        profile.TPSTOP(QUDA_PROFILE_D2H);
-
-        profile.TPSTART(QUDA_PROFILE_FREE);
-        pool_device_free(d_qDensity);
-        profile.TPSTOP(QUDA_PROFILE_FREE);
-      }
+    if (param.compute_qcharge_density) {
+      profile.TPSTART(QUDA_PROFILE_D2H);
+      qudaMemcpy(param.qcharge_density, d_qDensity, density_bytes, cudaMemcpyDeviceToHost);
+      profile.TPSTOP(QUDA_PROFILE_D2H);
     }
   }
 
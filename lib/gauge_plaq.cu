@@ -1,5 +1,6 @@
 #include <tune_quda.h>
 #include <gauge_field.h>
+#include <gauge_tools.h>
 #include <jitify_helper.cuh>
 #include <kernels/gauge_plaq.cuh>
 #include <instantiate.h>
@@ -63,6 +64,8 @@ namespace quda {
 
   double3 plaquette(const GaugeField &U)
   {
+    if (U.Location() == QUDA_CPU_FIELD_LOCATION) return plaquetteCPU(U);
+
     double2 plq;
     instantiate<Plaquette>(U, plq);
     double3 plaq = make_double3(0.5*(plq.x + plq.y), plq.x, plq.y);
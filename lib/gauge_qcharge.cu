@@ -1,9 +1,11 @@
 #include <quda_internal.h>
 #include <tune_quda.h>
 #include <gauge_field.h>
+#include <gauge_tools.h>
 #include <launch_kernel.cuh>
 #include <jitify_helper.cuh>
 #include <kernels/gauge_qcharge.cuh>
+#include <kernels/gauge_observables.cuh>
 #include <instantiate.h>
 
 namespace quda
@@ -98,6 +100,10 @@ namespace quda
   void computeQCharge(double energy[3], double &qcharge, const GaugeField &Fmunu)
   {
 #ifdef GPU_GAUGE_TOOLS
+    if (Fmunu.Location() == QUDA_CPU_FIELD_LOCATION) {
+      computeQChargeCPU(energy, qcharge, nullptr, Fmunu);
+      return;
+    }
     instantiate<QCharge,ReconstructNone>(Fmunu, energy, qcharge, nullptr, false);
 #else
     errorQuda("Gauge tools are not built");
@@ -107,9 +113,109 @@ namespace quda
   void computeQChargeDensity(double energy[3], double &qcharge, void *qdensity, const GaugeField &Fmunu)
   {
 #ifdef GPU_GAUGE_TOOLS
+    if (Fmunu.Location() == QUDA_CPU_FIELD_LOCATION) {
+      computeQChargeCPU(energy, qcharge, qdensity, Fmunu);
+      return;
+    }
     instantiate<QCharge,ReconstructNone>(Fmunu, energy, qcharge, qdensity, true);
 #else
     errorQuda("Gauge tools are not built");
 #endif // GPU_GAUGE_TOOLS
   }
+  template <typename Arg> class GaugeObservablesCompute : TunableLocalParity
+  {
+    Arg &arg;
+    const GaugeField &meta;
+
+  private:
+    bool tuneSharedBytes() const { return false; }
+    bool tuneGridDim() const { return true; }
+    unsigned int minThreads() const { return arg.threads; }
+
+  public:
+    GaugeObservablesCompute(Arg &arg, const GaugeField &meta) :
+      TunableLocalParity(),
+      arg(arg),
+      meta(meta)
+    {
+      strcpy(aux, meta.AuxString());
+      strcat(aux, comm_dim_partitioned_string());
+      if (Arg::density) strcat(aux, ",density");
+#ifdef JITIFY
+      create_jitify_program("kernels/gauge_observables.cuh");
+#endif
+    }
+
+    void apply(const cudaStream_t &stream)
+    {
+      for (int i = 0; i < GaugeObservablesReduce::size(); i++) ((double *)arg.result_h)[i] = 0.0;
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+#ifdef JITIFY
+      using namespace jitify::reflection;
+      jitify_error = program->kernel("quda::gaugeObservablesKernel")
+                       .instantiate((int)tp.block.x, Type<Arg>())
+                       .configure(tp.grid, tp.block, tp.shared_bytes, stream)
+                       .launch(arg);
+#else
+      LAUNCH_KERNEL_LOCAL_PARITY(gaugeObservablesKernel, (*this), tp, stream, arg, Arg);
+#endif
+    }
+
+    TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
+
+    long long flops() const
+    {
+      auto mm_flops = 8 * Arg::nColor * Arg::nColor * (Arg::nColor - 2);
+      auto traceless_flops = (Arg::nColor * Arg::nColor + Arg::nColor + 1);
+      auto fmunu_flops = 6 * (2430 + 36);
+      auto energy_flops = 6 * (mm_flops + traceless_flops + Arg::nColor);
+      auto q_flops = 3*mm_flops + 2*Arg::nColor + 2;
+      return 2ll * arg.threads * (fmunu_flops + energy_flops + q_flops);
+    }
+
+    // 16 links per leaf set, with no reuse assumed
+    long long bytes() const { return 2 * arg.threads * (6 * 16 * arg.u.Bytes() + Arg::density * sizeof(typename Arg::Float)); }
+  }; // GaugeObservablesCompute
+
+  template <typename Float, int nColor, QudaReconstructType recon> struct GaugeObservables {
+    template <bool density>
+    static GaugeObservablesReduce compute(const GaugeField &u, void *qdensity, int &threads)
+    {
+      GaugeObservablesArg<Float, nColor, recon, density> arg(u, static_cast<Float *>(qdensity));
+      GaugeObservablesCompute<decltype(arg)> compute(arg, u);
+      compute.apply(0);
+      qudaDeviceSynchronize();
+      threads = arg.threads;
+      return *arg.result_h;
+    }
+
+    GaugeObservables(const GaugeField &u, double plaq[3], double energy[3], double &qcharge, void *qdensity)
+    {
+      if (!u.isNative()) errorQuda("Order %d with %d reconstruct not supported", u.Order(), u.Reconstruct());
+
+      int threads;
+      GaugeObservablesReduce sum = qdensity ? compute<true>(u, qdensity, threads) : compute<false>(u, qdensity, threads);
+
+      comm_allreduce_array(sum.data, sum.size());
+      for (int i = 0; i < 2; i++) plaq[i + 1] = sum[i] / (9. * 2 * threads * comm_size());
+      plaq[0] = 0.5 * (plaq[1] + plaq[2]);
+      for (int i = 0; i < 2; i++) energy[i + 1] = sum[i + 2] / (2.0 * threads * comm_size());
+      energy[0] = energy[1] + energy[2];
+      qcharge = sum[4];
+    }
+  };
+
+  void computeGaugeObservables(double plaq[3], double energy[3], double &qcharge, void *qdensity, const GaugeField &u)
+  {
+#ifdef GPU_GAUGE_TOOLS
+    if (u.Location() == QUDA_CPU_FIELD_LOCATION) {
+      computeGaugeObservablesCPU(plaq, energy, qcharge, qdensity, u);
+      return;
+    }
+    instantiate<GaugeObservables, ReconstructWilson>(u, plaq, energy, qcharge, qdensity);
+#else
+    errorQuda("Gauge tools are not built");
+#endif // GPU_GAUGE_TOOLS
+  }
+
 } // namespace quda
@@ -1,6 +1,7 @@
 #include <quda_internal.h>
 #include <tune_quda.h>
 #include <gauge_field.h>
+#include <gauge_tools.h>
 
 #include <jitify_helper.cuh>
 #include <kernels/gauge_stout.cuh>
@@ -57,6 +58,11 @@ public:
   void STOUTStep(GaugeField &out, GaugeField &in, double rho)
   {
 #ifdef GPU_GAUGE_TOOLS
+    if (checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION) {
+      STOUTStepCPU(out, in, rho);
+      return;
+    }
+
     checkPrecision(out, in);
     checkReconstruct(out, in);
 
@@ -120,6 +126,11 @@ public:
   void OvrImpSTOUTStep(GaugeField &out, GaugeField& in, double rho, double epsilon)
   {
 #ifdef GPU_GAUGE_TOOLS
+    if (checkLocation(out, in) == QUDA_CPU_FIELD_LOCATION) {
+      OvrImpSTOUTStepCPU(out, in, rho, epsilon);
+      return;
+    }
+
     checkPrecision(out, in);
     checkReconstruct(out, in);
 
@@ -9,6 +9,7 @@
 #include <float_vector.h>
 #include <complex_quda.h>
 #include <instantiate.h>
+#include <gauge_update_quda.h>
 
 namespace quda {
 
@@ -143,6 +144,11 @@ namespace quda {
   void updateGaugeField(GaugeField &out, double dt, const GaugeField& in, const GaugeField& mom, bool conj_mom, bool exact)
   {
 #ifdef GPU_GAUGE_TOOLS
+    if (checkLocation(out, in, mom) == QUDA_CPU_FIELD_LOCATION) {
+      updateGaugeFieldCPU(out, dt, in, mom, conj_mom, exact);
+      return;
+    }
+
     checkPrecision(out, in, mom);
     checkLocation(out, in, mom);
     checkReconstruct(out, in);
@@ -1,6 +1,7 @@
 #include <quda_internal.h>
 #include <tune_quda.h>
 #include <gauge_field.h>
+#include <gauge_tools.h>
 
 #include <jitify_helper.cuh>
 #include <kernels/gauge_wilson_flow.cuh>
@@ -23,9 +24,10 @@ namespace quda {
     int blockMin() const { return 8; }
 
   public:
-    GaugeWFlowStep(GaugeField &out, GaugeField &temp, const GaugeField &in, const double epsilon, const QudaWFlowType wflow_type, const WFlowStepType step_type) :
+    GaugeWFlowStep(GaugeField &out, GaugeField &temp, GaugeField *err, const GaugeField &in, const double epsilon,
+                   const QudaWFlowType wflow_type, const WFlowStepType step_type) :
       TunableVectorYZ(2, wflow_dim),
-      arg(out, temp, in, epsilon, wflow_type, step_type),
+      arg(out, temp, err, in, epsilon, wflow_type, step_type),
       meta(in)
     {
       strcpy(aux, meta.AuxString());
@@ -41,6 +43,7 @@ namespace quda {
       case WFLOW_STEP_VT: strcat(aux, "_VT"); break;
       default : errorQuda("Unknown Wilson Flow step type %d", step_type);
       }
+      if (arg.embedded) strcat(aux, ",embedded");
 
 #ifdef JITIFY
       create_jitify_program("kernels/gauge_wilson_flow.cuh");
@@ -82,10 +85,12 @@ namespace quda {
     void preTune() {
       arg.out.save(); // defensive measure in case out aliases in
       arg.temp.save();
+      if (arg.embedded) arg.err.save();
     }
     void postTune() {
       arg.out.load();
       arg.temp.load();
+      if (arg.embedded) arg.err.load();
     }
 
     long long flops() const
@@ -111,33 +116,62 @@ namespace quda {
       default : errorQuda("Unknown Wilson Flow type");
       }
       auto temp_io = arg.step_type == WFLOW_STEP_W2 ? 2 : arg.step_type == WFLOW_STEP_VT ? 1 : 0;
-      return ((1 + (wflow_dim-1) * links) * arg.in.Bytes() + arg.out.Bytes() + temp_io*arg.temp.Bytes()) * 2ll * arg.threads * wflow_dim;
+      auto err_io = !arg.embedded ? 0 : arg.step_type == WFLOW_STEP_W1 ? 1 : arg.step_type == WFLOW_STEP_VT ? 2 : 0;
+      return ((1 + (wflow_dim-1) * links) * arg.in.Bytes() + arg.out.Bytes() + temp_io*arg.temp.Bytes() + err_io*arg.err.Bytes()) * 2ll * arg.threads * wflow_dim;
     }
   }; // GaugeWFlowStep
 
-  void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, const double epsilon, const QudaWFlowType wflow_type)
+  /**
+     @brief Apply the three stages of the flow step: W1 is written to
+     out, W2 to mid and the updated field to out.  mid may alias in.
+  */
+  static void wflowStep(GaugeField &out, GaugeField &mid, GaugeField &temp, GaugeField *err, const GaugeField &in,
+                        const double epsilon, const QudaWFlowType wflow_type)
   {
-#ifdef GPU_GAUGE_TOOLS
     checkPrecision(out, temp, in);
     checkReconstruct(out, in);
     if (temp.Reconstruct() != QUDA_RECONSTRUCT_NO) errorQuda("Temporary vector must not use reconstruct");
+    if (err && err->Reconstruct() != QUDA_RECONSTRUCT_NO) errorQuda("Error field must not use reconstruct");
+    if (checkLocation(out, temp, in) == QUDA_CPU_FIELD_LOCATION) {
+      WFlowStepCPU(out, mid, temp, err, in, epsilon, wflow_type);
+      return;
+    }
     if (!out.isNative()) errorQuda("Order %d with %d reconstruct not supported", in.Order(), in.Reconstruct());
     if (!in.isNative()) errorQuda("Order %d with %d reconstruct not supported", out.Order(), out.Reconstruct());
 
     // Set each step type as an arg parameter, update halos if needed
     // Step W1
-    instantiate<GaugeWFlowStep,WilsonReconstruct>(out, temp, in, epsilon, wflow_type, WFLOW_STEP_W1);
+    instantiate<GaugeWFlowStep,WilsonReconstruct>(out, temp, err, in, epsilon, wflow_type, WFLOW_STEP_W1);
     out.exchangeExtendedGhost(out.R(), false);
 
     // Step W2
-    instantiate<GaugeWFlowStep,WilsonReconstruct>(in, temp, out, epsilon, wflow_type, WFLOW_STEP_W2);
-    in.exchangeExtendedGhost(in.R(), false);
+    instantiate<GaugeWFlowStep,WilsonReconstruct>(mid, temp, err, out, epsilon, wflow_type, WFLOW_STEP_W2);
+    mid.exchangeExtendedGhost(mid.R(), false);
 
     // Step Vt
-    instantiate<GaugeWFlowStep,WilsonReconstruct>(out, temp, in, epsilon, wflow_type, WFLOW_STEP_VT);
+    instantiate<GaugeWFlowStep,WilsonReconstruct>(out, temp, err, mid, epsilon, wflow_type, WFLOW_STEP_VT);
     out.exchangeExtendedGhost(out.R(), false);
+  }
+
+  void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, const double epsilon, const QudaWFlowType wflow_type)
+  {
+#ifdef GPU_GAUGE_TOOLS
+    wflowStep(out, in, temp, nullptr, in, epsilon, wflow_type);
+#else
+    errorQuda("Gauge tools are not built");
+#endif
+  }
+
+  double WFlowStepEmbedded(GaugeField &out, GaugeField &mid, GaugeField &temp, GaugeField &err, const GaugeField &in,
+                           const double epsilon, const QudaWFlowType wflow_type)
+  {
+#ifdef GPU_GAUGE_TOOLS
+    checkPrecision(out, mid, err);
+    wflowStep(out, mid, temp, &err, in, epsilon, wflow_type);
+    return err.abs_max();
 #else
     errorQuda("Gauge tools are not built");
+    return 0.0;
 #endif
   }
 }
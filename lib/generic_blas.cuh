@@ -1,29 +1,28 @@
 /**
-   Generic blas kernel with four loads and up to four stores.
+   Generic blas kernel with four loads and up to four stores.  The
+   sites are distributed over the host threads.
   */
 template <typename Float, int writeX, int writeY, int writeZ, int writeW, int writeV, typename SpinorX,
     typename SpinorY, typename SpinorZ, typename SpinorW, typename SpinorV, typename Functor>
 void genericBlas(SpinorX &X, SpinorY &Y, SpinorZ &Z, SpinorW &W, SpinorV &V, Functor f)
 {
-  for (int parity = 0; parity < X.Nparity(); parity++) {
-    for (int x = 0; x < X.VolumeCB(); x++) {
-      for (int s = 0; s < X.Nspin(); s++) {
-        for (int c = 0; c < X.Ncolor(); c++) {
-          complex<Float> X_(X(parity, x, s, c));
-          complex<Float> Y_ = Y(parity, x, s, c);
-          complex<Float> Z_ = Z(parity, x, s, c);
-          complex<Float> W_ = W(parity, x, s, c);
-          complex<Float> V_ = V(parity, x, s, c);
-          f(X_, Y_, Z_, W_, V_);
-          if (writeX) X(parity, x, s, c) = X_;
-          if (writeY) Y(parity, x, s, c) = Y_;
-          if (writeZ) Z(parity, x, s, c) = Z_;
-          if (writeW) W(parity, x, s, c) = W_;
-          if (writeV) V(parity, x, s, c) = V_;
-        }
+  host::parallel_for(X.Nparity(), X.VolumeCB(), [&](int parity, int x) {
+    for (int s = 0; s < X.Nspin(); s++) {
+      for (int c = 0; c < X.Ncolor(); c++) {
+        complex<Float> X_(X(parity, x, s, c));
+        complex<Float> Y_ = Y(parity, x, s, c);
+        complex<Float> Z_ = Z(parity, x, s, c);
+        complex<Float> W_ = W(parity, x, s, c);
+        complex<Float> V_ = V(parity, x, s, c);
+        f(X_, Y_, Z_, W_, V_);
+        if (writeX) X(parity, x, s, c) = X_;
+        if (writeY) Y(parity, x, s, c) = Y_;
+        if (writeZ) Z(parity, x, s, c) = Z_;
+        if (writeW) W(parity, x, s, c) = W_;
+        if (writeV) V(parity, x, s, c) = V_;
       }
     }
-  }
+  });
 }
 
 template <typename Float, typename yFloat, int nSpin, int nColor, QudaFieldOrder order, int writeX, int writeY,
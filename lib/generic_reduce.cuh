@@ -1,36 +1,41 @@
 /**
-   Generic reduce kernel with four loads and up to four stores.
+   Generic reduce kernel with four loads and up to four stores.  Each
+   site is reduced with its own copy of the reducer, and the site sums
+   are combined by host::parallel_reduce, so the result does not
+   depend on the number of threads.
   */
 template <typename ReduceType, typename Float, int writeX, int writeY, int writeZ, int writeW, int writeV,
     typename SpinorX, typename SpinorY, typename SpinorZ, typename SpinorW, typename SpinorV, typename Reducer>
 ReduceType genericReduce(SpinorX &X, SpinorY &Y, SpinorZ &Z, SpinorW &W, SpinorV &V, Reducer r)
 {
-  ReduceType sum;
-  ::quda::zero(sum);
+  ReduceType init;
+  ::quda::zero(init);
 
-  for (int parity = 0; parity < X.Nparity(); parity++) {
-    for (int x = 0; x < X.VolumeCB(); x++) {
-      r.pre();
-      for (int s = 0; s < X.Nspin(); s++) {
-        for (int c = 0; c < X.Ncolor(); c++) {
-          complex<Float> X_ = X(parity, x, s, c);
-          complex<Float> Y_ = Y(parity, x, s, c);
-          complex<Float> Z_ = Z(parity, x, s, c);
-          complex<Float> W_ = W(parity, x, s, c);
-          complex<Float> V_ = V(parity, x, s, c);
-          r(sum, X_, Y_, Z_, W_, V_);
-          if (writeX) X(parity, x, s, c) = X_;
-          if (writeY) Y(parity, x, s, c) = Y_;
-          if (writeZ) Z(parity, x, s, c) = Z_;
-          if (writeW) W(parity, x, s, c) = W_;
-          if (writeV) V(parity, x, s, c) = V_;
-        }
+  auto site = [&](int parity, int x) {
+    Reducer r_ = r;
+    ReduceType sum;
+    ::quda::zero(sum);
+    r_.pre();
+    for (int s = 0; s < X.Nspin(); s++) {
+      for (int c = 0; c < X.Ncolor(); c++) {
+        complex<Float> X_ = X(parity, x, s, c);
+        complex<Float> Y_ = Y(parity, x, s, c);
+        complex<Float> Z_ = Z(parity, x, s, c);
+        complex<Float> W_ = W(parity, x, s, c);
+        complex<Float> V_ = V(parity, x, s, c);
+        r_(sum, X_, Y_, Z_, W_, V_);
+        if (writeX) X(parity, x, s, c) = X_;
+        if (writeY) Y(parity, x, s, c) = Y_;
+        if (writeZ) Z(parity, x, s, c) = Z_;
+        if (writeW) W(parity, x, s, c) = W_;
+        if (writeV) V(parity, x, s, c) = V_;
       }
-      r.post(sum);
     }
-  }
+    r_.post(sum);
+    return sum;
+  };
 
-  return sum;
+  return host::parallel_reduce(X.Nparity(), X.VolumeCB(), init, site, host::plus<ReduceType>());
 }
 
 template <typename ReduceType, typename Float, typename zFloat, int nSpin, int nColor, QudaFieldOrder order, int writeX,
@@ -32,9 +32,7 @@
 
 #include <deflation.h>
 
-#ifdef NUMA_NVML
 #include <numa_affinity.h>
-#endif
 
 #ifdef QUDA_NVML
 #include <nvml.h>
@@ -416,6 +414,7 @@ void initCommsGridQuda(int nDim, const int *dims, QudaCommsMap func, void *fdata
   }
 
   LexMapData map_data;
+  CommNodeMapData node_map_data;
   if (!func) {
 
 #if QMP_COMMS
@@ -435,12 +434,22 @@ void initCommsGridQuda(int nDim, const int *dims, QudaCommsMap func, void *fdata
       warningQuda("QMP logical topology is undeclared; using default lexicographical ordering");
 #endif
 
-      map_data.ndim = nDim;
-      for (int i=0; i<nDim; i++) {
-        map_data.dims[i] = dims[i];
+      char *node_map_env = getenv("QUDA_ENABLE_NODE_RANK_MAP");
+      if (node_map_env && strcmp(node_map_env, "1") == 0) {
+        // pack the ranks on each node into a compact sub-block of the grid
+        node_map_data.ndim = nDim;
+        for (int i = 0; i < nDim; i++) {
+          node_map_data.dims[i] = dims[i];
+          node_map_data.local_dims[i] = 0;
+        }
+        fdata = (void *)&node_map_data;
+        func = comm_node_rank_from_coords;
+      } else {
+        map_data.ndim = nDim;
+        for (int i = 0; i < nDim; i++) { map_data.dims[i] = dims[i]; }
+        fdata = (void *)&map_data;
+        func = lex_rank_from_coords;
       }
-      fdata = (void *) &map_data;
-      func = lex_rank_from_coords;
 
 #if QMP_COMMS
     }
@@ -603,16 +612,24 @@ void initQudaDevice(int dev) {
 #endif
 
 
-#if ((CUDA_VERSION >= 6000) && defined NUMA_NVML)
   char *enable_numa_env = getenv("QUDA_ENABLE_NUMA");
   if (enable_numa_env && strcmp(enable_numa_env, "0") == 0) {
     if (getVerbosity() > QUDA_SILENT) printfQuda("Disabling numa_affinity\n");
   }
   else{
-    setNumaAffinityNVML(dev);
-  }
+#if ((CUDA_VERSION >= 6000) && defined NUMA_NVML)
+    // the sysfs fallback is collective, so it is taken on every rank if NVML failed on any of them
+    int nvml_failed = setNumaAffinityNVML(dev) != 0 ? 1 : 0;
+    comm_allreduce_int(&nvml_failed);
+    if (nvml_failed) setNumaAffinitySysfs(dev);
+#else
+    setNumaAffinitySysfs(dev);
 #endif
 
+    char *thread_binding_env = getenv("QUDA_ENABLE_THREAD_BINDING");
+    if (thread_binding_env && strcmp(thread_binding_env, "1") == 0) bindHostThreads();
+  }
+
 
 
   cudaDeviceSetCacheConfig(cudaFuncCachePreferL1);
@@ -1491,6 +1508,9 @@ void endQuda(void)
 
   LatticeField::freeGhostBuffer();
   cpuColorSpinorField::freeGhostBuffer();
+  cpuGaugeField::freeGhostBuffer();
+
+  freeGaugeObservablesWorkspace();
 
   cublas::destroy();
   blas::end();
@@ -2422,6 +2442,57 @@ void eigensolveQuda(void **host_evecs, double _Complex *host_evals, QudaEigParam
   profileEigensolve.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
+/**
+   @brief Fingerprint of a multigrid hierarchy, combining the checksum
+   of the gauge field with the operator and multigrid parameters that
+   determine the contents and layout of a hierarchy checkpoint.
+*/
+static uint64_t multigridFingerprint(const QudaMultigridParam &mg_param, const GaugeField &gauge)
+{
+  uint64_t hash = 14695981039346656037ull; // 64-bit FNV-1a
+  auto add = [&hash](const auto &value) {
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(&value);
+    for (size_t i = 0; i < sizeof(value); i++) {
+      hash ^= data[i];
+      hash *= 1099511628211ull;
+    }
+  };
+
+  add(ChecksumCRC32(gauge));
+  for (int d = 0; d < 4; d++) {
+    add(gauge.X()[d]);
+    add(comm_dim(d));
+  }
+
+  const QudaInvertParam &param = *mg_param.invert_param;
+  add(param.dslash_type);
+  add(param.kappa);
+  add(param.mass);
+  add(param.mu);
+  add(param.epsilon);
+  add(param.clover_coeff);
+  add(param.matpc_type);
+  add(param.cuda_prec_sloppy);
+  add(param.cuda_prec_precondition);
+
+  add(mg_param.n_level);
+  for (int l = 0; l < mg_param.n_level; l++) {
+    add(mg_param.n_vec[l]);
+    add(mg_param.geo_block_size[l]);
+    add(mg_param.spin_block_size[l]);
+    add(mg_param.n_block_ortho[l]);
+    add(mg_param.precision_null[l]);
+    add(mg_param.location[l]);
+    add(mg_param.setup_location[l]);
+    add(mg_param.coarse_grid_solution_type[l]);
+    add(mg_param.smoother_solve_type[l]);
+    add(mg_param.mu_factor[l]);
+  }
+  add(mg_param.is_staggered);
+
+  return hash;
+}
+
 multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &profile)
   : profile(profile) {
   profile.TPSTART(QUDA_PROFILE_INIT);
@@ -2499,6 +2570,19 @@ multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &pr
   // fill out the MG parameters for the fine level
   mgParam = new MGParam(mg_param, B, m, mSmooth, mSmoothSloppy);
 
+  mg_param.checkpoint_restored = QUDA_BOOLEAN_FALSE;
+  if (mg_param.checkpoint_load == QUDA_BOOLEAN_TRUE) {
+    mgParam->checkpoint_fingerprint = multigridFingerprint(mg_param, *cudaGauge);
+    mgParam->load_checkpoint
+      = MG::checkpointMatches(mg_param.checkpoint_infile, mg_param.n_level, mgParam->checkpoint_fingerprint);
+    if (!mgParam->load_checkpoint)
+      warningQuda("Hierarchy checkpoint %s does not match the gauge field and parameters, running the setup",
+                  mg_param.checkpoint_infile);
+    else if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Restoring multigrid hierarchy from checkpoint %s\n", mg_param.checkpoint_infile);
+    if (mgParam->load_checkpoint) mg_param.checkpoint_restored = QUDA_BOOLEAN_TRUE;
+  }
+
   mg = new MG(*mgParam, profile);
   mgParam->updateInvertParam(*param);
 
@@ -2591,8 +2675,10 @@ void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
   if(mg->mgParam->mg_global.invert_param != param)
     mg->mgParam->mg_global.invert_param = param;
 
-  bool refresh = true;
-  mg->mg->reset(refresh);
+  // refresh the null space, or with adaptive refresh let the hierarchy decide
+  bool refreshed = mg->mg->update();
+  mg_param->refreshed = refreshed ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  mg_param->refresh_secs_saved = mg->mg->refreshSecsSaved();
 
   setOutputPrefix("");
 
@@ -2615,9 +2701,17 @@ void dumpMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
 
   auto *mg = static_cast<multigrid_solver*>(mg_);
   checkMultigridParam(mg_param);
-  checkGauge(mg_param->invert_param);
+  cudaGaugeField *cudaGauge = checkGauge(mg_param->invert_param);
 
-  mg->mg->dumpNullVectors();
+  // the null-space vectors are dumped unless only a hierarchy checkpoint was requested
+  if (mg_param->checkpoint_store != QUDA_BOOLEAN_TRUE || strcmp(mg_param->vec_outfile[0], "") != 0)
+    mg->mg->dumpNullVectors();
+
+  if (mg_param->checkpoint_store == QUDA_BOOLEAN_TRUE) {
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Saving multigrid hierarchy checkpoint %s\n", mg_param->checkpoint_outfile);
+    mg->mg->saveCheckpoint(mg_param->checkpoint_outfile, multigridFingerprint(*mg_param, *cudaGauge));
+  }
 
   profileInvert.TPSTOP(QUDA_PROFILE_TOTAL);
   popVerbosity();
@@ -3021,6 +3115,10 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     solverParam.updateInvertParam(*param);
   }
 
+  // the multigrid refresh controller tracks the outer iteration counts
+  if (param->inv_type_precondition == QUDA_MG_INVERTER && param->preconditioner)
+    static_cast<multigrid_solver *>(param->preconditioner)->mg->recordSolve(param->iter);
+
   if (getVerbosity() >= QUDA_VERBOSE){
     double nx = blas::norm2(*x);
     printfQuda("Solution = %g\n",nx);
@@ -5571,8 +5669,133 @@ void performWFlownStep(unsigned int n_steps, double step_size, int meas_interval
     }
   }
 
+  // the flowed field is in out, which after an odd number of steps is the auxiliary field
+  if (n_steps > 0 && out != gaugeSmeared) {
+    delete gaugeSmeared;
+    gaugeSmeared = static_cast<cudaGaugeField *>(out);
+  } else {
+    delete gaugeAux;
+  }
+
+  delete gaugeTemp;
+  profileWFlow.TPSTOP(QUDA_PROFILE_TOTAL);
+  popOutputPrefix();
+}
+
+void performWFlowAdaptive(int n_meas, const double *meas_times, double step_size, double tol,
+                          QudaWFlowType wflow_type)
+{
+  pushOutputPrefix("performWFlowAdaptive: ");
+  profileWFlow.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (gaugePrecise == nullptr) errorQuda("Gauge field must be loaded");
+  if (n_meas < 1) errorQuda("No measurement times given");
+  if (step_size <= 0.0 || tol <= 0.0) errorQuda("Invalid step size %e or tolerance %e", step_size, tol);
+  for (int i = 0; i < n_meas; i++)
+    if (meas_times[i] <= (i > 0 ? meas_times[i - 1] : 0.0)) errorQuda("Measurement times must be increasing");
+
+  if (gaugeSmeared != nullptr) delete gaugeSmeared;
+  gaugeSmeared = createExtendedGauge(*gaugePrecise, R, profileWFlow);
+
+  // the input W0 is kept until the step is accepted, the stage W2 goes to mid
+  GaugeFieldParam gParamEx(*gaugeSmeared);
+  auto *gaugeAux = new cudaGaugeField(gParamEx);
+  auto *gaugeMid = new cudaGaugeField(gParamEx);
+
+  GaugeFieldParam gParam(*gaugePrecise);
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO; // temporary fields are not on manifold so cannot use reconstruct
+  gParam.setPrecision(gParam.Precision(), true); // and must take the native order of an unreconstructed field
+  auto *gaugeTemp = GaugeField::Create(gParam);
+  auto *gaugeErr = GaugeField::Create(gParam);
+
+  cudaGaugeField *in = gaugeSmeared;
+  cudaGaugeField *out = gaugeAux;
+
+  QudaGaugeObservableParam param = newQudaGaugeObservableParam();
+  param.compute_plaquette = QUDA_BOOLEAN_TRUE;
+  param.compute_qcharge = QUDA_BOOLEAN_TRUE;
+
+  if (getVerbosity() >= QUDA_SUMMARIZE) {
+    gaugeObservables(*in, param, profileWFlow);
+    printfQuda("flow t, step size, plaquette, E_tot, E_spatial, E_temporal, Q charge\n");
+    printfQuda("%le %le %.16e %+.16e %+.16e %+.16e %+.16e\n", 0.0, 0.0, param.plaquette[0], param.energy[0],
+               param.energy[1], param.energy[2], param.qcharge);
+  }
+
+  // step size controller of Fritzsch and Ramos, the local error of
+  // the third-order step scales as epsilon^3
+  const double safety = 0.95;
+  const double min_scale = 0.2;
+  const double max_scale = 2.0;
+  // give up once the step size has collapsed or too many steps in a row were rejected
+  const double min_step = 1e-10 * meas_times[n_meas - 1];
+  const int max_rejected = 20;
+
+  double t = 0.0;
+  double epsilon = step_size;
+  int accepted = 0, rejected = 0, rejected_in_row = 0;
+
+  for (int m = 0; m < n_meas; m++) {
+    while (t < meas_times[m]) {
+      // shorten the step to land on the measurement time
+      const bool last = t + epsilon >= meas_times[m];
+      const double h = last ? meas_times[m] - t : epsilon;
+
+      profileWFlow.TPSTART(QUDA_PROFILE_COMPUTE);
+      double err = WFlowStepEmbedded(*out, *gaugeMid, *gaugeTemp, *gaugeErr, *in, h, wflow_type);
+      profileWFlow.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+      // a non-finite error estimate rejects the step with the largest reduction
+      const bool finite = std::isfinite(err);
+      double scale = err > 0.0 ? std::min(std::max(safety * cbrt(tol / err), min_scale), max_scale) : max_scale;
+      if (!finite) scale = min_scale;
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+        printfQuda("t = %e step %e error %e: %s\n", t, h, err, finite && err <= tol ? "accepted" : "rejected");
+
+      if (finite && err <= tol) {
+        t = last ? meas_times[m] : t + h;
+        std::swap(in, out);
+        accepted++;
+        rejected_in_row = 0;
+        // a shortened step does not limit the next one
+        if (!last || h * scale < epsilon) epsilon = h * scale;
+      } else {
+        epsilon = h * scale;
+        rejected++;
+        if (++rejected_in_row > max_rejected)
+          errorQuda("%d steps rejected in a row at t = %e (error %e, tolerance %e)", rejected_in_row, t, err, tol);
+        if (epsilon < min_step)
+          errorQuda("Step size %e fell below %e at t = %e (error %e, tolerance %e)", epsilon, min_step, t, err, tol);
+      }
+    }
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      gaugeObservables(*in, param, profileWFlow);
+      printfQuda("%le %le %.16e %+.16e %+.16e %+.16e %+.16e\n", t, epsilon, param.plaquette[0], param.energy[0],
+                 param.energy[1], param.energy[2], param.qcharge);
+    }
+  }
+
+  // each attempted step sweeps the field with the three stages and
+  // the error reduction, the fixed step path with the three stages
+  const int fixed_steps = (int)ceil(meas_times[n_meas - 1] / step_size - 1e-10);
+  const long adaptive_sweeps = 4l * (accepted + rejected);
+  const long fixed_sweeps = 3l * fixed_steps;
+  if (getVerbosity() >= QUDA_SUMMARIZE) {
+    printfQuda("Adaptive flow to t = %e took %d steps (%d rejected) and %ld field sweeps\n", t, accepted + rejected,
+               rejected, adaptive_sweeps);
+    printfQuda("Fixed step size %e would take %d steps and %ld field sweeps: saved %d steps and %ld sweeps\n", step_size,
+               fixed_steps, fixed_sweeps, fixed_steps - (accepted + rejected), fixed_sweeps - adaptive_sweeps);
+  }
+
+  // keep the flowed field as the smeared field
+  if (in != gaugeSmeared) delete gaugeSmeared;
+  if (in != gaugeAux) delete gaugeAux;
+  delete gaugeMid;
+  gaugeSmeared = in;
+
+  delete gaugeErr;
   delete gaugeTemp;
-  delete gaugeAux;
   profileWFlow.TPSTOP(QUDA_PROFILE_TOTAL);
   popOutputPrefix();
 }
@@ -5672,6 +5895,36 @@ int computeGaugeFixingFFTQuda(void* gauge, const unsigned int gauge_dir,  const
   GaugeFieldParam gParam(gauge, *param);
   auto *cpuGauge = new cpuGaugeField(gParam);
 
+  if (comm_partitioned()) {
+    // the device implementation does not support partitioned
+    // lattices, so fix the gauge on the host
+    GaugeFieldParam hParam(*cpuGauge);
+    hParam.create = QUDA_NULL_FIELD_CREATE;
+    hParam.order = QUDA_QDP_GAUGE_ORDER;
+    hParam.reconstruct = QUDA_RECONSTRUCT_NO;
+    hParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+    hParam.location = QUDA_CPU_FIELD_LOCATION;
+    cpuGaugeField hostGauge(hParam);
+    copyGenericGauge(hostGauge, *cpuGauge, QUDA_CPU_FIELD_LOCATION);
+    GaugeFixFFTQuda.TPSTOP(QUDA_PROFILE_INIT);
+
+    GaugeFixFFTQuda.TPSTART(QUDA_PROFILE_COMPUTE);
+    gaugefixingFFTCPU(hostGauge, gauge_dir, Nsteps, verbose_interval, alpha, autotune, tolerance, stopWtheta);
+    GaugeFixFFTQuda.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+    copyGenericGauge(*cpuGauge, hostGauge, QUDA_CPU_FIELD_LOCATION);
+    delete cpuGauge;
+    if (param->make_resident_gauge) warningQuda("Gauge field fixed on the host is not made resident");
+
+    GaugeFixFFTQuda.TPSTOP(QUDA_PROFILE_TOTAL);
+    if (timeinfo) {
+      timeinfo[0] = 0.0;
+      timeinfo[1] = GaugeFixFFTQuda.Last(QUDA_PROFILE_COMPUTE);
+      timeinfo[2] = 0.0;
+    }
+    return 0;
+  }
+
   //gParam.pad = getFatLinkPadding(param->X);
   gParam.create      = QUDA_NULL_FIELD_CREATE;
   gParam.link_type   = param->type;
@@ -5788,6 +6041,51 @@ void contractQuda(const void *hp_x, const void *hp_y, void *h_result, const Quda
   profileContract.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
+void contractMomentumQuda(const void *hp_x, const void *hp_y, void *h_result, const QudaContractType cType,
+                          const int *mom, int n_mom, QudaInvertParam *param, const int *X)
+{
+  profileContract.TPSTART(QUDA_PROFILE_TOTAL);
+  profileContract.TPSTART(QUDA_PROFILE_INIT);
+  // wrap CPU host side pointers
+  ColorSpinorParam cpuParam((void *)hp_x, *param, X, false, param->input_location);
+  ColorSpinorField *h_x = ColorSpinorField::Create(cpuParam);
+
+  cpuParam.v = (void *)hp_y;
+  ColorSpinorField *h_y = ColorSpinorField::Create(cpuParam);
+
+  // Create device parameter
+  ColorSpinorParam cudaParam(cpuParam);
+  cudaParam.location = QUDA_CUDA_FIELD_LOCATION;
+  cudaParam.create = QUDA_NULL_FIELD_CREATE;
+  // Quda uses Degrand-Rossi gamma basis for contractions and will
+  // automatically reorder data if necessary.
+  cudaParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  cudaParam.setPrecision(cpuParam.Precision(), cpuParam.Precision(), true);
+
+  ColorSpinorField *x = ColorSpinorField::Create(cudaParam);
+  ColorSpinorField *y = ColorSpinorField::Create(cudaParam);
+  profileContract.TPSTOP(QUDA_PROFILE_INIT);
+
+  profileContract.TPSTART(QUDA_PROFILE_H2D);
+  *x = *h_x;
+  *y = *h_y;
+  profileContract.TPSTOP(QUDA_PROFILE_H2D);
+
+  // only the correlators are returned to the host
+  profileContract.TPSTART(QUDA_PROFILE_COMPUTE);
+  contractMomentumQuda(*x, *y, h_result, cType, mom, n_mom);
+  profileContract.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  profileContract.TPSTART(QUDA_PROFILE_FREE);
+  delete x;
+  delete y;
+  delete h_y;
+  delete h_x;
+  profileContract.TPSTOP(QUDA_PROFILE_FREE);
+
+  profileContract.TPSTOP(QUDA_PROFILE_TOTAL);
+}
+
 void gaugeObservablesQuda(QudaGaugeObservableParam *param)
 {
   profileGaugeObs.TPSTART(QUDA_PROFILE_TOTAL);
@@ -223,8 +223,7 @@ namespace quda {
 
   void CG::operator()(ColorSpinorField &x, ColorSpinorField &b, ColorSpinorField *p_init, double r2_old_init)
   {
-    if (checkLocation(x, b) != QUDA_CUDA_FIELD_LOCATION)
-      errorQuda("Not supported");
+    checkLocation(x, b); // both device and host fields are supported
     if (checkPrecision(x, b) != param.precision)
       errorQuda("Precision mismatch: expected=%d, received=%d", param.precision, x.Precision());
 
@@ -788,8 +787,7 @@ void CG::blocksolve(ColorSpinorField& x, ColorSpinorField& b) {
   errorQuda("QUDA_BLOCKSOLVER not built.");
   #else
 
-  if (checkLocation(x, b) != QUDA_CUDA_FIELD_LOCATION)
-  errorQuda("Not supported");
+  checkLocation(x, b); // both device and host fields are supported
 
   profile.TPSTART(QUDA_PROFILE_INIT);
 
@@ -1168,8 +1166,7 @@ void CG::solve(ColorSpinorField& x, ColorSpinorField& b) {
   printfQuda("BCQ Solver\n");
   #endif
   const bool use_block = true;
-  if (checkLocation(x, b) != QUDA_CUDA_FIELD_LOCATION)
-  errorQuda("Not supported");
+  checkLocation(x, b); // both device and host fields are supported
 
   profile.TPSTART(QUDA_PROFILE_INIT);
 
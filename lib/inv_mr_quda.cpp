@@ -131,7 +131,8 @@ namespace quda {
     
 	  matSloppy(Ar, rSloppy, tmpSloppy);
 
-	  if (param.global_reduction) {
+	  // host fields have no asynchronous reductions, so compute alpha here
+	  if (param.global_reduction || Ar.Location() == QUDA_CPU_FIELD_LOCATION) {
 	    Ar3 = blas::cDotProductNormA(Ar, rSloppy);
 	    Complex alpha = Complex(Ar3.x, Ar3.y) / Ar3.z;
 
@@ -0,0 +1,360 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+
+#include <quda_internal.h>
+#include <blas_quda.h>
+#include <dslash_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+
+/**
+   Pipelined CG after P. Ghysels and W. Vanroose, "Hiding global
+   synchronization latency in the preconditioned Conjugate Gradient
+   algorithm", Parallel Computing 40 (2014) 224.  The recurrences for
+   s = A p, w = A r and z = A s allow both inner products of an
+   iteration, (r,r) and (w,r), to be computed in a single reduction,
+   so each iteration has one global synchronization instead of two.
+   Residual replacement follows S. Cools et al., SIAM J. Matrix
+   Anal. Appl. 39 (2018) 426: at a reliable update the recurred
+   vectors are recomputed from the true residual and the search
+   direction, which is kept.
+*/
+
+namespace quda {
+
+  PipelinedCG::PipelinedCG(DiracMatrix &mat, DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile) :
+    Solver(param, profile), mat(mat), matSloppy(matSloppy), init(false)
+  {
+  }
+
+  PipelinedCG::~PipelinedCG() {
+    if ( init ) {
+      delete rp;
+      delete yp;
+      delete tmpp;
+      delete wSp;
+      delete pSp;
+      delete sSp;
+      delete zSp;
+      delete qSp;
+      if(param.precision != param.precision_sloppy) {
+        delete rSp;
+        delete xSp;
+        delete tmpSp;
+      }
+      if(!mat.isStaggered()) delete tmp2Sp;
+
+      init = false;
+    }
+  }
+
+  void PipelinedCG::operator()(ColorSpinorField &x, ColorSpinorField &b)
+  {
+    if (checkLocation(x, b) != QUDA_CUDA_FIELD_LOCATION)
+      errorQuda("Not supported");
+    if (x.Precision() != param.precision || b.Precision() != param.precision)
+      errorQuda("Precision mismatch");
+
+    profile.TPSTART(QUDA_PROFILE_INIT);
+
+    // Check to see that we're not trying to invert on a zero-field source
+    double b2 = blas::norm2(b);
+    if(b2 == 0 &&
+       (param.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_NO || param.use_init_guess == QUDA_USE_INIT_GUESS_NO)){
+      profile.TPSTOP(QUDA_PROFILE_INIT);
+      printfQuda("Warning: inverting on zero-field source\n");
+      x = b;
+      param.true_res = 0.0;
+      param.true_res_hq = 0.0;
+      return;
+    }
+
+    const bool mixed_precision = (param.precision != param.precision_sloppy);
+    ColorSpinorParam csParam(x);
+    if (!init) {
+      csParam.create = QUDA_ZERO_FIELD_CREATE;
+      rp = ColorSpinorField::Create(csParam);
+      tmpp = ColorSpinorField::Create(csParam);
+      yp = ColorSpinorField::Create(csParam);
+
+      // Sloppy fields
+      csParam.setPrecision(param.precision_sloppy);
+      wSp = ColorSpinorField::Create(csParam);
+      pSp = ColorSpinorField::Create(csParam);
+      sSp = ColorSpinorField::Create(csParam);
+      zSp = ColorSpinorField::Create(csParam);
+      qSp = ColorSpinorField::Create(csParam);
+      if(mixed_precision) {
+        rSp = ColorSpinorField::Create(csParam);
+        xSp = ColorSpinorField::Create(csParam);
+        tmpSp = ColorSpinorField::Create(csParam);
+      } else {
+        tmpSp = tmpp;
+      }
+      if(!mat.isStaggered()) {
+        tmp2Sp = ColorSpinorField::Create(csParam);
+      } else {
+        tmp2Sp = tmpSp;
+      }
+
+      init = true;
+    }
+
+    ColorSpinorField &r = *rp;
+    ColorSpinorField &y = *yp;
+    ColorSpinorField &rS = mixed_precision ? *rSp : r;
+    ColorSpinorField &xS = mixed_precision ? *xSp : x;
+    ColorSpinorField &wS = *wSp;
+    ColorSpinorField &pS = *pSp;
+    ColorSpinorField &sS = *sSp;
+    ColorSpinorField &zS = *zSp;
+    ColorSpinorField &qS = *qSp;
+    ColorSpinorField &tmp = *tmpp;
+    ColorSpinorField &tmpS = *tmpSp;
+    ColorSpinorField &tmp2S = *tmp2Sp;
+
+    double stop = stopping(param.tol, b2, param.residual_type); // stopping condition of solver
+
+    const bool use_heavy_quark_res =
+      (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) ? true : false;
+
+    // this parameter determines how many consective reliable update
+    // reisudal increases we tolerate before terminating the solver,
+    // i.e., how long do we want to keep trying to converge
+    const int maxResIncrease = param.max_res_increase; // check if we reached the limit of our tolerance
+    const int maxResIncreaseTotal = param.max_res_increase_total;
+    int resIncrease = 0;
+    int resIncreaseTotal = 0;
+
+    int heavy_quark_check = param.heavy_quark_check; // how often to check the heavy quark residual
+    double heavy_quark_res = 0.0; // heavy quark residual
+
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+    profile.TPSTART(QUDA_PROFILE_PREAMBLE);
+
+    blas::flops = 0;
+
+    // compute initial residual depending on whether we have an initial guess or not
+    double r2;
+    if (param.use_init_guess == QUDA_USE_INIT_GUESS_YES) {
+      mat(r, x, y, tmp);
+      r2 = blas::xmyNorm(b, r);
+      if(b2==0) b2 = r2;
+      if (mixed_precision) {
+	blas::copy(y, x);
+	blas::zero(xS);
+      }
+    } else {
+      blas::copy(r, b);
+      r2 = b2;
+      blas::zero(x);
+      if (mixed_precision) {
+        blas::zero(y);
+        blas::zero(xS);
+      }
+    }
+    blas::copy(rS, r);
+
+    if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(x, r).z);
+
+    profile.TPSTOP(QUDA_PROFILE_PREAMBLE);
+    if(convergence(r2, heavy_quark_res, stop, param.tol_hq)) {
+      if(param.preserve_source == QUDA_PRESERVE_SOURCE_NO) {
+        blas::copy(b, r);
+      }
+      return;
+    }
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    // On single-parity device fields the fused reduction is launched
+    // asynchronously, leaving its local result in the device reduction
+    // buffer, and q = A w for the next iteration is applied before the
+    // result is read back and globally reduced, so the host does not
+    // wait for the reduction before launching the operator.
+    const bool async = rS.Location() == QUDA_CUDA_FIELD_LOCATION && rS.SiteSubset() == QUDA_PARITY_SITE_SUBSET;
+    double3 rw;
+    bool q_ready = false; // whether q = A w has been applied for the current w
+    auto reduce = [&]() {
+      if (!async) {
+        rw = blas::cDotProductNormA(rS, wS);
+        return;
+      }
+      const bool global_reduction = commGlobalReduction();
+      commGlobalReductionSet(false);
+      commAsyncReductionSet(true);
+      blas::cDotProductNormA(rS, wS);
+      commAsyncReductionSet(false);
+      commGlobalReductionSet(global_reduction);
+
+      matSloppy(qS, wS, tmpS, tmp2S);
+      q_ready = true;
+
+      qudaMemcpy(&rw, blas::getDeviceReduceBuffer(), sizeof(double3), cudaMemcpyDeviceToHost);
+      reduceDoubleArray(reinterpret_cast<double *>(&rw), 3);
+    };
+
+    // w = A r, and the fused reduction gamma = (r,r), delta = (w,r)
+    matSloppy(wS, rS, tmpS, tmp2S);
+    reduce();
+    double gamma = rw.z;
+    double delta = rw.x;
+
+    double r2_old = r2;
+    double rNorm  = sqrt(r2);
+    double r0Norm = rNorm;
+    double maxrx  = rNorm;
+    double maxrr  = rNorm;
+    double reliable_delta = param.delta;
+
+    int k = 0;
+    double alpha = 0.0, beta = 0.0;
+    double gamma_old = gamma;
+    bool restart = true;
+    while ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) && k < param.maxiter) {
+
+      // q = A w: this is independent of the reduction that produced
+      // gamma and delta, which is the latency the pipelining hides
+      if (!q_ready) matSloppy(qS, wS, tmpS, tmp2S);
+      q_ready = false;
+
+      if (restart) {
+        beta = 0.0;
+        alpha = gamma / delta;
+        restart = false;
+      } else {
+        beta = gamma / gamma_old;
+        alpha = gamma / (delta - beta * gamma / alpha);
+      }
+
+      blas::xpay(qS, beta, zS); // z = q + beta z
+      blas::xpay(wS, beta, sS); // s = w + beta s
+      blas::xpay(rS, beta, pS); // p = r + beta p
+      blas::axpy(alpha, pS, xS);  // x += alpha p
+      blas::axpy(-alpha, sS, rS); // r -= alpha s
+      blas::axpy(-alpha, zS, wS); // w -= alpha z
+
+      // the single global reduction of the iteration
+      reduce();
+      gamma_old = gamma;
+      gamma = rw.z;
+      delta = rw.x;
+      r2 = gamma;
+
+      k++;
+
+      if (use_heavy_quark_res && k%heavy_quark_check==0) {
+        if (mixed_precision) {
+          blas::copy(tmpS,y);
+          heavy_quark_res = sqrt(blas::xpyHeavyQuarkResidualNorm(xS, tmpS, rS).z);
+        } else {
+          heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(xS, rS).z);
+        }
+      }
+
+      // reliable update conditions
+      rNorm = sqrt(r2);
+      if (rNorm > maxrx) maxrx = rNorm;
+      if (rNorm > maxrr) maxrr = rNorm;
+      bool update = (rNorm < reliable_delta*r0Norm && r0Norm <= maxrx); // condition for x
+      update = ( update || (rNorm < reliable_delta*maxrr && r0Norm <= maxrr)); // condition for r
+
+      // force a reliable update if we are within target tolerance,
+      // since the recurred residual of pipelined CG can drift from
+      // the true one even in uniform precision
+      if ( convergence(r2, heavy_quark_res, stop, param.tol_hq) ) update = true;
+
+      if (update) {
+        if (mixed_precision) {
+          // accumulate the sloppy solution into y
+          blas::copy(x, xS);
+          blas::xpy(x, y);
+          blas::zero(xS);
+          mat(r, y, x, tmp); //  here we can use x as tmp
+        } else {
+          mat(r, x, y, tmp);
+        }
+        r2 = blas::xmyNorm(b, r);
+        param.true_res = sqrt(r2 / b2);
+        if (use_heavy_quark_res) {
+          heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(mixed_precision ? y : x, r).z);
+          param.true_res_hq = heavy_quark_res;
+        }
+
+        if (!convergence(r2, heavy_quark_res, stop, param.tol_hq)) {
+          // residual replacement: recompute the recurred vectors from
+          // the true residual while keeping the search direction
+          if (mixed_precision) blas::copy(rS, r);
+          matSloppy(wS, rS, tmpS, tmp2S); // w = A r
+          matSloppy(sS, pS, tmpS, tmp2S); // s = A p
+          matSloppy(zS, sS, tmpS, tmp2S); // z = A s
+          reduce();
+          gamma = rw.z;
+          delta = rw.x;
+        }
+
+        // break-out check if we have reached the limit of the precision
+        if (r2 > r2_old) {
+          resIncrease++;
+          resIncreaseTotal++;
+          warningQuda("PipelinedCG: new reliable residual norm %e is greater than previous reliable residual norm %e (total #inc %i)",
+                      sqrt(r2), sqrt(r2_old), resIncreaseTotal);
+          if (resIncrease > maxResIncrease or resIncreaseTotal > maxResIncreaseTotal) {
+            warningQuda("PipelinedCG: solver exiting due to too many true residual norm increases");
+            break;
+          }
+        } else {
+          resIncrease = 0;
+        }
+
+        r2_old = r2;
+        rNorm = sqrt(r2);
+        maxrr = rNorm;
+        maxrx = rNorm;
+        r0Norm = rNorm;
+      }
+
+      PrintStats("PipelinedCG", k, r2, b2, heavy_quark_res);
+    }
+
+    if (mixed_precision) {
+      blas::copy(x, xS);
+      blas::xpy(y, x);
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    profile.TPSTART(QUDA_PROFILE_EPILOGUE);
+
+    param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = (blas::flops + mat.flops() + matSloppy.flops())*1e-9;
+    param.gflops = gflops;
+    param.iter += k;
+
+    if (k == param.maxiter)
+      warningQuda("Exceeded maximum iterations %d", param.maxiter);
+
+    // compute the true residuals
+    if (param.compute_true_res) {
+      mat(r, x, y, tmp);
+      param.true_res = sqrt(blas::xmyNorm(b, r) / b2);
+      if (use_heavy_quark_res) param.true_res_hq = sqrt(blas::HeavyQuarkResidualNorm(x, r).z);
+    }
+
+    if(param.preserve_source == QUDA_PRESERVE_SOURCE_NO) {
+      blas::copy(b, r);
+    }
+
+    PrintSummary("PipelinedCG", k, r2, b2, stop, param.tol_hq);
+
+    // reset the flops counters
+    blas::flops = 0;
+    mat.flops();
+    matSloppy.flops();
+
+    profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
+
+    return;
+  }
+
+} // namespace quda
@@ -5,6 +5,7 @@
 #include <unistd.h> // for getpagesize()
 #include <execinfo.h> // for backtrace
 #include <quda_internal.h>
+#include <numa_affinity.h>
 
 #ifdef USE_QDPJIT
 #include "qdp_quda.h"
@@ -63,6 +64,7 @@ namespace quda
   static long max_total_bytes[N_ALLOC_TYPE] = {0};
   static long total_host_bytes, max_total_host_bytes;
   static long total_pinned_bytes, max_total_pinned_bytes;
+  static long host_allocations = 0;
 
   long device_allocated_peak() { return max_total_bytes[DEVICE]; }
 
@@ -74,6 +76,8 @@ namespace quda
 
   long host_allocated_peak() { return max_total_bytes[HOST]; }
 
+  long host_allocation_count() { return host_allocations; }
+
   static void print_trace (void) {
     void *array[10];
     size_t size;
@@ -113,6 +117,7 @@ namespace quda
   static void track_malloc(const AllocType &type, const MemAlloc &a, void *ptr)
   {
     total_bytes[type] += a.base_size;
+    if (type == HOST) host_allocations++;
     if (total_bytes[type] > max_total_bytes[type]) {
       max_total_bytes[type] = total_bytes[type];
     }
@@ -171,6 +176,8 @@ namespace quda
       errorQuda("Failed to allocate aligned host memory of size %zu (%s:%d in %s())\n", size, a.file.c_str(), a.line,
                 a.func.c_str());
     }
+    // place the pages before they are touched by the registration
+    numaFirstTouch(ptr, a.base_size, numaPlacement());
     return ptr;
   }
 
@@ -285,6 +292,7 @@ namespace quda
 
     void *ptr = malloc(size);
     if (!ptr) { errorQuda("Failed to allocate host memory of size %zu (%s:%d in %s())\n", size, file, line, func); }
+    numaFirstTouch(ptr, size, numaPlacement());
     track_malloc(HOST, a, ptr);
 #ifdef HOST_DEBUG
     memset(ptr, 0xff, size);
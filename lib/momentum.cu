@@ -5,6 +5,7 @@
 #include <launch_kernel.cuh>
 #include <cub_helper.cuh>
 #include <instantiate.h>
+#include <momentum.h>
 #include <fstream>
 
 namespace quda {
@@ -151,6 +152,7 @@ namespace quda {
   double computeMomAction(const GaugeField& mom) {
     double action = 0.0;
 #ifdef GPU_GAUGE_TOOLS
+    if (mom.Location() == QUDA_CPU_FIELD_LOCATION) return computeMomActionCPU(mom);
     instantiate<MomAction, Reconstruct10>(mom, action);
 #else
     errorQuda("%s not build", __func__);
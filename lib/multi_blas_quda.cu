@@ -675,11 +675,26 @@ namespace quda {
 
     using range = std::pair<size_t,size_t>;
 
+    inline void axpy_host(double a, ColorSpinorField &x, ColorSpinorField &y) { axpy(a, x, y); }
+    inline void axpy_host(const Complex &a, ColorSpinorField &x, ColorSpinorField &y) { caxpy(a, x, y); }
+
     template <template <int MXZ, typename Float, typename FloatN> class Functor, typename T>
     void axpy_recurse(const T *a_, std::vector<ColorSpinorField *> &x, std::vector<ColorSpinorField *> &y,
                       const range &range_x, const range &range_y, int upper)
     {
       using write_ = write<0, 1, 0, 0>;
+      if (x[0]->Location() == QUDA_CPU_FIELD_LOCATION) {
+        // host fields are updated pair by pair, skipping the zero triangle of a triangular matrix
+        for (size_t i = 0; i < x.size(); i++) {
+          for (size_t j = 0; j < y.size(); j++) {
+            if (upper == 1 && range_y.first + j > range_x.first + i) continue;
+            if (upper == -1 && range_x.first + i > range_y.first + j) continue;
+            axpy_host(a_[i * y.size() + j], *x[i], *y[j]);
+          }
+        }
+        return;
+      }
+
       // if greater than max single-kernel size, recurse
       if (y.size() > (size_t)max_YW_size<write_>(x.size(), x[0]->Precision(), y[0]->Precision(), false, false, false)) {
         // We need to split up 'a' carefully since it's row-major.
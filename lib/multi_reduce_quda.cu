@@ -1175,6 +1175,18 @@ namespace quda {
     {
       using write_ = write<0, 0, 0, 0>;
       if (x.size() == 0 || y.size() == 0) errorQuda("vector.size() == 0");
+
+      if (x[0]->Location() == QUDA_CPU_FIELD_LOCATION) {
+        // host fields are reduced locally pair by pair, followed by a single multi-node reduction
+        const bool global_reduction = commGlobalReduction();
+        commGlobalReductionSet(false);
+        for (unsigned int i = 0; i < x.size(); i++)
+          for (unsigned int j = 0; j < y.size(); j++) result[i * y.size() + j] = reDotProduct(*x[i], *y[j]);
+        commGlobalReductionSet(global_reduction);
+        reduceDoubleArray(result, x.size() * y.size());
+        return;
+      }
+
       double *result_tmp = new double[x.size() * y.size()];
       for (unsigned int i = 0; i < x.size()*y.size(); i++) result_tmp[i] = 0.0;
 
@@ -1228,6 +1240,18 @@ namespace quda {
     {
       using write_ = write<0, 0, 0, 0>;
       if (x.size() == 0 || y.size() == 0) errorQuda("vector.size() == 0");
+
+      if (x[0]->Location() == QUDA_CPU_FIELD_LOCATION) {
+        // host fields are reduced locally pair by pair, followed by a single multi-node reduction
+        const bool global_reduction = commGlobalReduction();
+        commGlobalReductionSet(false);
+        for (unsigned int i = 0; i < x.size(); i++)
+          for (unsigned int j = 0; j < y.size(); j++) result[i * y.size() + j] = cDotProduct(*x[i], *y[j]);
+        commGlobalReductionSet(global_reduction);
+        reduceDoubleArray((double *)result, 2 * x.size() * y.size());
+        return;
+      }
+
       Complex *result_tmp = new Complex[x.size() * y.size()];
       for (unsigned int i = 0; i < x.size() * y.size(); i++) result_tmp[i] = 0.0;
 
@@ -1,6 +1,8 @@
 #include <multigrid.h>
 #include <qio_field.h>
 #include <string.h>
+#include <stdio.h>
+#include <memory>
 
 #include <eigensolve_quda.h>
 
@@ -11,6 +13,154 @@ namespace quda
 
   static bool debug = false;
 
+  /**
+     A hierarchy checkpoint stores, for each level but the coarsest,
+     the null-space vectors, the block-orthonormal basis that defines
+     the transfer operator and the coarse link fields Y, X, Yhat and
+     Xinv.  Each process reads and writes its local part of a level in
+     its own file, whose header holds a fingerprint of the gauge field
+     and of the parameters that define the hierarchy.  Fields are
+     stored as raw bytes in their native order, so the precisions,
+     setup locations and process grid must match, which the
+     fingerprint covers.  The same methods are used for writing and
+     reading, so the two cannot go out of step.
+  */
+  class HierarchyCheckpoint
+  {
+    struct Header {
+      char magic[8];
+      uint64_t fingerprint;
+      int level;
+      int n_rank;
+    };
+
+    const std::string filename;
+    const bool write;
+    FILE *fp;
+
+    void io(void *data, size_t bytes, QudaFieldLocation location)
+    {
+      if (bytes == 0) return;
+      void *buffer = location == QUDA_CUDA_FIELD_LOCATION ? safe_malloc(bytes) : data;
+      if (write) {
+        if (location == QUDA_CUDA_FIELD_LOCATION) qudaMemcpy(buffer, data, bytes, cudaMemcpyDeviceToHost);
+        if (fwrite(buffer, 1, bytes, fp) != bytes) errorQuda("Failed to write %lu bytes to %s", bytes, filename.c_str());
+      } else {
+        if (fread(buffer, 1, bytes, fp) != bytes) errorQuda("Failed to read %lu bytes from %s", bytes, filename.c_str());
+        if (location == QUDA_CUDA_FIELD_LOCATION) qudaMemcpy(data, buffer, bytes, cudaMemcpyHostToDevice);
+      }
+      if (location == QUDA_CUDA_FIELD_LOCATION) host_free(buffer);
+    }
+
+    // every field is preceded by its size, which is checked on read, and its scale
+    void record(LatticeField &field, size_t bytes)
+    {
+      uint64_t size = bytes;
+      double scale = field.Scale();
+      io(&size, sizeof(size), QUDA_CPU_FIELD_LOCATION);
+      io(&scale, sizeof(scale), QUDA_CPU_FIELD_LOCATION);
+      if (!write) {
+        if (size != bytes) errorQuda("Field of %lu bytes in %s, expected %lu", size, filename.c_str(), bytes);
+        field.Scale(scale);
+      }
+    }
+
+    void field(ColorSpinorField &v)
+    {
+      record(v, v.Bytes() + v.NormBytes());
+      io(v.V(), v.Bytes(), v.Location());
+      io(v.Norm(), v.NormBytes(), v.Location());
+    }
+
+    void field(GaugeField &u)
+    {
+      record(u, u.Bytes());
+      if (u.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        io(u.Gauge_p(), u.Bytes(), QUDA_CUDA_FIELD_LOCATION);
+      } else {
+        if (u.Order() != QUDA_QDP_GAUGE_ORDER) errorQuda("Unsupported gauge order %d", u.Order());
+        // QDP-ordered host fields hold one allocation per direction
+        size_t dim_bytes = (size_t)u.Volume() * 2 * u.Ncolor() * u.Ncolor() * u.Precision();
+        for (size_t d = 0; d < u.Bytes() / dim_bytes; d++)
+          io(static_cast<void **>(u.Gauge_p())[d], dim_bytes, QUDA_CPU_FIELD_LOCATION);
+      }
+    }
+
+    static Header header(uint64_t fingerprint, int level)
+    {
+      return Header {{'Q', 'U', 'D', 'A', 'M', 'G', 'C', 'P'}, fingerprint, level, comm_size()};
+    }
+
+  public:
+    static std::string fileName(const char *prefix, int level)
+    {
+      return std::string(prefix) + "_level_" + std::to_string(level) + "_rank_" + std::to_string(comm_rank());
+    }
+
+    HierarchyCheckpoint(const char *prefix, int level, uint64_t fingerprint, bool write) :
+      filename(fileName(prefix, level)),
+      write(write),
+      fp(fopen(filename.c_str(), write ? "wb" : "rb"))
+    {
+      if (!fp) errorQuda("Failed to open hierarchy checkpoint %s", filename.c_str());
+      Header h = header(fingerprint, level);
+      Header h_file = h;
+      io(&h_file, sizeof(Header), QUDA_CPU_FIELD_LOCATION);
+      if (memcmp(&h, &h_file, sizeof(Header)) != 0)
+        errorQuda("Hierarchy checkpoint %s does not match this hierarchy", filename.c_str());
+    }
+
+    ~HierarchyCheckpoint() { fclose(fp); }
+
+    /**
+       @brief Check the header of a checkpoint file without failing
+    */
+    static bool matches(const char *prefix, int level, uint64_t fingerprint)
+    {
+      FILE *fp = fopen(fileName(prefix, level).c_str(), "rb");
+      if (!fp) return false;
+      Header h = header(fingerprint, level);
+      Header h_file;
+      bool match = fread(&h_file, sizeof(Header), 1, fp) == 1 && memcmp(&h, &h_file, sizeof(Header)) == 0;
+      fclose(fp);
+      return match;
+    }
+
+    /**
+       @brief Write or read the null-space vectors and the
+       block-orthonormal basis of the transfer operator.  The top level
+       of a staggered hierarchy holds neither, since its fields are
+       only metadata containers.
+    */
+    void transfer(std::vector<ColorSpinorField *> &B, Transfer &T, bool staggered_top)
+    {
+      if (staggered_top) return;
+      for (auto b : B) field(*b);
+      field(B[0]->Location() == QUDA_CUDA_FIELD_LOCATION ? *T.V_d : *T.V_h);
+    }
+
+    /**
+       @brief Write or read the coarse links in the location where
+       they are constructed.  On read, the halos are exchanged as
+       after the construction of the preconditioned links.
+    */
+    void links(DiracCoarse &D)
+    {
+      GaugeField *Y = D.gpu_setup ? static_cast<GaugeField *>(D.Y_d) : D.Y_h;
+      GaugeField *X = D.gpu_setup ? static_cast<GaugeField *>(D.X_d) : D.X_h;
+      GaugeField *Yhat = D.gpu_setup ? static_cast<GaugeField *>(D.Yhat_d) : D.Yhat_h;
+      GaugeField *Xinv = D.gpu_setup ? static_cast<GaugeField *>(D.Xinv_d) : D.Xinv_h;
+      field(*Y);
+      field(*X);
+      field(*Yhat);
+      field(*Xinv);
+      if (!write) {
+        Y->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+        Yhat->exchangeGhost(QUDA_LINK_FORWARDS);
+      }
+    }
+  };
+
   MG::MG(MGParam &param, TimeProfile &profile_global) :
     Solver(param, profile),
     param(param),
@@ -41,11 +191,14 @@ namespace quda
     matCoarseResidual(nullptr),
     matCoarseSmoother(nullptr),
     matCoarseSmootherSloppy(nullptr),
-    rng(nullptr)
+    rng(nullptr),
+    adaptive_refresh(param.level == 0 && param.mg_global.adaptive_refresh == QUDA_BOOLEAN_TRUE)
   {
     sprintf(prefix, "MG level %d (%s): ", param.level, param.location == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU");
     pushLevel(param.level);
 
+    if (adaptive_refresh) refresh_policy.growth = param.mg_global.refresh_growth;
+
     if (param.level >= QUDA_MAX_MG_LEVEL)
       errorQuda("Level=%d is greater than limit of multigrid recursion depth", param.level);
 
@@ -77,7 +230,9 @@ namespace quda
     rng = new RNG(*param.B[0], 1234);
     rng->Init();
 
-    if (param.level != 0 || !param.is_staggered) {
+    if (param.load_checkpoint) {
+      // the null-space vectors are restored with the rest of the level in reset()
+    } else if (param.level != 0 || !param.is_staggered) {
       if (param.level < param.Nlevel - 1) {
         if (param.mg_global.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_YES) {
           if (param.mg_global.generate_all_levels == QUDA_BOOLEAN_TRUE || param.level == 0) {
@@ -115,6 +270,85 @@ namespace quda
     popLevel(param.level);
   }
 
+  bool MGRefreshPolicy::refresh()
+  {
+    if (n_solve == 0) return false;
+
+    double mean_iter = iter / n_solve;
+    double mean_coarse_secs = iter > 0 ? coarse_secs / iter : 0.0;
+
+    if (!baseline_set) {
+      baseline_iter = mean_iter;
+      baseline_coarse_secs = mean_coarse_secs;
+      baseline_set = true;
+      return false;
+    }
+
+    return mean_iter > growth * baseline_iter || mean_coarse_secs > growth * baseline_coarse_secs;
+  }
+
+  void MGRefreshPolicy::update(bool refreshed, double secs)
+  {
+    if (refreshed) {
+      // the next interval sets the new baseline
+      baseline_set = false;
+      refresh_secs = secs;
+      n_refresh++;
+      if (n_pending > 0) {
+        secs_saved += std::max(n_pending * refresh_secs - pending_secs, 0.0);
+        pending_secs = 0.0;
+        n_pending = 0;
+      }
+    } else {
+      if (n_refresh > 0) {
+        secs_saved += std::max(refresh_secs - secs, 0.0);
+      } else {
+        pending_secs += secs;
+        n_pending++;
+      }
+      n_rebuild++;
+    }
+
+    n_solve = 0;
+    iter = 0.0;
+    coarse_secs = 0.0;
+  }
+
+  bool MG::update()
+  {
+    if (!adaptive_refresh) {
+      reset(true);
+      return true;
+    }
+
+    pushLevel(param.level);
+    double mean_iter = refresh_policy.n_solve ? refresh_policy.iter / refresh_policy.n_solve : 0.0;
+    bool refresh = refresh_policy.refresh();
+    popLevel(param.level);
+
+    Timer timer;
+    timer.Start(__func__, __FILE__, __LINE__);
+    reset(refresh);
+    qudaDeviceSynchronize();
+    timer.Stop(__func__, __FILE__, __LINE__);
+
+    pushLevel(param.level);
+    refresh_policy.update(refresh, timer.Last());
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      printfQuda("Adaptive refresh: mean outer iterations %.1f (baseline %.1f), %s in %.3f secs, %.3f secs saved so far\n",
+                 mean_iter, refresh_policy.baseline_iter, refresh ? "refreshed null space" : "rebuilt coarse operators",
+                 timer.Last(), refresh_policy.secs_saved);
+    }
+    popLevel(param.level);
+
+    return refresh;
+  }
+
+  void MG::recordSolve(int iter)
+  {
+    if (adaptive_refresh) refresh_policy.recordSolve(iter);
+  }
+
   void MG::reset(bool refresh) {
     pushLevel(param.level);
 
@@ -128,6 +362,8 @@ namespace quda
     diracSmoother = param.matSmooth->Expose();
     diracSmootherSloppy = param.matSmoothSloppy->Expose();
 
+    std::unique_ptr<HierarchyCheckpoint> checkpoint;
+
     // Check if we're on the top level of a staggered MG build.
     if (param.level != 0 || !param.is_staggered) {
       // Refresh the null-space vectors if we need to
@@ -147,11 +383,20 @@ namespace quda
           resetTransfer = false;
         }
       } else {
+        // when restoring from a checkpoint, the null-space vectors, the
+        // transfer operator and the coarse links are read rather than computed
+        if (param.load_checkpoint) {
+          checkpoint.reset(
+            new HierarchyCheckpoint(param.mg_global.checkpoint_infile, param.level, param.checkpoint_fingerprint, false));
+          if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Restoring level from hierarchy checkpoint\n");
+        }
+
         // create transfer operator
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating transfer operator\n");
         transfer = new Transfer(param.B, param.Nvec, param.NblockOrtho, param.geoBlockSize, param.spinBlockSize,
-                                param.mg_global.precision_null[param.level], profile);
+                                param.mg_global.precision_null[param.level], profile, !checkpoint);
         for (int i=0; i<QUDA_MAX_MG_LEVEL; i++) param.mg_global.geo_block_size[param.level][i] = param.geoBlockSize[i];
+        if (checkpoint) checkpoint->transfer(param.B, *transfer, param.level == 0 && param.is_staggered);
 
         // create coarse temporary vector if not already created in verify()
         if (!tmp_coarse)
@@ -185,10 +430,9 @@ namespace quda
         // if we're not generating on all levels then we need to propagate the vectors down
         if ((param.level != 0 || param.Nlevel - 1) && param.mg_global.generate_all_levels == QUDA_BOOLEAN_FALSE) {
           if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Restricting null space vectors\n");
-          for (int i=0; i<param.Nvec; i++) {
-            zero(*(*B_coarse)[i]);
-            transfer->R(*(*B_coarse)[i], *(param.B[i]));
-          }
+          std::vector<ColorSpinorField *> B_coarse_(B_coarse->begin(), B_coarse->begin() + param.Nvec);
+          std::vector<ColorSpinorField *> B_(param.B.begin(), param.B.begin() + param.Nvec);
+          transfer->R(B_coarse_, B_);
         }
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Transfer operator done\n");
       }
@@ -197,7 +441,11 @@ namespace quda
       // (only if using managed memory and prefetching is enabled, otherwise no-op)
       for (int i = 0; i < param.Nvec; i++) { param.B[i]->prefetch(QUDA_CPU_FIELD_LOCATION); }
 
-      createCoarseDirac();
+      createCoarseDirac(!checkpoint);
+      if (checkpoint) {
+        checkpoint->links(static_cast<DiracCoarse &>(*diracCoarseResidual));
+        checkpoint.reset();
+      }
     }
 
     // delay allocating smoother until after coarse-links have been created
@@ -341,7 +589,7 @@ namespace quda
     popLevel(param.level);
   }
 
-  void MG::createCoarseDirac() {
+  void MG::createCoarseDirac(bool compute_links) {
     pushLevel(param.level);
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating coarse Dirac operator\n");
@@ -383,7 +631,8 @@ namespace quda
     // use even-odd preconditioning for the coarse grid solver
     if (diracCoarseResidual) delete diracCoarseResidual;
     diracCoarseResidual = new DiracCoarse(diracParam, param.setup_location == QUDA_CUDA_FIELD_LOCATION ? true : false,
-                                          param.mg_global.setup_minimize_memory == QUDA_BOOLEAN_TRUE ? true : false);
+                                          param.mg_global.setup_minimize_memory == QUDA_BOOLEAN_TRUE ? true : false,
+                                          compute_links);
 
     // create smoothing operators
     diracParam.dirac = const_cast<Dirac*>(param.matSmooth->Expose());
@@ -643,6 +892,9 @@ namespace quda
     if (param_coarse) delete param_coarse;
 
     if (getVerbosity() >= QUDA_VERBOSE) profile.Print();
+    if (adaptive_refresh && getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Adaptive refresh: %d null-space refreshes, %d coarse-operator rebuilds, %.3f secs refresh saved\n",
+                 refresh_policy.n_refresh, refresh_policy.n_rebuild, refresh_policy.secs_saved);
 
     popLevel(param.level);
   }
@@ -992,6 +1244,9 @@ namespace quda
       }
     }
 
+    // the batched setup relaxes this level with its multi-source operator
+    if (param.level > 0 && param.mg_global.setup_batch_size[param.level] > 1) verifyBatched(tol);
+
     delete tmp1;
     delete tmp2;
     delete tmp_coarse;
@@ -1082,8 +1337,15 @@ namespace quda
         transfer->R(*r_coarse, residual);
         if ( debug ) printfQuda("after pre-smoothing x2 = %e, r2 = %e, r_coarse2 = %e\n", norm2(x), r2, norm2(*r_coarse));
 
-        // recurse to the next lower level
+        // recurse to the next lower level, timing the solve for the refresh controller
+        Timer coarse_timer;
+        if (adaptive_refresh) coarse_timer.Start(__func__, __FILE__, __LINE__);
         (*coarse_solver)(*x_coarse, *r_coarse);
+        if (adaptive_refresh) {
+          qudaDeviceSynchronize();
+          coarse_timer.Stop(__func__, __FILE__, __LINE__);
+          refresh_policy.coarse_secs += coarse_timer.Last();
+        }
         if (debug) printfQuda("after coarse solve x_coarse2 = %e r_coarse2 = %e\n", norm2(*x_coarse), norm2(*r_coarse));
 
         // prolongate back to this grid
@@ -1189,10 +1451,53 @@ namespace quda
     if (param.level < param.Nlevel - 2) coarse->dumpNullVectors();
   }
 
+  void MG::saveCheckpoint(const char *prefix, uint64_t fingerprint) const
+  {
+    if (param.level >= param.Nlevel - 1) return;
+    pushLevel(param.level);
+    profile_global.TPSTART(QUDA_PROFILE_IO);
+    {
+      HierarchyCheckpoint checkpoint(prefix, param.level, fingerprint, true);
+      checkpoint.transfer(param.B, *transfer, param.level == 0 && param.is_staggered);
+      checkpoint.links(static_cast<DiracCoarse &>(*diracCoarseResidual));
+    }
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Saved level to hierarchy checkpoint %s\n", prefix);
+    profile_global.TPSTOP(QUDA_PROFILE_IO);
+    popLevel(param.level);
+    coarse->saveCheckpoint(prefix, fingerprint);
+  }
+
+  bool MG::checkpointMatches(const char *prefix, int n_level, uint64_t fingerprint)
+  {
+    int mismatch = 0;
+    for (int l = 0; l < n_level - 1; l++)
+      if (!HierarchyCheckpoint::matches(prefix, l, fingerprint)) mismatch = 1;
+    comm_allreduce_int(&mismatch);
+    return mismatch == 0;
+  }
+
+  /**
+     Orthonormalize the null-space vectors with block Gram-Schmidt,
+     and at verbose level report the orthogonality loss and the number
+     of global reductions compared to pairwise Gram-Schmidt.
+  */
+  static void orthonormalizeNullVectors(std::vector<ColorSpinorField *> &B)
+  {
+    const bool verbose = getVerbosity() >= QUDA_VERBOSE;
+    double loss = 0.0;
+    int reductions = blockOrthonormalize(B, 8, verbose ? &loss : nullptr);
+    if (verbose)
+      printfQuda("Orthonormalized %lu vectors with %d reductions (%lu pairwise), orthogonality loss %e\n", B.size(),
+                 reductions, B.size() * (B.size() + 1) / 2, loss);
+  }
+
   void MG::generateNullVectors(std::vector<ColorSpinorField *> &B, bool refresh)
   {
     pushLevel(param.level);
 
+    Timer setup_timer;
+    setup_timer.Start(__func__, __FILE__, __LINE__);
+
     SolverParam solverParam(param); // Set solver field parameters:
     // set null-space generation options - need to expose these
     solverParam.maxiter
@@ -1247,10 +1552,26 @@ namespace quda
     QudaPrecision halo_precision = diracSmootherSloppy->HaloPrecision();
     if (halo_precision == QUDA_QUARTER_PRECISION) diracSmootherSloppy->setHaloPrecision(QUDA_HALF_PRECISION);
 
-    Solver *solve;
-    DiracMdagM *mdagm = (solverParam.inv_type == QUDA_CG_INVERTER || solverParam.inv_type == QUDA_CA_CG_INVERTER) ? new DiracMdagM(*diracSmoother) : nullptr;
-    DiracMdagM *mdagmSloppy = (solverParam.inv_type == QUDA_CG_INVERTER || solverParam.inv_type == QUDA_CA_CG_INVERTER) ? new DiracMdagM(*diracSmootherSloppy) : nullptr;
-    if (solverParam.inv_type == QUDA_CG_INVERTER || solverParam.inv_type == QUDA_CA_CG_INVERTER) {
+    // batching needs the multi-source coarse operator, so the fine grid
+    // is relaxed one vector at a time, and the batch is relaxed with
+    // minimal-residual iterations, so other setup solvers are not batched
+    bool batched = param.mg_global.setup_batch_size[param.level] > 1;
+    if (batched && param.level == 0) {
+      warningQuda("Batched null-space setup requires a coarse operator, relaxing level 0 vectors one at a time");
+      batched = false;
+    }
+    if (batched && solverParam.inv_type != QUDA_MR_INVERTER) {
+      warningQuda("Batched null-space setup requires the MR setup solver, not %d, relaxing level %d vectors one at a time",
+                  solverParam.inv_type, param.level);
+      batched = false;
+    }
+
+    Solver *solve = nullptr; // the batched relaxation does not use a solver
+    const bool normal_op
+      = !batched && (solverParam.inv_type == QUDA_CG_INVERTER || solverParam.inv_type == QUDA_CA_CG_INVERTER);
+    DiracMdagM *mdagm = normal_op ? new DiracMdagM(*diracSmoother) : nullptr;
+    DiracMdagM *mdagmSloppy = normal_op ? new DiracMdagM(*diracSmootherSloppy) : nullptr;
+    if (normal_op) {
       solve = Solver::create(solverParam, *mdagm, *mdagmSloppy, *mdagmSloppy, profile);
     } else if(solverParam.inv_type == QUDA_MG_INVERTER) {
       // in case MG has not been created, we create the Smoother
@@ -1271,7 +1592,7 @@ namespace quda
       solverParam.inv_type = QUDA_GCR_INVERTER;
       solve = Solver::create(solverParam, *param.matSmooth, *param.matSmooth, *param.matSmoothSloppy, profile);
       solverParam.inv_type = QUDA_MG_INVERTER;
-    } else {
+    } else if (!batched) {
       solve = Solver::create(solverParam, *param.matSmooth, *param.matSmoothSloppy, *param.matSmoothSloppy, profile);
     }
 
@@ -1281,20 +1602,12 @@ namespace quda
                    param.mg_global.num_setup_iter[param.level]);
 
       // global orthonormalization of the initial null-space vectors
-      if(param.mg_global.pre_orthonormalize) {
-        for(int i=0; i<(int)B.size(); i++) {
-          for (int j=0; j<i; j++) {
-            Complex alpha = cDotProduct(*B[j], *B[i]);// <j,i>
-            caxpy(-alpha, *B[j], *B[i]); // i-<j,i>j
-          }
-          double nrm2 = norm2(*B[i]);
-          if (nrm2 > 1e-16) ax(1.0 /sqrt(nrm2), *B[i]);// i/<i,i>
-          else errorQuda("\nCannot normalize %u vector\n", i);
-        }
-      }
+      if (param.mg_global.pre_orthonormalize) orthonormalizeNullVectors(B);
+
+      if (batched) relaxNullVectorsBatched(B, solverParam.maxiter, solverParam.tol);
 
       // launch solver for each source
-      for (int i=0; i<(int)B.size(); i++) {
+      for (int i = 0; i < (batched ? 0 : (int)B.size()); i++) {
         if (param.mg_global.setup_type == QUDA_TEST_VECTOR_SETUP) { // DDalphaAMG test vector idea
           *b = *B[i];  // inverting against the vector
           zero(*x);    // with zero initial guess
@@ -1316,17 +1629,7 @@ namespace quda
       }
 
       // global orthonormalization of the generated null-space vectors
-      if (param.mg_global.post_orthonormalize) {
-        for(int i=0; i<(int)B.size(); i++) {
-          for (int j=0; j<i; j++) {
-            Complex alpha = cDotProduct(*B[j], *B[i]);// <j,i>
-            caxpy(-alpha, *B[j], *B[i]); // i-<j,i>j
-          }
-          double nrm2 = norm2(*B[i]);
-          if (sqrt(nrm2) > 1e-16) ax(1.0/sqrt(nrm2), *B[i]);// i/<i,i>
-          else errorQuda("\nCannot normalize %u vector (nrm=%e)\n", i, sqrt(nrm2));
-        }
-      }
+      if (param.mg_global.post_orthonormalize) orthonormalizeNullVectors(B);
 
       if (solverParam.inv_type == QUDA_MG_INVERTER) {
 
@@ -1338,10 +1641,9 @@ namespace quda
               coarse->generateNullVectors(*B_coarse, refresh);
             } else {
               if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Restricting null space vectors\n");
-              for (int i=0; i<param.Nvec; i++) {
-                zero(*(*B_coarse)[i]);
-                transfer->R(*(*B_coarse)[i], *(param.B[i]));
-              }
+              std::vector<ColorSpinorField *> B_coarse_(B_coarse->begin(), B_coarse->begin() + param.Nvec);
+              std::vector<ColorSpinorField *> B_(param.B.begin(), param.B.begin() + param.Nvec);
+              transfer->R(B_coarse_, B_);
               // rebuild the transfer operator in the coarse level
               coarse->resetTransfer = true;
               coarse->reset();
@@ -1353,7 +1655,7 @@ namespace quda
       }
     }
 
-    delete solve;
+    if (solve) delete solve;
     if (mdagm) delete mdagm;
     if (mdagmSloppy) delete mdagmSloppy;
 
@@ -1370,6 +1672,11 @@ namespace quda
       diracSmootherSloppy->setCommDim(commDim);
     }
 
+    setup_timer.Stop(__func__, __FILE__, __LINE__);
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Null-space generation on level %d took %e secs%s\n", param.level, setup_timer.Last(),
+                 batched ? " (batched)" : "");
+
     if (param.mg_global.vec_store[param.level] == QUDA_BOOLEAN_TRUE) { // conditional store of null vectors
       saveVectors(B);
     }
@@ -1377,6 +1684,205 @@ namespace quda
     popLevel(param.level);
   }
 
+  /**
+     @brief Create a four-dimensional reference to slice s of a
+     five-dimensional field.  The reference keeps the stride of the
+     five-dimensional field (through its pad), so the blas kernels
+     only see the sites of that slice.
+  */
+  static ColorSpinorField *createSliceReference(ColorSpinorField &field, int s)
+  {
+    const int volumeCB = field.VolumeCB() / field.X(4);
+    ColorSpinorParam param(field);
+    param.nDim = 4;
+    param.x[4] = 1;
+    param.pad = field.Stride() - volumeCB;
+    param.create = QUDA_REFERENCE_FIELD_CREATE;
+    param.v = static_cast<char *>(field.V()) + (size_t)s * volumeCB * field.FieldOrder() * field.Precision();
+    if (field.Precision() == QUDA_HALF_PRECISION || field.Precision() == QUDA_QUARTER_PRECISION)
+      param.norm = static_cast<char *>(field.Norm()) + (size_t)s * volumeCB * sizeof(float);
+    return new cudaColorSpinorField(param);
+  }
+
+  void MG::relaxNullVectorsBatched(std::vector<ColorSpinorField *> &B, int maxiter, double tol, int batch)
+  {
+    const int n_vec = B.size();
+    batch = std::min(batch > 0 ? batch : param.mg_global.setup_batch_size[param.level], n_vec);
+    const bool test_vector = param.mg_global.setup_type == QUDA_TEST_VECTOR_SETUP;
+    const DiracMatrix &mat = *param.matResidual;
+
+    // the batch is the fifth dimension of the work fields, which the
+    // coarse operator treats as independent sources sharing the links
+    ColorSpinorParam csParam(*B[0]);
+    csParam.setPrecision(r->Precision(), r->Precision(), true); // ensure native ordering
+    csParam.location = QUDA_CUDA_FIELD_LOCATION;
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    csParam.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
+    ColorSpinorField *v = new cudaColorSpinorField(csParam); // staging field, since B may be on the host
+    if (batch > 1) {
+      csParam.nDim = 5;
+      csParam.x[4] = batch;
+      csParam.pc_type = QUDA_4D_PC;
+    }
+    ColorSpinorField *x5 = new cudaColorSpinorField(csParam);
+    ColorSpinorField *r5 = new cudaColorSpinorField(csParam);
+    ColorSpinorField *Ar5 = new cudaColorSpinorField(csParam);
+
+    std::vector<ColorSpinorField *> xb(batch), rb(batch), Arb(batch);
+    for (int s = 0; s < batch; s++) {
+      xb[s] = createSliceReference(*x5, s);
+      rb[s] = createSliceReference(*r5, s);
+      Arb[s] = createSliceReference(*Ar5, s);
+    }
+
+    long long applications = 0;     // batched operator applications
+    long long vec_applications = 0; // applications one vector at a time would need
+    int converged = 0;
+
+    for (int i0 = 0; i0 < n_vec; i0 += batch) {
+      const int n = std::min(batch, n_vec - i0);
+
+      // unused slices of the last batch are zero and stay zero
+      ax(0.0, *x5);
+      ax(0.0, *r5);
+      for (int s = 0; s < n; s++) {
+        *v = *B[i0 + s];
+        axpy(1.0, *v, test_vector ? *rb[s] : *xb[s]);
+      }
+
+      if (!test_vector) { // r = -A x, since we are solving A x = 0
+        mat(*Ar5, *x5);
+        axpy(-1.0, *Ar5, *r5);
+        applications++;
+        vec_applications += n;
+      }
+
+      std::vector<double> r2(n), r2_0(n);
+      std::vector<int> iter(n, 0);
+      std::vector<bool> active(n);
+      int n_active = 0;
+      for (int s = 0; s < n; s++) {
+        r2_0[s] = r2[s] = norm2(*rb[s]);
+        active[s] = r2[s] > 0.0;
+        if (active[s]) n_active++;
+      }
+
+      int k = 0;
+      while (n_active > 0 && k < maxiter) {
+        mat(*Ar5, *r5);
+        applications++;
+
+        // per-vector minimal residual step: x += alpha r, r -= alpha Ar
+        for (int s = 0; s < n; s++) {
+          if (!active[s]) continue;
+          double3 Arr = cDotProductNormA(*Arb[s], *rb[s]);
+          Complex alpha = Complex(Arr.x, Arr.y) / Arr.z;
+          r2[s] = caxpyXmazNormX(alpha, *rb[s], *xb[s], *Arb[s]);
+          iter[s]++;
+          vec_applications++;
+          if (r2[s] < tol * tol * r2_0[s]) {
+            active[s] = false;
+            n_active--;
+          }
+        }
+        k++;
+      }
+
+      for (int s = 0; s < n; s++) {
+        if (getVerbosity() >= QUDA_VERBOSE)
+          printfQuda("Vector %d: %s after %d iterations, residual reduction %e\n", i0 + s,
+                     active[s] ? "not converged" : "converged", iter[s], r2_0[s] > 0.0 ? sqrt(r2[s] / r2_0[s]) : 0.0);
+        if (!active[s]) converged++;
+        // store the relaxed vector back
+        ax(0.0, *v);
+        axpy(1.0, *xb[s], *v);
+        *B[i0 + s] = *v;
+      }
+    }
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Batched setup on level %d: %d of %d vectors converged, %lld batched operator applications "
+                 "in place of %lld (%.1fx less link traffic)\n",
+                 param.level, converged, n_vec, applications, vec_applications,
+                 applications > 0 ? (double)vec_applications / applications : 1.0);
+
+    for (int s = 0; s < batch; s++) {
+      delete Arb[s];
+      delete rb[s];
+      delete xb[s];
+    }
+    delete Ar5;
+    delete r5;
+    delete x5;
+    delete v;
+  }
+
+  void MG::verifyBatched(double tol)
+  {
+    const int batch = param.mg_global.setup_batch_size[param.level];
+    const DiracMatrix &mat = *param.matResidual;
+
+    ColorSpinorParam csParam(*r);
+    csParam.setPrecision(r->Precision(), r->Precision(), true); // ensure native ordering
+    csParam.location = QUDA_CUDA_FIELD_LOCATION;
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    csParam.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
+    std::vector<ColorSpinorField *> B_batch(param.Nvec), B_single(param.Nvec);
+    for (int i = 0; i < param.Nvec; i++) {
+      B_batch[i] = new cudaColorSpinorField(csParam);
+      B_single[i] = new cudaColorSpinorField(csParam);
+      spinorNoise(*B_batch[i], *rng, QUDA_NOISE_UNIFORM);
+      *B_single[i] = *B_batch[i];
+    }
+    ColorSpinorField *Ax = new cudaColorSpinorField(csParam);
+    csParam.nDim = 5;
+    csParam.x[4] = batch;
+    csParam.pc_type = QUDA_4D_PC;
+    ColorSpinorField *x5 = new cudaColorSpinorField(csParam);
+    ColorSpinorField *Ax5 = new cudaColorSpinorField(csParam);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Checking 0 = D x_s - (D x)_s for a %d-source field\n", batch);
+
+    for (int s = 0; s < batch; s++) {
+      ColorSpinorField *xs = createSliceReference(*x5, s);
+      axpy(1.0, *B_batch[s % param.Nvec], *xs); // x5 is zero, and the slice keeps its 5-d stride
+      delete xs;
+    }
+    mat(*Ax5, *x5);
+
+    for (int s = 0; s < batch; s++) {
+      ColorSpinorField *Axs = createSliceReference(*Ax5, s);
+      mat(*Ax, *B_batch[s % param.Nvec]);
+      double deviation = sqrt(xmyNorm(*Ax, *Axs) / norm2(*Ax));
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Source %d: L2 relative deviation = %e\n", s, deviation);
+      if (deviation > tol) errorQuda("Source %d failed, deviation = %e (tol=%e)", s, deviation, tol);
+      delete Axs;
+    }
+
+    // a fixed number of iterations, so both relaxations take the same steps
+    const int n_iter = 8;
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Checking batched against per-vector relaxation of %d vectors, %d iterations\n", param.Nvec, n_iter);
+
+    relaxNullVectorsBatched(B_batch, n_iter, 0.0, batch);
+    relaxNullVectorsBatched(B_single, n_iter, 0.0, 1);
+
+    for (int i = 0; i < param.Nvec; i++) {
+      double deviation = sqrt(xmyNorm(*B_single[i], *B_batch[i]) / norm2(*B_single[i]));
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Vector %d: L2 relative deviation = %e\n", i, deviation);
+      if (deviation > tol) errorQuda("Vector %d failed, deviation = %e (tol=%e)", i, deviation, tol);
+    }
+
+    delete Ax5;
+    delete x5;
+    delete Ax;
+    for (int i = 0; i < param.Nvec; i++) {
+      delete B_single[i];
+      delete B_batch[i];
+    }
+  }
+
   // generate a full span of free vectors.
   // FIXME: Assumes fine level is SU(3).
   void MG::buildFreeVectors(std::vector<ColorSpinorField *> &B)
@@ -1541,13 +2047,7 @@ namespace quda
     }
 
     // global orthonormalization of the generated null-space vectors
-    if(param.mg_global.post_orthonormalize) {
-      for(int i=0; i<(int)B.size(); i++) {
-        double nrm2 = norm2(*B[i]);
-        if (nrm2 > 1e-16) ax(1.0 /sqrt(nrm2), *B[i]);// i/<i,i>
-        else errorQuda("\nCannot normalize %u vector\n", i);
-      }
-    }
+    if (param.mg_global.post_orthonormalize) orthonormalizeNullVectors(B);
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Done building free vectors\n");
 
@@ -4,8 +4,25 @@
  *
  */
 
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <numa_affinity.h>
 #include <quda_internal.h>
+#include <comm_quda.h>
 
 #if ((CUDA_VERSION >= 6000) && defined NUMA_NVML)
 #include <nvml.h>
@@ -51,3 +68,230 @@ int setNumaAffinityNVML(int devid)
   return -1;
 #endif
 }
+
+/**
+ * parse a sysfs cpu/node list of the form "0-3,8,10-11"
+ */
+static std::vector<int> parseSysfsList(const char *path)
+{
+  std::vector<int> list;
+  FILE *f = fopen(path, "r");
+  if (!f) return list;
+
+  char buf[4096];
+  if (fgets(buf, sizeof(buf), f)) {
+    char *p = buf;
+    while (*p && *p != '\n') {
+      char *end;
+      int lo = strtol(p, &end, 10);
+      if (end == p) break;
+      int hi = lo;
+      p = end;
+      if (*p == '-') {
+        hi = strtol(p + 1, &end, 10);
+        p = end;
+      }
+      for (int i = lo; i <= hi; i++) list.push_back(i);
+      if (*p == ',') p++;
+    }
+  }
+  fclose(f);
+  return list;
+}
+
+static const std::vector<int> &numaNodes()
+{
+  static std::vector<int> nodes = parseSysfsList("/sys/devices/system/node/online");
+  return nodes;
+}
+
+static std::vector<int> numaNodeCpus(int node)
+{
+  char path[128];
+  sprintf(path, "/sys/devices/system/node/node%d/cpulist", node);
+  return parseSysfsList(path);
+}
+
+int numaNodeCount() { return std::max(static_cast<int>(numaNodes().size()), 1); }
+
+int numaNodeOfCpu(int cpu)
+{
+  static std::vector<int> node_of_cpu;
+  if (node_of_cpu.empty()) {
+    for (auto node : numaNodes()) {
+      for (auto c : numaNodeCpus(node)) {
+        if (c >= static_cast<int>(node_of_cpu.size())) node_of_cpu.resize(c + 1, 0);
+        node_of_cpu[c] = node;
+      }
+    }
+    if (node_of_cpu.empty()) node_of_cpu.push_back(0);
+  }
+  return cpu >= 0 && cpu < static_cast<int>(node_of_cpu.size()) ? node_of_cpu[cpu] : 0;
+}
+
+/**
+ * @return the NUMA node of the given device, or -1 if not reported
+ */
+static int numaNodeOfDevice(int devid)
+{
+#ifdef __linux__
+  char bus_id[32];
+  if (cudaDeviceGetPCIBusId(bus_id, sizeof(bus_id), devid) != cudaSuccess) return -1;
+  for (char *c = bus_id; *c; c++) *c = tolower(*c); // sysfs uses lower-case bus ids
+
+  std::string path = std::string("/sys/bus/pci/devices/") + bus_id + "/numa_node";
+  auto node = parseSysfsList(path.c_str());
+  return node.size() == 1 ? node[0] : -1;
+#else
+  return -1;
+#endif
+}
+
+int setNumaAffinitySysfs(int devid)
+{
+#ifdef __linux__
+  // the gathers are collective, so every rank takes part before deciding whether to bind
+  const int nranks = comm_size();
+  char *hostname_recv_buf = (char *)safe_malloc(128 * nranks);
+  int *gpuid_recv_buf = (int *)safe_malloc(sizeof(int) * nranks);
+  comm_gather_hostname(hostname_recv_buf);
+  comm_gather_gpuid(gpuid_recv_buf);
+
+  // find the ranks on this host whose device is on the same NUMA node
+  const int node = numaNodeOfDevice(devid);
+  int share_index = 0, share_count = 0;
+  for (int r = 0; node >= 0 && r < nranks; r++) {
+    if (strncmp(comm_hostname(), &hostname_recv_buf[128 * r], 128) != 0) continue;
+    if (numaNodeOfDevice(gpuid_recv_buf[r]) != node) continue;
+    if (r < comm_rank()) share_index++;
+    share_count++;
+  }
+  host_free(gpuid_recv_buf);
+  host_free(hostname_recv_buf);
+
+  if (node < 0) {
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("No NUMA node reported for device %d\n", devid);
+    return -1;
+  }
+
+  cpu_set_t current, mask;
+  if (sched_getaffinity(0, sizeof(current), &current) != 0) {
+    warningQuda("Failed to determine NUMA affinity for device %d (sched_getaffinity failed)", devid);
+    return -1;
+  }
+
+  std::vector<int> cpus;
+  auto node_cpus = numaNodeCpus(node);
+  for (auto cpu : node_cpus)
+    if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &current)) cpus.push_back(cpu);
+
+  if (cpus.empty()) {
+    warningQuda("Process is not bound to any cpu of NUMA node %d of device %d, leaving affinity unchanged", node, devid);
+    return -1;
+  }
+
+  // if the launcher has not restricted us within the node, split the node between the ranks that share it
+  if (cpus.size() == node_cpus.size() && share_count > 1 && static_cast<int>(cpus.size()) >= share_count) {
+    const size_t begin = (share_index * cpus.size()) / share_count;
+    const size_t end = ((share_index + 1) * cpus.size()) / share_count;
+    cpus = std::vector<int>(cpus.begin() + begin, cpus.begin() + end);
+  }
+
+  CPU_ZERO(&mask);
+  for (auto cpu : cpus) CPU_SET(cpu, &mask);
+  if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+    warningQuda("Failed to set NUMA affinity for device %d (sched_setaffinity failed)", devid);
+    return -1;
+  }
+
+  if (getVerbosity() >= QUDA_SUMMARIZE)
+    printfQuda("Set NUMA affinity for device %d to %lu cpus of NUMA node %d\n", devid, cpus.size(), node);
+  return 0;
+#else
+  warningQuda("Failed to determine NUMA affinity for device %d (sysfs not supported on this platform)", devid);
+  return -1;
+#endif
+}
+
+int bindHostThreads()
+{
+#if defined(__linux__) && defined(_OPENMP)
+  cpu_set_t current;
+  if (sched_getaffinity(0, sizeof(current), &current) != 0) return 0;
+
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    if (CPU_ISSET(cpu, &current)) cpus.push_back(cpu);
+  if (cpus.empty()) return 0;
+
+  // order by node, so that threads that are adjacent in a static schedule share a node
+  std::stable_sort(cpus.begin(), cpus.end(), [](int a, int b) { return numaNodeOfCpu(a) < numaNodeOfCpu(b); });
+
+  int nthreads = 0;
+  int failed = 0;
+#pragma omp parallel reduction(+ : failed)
+  {
+    // threads beyond the number of cpus are spread over the same cpus in block order
+    const int t = omp_get_thread_num();
+    const int n = omp_get_num_threads();
+    const int cpu = cpus[(static_cast<long>(t) * cpus.size()) / n];
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    if (sched_setaffinity(0, sizeof(mask), &mask) != 0) failed++;
+#pragma omp master
+    nthreads = n;
+  }
+
+  if (failed) warningQuda("Failed to bind %d of %d host threads", failed, nthreads);
+  if (getVerbosity() >= QUDA_VERBOSE)
+    printfQuda("Bound %d host threads to %lu cpus over %d NUMA nodes\n", nthreads, cpus.size(), numaNodeCount());
+  return nthreads - failed;
+#else
+  return 0;
+#endif
+}
+
+NumaPlacement numaPlacement()
+{
+  static bool init = false;
+  static NumaPlacement placement = NUMA_PLACEMENT_NONE;
+
+  if (!init) {
+    char *placement_env = getenv("QUDA_NUMA_PLACEMENT");
+    if (placement_env) {
+      if (strcmp(placement_env, "local") == 0) {
+        placement = NUMA_PLACEMENT_LOCAL;
+      } else if (strcmp(placement_env, "interleave") == 0) {
+        placement = NUMA_PLACEMENT_INTERLEAVE;
+      } else if (strcmp(placement_env, "none") == 0) {
+        placement = NUMA_PLACEMENT_NONE;
+      } else {
+        errorQuda("QUDA_NUMA_PLACEMENT=%s not recognized (local, interleave or none)", placement_env);
+      }
+    }
+    init = true;
+  }
+  return placement;
+}
+
+void numaFirstTouch(void *ptr, size_t bytes, NumaPlacement placement)
+{
+#ifdef _OPENMP
+  if (placement == NUMA_PLACEMENT_NONE || !ptr) return;
+
+  static const long page_size = sysconf(_SC_PAGESIZE);
+  const long pages = bytes / page_size;
+  const int nthreads = omp_get_max_threads();
+  if (nthreads == 1 || pages < 4l * nthreads) return;
+
+  char *p = static_cast<char *>(ptr);
+  if (placement == NUMA_PLACEMENT_LOCAL) {
+#pragma omp parallel for schedule(static)
+    for (long i = 0; i < pages; i++) p[i * page_size] = 0;
+  } else {
+#pragma omp parallel for schedule(static, 1)
+    for (long i = 0; i < pages; i++) p[i * page_size] = 0;
+  }
+#endif
+}
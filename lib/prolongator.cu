@@ -3,6 +3,7 @@
 #include <tune_quda.h>
 #include <typeinfo>
 #include <multigrid_helper.cuh>
+#include <host_parallel.h>
 
 namespace quda {
 
@@ -95,20 +96,65 @@ namespace quda {
 
   }
 
-  template <typename Float, int fineSpin, int fineColor, int coarseSpin, int coarseColor, int fine_colors_per_thread, typename Arg>
-  void Prolongate(Arg &arg) {
-    for (int parity=0; parity<arg.nParity; parity++) {
-      parity = (arg.nParity == 2) ? parity : arg.parity;
+  /**
+     Host kernel argument struct.  A set of vectors is prolongated in
+     a single pass over the null-space vectors.
+  */
+  template <typename Float, typename vFloat, int fineSpin, int fineColor, int coarseSpin, int coarseColor>
+  struct ProlongateHostArg {
+    static constexpr QudaFieldOrder order = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    std::vector<FieldOrderCB<Float,fineSpin,fineColor,1,order>> out;
+    std::vector<FieldOrderCB<Float,coarseSpin,coarseColor,1,order>> in;
+    const FieldOrderCB<Float,fineSpin,fineColor,coarseColor,order,vFloat> V;
+    const int *geo_map;
+    const spin_mapper<fineSpin,coarseSpin> spin_map;
+    const int parity; // the parity of the output field (if single parity)
+    const int nParity; // number of parities of input fine field
+    const int fineVolumeCB;
+    const int coarseVolumeCB;
 
-      for (int x_cb=0; x_cb<arg.out.VolumeCB(); x_cb++) {
-        complex<Float> tmp[fineSpin*coarseColor];
-        prolongate<Float,fineSpin,coarseColor>(tmp, arg.in, parity, x_cb, arg.geo_map, arg.spin_map, arg.out.VolumeCB());
-        for (int fine_color_block=0; fine_color_block<fineColor; fine_color_block+=fine_colors_per_thread) {
-          rotateFineColor<Float,fineSpin,fineColor,coarseColor,fine_colors_per_thread>
-            (arg.out, tmp, arg.V, parity, arg.nParity, x_cb, fine_color_block);
+    ProlongateHostArg(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+                      const ColorSpinorField &V, const int *geo_map, const int parity)
+      : V(V), geo_map(geo_map), spin_map(), parity(parity), nParity(out[0]->SiteSubset()),
+        fineVolumeCB(out[0]->VolumeCB()), coarseVolumeCB(in[0]->VolumeCB())
+    {
+      for (auto o : out) this->out.emplace_back(*o);
+      for (auto i : in) this->in.emplace_back(*i);
+    }
+  };
+
+  /**
+     Applies the prolongator to all vectors on the host.  Each element
+     of V is loaded once per site and applied to every vector.
+  */
+  template <typename Float, int fineSpin, int fineColor, int coarseSpin, int coarseColor, typename Arg>
+  void Prolongate(Arg &arg, int chunk) {
+    const int nVec = arg.out.size();
+
+    host::parallel_for(arg.nParity, arg.fineVolumeCB, [&](int parity, int x_cb) {
+      parity = (arg.nParity == 2) ? parity : arg.parity;
+      const int spinor_parity = (arg.nParity == 2) ? parity : 0;
+      const int v_parity = (arg.V.Nparity() == 2) ? parity : 0;
+
+      int x_coarse = arg.geo_map[parity*arg.fineVolumeCB + x_cb];
+      int parity_coarse = (x_coarse >= arg.coarseVolumeCB) ? 1 : 0;
+      int x_coarse_cb = x_coarse - parity_coarse*arg.coarseVolumeCB;
+
+      for (int s=0; s<fineSpin; s++) {
+        const int s_coarse = arg.spin_map(s,parity);
+        for (int i=0; i<fineColor; i++) {
+          complex<Float> v[coarseColor];
+          for (int j=0; j<coarseColor; j++) v[j] = arg.V(v_parity, x_cb, s, i, j);
+
+          for (int k=0; k<nVec; k++) {
+            const auto &in = arg.in[k];
+            complex<Float> sum = 0.0;
+            for (int j=0; j<coarseColor; j++) sum += v[j] * in(parity_coarse, x_coarse_cb, s_coarse, j);
+            arg.out[k](spinor_parity, x_cb, s, i) = sum;
+          }
         }
       }
-    }
+    }, chunk);
   }
 
   template <typename Float, int fineSpin, int fineColor, int coarseSpin, int coarseColor, int fine_colors_per_thread, typename Arg>
@@ -130,8 +176,8 @@ namespace quda {
   class ProlongateLaunch : public TunableVectorYZ {
 
   protected:
-    ColorSpinorField &out;
-    const ColorSpinorField &in;
+    const std::vector<ColorSpinorField*> &out;
+    const std::vector<ColorSpinorField*> &in;
     const ColorSpinorField &V;
     const int *fine_to_coarse;
     int parity;
@@ -139,61 +185,74 @@ namespace quda {
     char vol[TuneKey::volume_n];
 
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
-    unsigned int minThreads() const { return out.VolumeCB(); } // fine parity is the block y dimension
+    unsigned int minThreads() const { return out[0]->VolumeCB(); } // fine parity is the block y dimension
 
   public:
-    ProlongateLaunch(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &V,
-                     const int *fine_to_coarse, int parity)
-      : TunableVectorYZ(out.SiteSubset(), fineColor/fine_colors_per_thread), out(out), in(in), V(V),
-        fine_to_coarse(fine_to_coarse), parity(parity), location(checkLocation(out, in, V))
+    ProlongateLaunch(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+                     const ColorSpinorField &V, const int *fine_to_coarse, int parity)
+      : TunableVectorYZ(out[0]->SiteSubset(), fineColor/fine_colors_per_thread), out(out), in(in), V(V),
+        fine_to_coarse(fine_to_coarse), parity(parity), location(checkLocation(*out[0], *in[0], V))
     {
-      strcpy(vol, out.VolString());
+      strcpy(vol, out[0]->VolString());
       strcat(vol, ",");
-      strcat(vol, in.VolString());
+      strcat(vol, in[0]->VolString());
 
-      strcpy(aux, out.AuxString());
+      strcpy(aux, out[0]->AuxString());
       strcat(aux, ",");
-      strcat(aux, in.AuxString());
+      strcat(aux, in[0]->AuxString());
+      if (location == QUDA_CPU_FIELD_LOCATION) {
+        char nvec[16];
+        sprintf(nvec, ",nvec=%d", (int)out.size());
+        strcat(aux, nvec);
+      }
     }
 
     virtual ~ProlongateLaunch() { }
 
     void apply(const cudaStream_t &stream) {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
       if (location == QUDA_CPU_FIELD_LOCATION) {
-        if (out.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-          ProlongateArg<Float,vFloat,fineSpin,fineColor,coarseSpin,coarseColor,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER>
-            arg(out, in, V, fine_to_coarse, parity);
-          Prolongate<Float,fineSpin,fineColor,coarseSpin,coarseColor,fine_colors_per_thread>(arg);
+        if (out[0]->FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
+          ProlongateHostArg<Float,vFloat,fineSpin,fineColor,coarseSpin,coarseColor> arg(out, in, V, fine_to_coarse, parity);
+          Prolongate<Float,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
         } else {
-          errorQuda("Unsupported field order %d", out.FieldOrder());
+          errorQuda("Unsupported field order %d", out[0]->FieldOrder());
         }
       } else {
-        if (out.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
-          TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-          ProlongateArg<Float,vFloat,fineSpin,fineColor,coarseSpin,coarseColor,QUDA_FLOAT2_FIELD_ORDER>
-            arg(out, in, V, fine_to_coarse, parity);
-          ProlongateKernel<Float,fineSpin,fineColor,coarseSpin,coarseColor,fine_colors_per_thread>
-            <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
+        if (out[0]->FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
+          for (unsigned int i = 0; i < out.size(); i++) {
+            ProlongateArg<Float,vFloat,fineSpin,fineColor,coarseSpin,coarseColor,QUDA_FLOAT2_FIELD_ORDER>
+              arg(*out[i], *in[i], V, fine_to_coarse, parity);
+            ProlongateKernel<Float,fineSpin,fineColor,coarseSpin,coarseColor,fine_colors_per_thread>
+              <<<tp.grid, tp.block, tp.shared_bytes, stream>>>(arg);
+          }
         } else {
-          errorQuda("Unsupported field order %d", out.FieldOrder());
+          errorQuda("Unsupported field order %d", out[0]->FieldOrder());
         }
       }
     }
 
+    bool tuneHostChunk() const { return location == QUDA_CPU_FIELD_LOCATION; }
+
     TuneKey tuneKey() const { return TuneKey(vol, typeid(*this).name(), aux); }
 
-    long long flops() const { return 8 * fineSpin * fineColor * coarseColor * out.SiteSubset()*(long long)out.VolumeCB(); }
+    long long flops() const
+    {
+      return out.size() * 8 * fineSpin * fineColor * coarseColor * out[0]->SiteSubset() * (long long)out[0]->VolumeCB();
+    }
 
     long long bytes() const {
-      size_t v_bytes = V.Bytes() / (V.SiteSubset() == out.SiteSubset() ? 1 : 2);
-      return in.Bytes() + out.Bytes() + v_bytes + out.SiteSubset()*out.VolumeCB()*sizeof(int);
+      size_t v_bytes = V.Bytes() / (V.SiteSubset() == out[0]->SiteSubset() ? 1 : 2);
+      if (location == QUDA_CPU_FIELD_LOCATION) // V is only streamed once on the host
+        return out.size() * (in[0]->Bytes() + out[0]->Bytes()) + v_bytes + out[0]->SiteSubset() * out[0]->VolumeCB() * sizeof(int);
+      return out.size() * (in[0]->Bytes() + out[0]->Bytes() + v_bytes + out[0]->SiteSubset() * out[0]->VolumeCB() * sizeof(int));
     }
 
   };
 
   template <typename Float, int fineSpin, int fineColor, int coarseSpin, int coarseColor>
-  void Prolongate(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
-                  const int *fine_to_coarse, int parity) {
+  void Prolongate(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+                  const ColorSpinorField &v, const int *fine_to_coarse, int parity) {
 
     // for all grids use 1 color per thread
     constexpr int fine_colors_per_thread = 1;
@@ -206,7 +265,7 @@ namespace quda {
 #else
       errorQuda("QUDA_PRECISION=%d does not enable half precision", QUDA_PRECISION);
 #endif
-    } else if (v.Precision() == in.Precision()) {
+    } else if (v.Precision() == in[0]->Precision()) {
       ProlongateLaunch<Float, Float, fineSpin, fineColor, coarseSpin, coarseColor, fine_colors_per_thread>
       prolongator(out, in, v, fine_to_coarse, parity);
       prolongator.apply(0);
@@ -214,15 +273,15 @@ namespace quda {
       errorQuda("Unsupported V precision %d", v.Precision());
     }
 
-    if (checkLocation(out, in, v) == QUDA_CUDA_FIELD_LOCATION) checkCudaError();
+    if (checkLocation(*out[0], *in[0], v) == QUDA_CUDA_FIELD_LOCATION) checkCudaError();
   }
 
 
   template <typename Float, int fineSpin>
-  void Prolongate(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
-                  int nVec, const int *fine_to_coarse, const int * const * spin_map, int parity) {
+  void Prolongate(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+                  const ColorSpinorField &v, int nVec, const int *fine_to_coarse, const int * const * spin_map, int parity) {
 
-    if (in.Nspin() != 2) errorQuda("Coarse spin %d is not supported", in.Nspin());
+    if (in[0]->Nspin() != 2) errorQuda("Coarse spin %d is not supported", in[0]->Nspin());
     const int coarseSpin = 2;
 
     // first check that the spin_map matches the spin_mapper
@@ -231,7 +290,7 @@ namespace quda {
       for (int p=0; p<2; p++)
         if (mapper(s,p) != spin_map[s][p]) errorQuda("Spin map does not match spin_mapper");
 
-    if (out.Ncolor() == 3) {
+    if (out[0]->Ncolor() == 3) {
       const int fineColor = 3;
 #ifdef NSPIN4
       if (nVec == 6) { // Free field Wilson
@@ -248,7 +307,7 @@ namespace quda {
         errorQuda("Unsupported nVec %d", nVec);
       }
 #ifdef NSPIN4
-    } else if (out.Ncolor() == 6) { // for coarsening coarsened Wilson free field.
+    } else if (out[0]->Ncolor() == 6) { // for coarsening coarsened Wilson free field.
       const int fineColor = 6;
       if (nVec == 6) { // these are probably only for debugging only
         Prolongate<Float,fineSpin,fineColor,coarseSpin,6>(out, in, v, fine_to_coarse, parity);
@@ -256,7 +315,7 @@ namespace quda {
         errorQuda("Unsupported nVec %d", nVec);
       }
 #endif // NSPIN4
-    } else if (out.Ncolor() == 24) {
+    } else if (out[0]->Ncolor() == 24) {
       const int fineColor = 24;
       if (nVec == 24) { // to keep compilation under control coarse grids have same or more colors
         Prolongate<Float,fineSpin,fineColor,coarseSpin,24>(out, in, v, fine_to_coarse, parity);
@@ -274,7 +333,7 @@ namespace quda {
         errorQuda("Unsupported nVec %d", nVec);
       }
 #ifdef NSPIN4
-    } else if (out.Ncolor() == 32) {
+    } else if (out[0]->Ncolor() == 32) {
       const int fineColor = 32;
       if (nVec == 32) {
         Prolongate<Float,fineSpin,fineColor,coarseSpin,32>(out, in, v, fine_to_coarse, parity);
@@ -283,7 +342,7 @@ namespace quda {
       }
 #endif // NSPIN4
 #ifdef NSPIN1
-    } else if (out.Ncolor() == 64) {
+    } else if (out[0]->Ncolor() == 64) {
       const int fineColor = 64;
       if (nVec == 64) {
         Prolongate<Float,fineSpin,fineColor,coarseSpin,64>(out, in, v, fine_to_coarse, parity);
@@ -292,7 +351,7 @@ namespace quda {
       } else {
         errorQuda("Unsupported nVec %d", nVec);
       }
-    } else if (out.Ncolor() == 96) {
+    } else if (out[0]->Ncolor() == 96) {
       const int fineColor = 96;
       if (nVec == 96) {
         Prolongate<Float,fineSpin,fineColor,coarseSpin,96>(out, in, v, fine_to_coarse, parity);
@@ -301,40 +360,50 @@ namespace quda {
       }
 #endif // NSPIN1
     } else {
-      errorQuda("Unsupported nColor %d", out.Ncolor());
+      errorQuda("Unsupported nColor %d", out[0]->Ncolor());
     }
   }
 
   template <typename Float>
-  void Prolongate(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
-                  int Nvec, const int *fine_to_coarse, const int * const * spin_map, int parity) {
+  void Prolongate(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+                  const ColorSpinorField &v, int Nvec, const int *fine_to_coarse, const int * const * spin_map, int parity) {
 
-    if (out.Nspin() == 2) {
+    if (out[0]->Nspin() == 2) {
       Prolongate<Float,2>(out, in, v, Nvec, fine_to_coarse, spin_map, parity);
 #ifdef NSPIN4
-    } else if (out.Nspin() == 4) {
+    } else if (out[0]->Nspin() == 4) {
       Prolongate<Float,4>(out, in, v, Nvec, fine_to_coarse, spin_map, parity);
 #endif
 #if 0 // Not needed until we have Laplace MG or staggered MG Lanczos
 //#ifdef NSPIN1
-    } else if (out.Nspin() == 1) {
+    } else if (out[0]->Nspin() == 1) {
       Prolongate<Float,1>(out, in, v, Nvec, fine_to_coarse, spin_map, parity);
 #endif
     } else {
-      errorQuda("Unsupported nSpin %d", out.Nspin());
+      errorQuda("Unsupported nSpin %d", out[0]->Nspin());
     }
   }
 
 #endif // GPU_MULTIGRID
 
-  void Prolongate(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
+  void Prolongate(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in, const ColorSpinorField &v,
                   int Nvec, const int *fine_to_coarse, const int * const * spin_map, int parity) {
 #ifdef GPU_MULTIGRID
-    if (out.FieldOrder() != in.FieldOrder() || out.FieldOrder() != v.FieldOrder())
-      errorQuda("Field orders do not match (out=%d, in=%d, v=%d)", 
-                out.FieldOrder(), in.FieldOrder(), v.FieldOrder());
+    if (out.size() == 0) return;
+    if (out.size() != in.size()) errorQuda("Number of output vectors %d does not match input %d", (int)out.size(), (int)in.size());
+
+    for (unsigned int i = 0; i < out.size(); i++) {
+      if (out[i]->FieldOrder() != in[i]->FieldOrder() || out[i]->FieldOrder() != v.FieldOrder())
+        errorQuda("Field orders do not match (out=%d, in=%d, v=%d)",
+                  out[i]->FieldOrder(), in[i]->FieldOrder(), v.FieldOrder());
+      checkPrecision(*out[i], *in[i], *out[0]);
+      checkLocation(*out[i], *in[i], *out[0]);
+      if (out[i]->SiteSubset() != out[0]->SiteSubset() || out[i]->Ncolor() != out[0]->Ncolor()
+          || in[i]->Ncolor() != in[0]->Ncolor())
+        errorQuda("Vector %d does not match vector 0", i);
+    }
 
-    QudaPrecision precision = checkPrecision(out, in);
+    QudaPrecision precision = out[0]->Precision();
 
     if (precision == QUDA_DOUBLE_PRECISION) {
 #ifdef GPU_MULTIGRID_DOUBLE
@@ -345,13 +414,20 @@ namespace quda {
     } else if (precision == QUDA_SINGLE_PRECISION) {
       Prolongate<float>(out, in, v, Nvec, fine_to_coarse, spin_map, parity);
     } else {
-      errorQuda("Unsupported precision %d", out.Precision());
+      errorQuda("Unsupported precision %d", precision);
     }
 
-    if (checkLocation(out, in, v) == QUDA_CUDA_FIELD_LOCATION) checkCudaError();
+    if (checkLocation(*out[0], *in[0], v) == QUDA_CUDA_FIELD_LOCATION) checkCudaError();
 #else
     errorQuda("Multigrid has not been built");
 #endif
   }
 
+  void Prolongate(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
+                  int Nvec, const int *fine_to_coarse, const int * const * spin_map, int parity) {
+    std::vector<ColorSpinorField*> out_{&out};
+    std::vector<ColorSpinorField*> in_{const_cast<ColorSpinorField*>(&in)};
+    Prolongate(out_, in_, v, Nvec, fine_to_coarse, spin_map, parity);
+  }
+
 } // end namespace quda
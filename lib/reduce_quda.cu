@@ -7,6 +7,7 @@
 #include <launch_kernel.cuh>
 #include <jitify_helper.cuh>
 #include <kernels/reduce_core.cuh>
+#include <host_parallel.h>
 
 // These are used for reduction kernels
 static QudaSumFloat *d_reduce=0;
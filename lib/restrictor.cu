@@ -5,16 +5,104 @@
 
 #include <jitify_helper.cuh>
 #include <kernels/restrictor.cuh>
+#include <host_parallel.h>
 
 namespace quda {
 
+  /**
+     Host kernel argument struct.  A set of vectors is restricted in
+     a single pass over the null-space vectors.
+  */
+  template <typename Float, typename vFloat, int fineSpin, int fineColor, int coarseSpin, int coarseColor>
+  struct RestrictHostArg {
+    static constexpr QudaFieldOrder order = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    std::vector<FieldOrderCB<Float,coarseSpin,coarseColor,1,order>> out;
+    std::vector<FieldOrderCB<Float,fineSpin,fineColor,1,order>> in;
+    const FieldOrderCB<Float,fineSpin,fineColor,coarseColor,order,vFloat> V;
+    const int *coarse_to_fine;
+    const spin_mapper<fineSpin,coarseSpin> spin_map;
+    const int parity; // the parity of the input field (if single parity)
+    const int nParity; // number of parities of input fine field
+    const int fineVolumeCB;
+    const int coarseVolumeCB;
+    const int aggregate_size; // number of fine sites per parity of each aggregate
+
+    RestrictHostArg(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+                    const ColorSpinorField &V, const int *coarse_to_fine, int parity)
+      : V(V), coarse_to_fine(coarse_to_fine), spin_map(), parity(parity), nParity(in[0]->SiteSubset()),
+        fineVolumeCB(in[0]->VolumeCB()), coarseVolumeCB(out[0]->VolumeCB()),
+        aggregate_size(in[0]->VolumeCB() / (2 * out[0]->VolumeCB()))
+    {
+      for (auto o : out) this->out.emplace_back(*o);
+      for (auto i : in) this->in.emplace_back(*i);
+    }
+  };
+
+  /**
+     Applies the restrictor to all vectors on the host.  Threads are
+     assigned to aggregates, and the fine sites of each aggregate are
+     found from the coarse_to_fine map, so each coarse site is summed
+     by a single thread in a fixed order: there are no races and the
+     result does not depend on the number of threads.  Each element of
+     V is loaded once and applied to every vector.
+  */
+  template <typename Float, int fineSpin, int fineColor, int coarseSpin, int coarseColor, typename Arg>
+  void Restrict(Arg &arg, int chunk) {
+    const int nVec = arg.out.size();
+
+    host::parallel_for(2*arg.coarseVolumeCB, [&](int x_coarse) {
+      int parity_coarse = (x_coarse >= arg.coarseVolumeCB) ? 1 : 0;
+      int x_coarse_cb = x_coarse - parity_coarse*arg.coarseVolumeCB;
+
+      // per-thread scratch, so that no allocation is made per site
+      thread_local std::vector<complex<Float>> sum, in;
+      sum.assign(nVec*coarseSpin*coarseColor, complex<Float>(0.0, 0.0));
+      in.resize(nVec*fineColor);
+
+      for (int p=0; p<arg.nParity; p++) {
+        const int parity = (arg.nParity == 2) ? p : arg.parity;
+        const int spinor_parity = (arg.nParity == 2) ? parity : 0;
+        const int v_parity = (arg.V.Nparity() == 2) ? parity : 0;
+
+        for (int i=0; i<arg.aggregate_size; i++) {
+          int x_fine = arg.coarse_to_fine[(x_coarse*2 + parity) * arg.aggregate_size + i];
+          int x_fine_cb = x_fine - parity*arg.fineVolumeCB;
+
+          for (int s=0; s<fineSpin; s++) {
+            const int s_coarse = arg.spin_map(s,parity);
+            for (int k=0; k<nVec; k++) {
+              const auto &in_k = arg.in[k];
+              for (int j=0; j<fineColor; j++) in[k*fineColor+j] = in_k(spinor_parity, x_fine_cb, s, j);
+            }
+
+            for (int c=0; c<coarseColor; c++) {
+              complex<Float> v[fineColor];
+              for (int j=0; j<fineColor; j++) v[j] = conj(arg.V(v_parity, x_fine_cb, s, j, c));
+
+              for (int k=0; k<nVec; k++) {
+                complex<Float> partial = 0.0;
+                for (int j=0; j<fineColor; j++) partial += v[j] * in[k*fineColor+j];
+                sum[(k*coarseSpin + s_coarse)*coarseColor + c] += partial;
+              }
+            }
+          }
+        }
+      }
+
+      for (int k=0; k<nVec; k++)
+        for (int s=0; s<coarseSpin; s++)
+          for (int c=0; c<coarseColor; c++)
+            arg.out[k](parity_coarse, x_coarse_cb, s, c) = sum[(k*coarseSpin + s)*coarseColor + c];
+    }, chunk);
+  }
+
   template <typename Float, typename vFloat, int fineSpin, int fineColor, int coarseSpin, int coarseColor,
             int coarse_colors_per_thread>
   class RestrictLaunch : public Tunable {
 
   protected:
-    ColorSpinorField &out;
-    const ColorSpinorField &in;
+    const std::vector<ColorSpinorField*> &out;
+    const std::vector<ColorSpinorField*> &in;
     const ColorSpinorField &v;
     const int *fine_to_coarse;
     const int *coarse_to_fine;
@@ -27,61 +115,76 @@ namespace quda {
     unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
     bool tuneGridDim() const { return false; } // Don't tune the grid dimensions.
     bool tuneAuxDim() const { return true; } // Do tune the aux dimensions.
-    unsigned int minThreads() const { return in.VolumeCB(); } // fine parity is the block y dimension
+    unsigned int minThreads() const
+    {
+      // host threads are assigned to aggregates, fine parity is the block y dimension on the device
+      return location == QUDA_CPU_FIELD_LOCATION ? 2 * out[0]->VolumeCB() : in[0]->VolumeCB();
+    }
 
   public:
-    RestrictLaunch(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
-                   const int *fine_to_coarse, const int *coarse_to_fine, int parity)
+    RestrictLaunch(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+                   const ColorSpinorField &v, const int *fine_to_coarse, const int *coarse_to_fine, int parity)
       : out(out), in(in), v(v), fine_to_coarse(fine_to_coarse), coarse_to_fine(coarse_to_fine),
-        parity(parity), location(checkLocation(out,in,v)), block_size(in.VolumeCB()/(2*out.VolumeCB()))
+        parity(parity), location(checkLocation(*out[0], *in[0], v)), block_size(in[0]->VolumeCB()/(2*out[0]->VolumeCB()))
     {
       if (v.Location() == QUDA_CUDA_FIELD_LOCATION) {
 #ifdef JITIFY
         create_jitify_program("kernels/restrictor.cuh");
 #endif
       }
-      strcpy(aux, compile_type_str(in));
-      strcat(aux, out.AuxString());
+      strcpy(aux, compile_type_str(*in[0]));
+      strcat(aux, out[0]->AuxString());
       strcat(aux, ",");
-      strcat(aux, in.AuxString());
+      strcat(aux, in[0]->AuxString());
+      if (location == QUDA_CPU_FIELD_LOCATION) {
+        char nvec[16];
+        sprintf(nvec, ",nvec=%d", (int)out.size());
+        strcat(aux, nvec);
+      }
 
-      strcpy(vol, out.VolString());
+      strcpy(vol, out[0]->VolString());
       strcat(vol, ",");
-      strcat(vol, in.VolString());
+      strcat(vol, in[0]->VolString());
     } // block size is checkerboard fine length / full coarse length
 
     void apply(const cudaStream_t &stream) {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+
       if (location == QUDA_CPU_FIELD_LOCATION) {
-        if (out.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-          RestrictArg<Float,vFloat,fineSpin,fineColor,coarseSpin,coarseColor,QUDA_SPACE_SPIN_COLOR_FIELD_ORDER>
-            arg(out, in, v, fine_to_coarse, coarse_to_fine, parity);
-          Restrict<Float,fineSpin,fineColor,coarseSpin,coarseColor,coarse_colors_per_thread>(arg);
+        if (out[0]->FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
+          RestrictHostArg<Float,vFloat,fineSpin,fineColor,coarseSpin,coarseColor> arg(out, in, v, coarse_to_fine, parity);
+          Restrict<Float,fineSpin,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
         } else {
-          errorQuda("Unsupported field order %d", out.FieldOrder());
+          errorQuda("Unsupported field order %d", out[0]->FieldOrder());
         }
       } else {
-        TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-
-        if (out.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
+        if (out[0]->FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
           typedef RestrictArg<Float,vFloat,fineSpin,fineColor,coarseSpin,coarseColor,QUDA_FLOAT2_FIELD_ORDER> Arg;
-          Arg arg(out, in, v, fine_to_coarse, coarse_to_fine, parity);
-          arg.swizzle = tp.aux.x;
+          for (unsigned int i = 0; i < out.size(); i++) {
+            Arg arg(*out[i], *in[i], v, fine_to_coarse, coarse_to_fine, parity);
+            arg.swizzle = tp.aux.x;
 
 #ifdef JITIFY
-          using namespace jitify::reflection;
-          jitify_error = program->kernel("quda::RestrictKernel")
-            .instantiate((int)tp.block.x,Type<Float>(),fineSpin,fineColor,coarseSpin,coarseColor,coarse_colors_per_thread,Type<Arg>())
-            .configure(tp.grid,tp.block,tp.shared_bytes,stream).launch(arg);
+            using namespace jitify::reflection;
+            jitify_error = program->kernel("quda::RestrictKernel")
+              .instantiate((int)tp.block.x,Type<Float>(),fineSpin,fineColor,coarseSpin,coarseColor,coarse_colors_per_thread,Type<Arg>())
+              .configure(tp.grid,tp.block,tp.shared_bytes,stream).launch(arg);
 #else
-          LAUNCH_KERNEL_MG_BLOCK_SIZE(RestrictKernel,tp,stream,arg,Float,fineSpin,fineColor,
-                                      coarseSpin,coarseColor,coarse_colors_per_thread,Arg);
+            LAUNCH_KERNEL_MG_BLOCK_SIZE(RestrictKernel,tp,stream,arg,Float,fineSpin,fineColor,
+                                        coarseSpin,coarseColor,coarse_colors_per_thread,Arg);
 #endif
+          }
         } else {
-          errorQuda("Unsupported field order %d", out.FieldOrder());
+          errorQuda("Unsupported field order %d", out[0]->FieldOrder());
         }
       }
     }
 
+    bool tuneHostChunk() const { return location == QUDA_CPU_FIELD_LOCATION; }
+
+    // aggregates are large units of work, so start from a chunk of one
+    unsigned int hostChunkMin() const { return 1; }
+
     // This block tuning tunes for the optimal amount of color
     // splitting between blockDim.z and gridDim.z.  However, enabling
     // blockDim.z > 1 gives incorrect results due to cub reductions
@@ -135,7 +238,7 @@ namespace quda {
 
     /** sets default values for when tuning is disabled */
     void defaultTuneParam(TuneParam &param) const {
-      param.block = dim3(block_size, in.SiteSubset(), 1);
+      param.block = dim3(block_size, in[0]->SiteSubset(), 1);
       param.grid = dim3( (minThreads()+param.block.x-1) / param.block.x, 1, 1);
       param.shared_bytes = 0;
 
@@ -144,18 +247,23 @@ namespace quda {
       param.aux.x = 1; // swizzle factor
     }
 
-    long long flops() const { return 8 * fineSpin * fineColor * coarseColor * in.SiteSubset()*(long long)in.VolumeCB(); }
+    long long flops() const
+    {
+      return in.size() * 8 * fineSpin * fineColor * coarseColor * in[0]->SiteSubset() * (long long)in[0]->VolumeCB();
+    }
 
     long long bytes() const {
-      size_t v_bytes = v.Bytes() / (v.SiteSubset() == in.SiteSubset() ? 1 : 2);
-      return in.Bytes() + out.Bytes() + v_bytes + in.SiteSubset()*in.VolumeCB()*sizeof(int);
+      size_t v_bytes = v.Bytes() / (v.SiteSubset() == in[0]->SiteSubset() ? 1 : 2);
+      if (location == QUDA_CPU_FIELD_LOCATION) // V is only streamed once on the host
+        return in.size() * (in[0]->Bytes() + out[0]->Bytes()) + v_bytes + in[0]->SiteSubset() * in[0]->VolumeCB() * sizeof(int);
+      return in.size() * (in[0]->Bytes() + out[0]->Bytes() + v_bytes + in[0]->SiteSubset() * in[0]->VolumeCB() * sizeof(int));
     }
 
   };
 
   template <typename Float, int fineSpin, int fineColor, int coarseSpin, int coarseColor>
-  void Restrict(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
-                const int *fine_to_coarse, const int *coarse_to_fine, int parity) {
+  void Restrict(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+                const ColorSpinorField &v, const int *fine_to_coarse, const int *coarse_to_fine, int parity) {
 
     // for fine grids (Nc=3) have more parallelism so can use more coarse strategy
     constexpr int coarse_colors_per_thread = fineColor != 3 ? 2 : coarseColor >= 4 && coarseColor % 4 == 0 ? 4 : 2;
@@ -169,7 +277,7 @@ namespace quda {
 #else
       errorQuda("QUDA_PRECISION=%d does not enable half precision", QUDA_PRECISION);
 #endif
-    } else if (v.Precision() == in.Precision()) {
+    } else if (v.Precision() == in[0]->Precision()) {
       RestrictLaunch<Float, Float, fineSpin, fineColor, coarseSpin, coarseColor, coarse_colors_per_thread>
         restrictor(out, in, v, fine_to_coarse, coarse_to_fine, parity);
       restrictor.apply(0);
@@ -177,19 +285,20 @@ namespace quda {
       errorQuda("Unsupported V precision %d", v.Precision());
     }
 
-    if (checkLocation(out, in, v) == QUDA_CUDA_FIELD_LOCATION) checkCudaError();
+    if (checkLocation(*out[0], *in[0], v) == QUDA_CUDA_FIELD_LOCATION) checkCudaError();
   }
 
   template <typename Float>
-  void Restrict(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
-                int nVec, const int *fine_to_coarse, const int *coarse_to_fine, const int * const * spin_map, int parity)
+  void Restrict(const std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in,
+                const ColorSpinorField &v, int nVec, const int *fine_to_coarse, const int *coarse_to_fine,
+                const int * const * spin_map, int parity)
   {
-    if (out.Nspin() != 2) errorQuda("Unsupported nSpin %d", out.Nspin());
+    if (out[0]->Nspin() != 2) errorQuda("Unsupported nSpin %d", out[0]->Nspin());
     constexpr int coarseSpin = 2;
 
     // Template over fine color
-    if (in.Ncolor() == 3) { // standard QCD
-      if (in.Nspin() != 4) errorQuda("Unexpected nSpin = %d", in.Nspin());
+    if (in[0]->Ncolor() == 3) { // standard QCD
+      if (in[0]->Nspin() != 4) errorQuda("Unexpected nSpin = %d", in[0]->Nspin());
 #ifdef NSPIN4
       constexpr int fineSpin = 4;
       constexpr int fineColor = 3;
@@ -213,7 +322,7 @@ namespace quda {
 
     } else { // Nc != 3
 
-      if (in.Nspin() != 2) errorQuda("Unexpected nSpin = %d", in.Nspin());
+      if (in[0]->Nspin() != 2) errorQuda("Unexpected nSpin = %d", in[0]->Nspin());
       constexpr int fineSpin = 2;
 
       // first check that the spin_map matches the spin_mapper
@@ -223,7 +332,7 @@ namespace quda {
           if (mapper(s,p) != spin_map[s][p]) errorQuda("Spin map does not match spin_mapper");
 
 #ifdef NSPIN4
-      if (in.Ncolor() == 6) { // Coarsen coarsened Wilson free field
+      if (in[0]->Ncolor() == 6) { // Coarsen coarsened Wilson free field
         const int fineColor = 6;
         if (nVec == 6) {
           Restrict<Float,fineSpin,fineColor,coarseSpin,6>(out, in, v, fine_to_coarse, coarse_to_fine, parity);
@@ -232,7 +341,7 @@ namespace quda {
         }
       } else
 #endif // NSPIN4
-      if (in.Ncolor() == 24) { // to keep compilation under control coarse grids have same or more colors
+      if (in[0]->Ncolor() == 24) { // to keep compilation under control coarse grids have same or more colors
         const int fineColor = 24;
         if (nVec == 24) {
           Restrict<Float,fineSpin,fineColor,coarseSpin,24>(out, in, v, fine_to_coarse, coarse_to_fine, parity);
@@ -250,7 +359,7 @@ namespace quda {
           errorQuda("Unsupported nVec %d", nVec);
         }
 #ifdef NSPIN4
-      } else if (in.Ncolor() == 32) {
+      } else if (in[0]->Ncolor() == 32) {
         const int fineColor = 32;
         if (nVec == 32) {
           Restrict<Float,fineSpin,fineColor,coarseSpin,32>(out, in, v, fine_to_coarse, coarse_to_fine, parity);
@@ -259,7 +368,7 @@ namespace quda {
         }
 #endif // NSPIN4
 #ifdef NSPIN1
-      } else if (in.Ncolor() == 64) {
+      } else if (in[0]->Ncolor() == 64) {
         const int fineColor = 64;
         if (nVec == 64) {
           Restrict<Float,fineSpin,fineColor,coarseSpin,64>(out, in, v, fine_to_coarse, coarse_to_fine, parity);
@@ -268,7 +377,7 @@ namespace quda {
         } else {
           errorQuda("Unsupported nVec %d", nVec);
         }
-      } else if (in.Ncolor() == 96) {
+      } else if (in[0]->Ncolor() == 96) {
         const int fineColor = 96;
         if (nVec == 96) {
           Restrict<Float,fineSpin,fineColor,coarseSpin,96>(out, in, v, fine_to_coarse, coarse_to_fine, parity);
@@ -277,20 +386,30 @@ namespace quda {
         }
 #endif // NSPIN1
       } else {
-        errorQuda("Unsupported nColor %d", in.Ncolor());
+        errorQuda("Unsupported nColor %d", in[0]->Ncolor());
       }
     } // Nc != 3
   }
 
-  void Restrict(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
+  void Restrict(std::vector<ColorSpinorField*> &out, const std::vector<ColorSpinorField*> &in, const ColorSpinorField &v,
                 int Nvec, const int *fine_to_coarse, const int *coarse_to_fine, const int * const * spin_map, int parity)
   {
 #ifdef GPU_MULTIGRID
-    if (out.FieldOrder() != in.FieldOrder() ||        out.FieldOrder() != v.FieldOrder())
-      errorQuda("Field orders do not match (out=%d, in=%d, v=%d)",
-                out.FieldOrder(), in.FieldOrder(), v.FieldOrder());
+    if (out.size() == 0) return;
+    if (out.size() != in.size()) errorQuda("Number of output vectors %d does not match input %d", (int)out.size(), (int)in.size());
+
+    for (unsigned int i = 0; i < out.size(); i++) {
+      if (out[i]->FieldOrder() != in[i]->FieldOrder() || out[i]->FieldOrder() != v.FieldOrder())
+        errorQuda("Field orders do not match (out=%d, in=%d, v=%d)",
+                  out[i]->FieldOrder(), in[i]->FieldOrder(), v.FieldOrder());
+      checkPrecision(*out[i], *in[i], *out[0]);
+      checkLocation(*out[i], *in[i], *out[0]);
+      if (in[i]->SiteSubset() != in[0]->SiteSubset() || out[i]->Ncolor() != out[0]->Ncolor()
+          || in[i]->Ncolor() != in[0]->Ncolor())
+        errorQuda("Vector %d does not match vector 0", i);
+    }
 
-    QudaPrecision precision = checkPrecision(out, in);
+    QudaPrecision precision = out[0]->Precision();
 
     if (precision == QUDA_DOUBLE_PRECISION) {
 #ifdef GPU_MULTIGRID_DOUBLE
@@ -301,11 +420,19 @@ namespace quda {
     } else if (precision == QUDA_SINGLE_PRECISION) {
       Restrict<float>(out, in, v, Nvec, fine_to_coarse, coarse_to_fine, spin_map, parity);
     } else {
-      errorQuda("Unsupported precision %d", out.Precision());
+      errorQuda("Unsupported precision %d", precision);
     }
 #else
     errorQuda("Multigrid has not been built");
 #endif
   }
 
+  void Restrict(ColorSpinorField &out, const ColorSpinorField &in, const ColorSpinorField &v,
+                int Nvec, const int *fine_to_coarse, const int *coarse_to_fine, const int * const * spin_map, int parity)
+  {
+    std::vector<ColorSpinorField*> out_{&out};
+    std::vector<ColorSpinorField*> in_{const_cast<ColorSpinorField*>(&in)};
+    Restrict(out_, in_, v, Nvec, fine_to_coarse, coarse_to_fine, spin_map, parity);
+  }
+
 } // namespace quda
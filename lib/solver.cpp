@@ -152,6 +152,10 @@ namespace quda {
       // CG3NR is included in CG3NE
       solver = new CG3NE(mat, matSloppy, param, profile);
       break;
+    case QUDA_PIPELINED_CG_INVERTER:
+      report("PipelinedCG");
+      solver = new PipelinedCG(mat, matSloppy, param, profile);
+      break;
     default:
       errorQuda("Invalid solver type %d", param.inv_type);
     }
@@ -58,7 +58,7 @@ namespace quda {
       TuneParam tp = tuneLaunch(*this, getTuning(), QUDA_VERBOSE);
 
       if (meta.Location() == QUDA_CPU_FIELD_LOCATION) {
-        ComputeStaggeredVUVCPU<Float,fineColor,coarseSpin,coarseColor>(arg);
+        ComputeStaggeredVUVCPU<Float,fineColor,coarseSpin,coarseColor>(arg, tp.block.x);
       } else {
 #ifdef JITIFY
         using namespace jitify::reflection;
@@ -71,6 +71,8 @@ namespace quda {
       }
     }
 
+    bool tuneHostChunk() const { return meta.Location() == QUDA_CPU_FIELD_LOCATION; }
+
     bool advanceTuneParam(TuneParam &param) const {
       // only do autotuning if we have device fields
       if (meta.Location() == QUDA_CUDA_FIELD_LOCATION && Y.MemType() == QUDA_MEMORY_DEVICE) return Tunable::advanceTuneParam(param);
@@ -289,9 +291,13 @@ namespace quda {
 
   //Calculates the coarse color matrix and puts the result in Y.
   //N.B. Assumes Y, X have been allocated.
-  void StaggeredCoarseOp(GaugeField &Y, GaugeField &X, const Transfer &T, const cudaGaugeField &gauge,
+  void StaggeredCoarseOp(GaugeField &Y, GaugeField &X, const Transfer &T, const GaugeField &fine_gauge,
                          double mass, QudaDiracType dirac, QudaMatPCType matpc)
   {
+    if (fine_gauge.Location() != QUDA_CUDA_FIELD_LOCATION)
+      errorQuda("Coarse-operator construction requires a device fine-grid gauge field");
+    const cudaGaugeField &gauge = static_cast<const cudaGaugeField &>(fine_gauge);
+
     QudaPrecision precision = Y.Precision();
     QudaFieldLocation location = checkLocation(Y, X);
 
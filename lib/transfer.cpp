@@ -19,7 +19,7 @@ namespace quda {
   * however we do even-odd to preserve chirality (that is straightforward)
   */
   Transfer::Transfer(const std::vector<ColorSpinorField *> &B, int Nvec, int n_block_ortho, int *geo_bs, int spin_bs,
-                     QudaPrecision null_precision, TimeProfile &profile) :
+                     QudaPrecision null_precision, TimeProfile &profile, bool block_ortho) :
     B(B),
     Nvec(Nvec),
     NblockOrtho(n_block_ortho),
@@ -104,7 +104,7 @@ namespace quda {
     for (int s = 0; s < B[0]->Nspin(); s++) spin_map[s] = static_cast<int*>(safe_malloc(2*sizeof(int)));
     createSpinMap(spin_bs);
 
-    reset();
+    if (block_ortho) reset();
     postTrace();
   }
 
@@ -429,6 +429,74 @@ namespace quda {
     profile.TPSTOP(QUDA_PROFILE_COMPUTE);
   }
 
+  /**
+     @brief Whether a set of fields can be transferred by the fused
+     host kernels directly, without going through the temporaries
+   */
+  static bool fusedHostTransfer(const std::vector<ColorSpinorField *> &fine, const std::vector<ColorSpinorField *> &coarse,
+                                const ColorSpinorField &V)
+  {
+    for (unsigned int i = 0; i < fine.size(); i++) {
+      for (auto f : {fine[i], coarse[i]}) {
+        if (f->Location() != QUDA_CPU_FIELD_LOCATION || f->FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) return false;
+        if (f->Precision() != fine[0]->Precision() || f->Precision() < QUDA_SINGLE_PRECISION) return false;
+        if (V.Nspin() != 1 && f->GammaBasis() != V.GammaBasis()) return false;
+      }
+      if (fine[i]->SiteSubset() != fine[0]->SiteSubset()) return false;
+    }
+    return true;
+  }
+
+  // apply the prolongator to a set of vectors
+  void Transfer::P(std::vector<ColorSpinorField *> &out, const std::vector<ColorSpinorField *> &in) const
+  {
+    if (out.size() != in.size())
+      errorQuda("Number of output vectors %d does not match input %d", (int)out.size(), (int)in.size());
+    if (out.size() == 0) return;
+
+    if (!use_gpu && !is_staggered) initializeLazy(QUDA_CPU_FIELD_LOCATION);
+    if (use_gpu || is_staggered || !fusedHostTransfer(out, in, *V_h)) {
+      for (unsigned int i = 0; i < out.size(); i++) P(*out[i], *in[i]);
+      return;
+    }
+
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    if (V_h->SiteSubset() == QUDA_PARITY_SITE_SUBSET && out[0]->SiteSubset() == QUDA_FULL_SITE_SUBSET)
+      errorQuda("Cannot prolongate to a full field since only have single parity null-space components");
+
+    Prolongate(out, in, *V_h, Nvec, fine_to_coarse_h, spin_map, parity);
+
+    flops_ += out.size() * 8 * in[0]->Ncolor() * out[0]->Ncolor() * out[0]->VolumeCB() * out[0]->SiteSubset();
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+  }
+
+  // apply the restrictor to a set of vectors
+  void Transfer::R(std::vector<ColorSpinorField *> &out, const std::vector<ColorSpinorField *> &in) const
+  {
+    if (out.size() != in.size())
+      errorQuda("Number of output vectors %d does not match input %d", (int)out.size(), (int)in.size());
+    if (out.size() == 0) return;
+
+    if (!use_gpu && !is_staggered) initializeLazy(QUDA_CPU_FIELD_LOCATION);
+    if (use_gpu || is_staggered || in[0]->Nspin() == 1 || !fusedHostTransfer(in, out, *V_h)) {
+      for (unsigned int i = 0; i < out.size(); i++) R(*out[i], *in[i]);
+      return;
+    }
+
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    if (V_h->SiteSubset() == QUDA_PARITY_SITE_SUBSET && in[0]->SiteSubset() == QUDA_FULL_SITE_SUBSET)
+      errorQuda("Cannot restrict a full field since only have single parity null-space components");
+
+    Restrict(out, in, *V_h, Nvec, fine_to_coarse_h, coarse_to_fine_h, spin_map, parity);
+
+    flops_ += out.size() * 8 * out[0]->Ncolor() * in[0]->Ncolor() * in[0]->VolumeCB() * in[0]->SiteSubset();
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+  }
+
   double Transfer::flops() const {
     double rtn = flops_;
     flops_ = 0;
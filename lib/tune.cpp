@@ -650,6 +650,7 @@ namespace quda {
 
     TuneKey key = tunable.tuneKey();
     if (use_managed_memory()) strcat(key.aux, ",managed");
+    if (tunable.tuneHostChunk() && !strstr(key.aux, ",omp_threads=")) strcat(key.aux, getOmpThreadStr());
     last_key = key;
     static TuneParam param;
 
@@ -705,7 +706,8 @@ namespace quda {
 #endif
 
     if (enabled == QUDA_TUNE_NO) {
-      tunable.defaultTuneParam(param);
+      if (tunable.tuneHostChunk()) tunable.initHostTuneParam(param);
+      else tunable.defaultTuneParam(param);
       tunable.checkLaunchParam(param);
       if (verbosity >= QUDA_DEBUG_VERBOSE) {
         printfQuda("Launching %s with %s at vol=%s with %s (untuned)\n",
@@ -730,8 +732,12 @@ namespace quda {
 	if (verbosity >= QUDA_DEBUG_VERBOSE) printfQuda("PreTune %s\n", key.name);
 	tunable.preTune();
 
-	cudaEventCreate(&start);
-	cudaEventCreate(&end);
+        // host kernels are synchronous and timed on the host, so make no CUDA calls for them
+        const bool host = tunable.tuneHostChunk();
+        if (!host) {
+          cudaEventCreate(&start);
+          cudaEventCreate(&end);
+        }
 
 	if (verbosity >= QUDA_DEBUG_VERBOSE) {
 	  printfQuda("Tuning %s with %s at vol=%s\n", key.name, key.aux, key.volume);
@@ -740,10 +746,13 @@ namespace quda {
         Timer tune_timer;
         tune_timer.Start(__func__, __FILE__, __LINE__);
 
-        tunable.initTuneParam(param);
+        if (host) tunable.initHostTuneParam(param);
+        else tunable.initTuneParam(param);
 	while (tuning) {
-	  cudaDeviceSynchronize();
-	  cudaGetLastError(); // clear error counter
+          if (!host) {
+            cudaDeviceSynchronize();
+            cudaGetLastError(); // clear error counter
+          }
 	  tunable.checkLaunchParam(param);
 	  tunable.apply(0); // do initial call in case we need to jit compile for these parameters or if policy tuning
 	  if (verbosity >= QUDA_DEBUG_VERBOSE) {
@@ -754,21 +763,30 @@ namespace quda {
 		       param.aux.x, param.aux.y, param.aux.z);
 	  }
 
-	  cudaEventRecord(start, 0);
-	  for (int i=0; i<tunable.tuningIter(); i++) {
-	    tunable.apply(0);  // calls tuneLaunch() again, which simply returns the currently active param
-	  }
-	  cudaEventRecord(end, 0);
-	  cudaEventSynchronize(end);
-	  cudaEventElapsedTime(&elapsed_time, start, end);
-	  cudaDeviceSynchronize();
-	  error = cudaGetLastError();
-
-	  { // check that error state is cleared
-	    cudaDeviceSynchronize();
-	    cudaError_t error = cudaGetLastError();
-	    if (error != cudaSuccess) errorQuda("Failed to clear error state %s\n", cudaGetErrorString(error));
-	  }
+          if (host) {
+            Timer host_timer;
+            host_timer.Start(__func__, __FILE__, __LINE__);
+            for (int i = 0; i < tunable.tuningIter(); i++) tunable.apply(0);
+            host_timer.Stop(__func__, __FILE__, __LINE__);
+            elapsed_time = 1e3 * host_timer.Last();
+          } else {
+            cudaEventRecord(start, 0);
+            for (int i = 0; i < tunable.tuningIter(); i++) {
+              tunable.apply(0); // calls tuneLaunch() again, which simply returns the currently active param
+            }
+            cudaEventRecord(end, 0);
+            cudaEventSynchronize(end);
+            cudaEventElapsedTime(&elapsed_time, start, end);
+
+            cudaDeviceSynchronize();
+            error = cudaGetLastError();
+
+            { // check that error state is cleared
+              cudaDeviceSynchronize();
+              cudaError_t error = cudaGetLastError();
+              if (error != cudaSuccess) errorQuda("Failed to clear error state %s\n", cudaGetErrorString(error));
+            }
+          }
 
 	  elapsed_time /= (1e3 * tunable.tuningIter());
 	  if ( (elapsed_time < best_time) && (error == cudaSuccess) && (tunable.jitifyError() == CUDA_SUCCESS) ) {
@@ -791,7 +809,7 @@ namespace quda {
 	      }
             }
 	  }
-	  tuning = tunable.advanceTuneParam(param);
+	  tuning = host ? tunable.advanceHostTuneParam(param) : tunable.advanceTuneParam(param);
 	  tunable.jitifyError() = CUDA_SUCCESS;
 	}
 
@@ -810,8 +828,10 @@ namespace quda {
 	best_param.comment += ctime(&now); // includes a newline
 	best_param.time = best_time;
 
-	cudaEventDestroy(start);
-	cudaEventDestroy(end);
+        if (!host) {
+          cudaEventDestroy(start);
+          cudaEventDestroy(end);
+        }
 
 	if (verbosity >= QUDA_DEBUG_VERBOSE) printfQuda("PostTune %s\n", key.name);
 	tunable.postTune();
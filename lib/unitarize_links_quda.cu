@@ -9,6 +9,7 @@
 #include <tune_quda.h>
 #include <quda_matrix.h>
 #include <unitarization_links.h>
+#include <gauge_tools.h>
 
 #include <su3_project.cuh>
 #include <index_helper.cuh>
@@ -458,6 +459,11 @@ namespace {
 
   void projectSU3(GaugeField &u, double tol, int *fails) {
 #ifdef GPU_GAUGE_TOOLS
+    if (u.Location() == QUDA_CPU_FIELD_LOCATION) {
+      *fails += projectSU3CPU(u, tol);
+      return;
+    }
+
     // check the the field doesn't have staggered phases applied
     if (u.StaggeredPhaseApplied())
       errorQuda("Cannot project gauge field with staggered phases applied");
@@ -8,6 +8,7 @@
 #include <enum_quda.h>
 #include <util_quda.h>
 #include <malloc_quda.h>
+#include <host_parallel.h>
 
 static const size_t MAX_PREFIX_SIZE = 100;
 
@@ -135,9 +136,7 @@ char* getOmpThreadStr() {
   static char omp_thread_string[128];
   static bool init = false;
   if (!init) {
-    strcpy(omp_thread_string,",omp_threads=");
-    char *omp_threads = getenv("OMP_NUM_THREADS");
-    strcat(omp_thread_string, omp_threads ? omp_threads : "1");
+    sprintf(omp_thread_string, ",omp_threads=%d", quda::host::thread_count());
     init = true;
   }
   return omp_thread_string;
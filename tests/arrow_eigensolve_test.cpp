@@ -0,0 +1,112 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <test_util.h>
+#include <test_params.h>
+
+#include <quda_internal.h>
+#include <timer.h>
+#include <eigensolve_quda.h>
+#include <host_parallel.h>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/Dense>
+
+/**
+   Benchmark of the arrow matrix eigensolver used by TRLM.  For each
+   Krylov space size nKr a random arrow matrix, with the arrowhead in
+   the middle as after a thick restart, is solved both with the dense
+   self-adjoint eigensolver and with ArrowEigensolver, keeping half of
+   the Ritz vectors.  The eigenvalues, the last eigenvector components
+   (which give the TRLM residua), the eigen-residual and the
+   orthogonality of the kept vectors are checked.
+ */
+
+using namespace quda;
+using namespace Eigen;
+
+static std::vector<int> arrow_dims = {64, 128, 256, 512, 1024, 2048};
+
+static bool arrow(int dim)
+{
+  const int arrow_pos = dim / 2 + 1;
+  const int n_keep = dim / 2;
+
+  std::mt19937 rng(dim);
+  std::normal_distribution<double> normal;
+  std::vector<double> alpha(dim), beta(dim);
+  for (auto &a : alpha) a = normal(rng);
+  for (auto &b : beta) b = normal(rng);
+
+  MatrixXd A = MatrixXd::Zero(dim, dim);
+  for (int i = 0; i < dim; i++) A(i, i) = alpha[i];
+  for (int i = 0; i < arrow_pos - 1; i++) A(i, arrow_pos - 1) = A(arrow_pos - 1, i) = beta[i];
+  for (int i = arrow_pos - 1; i < dim - 1; i++) A(i, i + 1) = A(i + 1, i) = beta[i];
+
+  SelfAdjointEigenSolver<MatrixXd> dense;
+  ArrowEigensolver structured;
+  std::vector<double> vecs((size_t)dim * n_keep);
+
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+  dense.compute(A);
+  timer.Stop(__func__, __FILE__, __LINE__);
+  const double t_dense = timer.Last();
+
+  timer.Start(__func__, __FILE__, __LINE__);
+  structured.compute(alpha.data(), beta.data(), dim, arrow_pos);
+  structured.vectors(vecs.data(), n_keep);
+  timer.Stop(__func__, __FILE__, __LINE__);
+  const double t_arrow = timer.Last();
+
+  double d_eval = 0.0, d_last = 0.0;
+  for (int i = 0; i < dim; i++) {
+    d_eval = std::max(d_eval, fabs(structured.eval(i) - dense.eigenvalues()[i]));
+    d_last = std::max(d_last, fabs(fabs(structured.lastComponent(i)) - fabs(dense.eigenvectors()(dim - 1, i))));
+  }
+
+  Map<MatrixXd> V(vecs.data(), dim, n_keep);
+  MatrixXd R = A * V;
+  for (int i = 0; i < n_keep; i++) R.col(i) -= structured.eval(i) * V.col(i);
+  const double res = R.cwiseAbs().maxCoeff();
+  const double orth = (V.transpose() * V - MatrixXd::Identity(n_keep, n_keep)).cwiseAbs().maxCoeff();
+
+  printfQuda("nKr = %5d: dense %9.4f s, arrow %9.4f s (x%6.2f), |d eval| = %.1e, |d last| = %.1e, |Av - lv| = %.1e, "
+             "|V^T V - 1| = %.1e\n",
+             dim, t_dense, t_arrow, t_dense / t_arrow, d_eval, d_last, res, orth);
+
+  const double tol = 1e-11;
+  return d_eval < tol && d_last < tol && res < tol && orth < tol;
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  app->add_option("--arrow-dims", arrow_dims, "Krylov space sizes to benchmark (default 64 128 256 512 1024 2048)");
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+
+  printfQuda("Arrow matrix eigensolver with %d threads, keeping nKr / 2 Ritz vectors\n", host::thread_count());
+
+  int fail = 0;
+  for (auto dim : arrow_dims) {
+    if (dim < 4) errorQuda("nKr = %d is too small", dim);
+    if (!arrow(dim)) fail++;
+  }
+
+  if (fail) warningQuda("%d arrow matrix eigendecompositions failed the accuracy check", fail);
+
+  finalizeComms();
+  return fail ? 1 : 0;
+}
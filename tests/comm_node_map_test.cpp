@@ -0,0 +1,148 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+#include <test_util.h>
+#include <test_params.h>
+
+// google test
+#include <gtest/gtest.h>
+
+#include <comm_quda.h>
+
+/**
+   Simulator for the node-aware rank map (comm_node_rank_from_coords).
+   The mapping is computed for a given process grid, local lattice
+   size and number of nodes without any communication, and its
+   intra-/inter-node halo surface is compared against the
+   lexicographical maps used by default.
+ */
+
+static int sim_nodes = 2;
+
+/**
+   Lexicographical rank layout, with either t (rank_order = 0) or x
+   (rank_order = 1) running fastest.
+ */
+static void lex_layout(const int *dims, int rank_order, int *rank_of_grid)
+{
+  for (int x0 = 0; x0 < dims[0]; x0++)
+    for (int x1 = 0; x1 < dims[1]; x1++)
+      for (int x2 = 0; x2 < dims[2]; x2++)
+        for (int x3 = 0; x3 < dims[3]; x3++) {
+          int idx = ((x0 * dims[1] + x1) * dims[2] + x2) * dims[3] + x3;
+          int rank = rank_order == 0 ? idx : ((x3 * dims[2] + x2) * dims[1] + x1) * dims[0] + x0;
+          rank_of_grid[idx] = rank;
+        }
+}
+
+/**
+   Ranks are assigned to nodes in blocks, as with the usual
+   "--map-by node:PE" style launches, so node n holds ranks
+   [n*ranks_per_node, (n+1)*ranks_per_node).
+ */
+static std::vector<int> block_nodes(int nranks, int nodes)
+{
+  std::vector<int> node_of_rank(nranks);
+  for (int r = 0; r < nranks; r++) node_of_rank[r] = r / (nranks / nodes);
+  return node_of_rank;
+}
+
+struct MapScore {
+  double intra;
+  double inter;
+};
+
+static MapScore score(const int *dims, const int *local_dims, const std::vector<int> &rank_of_grid,
+                      const std::vector<int> &node_of_rank)
+{
+  MapScore s;
+  comm_node_map_surface(4, dims, local_dims, rank_of_grid.data(), node_of_rank.data(), &s.intra, &s.inter);
+  return s;
+}
+
+/**
+   @brief Check the node map is a permutation of the ranks, and
+   that its inter-node surface is no worse than either
+   lexicographical map.
+ */
+static bool simulate(const int *dims, const int *local_dims, int nodes, bool verbose)
+{
+  int nranks = dims[0] * dims[1] * dims[2] * dims[3];
+  if (nranks % nodes != 0) return true;
+
+  auto node_of_rank = block_nodes(nranks, nodes);
+
+  std::vector<int> node_map(nranks, -1);
+  int block[4];
+  bool found = comm_node_map_layout(4, dims, local_dims, nranks, node_of_rank.data(), node_map.data(), block);
+
+  std::vector<int> lex_t(nranks), lex_x(nranks);
+  lex_layout(dims, 0, lex_t.data());
+  lex_layout(dims, 1, lex_x.data());
+
+  auto s_t = score(dims, local_dims, lex_t, node_of_rank);
+  auto s_x = score(dims, local_dims, lex_x, node_of_rank);
+
+  if (verbose) {
+    printf("grid %dx%dx%dx%d, local %dx%dx%dx%d, %d nodes x %d ranks\n", dims[0], dims[1], dims[2], dims[3],
+           local_dims[0], local_dims[1], local_dims[2], local_dims[3], nodes, nranks / nodes);
+    printf("  lex (t fastest): intra = %12.0f inter = %12.0f\n", s_t.intra, s_t.inter);
+    printf("  lex (x fastest): intra = %12.0f inter = %12.0f\n", s_x.intra, s_x.inter);
+  }
+
+  if (!found) {
+    if (verbose) printf("  node map: no valid sub-block\n");
+    return true;
+  }
+
+  std::vector<int> seen(nranks, 0);
+  for (auto r : node_map) {
+    if (r < 0 || r >= nranks || seen[r]) return false;
+    seen[r] = 1;
+  }
+
+  auto s_n = score(dims, local_dims, node_map, node_of_rank);
+  if (verbose) {
+    if (block[0] > 0)
+      printf("  node map %dx%dx%dx%d: intra = %12.0f inter = %12.0f\n", block[0], block[1], block[2], block[3],
+             s_n.intra, s_n.inter);
+    else
+      printf("  node map (lex fill): intra = %12.0f inter = %12.0f\n", s_n.intra, s_n.inter);
+  }
+
+  return s_n.inter <= s_t.inter && s_n.inter <= s_x.inter;
+}
+
+TEST(NodeMap, commandline)
+{
+  int local_dims[4] = {xdim, ydim, zdim, tdim};
+  EXPECT_TRUE(simulate(gridsize_from_cmdline.data(), local_dims, sim_nodes, true));
+}
+
+TEST(NodeMap, sweep)
+{
+  const int local_dims[][4] = {{16, 16, 16, 16}, {24, 24, 24, 12}, {8, 16, 16, 32}};
+  const int grids[][4] = {{1, 1, 2, 4}, {1, 2, 2, 4}, {2, 2, 2, 4}, {2, 2, 4, 4}, {2, 4, 4, 8}, {4, 4, 4, 8}};
+  const int nodes[] = {1, 2, 4, 8, 16, 32};
+
+  for (auto &l : local_dims)
+    for (auto &g : grids)
+      for (auto n : nodes) EXPECT_TRUE(simulate(g, l, n, false));
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  app->add_option("--nodes", sim_nodes, "Number of nodes to simulate the rank map for (default 2)");
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  // no communication is needed: the mapping is simulated for sim_nodes nodes
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -10,15 +10,14 @@ extern int Vh;
 extern int V;
 
 using namespace quda;
-using namespace std;
 
 template <typename Float> void contractDegrandRossi(Float *h_result_)
 {
 
   // Put data in complex form
-  complex<Float> temp[16];
-  complex<Float> *h_result = (complex<Float> *)(Float *)(h_result_);
-  complex<Float> I(0.0, 1.0);
+  std::complex<Float> temp[16];
+  std::complex<Float> *h_result = (std::complex<Float> *)(Float *)(h_result_);
+  std::complex<Float> I(0.0, 1.0);
 
   for (int site = 0; site < V; site++) {
 
@@ -232,3 +231,46 @@ int contraction_reference(Float *spinorX, Float *spinorY, Float *d_result, QudaC
   free(h_result);
   return faults;
 };
+
+/**
+   @brief Reference momentum-projected, time-sliced contraction: the
+   site contractions of contraction_reference summed over each time
+   slice with the phase exp(-i p.x)
+   @param[out] result Nt x n_mom x 16 complex correlators, with Nt the global temporal extent
+*/
+template <typename Float>
+void contraction_momentum_reference(Float *spinorX, Float *spinorY, double *result, QudaContractType cType,
+                                    const int *mom, int n_mom)
+{
+  Float *h_result = (Float *)malloc(V * 2 * 16 * sizeof(Float));
+  contractColor(spinorX, spinorY, h_result);
+  if (cType == QUDA_CONTRACT_TYPE_DR) contractDegrandRossi(h_result);
+
+  int N[4];
+  for (int d = 0; d < 4; d++) N[d] = Z[d] * comm_dim(d);
+  const int n_corr = N[3] * n_mom * 16;
+  for (int i = 0; i < 2 * n_corr; i++) result[i] = 0.0;
+
+  for (int i = 0; i < V; i++) {
+    int Y = fullLatticeIndex(i % Vh, i / Vh);
+    int x[4];
+    for (int d = 0; d < 4; d++) {
+      x[d] = Y % Z[d] + comm_coord(d) * Z[d];
+      Y /= Z[d];
+    }
+    for (int m = 0; m < n_mom; m++) {
+      double theta = 0.0;
+      for (int j = 0; j < 3; j++) theta += 2.0 * M_PI * mom[3 * m + j] * x[j] / N[j];
+      for (int g = 0; g < 16; g++) {
+        double re = h_result[2 * (16 * i + g) + 0];
+        double im = h_result[2 * (16 * i + g) + 1];
+        double *r = result + 2 * ((x[3] * n_mom + m) * 16 + g);
+        r[0] += re * cos(theta) + im * sin(theta);
+        r[1] += im * cos(theta) - re * sin(theta);
+      }
+    }
+  }
+  comm_allreduce_array(result, 2 * n_corr);
+
+  free(h_result);
+}
@@ -23,6 +23,7 @@
 // In a typical application, quda.h is the only QUDA header required.
 #include <quda.h>
 #include <color_spinor_field.h>
+#include <contract_quda.h>
 
 
 // If you add a new contraction type, this must be updated++
@@ -250,3 +251,82 @@ std::string getContractName(testing::TestParamInfo<::testing::tuple<int, int>> p
 
 // Instantiate all test cases
 INSTANTIATE_TEST_SUITE_P(QUDA, ContractionTest, Combine(Range(0, 2), Range(0, NcontractType)), getContractName);
+
+// Compares the device and host momentum-projected contractions with the
+// projection of the site contractions of the reference code
+void testMomentum(int contractionType, int Prec)
+{
+  QudaPrecision testPrec = Prec == 0 ? QUDA_SINGLE_PRECISION : QUDA_DOUBLE_PRECISION;
+  QudaContractType cType = contractionType == 0 ? QUDA_CONTRACT_TYPE_OPEN : QUDA_CONTRACT_TYPE_DR;
+
+  int X[4] = {xdim, ydim, zdim, tdim};
+
+  QudaInvertParam inv_param = newQudaInvertParam();
+  setInvertParam(inv_param);
+  inv_param.cpu_prec = testPrec;
+  inv_param.cuda_prec = testPrec;
+  inv_param.cuda_prec_sloppy = testPrec;
+  inv_param.cuda_prec_precondition = testPrec;
+
+  size_t sSize = (testPrec == QUDA_DOUBLE_PRECISION) ? sizeof(double) : sizeof(float);
+  void *spinorX = malloc(V * spinorSiteSize * sSize);
+  void *spinorY = malloc(V * spinorSiteSize * sSize);
+  for (int i = 0; i < V * spinorSiteSize; i++) {
+    if (testPrec == QUDA_SINGLE_PRECISION) {
+      ((float *)spinorX)[i] = rand() / (float)RAND_MAX;
+      ((float *)spinorY)[i] = rand() / (float)RAND_MAX;
+    } else {
+      ((double *)spinorX)[i] = rand() / (double)RAND_MAX;
+      ((double *)spinorY)[i] = rand() / (double)RAND_MAX;
+    }
+  }
+
+  const int mom[] = {0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, -1, 0, 2, 1, 1, 1};
+  const int n_mom = sizeof(mom) / (3 * sizeof(int));
+  const int n_corr = tdim * comm_dim(3) * n_mom * 16;
+
+  std::vector<double> d_result(2 * n_corr), h_result(2 * n_corr), ref(2 * n_corr);
+  contractMomentumQuda(spinorX, spinorY, d_result.data(), cType, mom, n_mom, &inv_param, X);
+
+  ColorSpinorParam cpuParam(spinorX, inv_param, X, false, QUDA_CPU_FIELD_LOCATION);
+  cpuColorSpinorField h_x(cpuParam);
+  cpuParam.v = spinorY;
+  cpuColorSpinorField h_y(cpuParam);
+  quda::contractMomentumQuda(h_x, h_y, h_result.data(), cType, mom, n_mom);
+
+  if (testPrec == QUDA_DOUBLE_PRECISION)
+    contraction_momentum_reference((double *)spinorX, (double *)spinorY, ref.data(), cType, mom, n_mom);
+  else
+    contraction_momentum_reference((float *)spinorX, (float *)spinorY, ref.data(), cType, mom, n_mom);
+
+  // the correlators are sums over a time slice, so compare relative to the slice volume
+  const double tol = (testPrec == QUDA_DOUBLE_PRECISION ? 1e-12 : 1e-5) * V / tdim;
+  int device_faults = 0, host_faults = 0;
+  for (int i = 0; i < 2 * n_corr; i++) {
+    if (fabs(d_result[i] - ref[i]) > tol) device_faults++;
+    if (fabs(h_result[i] - ref[i]) > tol) host_faults++;
+  }
+
+  printfQuda("Momentum contraction %s with %d momenta: %d device and %d host faults out of %d\n",
+             get_contract_str(cType), n_mom, device_faults, host_faults, 2 * n_corr);
+
+  EXPECT_EQ(device_faults, 0) << "Device momentum contraction does not agree with the reference";
+  EXPECT_EQ(host_faults, 0) << "Host momentum contraction does not agree with the reference";
+
+  free(spinorX);
+  free(spinorY);
+}
+
+class MomentumContractionTest : public ContractionTest
+{
+};
+
+TEST_P(MomentumContractionTest, verify)
+{
+  int prec = ::testing::get<0>(GetParam());
+  int contractionType = ::testing::get<1>(GetParam());
+  testMomentum(contractionType, prec);
+}
+
+INSTANTIATE_TEST_SUITE_P(QUDA, MomentumContractionTest, Combine(Range(0, 2), Range(0, NcontractType)),
+                         getContractName);
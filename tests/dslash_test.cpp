@@ -268,7 +268,7 @@ void init(int argc, char **argv) {
   printfQuda("Randomizing fields... ");
 
   if (strcmp(latfile,"")) {  // load in the command line supplied gauge field
-    read_gauge_field(latfile, hostGauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    load_gauge_field(latfile, hostGauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
     construct_gauge_field(hostGauge, 2, gauge_param.cpu_prec, &gauge_param);
   } else { // else generate an SU(3) field
     if (unit_gauge) {
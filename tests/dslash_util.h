@@ -3,6 +3,7 @@
 
 #include <test_util.h>
 #include <comm_quda.h>
+#include <host_su3.h>
 
 template <typename Float>
 static inline void sum(Float *dst, Float *a, Float *b, int cnt) {
@@ -78,14 +79,12 @@ static inline void su3Transpose(Float *res, Float *mat) {
 
 template <typename sFloat, typename gFloat>
 static inline void su3Mul(sFloat *res, gFloat *mat, sFloat *vec) {
-  for (int n = 0; n < 3; n++) dot(&res[n*(2)], &mat[n*(3*2)], vec);
+  quda::host::mat_vec(res, mat, vec);
 }
 
 template <typename sFloat, typename gFloat>
 static inline void su3Tmul(sFloat *res, gFloat *mat, sFloat *vec) {
-  gFloat matT[3*3*2];
-  su3Transpose(matT, mat);
-  su3Mul(res, matT, vec);
+  quda::host::adj_mat_vec(res, mat, vec);
 }
 
 
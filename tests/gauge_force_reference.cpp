@@ -8,6 +8,7 @@
 #include "test_util.h"
 #include "misc.h"
 #include "gauge_force_reference.h"
+#include <host_su3.h>
 
 extern int Z[4];
 extern int V;
@@ -149,53 +150,23 @@ template <typename su3_matrix>
 static void
 mult_su3_nn(su3_matrix* a, su3_matrix* b, su3_matrix* c)
 {
-    int i,j,k;
-    typename std::remove_reference<decltype(a->e[0][0])>::type x,y;
-    for(i=0;i<3;i++){
-	for(j=0;j<3;j++){
-	    x.real=x.imag=0.0;
-	    for(k=0;k<3;k++){
-		CMUL( a->e[i][k] , b->e[k][j] , y );
-		CSUM( x , y );
-	    }
-	    c->e[i][j] = x;
-	}
-    }    
+    using real = typename std::remove_reference<decltype(a->e[0][0].real)>::type;
+    quda::host::mul_nn(reinterpret_cast<real *>(c), reinterpret_cast<real *>(a), reinterpret_cast<real *>(b));
 }
 template<typename su3_matrix>
 static void 
 mult_su3_an( su3_matrix *a, su3_matrix *b, su3_matrix *c )
 {
-    int i,j,k;
-    typename std::remove_reference<decltype(a->e[0][0])>::type x,y;
-    for(i=0;i<3;i++){
-	for(j=0;j<3;j++){
-	    x.real=x.imag=0.0;
-	    for(k=0;k<3;k++){
-		CMULJ_( a->e[k][i] , b->e[k][j], y );
-		CSUM( x , y );
-	    }
-	    c->e[i][j] = x;
-	}
-    }
+    using real = typename std::remove_reference<decltype(a->e[0][0].real)>::type;
+    quda::host::mul_an(reinterpret_cast<real *>(c), reinterpret_cast<real *>(a), reinterpret_cast<real *>(b));
 }
 
 template<typename su3_matrix>
 static void
 mult_su3_na(  su3_matrix *a, su3_matrix *b, su3_matrix *c )
 {
-    int i,j,k;
-    typename std::remove_reference<decltype(a->e[0][0])>::type x,y;
-    for(i=0;i<3;i++){
-	for(j=0;j<3;j++){
-	    x.real=x.imag=0.0;
-	    for(k=0;k<3;k++){
-		CMUL_J( a->e[i][k] , b->e[j][k] , y );
-		CSUM( x , y );
-	    }
-	    c->e[i][j] = x;
-	}
-    }
+    using real = typename std::remove_reference<decltype(a->e[0][0].real)>::type;
+    quda::host::mul_na(reinterpret_cast<real *>(c), reinterpret_cast<real *>(a), reinterpret_cast<real *>(b));
 }
 
 template < typename su3_matrix>
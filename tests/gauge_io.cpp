@@ -0,0 +1,442 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <map>
+#include <string>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <host_parallel.h>
+#include <timer.h>
+#include <qio_field.h>
+#include <test_util.h>
+
+/**
+   Loaders for configurations in the NERSC archive and MILC native
+   binary formats, which need neither QIO nor a per-site callback.
+   The file is memory mapped on every rank, and each rank unpacks its
+   local sub-lattice with the host threads: byte swapping, expanding
+   reconstruct-12 links and converting precision on the fly, straight
+   into the QDP order of a cpuGaugeField.  The file checksum is
+   accumulated along the way, and the plaquette of the loaded field,
+   computed by QUDA's host plaquette, is checked against the header.
+ */
+
+using namespace quda;
+
+namespace
+{
+
+  /**
+     A read-only memory map of a whole file
+  */
+  class MappedFile
+  {
+    int fd;
+    size_t bytes;
+    const char *data;
+
+  public:
+    MappedFile(const char *filename) : fd(-1), bytes(0), data(nullptr)
+    {
+      fd = open(filename, O_RDONLY);
+      if (fd < 0) errorQuda("Unable to open %s", filename);
+      struct stat st;
+      if (fstat(fd, &st) != 0) errorQuda("Unable to stat %s", filename);
+      bytes = st.st_size;
+      void *map = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED) errorQuda("Unable to map %s", filename);
+      data = static_cast<const char *>(map);
+    }
+
+    ~MappedFile()
+    {
+      munmap(const_cast<char *>(data), bytes);
+      close(fd);
+    }
+
+    size_t Bytes() const { return bytes; }
+    const char *Data() const { return data; }
+  };
+
+  bool host_big_endian()
+  {
+    const uint32_t one = 1;
+    return *reinterpret_cast<const char *>(&one) == 0;
+  }
+
+  template <typename T> T byteswap(T v)
+  {
+    char b[sizeof(T)];
+    memcpy(b, &v, sizeof(T));
+    for (size_t i = 0; i < sizeof(T) / 2; i++) std::swap(b[i], b[sizeof(T) - 1 - i]);
+    memcpy(&v, b, sizeof(T));
+    return v;
+  }
+
+  /**
+     The binary payload of a configuration: the four links of each
+     site in lexicographic order of the global lattice (x fastest),
+     each link row-major with real and imaginary parts interleaved
+  */
+  struct Payload {
+    const char *data;
+    int X[4];   // global lattice dimensions
+    int rows;   // rows stored per link: 3, or 2 for reconstruct-12
+    int word;   // bytes per real: 4 or 8
+    bool swap;  // whether the byte order differs from the host's
+
+    size_t Bytes() const { return static_cast<size_t>(X[0]) * X[1] * X[2] * X[3] * 4 * rows * 6 * word; }
+  };
+
+  /**
+     NERSC checksum: the sum of the 32-bit words of the stored links
+  */
+  struct NerscChecksum {
+    using reducer = host::plus<uint64_t>;
+    uint64_t operator()(const uint32_t *w, int n, size_t) const
+    {
+      uint64_t sum = 0;
+      for (int i = 0; i < n; i++) sum += w[i];
+      return sum;
+    }
+  };
+
+  /**
+     MILC checksums: the xor of the 32-bit words, each rotated left by
+     its index in the file modulo 29 and 31, with sum29 in the upper
+     and sum31 in the lower half of the result
+  */
+  struct MilcChecksum {
+    using reducer = host::bit_xor<uint64_t>;
+    uint64_t operator()(const uint32_t *w, int n, size_t site) const
+    {
+      auto rotl = [](uint32_t v, int r) { return r ? (v << r) | (v >> (32 - r)) : v; };
+      uint32_t sum29 = 0, sum31 = 0;
+      int r29 = (n * site) % 29, r31 = (n * site) % 31;
+      for (int i = 0; i < n; i++) {
+        sum29 ^= rotl(w[i], r29);
+        sum31 ^= rotl(w[i], r31);
+        if (++r29 == 29) r29 = 0;
+        if (++r31 == 31) r31 = 0;
+      }
+      return (static_cast<uint64_t>(sum29) << 32) | sum31;
+    }
+  };
+
+  /**
+     @brief Unpack the local sub-lattice of the payload into the QDP
+     ordered host field gauge, and return the local checksum
+  */
+  template <typename Float, typename File, typename Checksum>
+  uint64_t unpack(void *gauge[], const int *X, const Payload &p, Checksum checksum)
+  {
+    const int reals = 4 * p.rows * 6;
+    const int words = reals * sizeof(File) / sizeof(uint32_t);
+    const int volumeCB = X[0] * X[1] * X[2] * X[3] / 2;
+    int offset[4];
+    for (int d = 0; d < 4; d++) offset[d] = comm_coord(d) * X[d];
+
+    return host::parallel_reduce(
+      2, volumeCB, static_cast<uint64_t>(0),
+      [&](int parity, int x_cb) {
+        // local coordinates of the checkerboard index
+        int x[4];
+        int za = x_cb / (X[0] / 2);
+        int zb = za / X[1];
+        x[1] = za - zb * X[1];
+        x[3] = zb / X[2];
+        x[2] = zb - x[3] * X[2];
+        x[0] = 2 * (x_cb - za * (X[0] / 2)) + ((x[1] + x[2] + x[3] + parity) & 1);
+
+        size_t site = 0;
+        for (int d = 3; d >= 0; d--) site = site * p.X[d] + offset[d] + x[d];
+
+        File buf[4 * gaugeSiteSize];
+        memcpy(buf, p.data + site * reals * sizeof(File), reals * sizeof(File));
+        if (p.swap)
+          for (int i = 0; i < reals; i++) buf[i] = byteswap(buf[i]);
+
+        uint32_t w[4 * gaugeSiteSize * sizeof(File) / sizeof(uint32_t)];
+        memcpy(w, buf, words * sizeof(uint32_t));
+        uint64_t sum = checksum(w, words, site);
+
+        const size_t index = (static_cast<size_t>(parity) * volumeCB + x_cb) * gaugeSiteSize;
+        for (int mu = 0; mu < 4; mu++) {
+          const File *in = buf + mu * p.rows * 6;
+          Float *out = static_cast<Float *>(gauge[mu]) + index;
+          for (int i = 0; i < p.rows * 6; i++) out[i] = in[i];
+          if (p.rows == 2) {
+            // row 2 = conj(row 0 x row 1), in double precision
+            for (int k = 0; k < 3; k++) {
+              const int a = (k + 1) % 3, b = (k + 2) % 3;
+              double a0r = in[2 * a], a0i = in[2 * a + 1], b0r = in[2 * b], b0i = in[2 * b + 1];
+              double a1r = in[6 + 2 * a], a1i = in[6 + 2 * a + 1], b1r = in[6 + 2 * b], b1i = in[6 + 2 * b + 1];
+              out[12 + 2 * k] = (a0r * b1r - a0i * b1i) - (b0r * a1r - b0i * a1i);
+              out[12 + 2 * k + 1] = -((a0r * b1i + a0i * b1r) - (b0r * a1i + b0i * a1r));
+            }
+          }
+        }
+        return sum;
+      },
+      typename Checksum::reducer());
+  }
+
+  template <typename Checksum>
+  uint64_t unpack(void *gauge[], QudaPrecision precision, const int *X, const Payload &p, Checksum checksum)
+  {
+    if (precision == QUDA_DOUBLE_PRECISION) {
+      return p.word == 8 ? unpack<double, double>(gauge, X, p, checksum) : unpack<double, float>(gauge, X, p, checksum);
+    } else if (precision == QUDA_SINGLE_PRECISION) {
+      return p.word == 8 ? unpack<float, double>(gauge, X, p, checksum) : unpack<float, float>(gauge, X, p, checksum);
+    } else {
+      errorQuda("Unsupported precision %d", precision);
+    }
+    return 0;
+  }
+
+  /**
+     @brief The plaquette, computed by QUDA's host plaquette, and the
+     average link trace Re tr U / 3 of a QDP ordered host field
+  */
+  void observables(double &plaq, double &trace, void *gauge[], QudaPrecision precision, const int *X)
+  {
+    QudaGaugeParam param = newQudaGaugeParam();
+    for (int d = 0; d < 4; d++) param.X[d] = X[d];
+    param.cpu_prec = precision;
+    param.cuda_prec = precision;
+    param.type = QUDA_WILSON_LINKS;
+    param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+    param.t_boundary = QUDA_PERIODIC_T;
+    param.reconstruct = QUDA_RECONSTRUCT_NO;
+    param.anisotropy = 1.0;
+
+    GaugeFieldParam gParam(gauge, param);
+    gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+    cpuGaugeField u(gParam);
+
+    int R[4];
+    for (int d = 0; d < 4; d++) R[d] = 2 * comm_dim_partitioned(d);
+    GaugeFieldParam gParamEx(u);
+    gParamEx.create = QUDA_NULL_FIELD_CREATE;
+    gParamEx.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+    gParamEx.pad = 0;
+    gParamEx.nFace = 1;
+    for (int d = 0; d < 4; d++) {
+      gParamEx.x[d] += 2 * R[d];
+      gParamEx.r[d] = R[d];
+    }
+    cpuGaugeField ex(gParamEx);
+    copyExtendedGauge(ex, u, QUDA_CPU_FIELD_LOCATION);
+    ex.exchangeExtendedGhost(R, false);
+    plaq = plaquette(ex).x;
+
+    const int volume = X[0] * X[1] * X[2] * X[3];
+    trace = host::parallel_reduce(
+      volume, 0.0,
+      [&](int i) {
+        double t = 0.0;
+        for (int mu = 0; mu < 4; mu++) {
+          for (int c = 0; c < 3; c++) {
+            size_t k = static_cast<size_t>(i) * gaugeSiteSize + 8 * c;
+            t += precision == QUDA_DOUBLE_PRECISION ? static_cast<double *>(gauge[mu])[k] :
+                                                      static_cast<float *>(gauge[mu])[k];
+          }
+        }
+        return t;
+      },
+      host::plus<double>());
+    comm_allreduce(&trace);
+    trace /= 3.0 * 4 * volume * comm_size();
+  }
+
+  std::string trim(const std::string &s)
+  {
+    size_t begin = s.find_first_not_of(" \t\r");
+    size_t end = s.find_last_not_of(" \t\r");
+    return begin == std::string::npos ? "" : s.substr(begin, end - begin + 1);
+  }
+
+  void check_dims(const char *filename, const int *file_dims, const int *X)
+  {
+    for (int d = 0; d < 4; d++) {
+      if (file_dims[d] != X[d] * comm_dim(d))
+        errorQuda("%s has dimension %d = %d, expected %d", filename, d, file_dims[d], X[d] * comm_dim(d));
+    }
+  }
+
+} // namespace
+
+void read_nersc_gauge_field(const char *filename, void *gauge[], QudaPrecision precision, const int *X)
+{
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+  MappedFile file(filename);
+
+  // the ASCII header, KEY = VALUE lines between BEGIN_HEADER and END_HEADER
+  const char *end = static_cast<const char *>(memmem(file.Data(), file.Bytes(), "END_HEADER", 10));
+  if (strncmp(file.Data(), "BEGIN_HEADER", 12) || !end) errorQuda("%s is not a NERSC archive", filename);
+  const char *payload = static_cast<const char *>(memchr(end, '\n', file.Bytes() - (end - file.Data())));
+  if (!payload) errorQuda("%s has a truncated header", filename);
+  payload++;
+
+  std::map<std::string, std::string> header;
+  std::string text(file.Data(), end);
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t eol = text.find('\n', pos);
+    if (eol == std::string::npos) eol = text.size();
+    std::string line = text.substr(pos, eol - pos);
+    size_t eq = line.find('=');
+    if (eq != std::string::npos) header[trim(line.substr(0, eq))] = trim(line.substr(eq + 1));
+    pos = eol + 1;
+  }
+
+  auto value = [&](const std::string &key) -> const std::string & {
+    auto it = header.find(key);
+    if (it == header.end()) errorQuda("%s has no %s in its header", filename, key.c_str());
+    return it->second;
+  };
+
+  Payload p;
+  p.data = payload;
+  for (int d = 0; d < 4; d++) p.X[d] = atoi(value("DIMENSION_" + std::to_string(d + 1)).c_str());
+  check_dims(filename, p.X, X);
+
+  const std::string &datatype = value("DATATYPE");
+  if (datatype == "4D_SU3_GAUGE_3x3") {
+    p.rows = 3;
+  } else if (datatype == "4D_SU3_GAUGE") {
+    p.rows = 2;
+  } else {
+    errorQuda("%s has unsupported DATATYPE %s", filename, datatype.c_str());
+  }
+
+  const std::string &fp = value("FLOATING_POINT");
+  bool big;
+  if (fp == "IEEE32" || fp == "IEEE32BIG") {
+    p.word = 4;
+    big = true;
+  } else if (fp == "IEEE32LITTLE") {
+    p.word = 4;
+    big = false;
+  } else if (fp == "IEEE64BIG") {
+    p.word = 8;
+    big = true;
+  } else if (fp == "IEEE64LITTLE") {
+    p.word = 8;
+    big = false;
+  } else {
+    errorQuda("%s has unsupported FLOATING_POINT %s", filename, fp.c_str());
+  }
+  p.swap = big != host_big_endian();
+
+  if (static_cast<size_t>(payload - file.Data()) + p.Bytes() > file.Bytes())
+    errorQuda("%s is truncated: %lu bytes of links expected", filename, p.Bytes());
+
+  uint64_t sum = unpack(gauge, precision, X, p, NerscChecksum());
+
+  // partial sums modulo 2^32 are exact in double across the ranks
+  double partial = static_cast<double>(sum & 0xffffffffu);
+  comm_allreduce(&partial);
+  uint32_t checksum = static_cast<uint64_t>(partial) & 0xffffffffu;
+  uint32_t expected = strtoul(value("CHECKSUM").c_str(), nullptr, 16);
+  if (checksum != expected) errorQuda("%s checksum %x does not match its header %x", filename, checksum, expected);
+
+  double plaq, trace;
+  observables(plaq, trace, gauge, precision, X);
+  timer.Stop(__func__, __FILE__, __LINE__);
+
+  double header_plaq = atof(value("PLAQUETTE").c_str());
+  double header_trace = atof(value("LINK_TRACE").c_str());
+  printfQuda("Loaded NERSC %s (%s, %s) in %.3f s: plaquette %.12f (header %.12f), link trace %.12f (header %.12f)\n",
+             filename, datatype.c_str(), fp.c_str(), timer.Last(), plaq, header_plaq, trace, header_trace);
+  if (fabs(plaq - header_plaq) > 1e-5) errorQuda("%s plaquette does not match its header", filename);
+  if (fabs(trace - header_trace) > 1e-6) errorQuda("%s link trace does not match its header", filename);
+}
+
+void read_milc_gauge_field(const char *filename, void *gauge[], QudaPrecision precision, const int *X)
+{
+  // magic number, dimensions, time stamp, site order and the two checksums
+  constexpr int32_t magic = 20103;
+  constexpr size_t header_bytes = 4 + 4 * 4 + 64 + 4 + 2 * 4;
+
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+  MappedFile file(filename);
+  if (file.Bytes() < header_bytes) errorQuda("%s is not a MILC configuration", filename);
+
+  int32_t word[5];
+  memcpy(word, file.Data(), sizeof(word));
+  Payload p;
+  if (word[0] == magic) {
+    p.swap = false;
+  } else if (byteswap(word[0]) == magic) {
+    p.swap = true;
+  } else {
+    errorQuda("%s is not a MILC configuration", filename);
+  }
+  for (int d = 0; d < 4; d++) p.X[d] = p.swap ? byteswap(word[d + 1]) : word[d + 1];
+  check_dims(filename, p.X, X);
+
+  int32_t order;
+  uint32_t sum[2];
+  memcpy(&order, file.Data() + 4 + 4 * 4 + 64, sizeof(order));
+  memcpy(sum, file.Data() + 4 + 4 * 4 + 64 + 4, sizeof(sum));
+  if (p.swap) {
+    order = byteswap(order);
+    for (auto &s : sum) s = byteswap(s);
+  }
+  if (order != 0) errorQuda("%s is not in natural site order", filename);
+
+  // the precision follows from the payload size
+  p.data = file.Data() + header_bytes;
+  p.rows = 3;
+  p.word = 4;
+  if (p.Bytes() != file.Bytes() - header_bytes) {
+    p.word = 8;
+    if (p.Bytes() != file.Bytes() - header_bytes)
+      errorQuda("%s has %lu bytes of links, which matches neither precision", filename, file.Bytes() - header_bytes);
+  }
+
+  uint64_t local = unpack(gauge, precision, X, p, MilcChecksum());
+  comm_allreduce_xor(&local);
+  uint32_t sum29 = local >> 32, sum31 = local & 0xffffffffu;
+  if (sum29 != sum[0] || sum31 != sum[1])
+    errorQuda("%s checksums %x %x do not match its header %x %x", filename, sum29, sum31, sum[0], sum[1]);
+
+  double plaq, trace;
+  observables(plaq, trace, gauge, precision, X);
+  timer.Stop(__func__, __FILE__, __LINE__);
+
+  printfQuda("Loaded MILC %s (%s precision) in %.3f s: plaquette %.12f, link trace %.12f\n", filename,
+             p.word == 8 ? "double" : "single", timer.Last(), plaq, trace);
+}
+
+void load_gauge_field(const char *filename, void *gauge[], QudaPrecision precision, const int *X, int argc,
+                      char *argv[])
+{
+  char head[12] = {};
+  FILE *file = fopen(filename, "rb");
+  if (!file) errorQuda("Unable to open %s", filename);
+  size_t n = fread(head, 1, sizeof(head), file);
+  fclose(file);
+
+  int32_t magic;
+  memcpy(&magic, head, sizeof(magic));
+  if (n == sizeof(head) && strncmp(head, "BEGIN_HEADER", 12) == 0) {
+    read_nersc_gauge_field(filename, gauge, precision, X);
+  } else if (n >= sizeof(magic) && (magic == 20103 || byteswap(magic) == 20103)) {
+    read_milc_gauge_field(filename, gauge, precision, X);
+  } else {
+    read_gauge_field(filename, gauge, precision, X, argc, argv);
+  }
+}
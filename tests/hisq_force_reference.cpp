@@ -8,6 +8,7 @@
 #include "test_util.h"
 #include "misc.h"
 #include "hisq_force_reference.h"
+#include <host_su3.h>
 
 extern int Z[4];
 extern int V;
@@ -260,19 +261,8 @@ template<typename su3_matrix>
 static void
 matrix_mult_nn(su3_matrix* a, su3_matrix* b, su3_matrix* c){
   // c = a*b
-  typename std::remove_reference<decltype(c->e[0][0])>::type x;
-  for(int i=0; i<3; i++){
-    for(int j=0; j<3; j++){	
-      c->e[i][j].real = 0.;
-      c->e[i][j].imag = 0.;
-      for(int k=0; k<3; k++){	
-	CMUL(a->e[i][k],b->e[k][j],x);
-	c->e[i][j].real += x.real;
-	c->e[i][j].imag += x.imag;
-      } 	
-    }	
-  }
-  return;
+  using real = typename std::remove_reference<decltype(c->e[0][0].real)>::type;
+  quda::host::mul_nn(reinterpret_cast<real *>(c), reinterpret_cast<real *>(a), reinterpret_cast<real *>(b));
 }
 
 
@@ -280,19 +270,8 @@ template<typename su3_matrix>
 static void
 matrix_mult_an(su3_matrix* a, su3_matrix* b, su3_matrix* c){
   // c = (a^{\dagger})*b
-  typename std::remove_reference<decltype(c->e[0][0])>::type x;
-  for(int i=0; i<3; i++){
-    for(int j=0; j<3; j++){	
-      c->e[i][j].real = 0.;
-      c->e[i][j].imag = 0.;
-      for(int k=0; k<3; k++){	
-	CMULJ_(a->e[k][i],b->e[k][j],x);
-	c->e[i][j].real += x.real;
-	c->e[i][j].imag += x.imag;
-      } 	
-    }	
-  }
-  return;
+  using real = typename std::remove_reference<decltype(c->e[0][0].real)>::type;
+  quda::host::mul_an(reinterpret_cast<real *>(c), reinterpret_cast<real *>(a), reinterpret_cast<real *>(b));
 }
 
 
@@ -301,18 +280,8 @@ template<typename su3_matrix>
 static void
 matrix_mult_na(su3_matrix* a, su3_matrix* b, su3_matrix* c){
   // c = a*b^{\dagger}
-  typename std::remove_reference<decltype(c->e[0][0])>::type x;
-  for(int i=0; i<3; i++){
-    for(int j=0; j<3; j++){
-      c->e[i][j].real = 0.; c->e[i][j].imag = 0.;
-      for(int k=0; k<3; k++){
-        CMUL_J(a->e[i][k],b->e[j][k],x);
-	c->e[i][j].real += x.real;
-	c->e[i][j].imag += x.imag;
-      }
-    }
-  }
-  return;
+  using real = typename std::remove_reference<decltype(c->e[0][0].real)>::type;
+  quda::host::mul_na(reinterpret_cast<real *>(c), reinterpret_cast<real *>(a), reinterpret_cast<real *>(b));
 }
 
 template<typename su3_matrix>
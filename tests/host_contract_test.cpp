@@ -0,0 +1,356 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#include <test_util.h>
+#include <test_params.h>
+#include <contract_reference.h>
+
+#include <quda_internal.h>
+#include <timer.h>
+#include <color_spinor_field.h>
+#include <contract_quda.h>
+#include <host_parallel.h>
+
+/**
+   Propagator contraction benchmark.  All 256 meson gamma structures
+   and two nucleon correlators of a pair of random host propagators are
+   computed by the propagator contraction engine, and the time is
+   compared with the per-pair approach, in which the 48 color-diagonal
+   column pairs are contracted one at a time by the momentum-projected
+   contraction and the mesons are then formed from the resulting spin
+   elementals.  The mesons of the two must agree, and those whose sink
+   gamma structure is one of the DeGrand-Rossi contractions of
+   contraction_reference are also checked against that reference.  The
+   baryons are checked against a naive evaluation of the
+   epsilon-tensor sums.
+ */
+
+using namespace quda;
+
+using SpinMatrix = complex<double>[4][4];
+
+static void multiply(SpinMatrix c, const SpinMatrix a, const SpinMatrix b)
+{
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++) {
+      c[i][j] = 0.0;
+      for (int k = 0; k < 4; k++) c[i][j] += a[i][k] * b[k][j];
+    }
+}
+
+static int levi_civita(int a, int b, int c)
+{
+  if (a == b || b == c || a == c) return 0;
+  return ((b - a + 3) % 3 == 1) ? 1 : -1;
+}
+
+/**
+   @brief Naive baryon correlators, following the formula documented
+   with BaryonContraction term by term
+*/
+static void baryon_reference(const std::vector<ColorSpinorField *> &S1, const std::vector<ColorSpinorField *> &S2,
+                             const std::vector<BaryonContraction> &baryons, const int *mom, int n_mom,
+                             std::vector<complex<double>> &result)
+{
+  const int n_b = baryons.size();
+  int N[4];
+  for (int d = 0; d < 4; d++) N[d] = Z[d] * comm_dim(d);
+  result.assign(N[3] * n_mom * n_b, complex<double>(0.0, 0.0));
+
+  SpinMatrix g2, g4, C;
+  contractionGamma(g2, QUDA_CONTRACT_GAMMA_G2);
+  contractionGamma(g4, QUDA_CONTRACT_GAMMA_G4);
+  multiply(C, g4, g2);
+
+  std::vector<std::vector<complex<double>>> dq(n_b, std::vector<complex<double>>(16)), dqbar = dq;
+  for (int n = 0; n < n_b; n++) {
+    SpinMatrix g, cg, cg_dag, tmp, bar;
+    contractionGamma(g, baryons[n].diquark);
+    multiply(cg, C, g);
+    for (int i = 0; i < 4; i++)
+      for (int j = 0; j < 4; j++) cg_dag[i][j] = conj(cg[j][i]);
+    multiply(tmp, g4, cg_dag);
+    multiply(bar, tmp, g4);
+    for (int i = 0; i < 4; i++)
+      for (int j = 0; j < 4; j++) {
+        dq[n][4 * i + j] = cg[i][j];
+        dqbar[n][4 * i + j] = bar[i][j];
+      }
+  }
+
+  for (int s = 0; s < V; s++) {
+    // S^{aa'}_{kk'}, with the column 3 k' + a'
+    auto u = [&](int k, int a, int kp, int ap) {
+      const double *v = static_cast<const double *>(S1[3 * kp + ap]->V()) + 24 * s + 2 * (3 * k + a);
+      return complex<double>(v[0], v[1]);
+    };
+    auto d = [&](int k, int a, int kp, int ap) {
+      const double *v = static_cast<const double *>(S2[3 * kp + ap]->V()) + 24 * s + 2 * (3 * k + a);
+      return complex<double>(v[0], v[1]);
+    };
+
+    int Y = fullLatticeIndex(s % Vh, s / Vh);
+    int x[4];
+    for (int dim = 0; dim < 4; dim++) {
+      x[dim] = Y % Z[dim] + comm_coord(dim) * Z[dim];
+      Y /= Z[dim];
+    }
+
+    for (int n = 0; n < n_b; n++) {
+      complex<double> sum = 0.0;
+      for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++)
+          for (int c = 0; c < 3; c++) {
+            if (!levi_civita(a, b, c)) continue;
+            for (int ap = 0; ap < 3; ap++)
+              for (int bp = 0; bp < 3; bp++)
+                for (int cp = 0; cp < 3; cp++) {
+                  const int e = levi_civita(a, b, c) * levi_civita(ap, bp, cp);
+                  if (!e) continue;
+                  for (int i = 0; i < 4; i++)
+                    for (int j = 0; j < 4; j++)
+                      for (int jp = 0; jp < 4; jp++)
+                        for (int ip = 0; ip < 4; ip++) {
+                          complex<double> w = dq[n][4 * i + j] * dqbar[n][4 * jp + ip];
+                          if (norm(w) == 0.0) continue;
+                          w *= static_cast<double>(e) * d(j, c, jp, cp);
+                          for (int kp = 0; kp < 4; kp++)
+                            for (int k = 0; k < 4; k++)
+                              sum += w * baryons[n].projector[kp][k]
+                                * (u(k, a, kp, ap) * u(i, b, ip, bp) - u(k, a, ip, bp) * u(i, b, kp, ap));
+                        }
+                }
+          }
+
+      for (int p = 0; p < n_mom; p++) {
+        double theta = 0.0;
+        for (int j = 0; j < 3; j++) theta += 2.0 * M_PI * mom[3 * p + j] * x[j] / N[j];
+        result[(x[3] * n_mom + p) * n_b + n] += complex<double>(cos(theta), -sin(theta)) * sum;
+      }
+    }
+  }
+  comm_allreduce_array(reinterpret_cast<double *>(result.data()), 2 * result.size());
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+  int X[4] = {xdim, ydim, zdim, tdim};
+  setDims(X);
+
+  ColorSpinorParam param;
+  param.nColor = 3;
+  param.nSpin = 4;
+  param.nDim = 4;
+  for (int d = 0; d < 4; d++) param.x[d] = X[d];
+  param.setPrecision(QUDA_DOUBLE_PRECISION);
+  param.pad = 0;
+  param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.pc_type = QUDA_4D_PC;
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+
+  std::vector<ColorSpinorField *> S1, S2;
+  for (int col = 0; col < 12; col++) {
+    S1.push_back(new cpuColorSpinorField(param));
+    S1[col]->Source(QUDA_RANDOM_SOURCE);
+    S2.push_back(new cpuColorSpinorField(param));
+    S2[col]->Source(QUDA_RANDOM_SOURCE);
+  }
+
+  const int mom[] = {0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1};
+  const int n_mom = 4;
+
+  std::vector<MesonContraction> mesons;
+  for (int snk = 0; snk < 16; snk++)
+    for (int src = 0; src < 16; src++)
+      mesons.push_back({static_cast<QudaContractGamma>(snk), static_cast<QudaContractGamma>(src)});
+
+  // nucleon with the positive parity projector (1 + g4) / 2
+  SpinMatrix g4;
+  contractionGamma(g4, QUDA_CONTRACT_GAMMA_G4);
+  std::vector<BaryonContraction> baryons(2);
+  baryons[0].diquark = QUDA_CONTRACT_GAMMA_G5;
+  baryons[1].diquark = QUDA_CONTRACT_GAMMA_G4G5;
+  for (auto &b : baryons)
+    for (int i = 0; i < 4; i++)
+      for (int j = 0; j < 4; j++) b.projector[i][j] = 0.5 * ((i == j ? 1.0 : 0.0) + g4[i][j]);
+
+  const int Nt = tdim * comm_dim(3);
+  const int n_meson = mesons.size();
+  printfQuda("Propagator contractions on %dx%dx%dx%d sites with %d threads, %d mesons, %lu baryons, %d momenta\n",
+             xdim, ydim, zdim, tdim, host::thread_count(), n_meson, baryons.size(), n_mom);
+
+  // the engine
+  std::vector<complex<double>> meson_result, baryon_result;
+  Timer engine;
+  engine.Start(__func__, __FILE__, __LINE__);
+  contractPropagatorsQuda(S1, S2, mesons, baryons, mom, n_mom, meson_result, baryon_result);
+  engine.Stop(__func__, __FILE__, __LINE__);
+
+  // the per-pair loop: the spin elementals
+  // P[j'][j][i'][i] = sum_b <S2_{j'b}(i') | S1_{jb}(i)> of each time
+  // slice and momentum, from which each meson is a sum over its gammas
+  Timer pairs;
+  pairs.Start(__func__, __FILE__, __LINE__);
+  std::vector<complex<double>> P(Nt * n_mom * 256, complex<double>(0.0, 0.0));
+  std::vector<complex<double>> A(Nt * n_mom * 16);
+  for (int jp = 0; jp < 4; jp++)
+    for (int j = 0; j < 4; j++)
+      for (int b = 0; b < 3; b++) {
+        contractMomentumQuda(*S2[3 * jp + b], *S1[3 * j + b], A.data(), QUDA_CONTRACT_TYPE_OPEN, mom, n_mom);
+        for (int tp = 0; tp < Nt * n_mom; tp++)
+          for (int e = 0; e < 16; e++) P[tp * 256 + (4 * jp + j) * 16 + e] += A[tp * 16 + e];
+      }
+
+  SpinMatrix g5;
+  contractionGamma(g5, QUDA_CONTRACT_GAMMA_G5);
+  std::vector<complex<double>> meson_pairs(Nt * n_mom * n_meson, complex<double>(0.0, 0.0));
+  for (int m = 0; m < n_meson; m++) {
+    SpinMatrix snk, src, w_snk, w_src;
+    contractionGamma(snk, mesons[m].snk);
+    contractionGamma(src, mesons[m].src);
+    multiply(w_src, src, g5);
+    multiply(w_snk, g5, snk);
+    for (int tp = 0; tp < Nt * n_mom; tp++) {
+      complex<double> sum = 0.0;
+      for (int jp = 0; jp < 4; jp++)
+        for (int j = 0; j < 4; j++)
+          for (int ip = 0; ip < 4; ip++)
+            for (int i = 0; i < 4; i++)
+              sum += w_src[j][jp] * w_snk[ip][i] * P[tp * 256 + (4 * jp + j) * 16 + 4 * ip + i];
+      meson_pairs[tp * n_meson + m] = sum;
+    }
+  }
+  pairs.Stop(__func__, __FILE__, __LINE__);
+
+  printfQuda("Propagator engine %9.3f s\n", engine.Last());
+  printfQuda("Per-pair loop     %9.3f s (mesons only), %.2fx\n", pairs.Last(), pairs.Last() / engine.Last());
+
+  // the correlators are sums over a time slice, so compare relative to the slice volume
+  const double tol = 1e-12 * V / tdim * 12;
+  int fail = 0;
+
+  double meson_dev = 0.0;
+  for (size_t i = 0; i < meson_result.size(); i++) meson_dev = std::max(meson_dev, abs(meson_result[i] - meson_pairs[i]));
+  if (meson_dev > tol) fail++;
+  printfQuda("Mesons:  max deviation from the per-pair loop %e  %s\n", meson_dev, meson_dev > tol ? "FAILED" : "");
+
+  // the spin matrices D_g of the DeGrand-Rossi contractions, for which
+  // sum_{i'i} D_g[i'][i] <S2(i') | S1(i)> is contraction g, read off
+  // by contracting unit spin elementals
+  std::vector<complex<double>> unit(16 * V, complex<double>(0.0, 0.0));
+  for (int e = 0; e < 16; e++) unit[16 * e + e] = 1.0;
+  contractDegrandRossi(reinterpret_cast<double *>(unit.data()));
+  auto D = [&](int g, int ip, int i) { return unit[16 * (4 * ip + i) + g]; };
+
+  // R[j'][j] = sum_b of the DeGrand-Rossi contractions of S2_{j'b} and S1_{jb}
+  std::vector<double> R(16 * Nt * n_mom * 32, 0.0), r(Nt * n_mom * 32);
+  for (int jp = 0; jp < 4; jp++)
+    for (int j = 0; j < 4; j++)
+      for (int b = 0; b < 3; b++) {
+        contraction_momentum_reference(static_cast<double *>(S2[3 * jp + b]->V()),
+                                       static_cast<double *>(S1[3 * j + b]->V()), r.data(), QUDA_CONTRACT_TYPE_DR, mom,
+                                       n_mom);
+        for (size_t k = 0; k < r.size(); k++) R[(4 * jp + j) * r.size() + k] += r[k];
+      }
+
+  double reference_dev = 0.0;
+  int n_reference = 0;
+  for (int m = 0; m < n_meson; m++) {
+    SpinMatrix snk, src, w_snk, w_src;
+    contractionGamma(snk, mesons[m].snk);
+    contractionGamma(src, mesons[m].src);
+    multiply(w_src, src, g5);
+    multiply(w_snk, g5, snk);
+
+    // find the contraction g with w_snk = c D_g
+    int g_snk = -1;
+    complex<double> c = 0.0;
+    for (int g = 0; g < 16 && g_snk < 0; g++) {
+      complex<double> overlap = 0.0;
+      double norm2 = 0.0;
+      for (int ip = 0; ip < 4; ip++)
+        for (int i = 0; i < 4; i++) {
+          overlap += conj(D(g, ip, i)) * w_snk[ip][i];
+          norm2 += norm(D(g, ip, i));
+        }
+      double residual = 0.0;
+      for (int ip = 0; ip < 4; ip++)
+        for (int i = 0; i < 4; i++) residual += norm(w_snk[ip][i] - overlap / norm2 * D(g, ip, i));
+      if (residual < 1e-24) {
+        g_snk = g;
+        c = overlap / norm2;
+      }
+    }
+    if (g_snk < 0) continue;
+
+    for (int tp = 0; tp < Nt * n_mom; tp++) {
+      complex<double> sum = 0.0;
+      for (int jp = 0; jp < 4; jp++)
+        for (int j = 0; j < 4; j++) {
+          const double *v = &R[(4 * jp + j) * r.size() + 2 * (tp * 16 + g_snk)];
+          sum += w_src[j][jp] * c * complex<double>(v[0], v[1]);
+        }
+      reference_dev = std::max(reference_dev, abs(meson_result[tp * n_meson + m] - sum));
+    }
+    n_reference++;
+  }
+  if (n_reference == 0 || reference_dev > tol) fail++;
+  printfQuda("Mesons:  max deviation of %d mesons from contraction_reference %e  %s\n", n_reference, reference_dev,
+             n_reference == 0 || reference_dev > tol ? "FAILED" : "");
+
+  Timer naive;
+  naive.Start(__func__, __FILE__, __LINE__);
+  std::vector<complex<double>> baryon_ref;
+  baryon_reference(S1, S2, baryons, mom, n_mom, baryon_ref);
+  naive.Stop(__func__, __FILE__, __LINE__);
+
+  double baryon_dev = 0.0, baryon_max = 0.0;
+  for (size_t i = 0; i < baryon_result.size(); i++) {
+    baryon_dev = std::max(baryon_dev, abs(baryon_result[i] - baryon_ref[i]));
+    baryon_max = std::max(baryon_max, abs(baryon_ref[i]));
+  }
+  if (baryon_dev > 1e-12 * baryon_max) fail++;
+  printfQuda("Baryons: max relative deviation from the naive sums %e (naive %.3f s)  %s\n",
+             baryon_dev / baryon_max, naive.Last(), baryon_dev > 1e-12 * baryon_max ? "FAILED" : "");
+
+  // with S1 = S2 the pion tr[g5 S g5 g5 S^dag g5] = |S|^2 is real and positive
+  {
+    std::vector<MesonContraction> pion = {{QUDA_CONTRACT_GAMMA_G5, QUDA_CONTRACT_GAMMA_G5}};
+    std::vector<BaryonContraction> none;
+    std::vector<complex<double>> pi, empty;
+    const int zero[] = {0, 0, 0};
+    contractPropagatorsQuda(S1, S1, pion, none, zero, 1, pi, empty);
+    bool positive = true;
+    for (int t = 0; t < Nt; t++)
+      if (pi[t].real() <= 0.0 || fabs(pi[t].imag()) > 1e-12 * pi[t].real()) positive = false;
+    if (!positive) fail++;
+    printfQuda("Pion:    C(0) = %e  %s\n", pi[0].real(), positive ? "real and positive" : "FAILED");
+  }
+
+  for (int col = 0; col < 12; col++) {
+    delete S1[col];
+    delete S2[col];
+  }
+
+  if (fail) warningQuda("%d propagator contraction checks failed", fail);
+
+  finalizeComms();
+  return fail ? 1 : 0;
+}
@@ -0,0 +1,720 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <random>
+
+#include <test_util.h>
+#include <test_params.h>
+#include <misc.h>
+#include <wilson_dslash_reference.h>
+#include <staggered_dslash_reference.h>
+
+// google test
+#include <gtest/gtest.h>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <clover_field.h>
+#include <dirac_quda.h>
+#include <dslash_quda.h>
+#include <invert_quda.h>
+#include <blas_quda.h>
+#include <eigensolve_quda.h>
+
+/**
+   Test of the host Dirac operators.  The Wilson, clover, twisted-mass,
+   naive and improved staggered operators, as well as gamma5 and the
+   twisted-mass twist, are applied to host fields through the Dirac
+   classes and compared against the reference implementations.  Even-odd
+   preconditioned solves with CG, BiCGStab, GCR and MR, and eigensolves
+   with the thick restarted Lanczos method and its block variant, are
+   run with all fields on the host.  The in-place host Ritz rotation is
+   compared against the same rotation done with axpy.  The CRC32
+   checksums of spinor and clover fields are checked against a bitwise
+   CRC32 and against reordered copies of the fields.
+ */
+
+using namespace quda;
+
+static QudaGaugeParam gauge_param;
+static void *hostGauge[4];
+static cpuGaugeField *cpuGauge = nullptr;
+
+static ColorSpinorParam spinorParam(QudaGammaBasis basis)
+{
+  ColorSpinorParam csParam;
+  csParam.nColor = 3;
+  csParam.nSpin = 4;
+  csParam.nDim = 4;
+  for (int d = 0; d < 4; d++) csParam.x[d] = gauge_param.X[d];
+  csParam.x[0] /= 2;
+  csParam.setPrecision(QUDA_DOUBLE_PRECISION);
+  csParam.pad = 0;
+  csParam.siteSubset = QUDA_PARITY_SITE_SUBSET;
+  csParam.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  csParam.gammaBasis = basis;
+  csParam.pc_type = QUDA_4D_PC;
+  csParam.location = QUDA_CPU_FIELD_LOCATION;
+  csParam.create = QUDA_ZERO_FIELD_CREATE;
+  return csParam;
+}
+
+static ColorSpinorParam fullSpinorParam(QudaGammaBasis basis)
+{
+  ColorSpinorParam csParam = spinorParam(basis);
+  csParam.x[0] = gauge_param.X[0];
+  csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  return csParam;
+}
+
+/**
+   @brief Single-parity staggered fields, which carry a trivial fifth dimension
+*/
+static ColorSpinorParam staggeredParam()
+{
+  ColorSpinorParam csParam = spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS);
+  csParam.nSpin = 1;
+  csParam.nDim = 5;
+  csParam.x[4] = 1;
+  return csParam;
+}
+
+static Dirac *createDirac(QudaDiracType type, double kappa, CloverField *clover = nullptr, double mu = 0.0)
+{
+  DiracParam diracParam;
+  diracParam.type = type;
+  diracParam.kappa = kappa;
+  diracParam.mu = mu;
+  diracParam.epsilon = 0.0;
+  diracParam.matpcType = QUDA_MATPC_EVEN_EVEN;
+  diracParam.dagger = QUDA_DAG_NO;
+  diracParam.gauge = cpuGauge;
+  diracParam.clover = clover;
+  for (int d = 0; d < 4; d++) diracParam.commDim[d] = comm_dim_partitioned(d);
+  return Dirac::create(diracParam);
+}
+
+/**
+   @return The norm of ref - out relative to the norm of ref
+*/
+static double deviation(ColorSpinorField &ref, ColorSpinorField &out)
+{
+  double ref2 = blas::norm2(ref);
+  double diff = blas::xmyNorm(ref, out);
+  return sqrt(diff / ref2);
+}
+
+static void init()
+{
+  gauge_param = newQudaGaugeParam();
+  gauge_param.X[0] = xdim;
+  gauge_param.X[1] = ydim;
+  gauge_param.X[2] = zdim;
+  gauge_param.X[3] = tdim;
+  setDims(gauge_param.X);
+
+  gauge_param.anisotropy = 1.0;
+  gauge_param.type = QUDA_WILSON_LINKS;
+  gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  gauge_param.t_boundary = QUDA_ANTI_PERIODIC_T;
+  gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.cuda_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.reconstruct = QUDA_RECONSTRUCT_NO;
+  gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+
+  for (int dir = 0; dir < 4; dir++) hostGauge[dir] = malloc((size_t)V * gaugeSiteSize * sizeof(double));
+  construct_gauge_field(hostGauge, 1, gauge_param.cpu_prec, &gauge_param);
+
+  // the host operators read the backward links from the ghost zone
+  GaugeFieldParam gParam(hostGauge, gauge_param);
+  gParam.nFace = 1;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  cpuGauge = new cpuGaugeField(gParam);
+}
+
+static void end()
+{
+  delete cpuGauge;
+  for (int dir = 0; dir < 4; dir++) free(hostGauge[dir]);
+}
+
+/**
+   @brief Apply the host Wilson dslash and return its deviation from
+   the reference implementation
+*/
+static double wilsonDslash(int parity, int dagger)
+{
+  cpuColorSpinorField in_dr(spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+  cpuColorSpinorField ref_dr(spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+  cpuColorSpinorField out_dr(spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+  cpuColorSpinorField in(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+  cpuColorSpinorField out(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+
+  in_dr.Source(QUDA_RANDOM_SOURCE);
+  wil_dslash(ref_dr.V(), hostGauge, in_dr.V(), parity, dagger, QUDA_DOUBLE_PRECISION, gauge_param);
+
+  Dirac *dirac = createDirac(QUDA_WILSON_DIRAC, 0.12);
+  dirac->Dagger(dagger ? QUDA_DAG_YES : QUDA_DAG_NO);
+  in = in_dr; // change to the UKQCD basis
+  dirac->Dslash(out, in, static_cast<QudaParity>(parity));
+  out_dr = out;
+  delete dirac;
+
+  double ref = blas::norm2(ref_dr);
+  double diff = blas::xmyNorm(ref_dr, out_dr);
+  printfQuda("Wilson dslash parity=%d dagger=%d: |ref|^2 = %e, |ref - host|^2 = %e\n", parity, dagger, ref, diff);
+  return sqrt(diff / ref);
+}
+
+TEST(HostDirac, wilson_dslash)
+{
+  for (int parity = 0; parity < 2; parity++)
+    for (int dagger = 0; dagger < 2; dagger++) EXPECT_LT(wilsonDslash(parity, dagger), 1e-13);
+}
+
+TEST(HostDirac, clover)
+{
+#ifndef GPU_CLOVER_DIRAC
+  GTEST_SKIP();
+#endif
+  // the reference clover is packed in the DeGrand-Rossi basis, the host field holds half of it
+  const size_t length = (size_t)V * cloverSiteSize;
+  std::vector<double> clover(length), clover_internal(length);
+  construct_clover_field(clover.data(), 0.1, 1.0, QUDA_DOUBLE_PRECISION);
+  for (size_t i = 0; i < length; i++) clover_internal[i] = 0.5 * clover[i];
+
+  CloverFieldParam cloverParam;
+  cloverParam.nDim = 4;
+  for (int d = 0; d < 4; d++) cloverParam.x[d] = gauge_param.X[d];
+  cloverParam.setPrecision(QUDA_DOUBLE_PRECISION);
+  cloverParam.order = QUDA_PACKED_CLOVER_ORDER;
+  cloverParam.pad = 0;
+  cloverParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  cloverParam.csw = 1.0;
+  cloverParam.direct = true;
+  cloverParam.inverse = false;
+  cloverParam.clover = clover_internal.data();
+  cloverParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  cpuCloverField cpuClover(cloverParam);
+
+  const double kappa = 0.12;
+  Dirac *dirac = createDirac(QUDA_CLOVER_DIRAC, kappa, &cpuClover);
+
+  {
+    cpuColorSpinorField in_dr(spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+    cpuColorSpinorField ref_dr(spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+    cpuColorSpinorField out_dr(spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+    cpuColorSpinorField in(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+    cpuColorSpinorField out(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+
+    for (int parity = 0; parity < 2; parity++) {
+      in_dr.Source(QUDA_RANDOM_SOURCE);
+      apply_clover(ref_dr.V(), clover.data(), in_dr.V(), parity, QUDA_DOUBLE_PRECISION);
+      in = in_dr;
+      static_cast<DiracClover *>(dirac)->Clover(out, in, static_cast<QudaParity>(parity));
+      out_dr = out;
+      double dev = deviation(ref_dr, out_dr);
+      printfQuda("Clover parity=%d: deviation = %e\n", parity, dev);
+      EXPECT_LT(dev, 1e-13);
+    }
+  }
+
+  {
+    cpuColorSpinorField in_dr(fullSpinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+    cpuColorSpinorField ref_dr(fullSpinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+    cpuColorSpinorField out_dr(fullSpinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+    cpuColorSpinorField in(fullSpinorParam(QUDA_UKQCD_GAMMA_BASIS));
+    cpuColorSpinorField out(fullSpinorParam(QUDA_UKQCD_GAMMA_BASIS));
+
+    for (int dagger = 0; dagger < 2; dagger++) {
+      in_dr.Source(QUDA_RANDOM_SOURCE);
+      clover_mat(ref_dr.V(), hostGauge, clover.data(), in_dr.V(), kappa, dagger, QUDA_DOUBLE_PRECISION, gauge_param);
+      in = in_dr;
+      dirac->Dagger(dagger ? QUDA_DAG_YES : QUDA_DAG_NO);
+      dirac->M(out, in);
+      out_dr = out;
+      double dev = deviation(ref_dr, out_dr);
+      printfQuda("Wilson-clover M dagger=%d: deviation = %e\n", dagger, dev);
+      EXPECT_LT(dev, 1e-13);
+    }
+  }
+
+  delete dirac;
+}
+
+static uint32_t rotl32(uint32_t x, int n) { return n ? (x << n) | (x >> (32 - n)) : x; }
+
+/**
+   @brief The SciDAC-style combination of the CRCs of the site records
+   of a full host field, record(buffer, parity, x_cb) writing the
+   record of a site
+*/
+template <typename Record> static uint64_t checksumReference(size_t record_bytes, Record record)
+{
+  std::vector<char> buffer(record_bytes);
+  uint32_t sum29 = 0, sum31 = 0;
+  for (int parity = 0; parity < 2; parity++) {
+    for (int x_cb = 0; x_cb < Vh; x_cb++) {
+      record(buffer.data(), parity, x_cb);
+      uint32_t crc = crc32_reference(buffer.data(), record_bytes);
+      int r = fullLatticeIndex(x_cb, parity);
+      sum29 ^= rotl32(crc, r % 29);
+      sum31 ^= rotl32(crc, r % 31);
+    }
+  }
+  return (static_cast<uint64_t>(sum29) << 32) | sum31;
+}
+
+TEST(HostDirac, checksum_crc32_spinor)
+{
+  if (comm_size() > 1) GTEST_SKIP(); // the reference uses the local site index
+
+  ColorSpinorParam csParam = fullSpinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS);
+  cpuColorSpinorField v(csParam);
+  v.Source(QUDA_RANDOM_SOURCE);
+
+  // the record of a site is its (spin, color, real/imaginary) block
+  uint64_t expected = checksumReference(spinorSiteSize * sizeof(double), [&](char *buffer, int parity, int x_cb) {
+    memcpy(buffer, static_cast<double *>(v.V()) + (parity * Vh + x_cb) * spinorSiteSize,
+           spinorSiteSize * sizeof(double));
+  });
+  EXPECT_EQ(ChecksumCRC32(v), expected);
+
+  // reordering the field does not change the checksum
+  csParam.fieldOrder = QUDA_SPACE_COLOR_SPIN_FIELD_ORDER;
+  cpuColorSpinorField w(csParam);
+  w = v;
+  EXPECT_EQ(ChecksumCRC32(w), expected);
+}
+
+TEST(HostDirac, checksum_crc32_clover)
+{
+  if (comm_size() > 1) GTEST_SKIP();
+
+  const size_t length = (size_t)V * cloverSiteSize;
+  std::vector<double> packed(length);
+  construct_clover_field(packed.data(), 0.1, 1.0, QUDA_DOUBLE_PRECISION);
+
+  CloverFieldParam cloverParam;
+  cloverParam.nDim = 4;
+  for (int d = 0; d < 4; d++) cloverParam.x[d] = gauge_param.X[d];
+  cloverParam.setPrecision(QUDA_DOUBLE_PRECISION);
+  cloverParam.order = QUDA_PACKED_CLOVER_ORDER;
+  cloverParam.pad = 0;
+  cloverParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  cloverParam.csw = 1.0;
+  cloverParam.direct = true;
+  cloverParam.inverse = false;
+  cloverParam.clover = packed.data();
+  cloverParam.create = QUDA_REFERENCE_FIELD_CREATE;
+  cpuCloverField clover(cloverParam);
+
+  // each packed chiral block holds the real diagonal, then the lower
+  // triangle column by column, and the record is its lower triangle row by row
+  const int N = 6;
+  uint64_t expected = checksumReference(cloverSiteSize * sizeof(double), [&](char *buffer, int parity, int x_cb) {
+    double *r = reinterpret_cast<double *>(buffer);
+    for (int ch = 0; ch < 2; ch++) {
+      const double *a = packed.data() + ((parity * Vh + x_cb) * 2 + ch) * N * N;
+      for (int row = 0; row < N; row++) {
+        for (int col = 0; col < row; col++) {
+          int k = N * (N - 1) / 2 - (N - col) * (N - col - 1) / 2 + row - col - 1;
+          *r++ = a[N + 2 * k];
+          *r++ = a[N + 2 * k + 1];
+        }
+        *r++ = a[row];
+      }
+    }
+  });
+  EXPECT_EQ(ChecksumCRC32(clover), expected);
+
+  // the same field in the native order gives the same checksum
+  cloverParam.order = QUDA_FLOAT2_CLOVER_ORDER;
+  cloverParam.clover = nullptr;
+  size_t bytes = cpuCloverField(cloverParam).Bytes();
+  std::vector<char> native(bytes);
+  cloverParam.clover = native.data();
+  cpuCloverField clover_native(cloverParam);
+  copyGenericClover(clover_native, clover, false, QUDA_CPU_FIELD_LOCATION);
+  EXPECT_EQ(ChecksumCRC32(clover_native), expected);
+}
+
+TEST(HostDirac, twisted_mass)
+{
+#ifndef GPU_TWISTED_MASS_DIRAC
+  GTEST_SKIP();
+#endif
+  const double kappa = 0.12, mu = 0.1;
+  Dirac *dirac = createDirac(QUDA_TWISTED_MASS_DIRAC, kappa, nullptr, mu);
+
+  ColorSpinorParam dr = fullSpinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS);
+  ColorSpinorParam ukqcd = fullSpinorParam(QUDA_UKQCD_GAMMA_BASIS);
+  dr.twistFlavor = ukqcd.twistFlavor = QUDA_TWIST_SINGLET;
+  cpuColorSpinorField in_dr(dr), ref_dr(dr), out_dr(dr);
+  cpuColorSpinorField in(ukqcd), out(ukqcd);
+
+  for (int dagger = 0; dagger < 2; dagger++) {
+    in_dr.Source(QUDA_RANDOM_SOURCE);
+    tm_mat(ref_dr.V(), hostGauge, in_dr.V(), kappa, mu, QUDA_TWIST_SINGLET, dagger, QUDA_DOUBLE_PRECISION, gauge_param);
+    in = in_dr;
+    dirac->Dagger(dagger ? QUDA_DAG_YES : QUDA_DAG_NO);
+    dirac->M(out, in);
+    out_dr = out;
+    double dev = deviation(ref_dr, out_dr);
+    printfQuda("Twisted-mass M dagger=%d: deviation = %e\n", dagger, dev);
+    EXPECT_LT(dev, 1e-13);
+  }
+
+  delete dirac;
+}
+
+// defined in wilson_dslash_reference.cpp
+void twist_gamma5(void *out, void *in, int daggerBit, double kappa, double mu, QudaTwistFlavorType flavor, int V,
+                  QudaTwistGamma5Type twist, QudaPrecision precision);
+
+TEST(HostDirac, twist_gamma)
+{
+#ifndef GPU_TWISTED_MASS_DIRAC
+  GTEST_SKIP();
+#endif
+  const double kappa = 0.12, mu = 0.1;
+  cpuColorSpinorField in_dr(spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+  cpuColorSpinorField ref_dr(spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+  cpuColorSpinorField out_dr(spinorParam(QUDA_DEGRAND_ROSSI_GAMMA_BASIS));
+  cpuColorSpinorField in(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+  cpuColorSpinorField out(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+
+  // gamma5 = diag(1, 1, -1, -1) in the DeGrand-Rossi basis, as in the reference twist
+  in_dr.Source(QUDA_RANDOM_SOURCE);
+  ref_dr = in_dr;
+  double *ref = static_cast<double *>(ref_dr.V());
+  for (int i = 0; i < Vh; i++)
+    for (int j = 12; j < 24; j++) ref[i * 24 + j] = -ref[i * 24 + j];
+  in = in_dr;
+  gamma5(out, in);
+  out_dr = out;
+  double dev = deviation(ref_dr, out_dr);
+  printfQuda("gamma5: deviation = %e\n", dev);
+  EXPECT_LT(dev, 1e-15);
+
+  for (auto type : {QUDA_TWIST_GAMMA5_DIRECT, QUDA_TWIST_GAMMA5_INVERSE}) {
+    for (int dagger = 0; dagger < 2; dagger++) {
+      in_dr.Source(QUDA_RANDOM_SOURCE);
+      twist_gamma5(ref_dr.V(), in_dr.V(), dagger, kappa, mu, QUDA_TWIST_SINGLET, Vh, type, QUDA_DOUBLE_PRECISION);
+      in = in_dr;
+      ApplyTwistGamma(out, in, 4, kappa, mu, 0.0, dagger, type);
+      out_dr = out;
+      dev = deviation(ref_dr, out_dr);
+      printfQuda("Twist %s dagger=%d: deviation = %e\n", type == QUDA_TWIST_GAMMA5_DIRECT ? "direct" : "inverse",
+                 dagger, dev);
+      EXPECT_LT(dev, 1e-13);
+    }
+  }
+}
+
+/**
+   @brief Apply the host naive or improved staggered dslash and return
+   its deviation from the reference implementation
+*/
+static double staggeredDslash(QudaDslashType dslash_type, int parity, int dagger)
+{
+  const bool improved = dslash_type == QUDA_ASQTAD_DSLASH;
+  QudaGaugeParam param = gauge_param;
+  void *fatlink[4], *longlink[4];
+  for (int dir = 0; dir < 4; dir++) {
+    fatlink[dir] = malloc((size_t)V * gaugeSiteSize * sizeof(double));
+    longlink[dir] = malloc((size_t)V * gaugeSiteSize * sizeof(double));
+    memset(longlink[dir], 0, (size_t)V * gaugeSiteSize * sizeof(double));
+  }
+  // the links are constructed with the staggered phases applied
+  construct_fat_long_gauge_field(fatlink, longlink, 1, QUDA_DOUBLE_PRECISION, &param, dslash_type);
+
+  param.type = improved ? QUDA_ASQTAD_FAT_LINKS : QUDA_SU3_LINKS;
+  GaugeFieldParam fatParam(fatlink, param);
+  fatParam.nFace = 1;
+  fatParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  cpuGaugeField fat(fatParam);
+
+  param.type = QUDA_ASQTAD_LONG_LINKS;
+  GaugeFieldParam longParam(longlink, param);
+  longParam.nFace = 3;
+  longParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  cpuGaugeField lng(longParam);
+
+  cpuColorSpinorField in(staggeredParam());
+  cpuColorSpinorField ref(staggeredParam());
+  cpuColorSpinorField out(staggeredParam());
+  in.Source(QUDA_RANDOM_SOURCE);
+  staggered_dslash(&ref, fatlink, longlink, fat.Ghost(), lng.Ghost(), &in, parity, dagger, QUDA_DOUBLE_PRECISION,
+                   QUDA_DOUBLE_PRECISION, dslash_type);
+
+  DiracParam diracParam;
+  diracParam.type = improved ? QUDA_ASQTAD_DIRAC : QUDA_STAGGERED_DIRAC;
+  diracParam.mass = 0.1;
+  diracParam.matpcType = QUDA_MATPC_EVEN_EVEN;
+  diracParam.dagger = dagger ? QUDA_DAG_YES : QUDA_DAG_NO;
+  diracParam.gauge = &fat;
+  diracParam.fatGauge = &fat;
+  diracParam.longGauge = &lng;
+  for (int d = 0; d < 4; d++) diracParam.commDim[d] = comm_dim_partitioned(d);
+  Dirac *dirac = Dirac::create(diracParam);
+  dirac->Dslash(out, in, static_cast<QudaParity>(parity));
+  delete dirac;
+
+  double dev = deviation(ref, out);
+  printfQuda("%s dslash parity=%d dagger=%d: deviation = %e\n", improved ? "Improved staggered" : "Staggered", parity,
+             dagger, dev);
+
+  for (int dir = 0; dir < 4; dir++) {
+    free(longlink[dir]);
+    free(fatlink[dir]);
+  }
+  return dev;
+}
+
+TEST(HostDirac, staggered_dslash)
+{
+#ifndef GPU_STAGGERED_DIRAC
+  GTEST_SKIP();
+#endif
+  for (int parity = 0; parity < 2; parity++)
+    for (int dagger = 0; dagger < 2; dagger++) EXPECT_LT(staggeredDslash(QUDA_STAGGERED_DSLASH, parity, dagger), 1e-13);
+}
+
+TEST(HostDirac, asqtad_dslash)
+{
+#ifndef GPU_STAGGERED_DIRAC
+  GTEST_SKIP();
+#endif
+  for (int parity = 0; parity < 2; parity++)
+    for (int dagger = 0; dagger < 2; dagger++) EXPECT_LT(staggeredDslash(QUDA_ASQTAD_DSLASH, parity, dagger), 1e-13);
+}
+
+/**
+   @brief Solve the even-odd preconditioned Wilson system on host
+   fields.  CG is applied to the normal operator and the other solvers
+   to the preconditioned operator itself.
+   @return The true residual relative to the source
+*/
+static double wilsonSolve(QudaInverterType inv_type)
+{
+  QudaInvertParam inv_param = newQudaInvertParam();
+  inv_param.inv_type = inv_type;
+  inv_param.inv_type_precondition = QUDA_INVALID_INVERTER;
+  inv_param.residual_type = QUDA_L2_RELATIVE_RESIDUAL;
+  inv_param.tol = 1e-10;
+  inv_param.tol_hq = 0.0;
+  inv_param.maxiter = 2000;
+  inv_param.reliable_delta = 0.1;
+  inv_param.use_alternative_reliable = false;
+  inv_param.use_sloppy_partial_accumulator = 0;
+  inv_param.solution_accumulator_pipeline = 0;
+  inv_param.max_res_increase = 1;
+  inv_param.pipeline = 0;
+  inv_param.Nsteps = 2;
+  inv_param.gcrNkrylov = 16;
+  inv_param.omega = 1.0;
+  inv_param.compute_true_res = 1;
+  inv_param.use_init_guess = QUDA_USE_INIT_GUESS_NO;
+  inv_param.preserve_source = QUDA_PRESERVE_SOURCE_YES;
+  inv_param.cuda_prec = QUDA_DOUBLE_PRECISION;
+  inv_param.cuda_prec_sloppy = QUDA_DOUBLE_PRECISION;
+  inv_param.cuda_prec_refinement_sloppy = QUDA_DOUBLE_PRECISION;
+  inv_param.cuda_prec_precondition = QUDA_DOUBLE_PRECISION;
+  inv_param.verbosity = verbosity;
+
+  if (inv_type == QUDA_MR_INVERTER) {
+    // MR runs maxiter iterations per cycle and checks the true residual between cycles
+    inv_param.maxiter = 50;
+    inv_param.Nsteps = 40;
+  }
+
+  cpuColorSpinorField b(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+  cpuColorSpinorField x(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+  cpuColorSpinorField r(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+  b.Source(QUDA_RANDOM_SOURCE);
+
+  Dirac *dirac = createDirac(QUDA_WILSONPC_DIRAC, 0.12);
+  DiracMatrix *m = inv_type == QUDA_CG_INVERTER ? static_cast<DiracMatrix *>(new DiracMdagM(*dirac)) :
+                                                  static_cast<DiracMatrix *>(new DiracM(*dirac));
+
+  SolverParam solverParam(inv_param);
+  TimeProfile profile("host_dirac_test");
+  {
+    Solver *solve = Solver::create(solverParam, *m, *m, *m, profile);
+    (*solve)(x, b);
+    delete solve;
+  }
+
+  // true residual
+  (*m)(r, x);
+  double r2 = blas::xmyNorm(b, r);
+  double b2 = blas::norm2(b);
+  printfQuda("%s converged in %d iterations, true residual = %e\n", get_solver_str(inv_type), solverParam.iter,
+             sqrt(r2 / b2));
+
+  delete m;
+  delete dirac;
+  return sqrt(r2 / b2);
+}
+
+TEST(HostDirac, wilson_cg) { EXPECT_LT(wilsonSolve(QUDA_CG_INVERTER), 1e-9); }
+
+TEST(HostDirac, wilson_bicgstab) { EXPECT_LT(wilsonSolve(QUDA_BICGSTAB_INVERTER), 1e-9); }
+
+TEST(HostDirac, wilson_gcr) { EXPECT_LT(wilsonSolve(QUDA_GCR_INVERTER), 1e-9); }
+
+TEST(HostDirac, wilson_mr) { EXPECT_LT(wilsonSolve(QUDA_MR_INVERTER), 1e-9); }
+
+/**
+   @brief Compute the largest eigenvalues of the even-odd
+   preconditioned normal Wilson operator on host fields
+   @param[in] type The eigensolver type
+   @param[out] evals The eigenvalues
+   @return The largest eigenvector residual relative to its eigenvalue
+*/
+static double wilsonEigensolve(QudaEigType type, std::vector<Complex> &evals)
+{
+  QudaEigParam eig_param = newQudaEigParam();
+  eig_param.eig_type = type;
+  eig_param.spectrum = QUDA_SPECTRUM_LR_EIG;
+  eig_param.nConv = 8;
+  eig_param.nEv = 16;
+  eig_param.nKr = 48;
+  eig_param.block_size = 4;
+  eig_param.tol = 1e-8;
+  eig_param.max_restarts = 1000;
+  eig_param.require_convergence = QUDA_BOOLEAN_TRUE;
+  eig_param.use_poly_acc = QUDA_BOOLEAN_FALSE;
+  eig_param.batched_rotate = 0;
+  eig_param.vec_infile[0] = '\0';
+  eig_param.vec_outfile[0] = '\0';
+
+  Dirac *dirac = createDirac(QUDA_WILSONPC_DIRAC, 0.12);
+  DiracMdagM m(*dirac);
+
+  std::vector<ColorSpinorField *> kSpace;
+  for (int i = 0; i < eig_param.nConv; i++)
+    kSpace.push_back(new cpuColorSpinorField(spinorParam(QUDA_UKQCD_GAMMA_BASIS)));
+  evals.resize(eig_param.nConv);
+
+  TimeProfile profile("host_dirac_test");
+  EigenSolver *eig_solve = EigenSolver::create(&eig_param, m, profile);
+  (*eig_solve)(kSpace, evals);
+  delete eig_solve;
+
+  // relative residuals of the returned eigenpairs
+  cpuColorSpinorField r(spinorParam(QUDA_UKQCD_GAMMA_BASIS));
+  double res = 0.0;
+  for (int i = 0; i < eig_param.nConv; i++) {
+    m(r, *kSpace[i]);
+    blas::caxpy(-evals[i], *kSpace[i], r);
+    res = std::max(res, sqrt(blas::norm2(r) / blas::norm2(*kSpace[i])) / abs(evals[i]));
+  }
+
+  for (auto v : kSpace) delete v;
+  delete dirac;
+  return res;
+}
+
+TEST(HostDirac, wilson_block_trlm)
+{
+  std::vector<Complex> evals, block_evals;
+  EXPECT_LT(wilsonEigensolve(QUDA_EIG_TR_LANCZOS, evals), 1e-6);
+  EXPECT_LT(wilsonEigensolve(QUDA_EIG_BLK_TR_LANCZOS, block_evals), 1e-6);
+
+  // both solvers find the same end of the spectrum
+  for (unsigned int i = 0; i < evals.size(); i++) EXPECT_LT(abs(evals[i] - block_evals[i]) / abs(evals[i]), 1e-8);
+}
+
+/**
+   @brief Rotate a set of random host vectors with rotateHost and
+   return the largest deviation from the rotation computed with axpy
+*/
+template <typename Coeff> static double rotate(EigenSolver &eig, const std::vector<Coeff> &rot, int rank, int n_keep)
+{
+  std::vector<ColorSpinorField *> kSpace, ref;
+  for (int i = 0; i < rank; i++) {
+    kSpace.push_back(new cpuColorSpinorField(spinorParam(QUDA_UKQCD_GAMMA_BASIS)));
+    kSpace[i]->Source(QUDA_RANDOM_SOURCE);
+  }
+  for (int j = 0; j < n_keep; j++) {
+    ref.push_back(new cpuColorSpinorField(spinorParam(QUDA_UKQCD_GAMMA_BASIS)));
+    for (int i = 0; i < rank; i++) blas::caxpy(rot[j * rank + i], *kSpace[i], *ref[j]);
+  }
+
+  eig.rotateHost(kSpace, rot.data(), rank, n_keep);
+
+  double dev = 0.0;
+  for (int j = 0; j < n_keep; j++) dev = std::max(dev, deviation(*ref[j], *kSpace[j]));
+  for (auto v : ref) delete v;
+  for (auto v : kSpace) delete v;
+  return dev;
+}
+
+TEST(HostDirac, rotate)
+{
+  const int rank = 12, n_keep = 5;
+  QudaEigParam eig_param = newQudaEigParam();
+  eig_param.eig_type = QUDA_EIG_TR_LANCZOS;
+  eig_param.spectrum = QUDA_SPECTRUM_LR_EIG;
+  eig_param.nConv = 4;
+  eig_param.nEv = 8;
+  eig_param.nKr = 16;
+  eig_param.batched_rotate = 3;
+
+  Dirac *dirac = createDirac(QUDA_WILSONPC_DIRAC, 0.12);
+  DiracMdagM m(*dirac);
+  TimeProfile profile("host_dirac_test");
+  EigenSolver *eig = EigenSolver::create(&eig_param, m, profile);
+
+  std::mt19937 rng(comm_rank());
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::vector<double> real_rot(rank * n_keep);
+  std::vector<Complex> complex_rot(rank * n_keep);
+  for (auto &r : real_rot) r = uniform(rng);
+  for (auto &r : complex_rot) r = Complex(uniform(rng), uniform(rng));
+
+  double dev = rotate(*eig, real_rot, rank, n_keep);
+  printfQuda("Real rotation: deviation = %e\n", dev);
+  EXPECT_LT(dev, 1e-14);
+  dev = rotate(*eig, complex_rot, rank, n_keep);
+  printfQuda("Complex rotation: deviation = %e\n", dev);
+  EXPECT_LT(dev, 1e-14);
+
+  // the batch size is set by batched_rotate, but never exceeds the number of vectors kept
+  std::vector<ColorSpinorField *> kSpace(1, new cpuColorSpinorField(spinorParam(QUDA_UKQCD_GAMMA_BASIS)));
+  EXPECT_EQ(eig->rotateBatchSize(kSpace, n_keep), 3);
+  EXPECT_EQ(eig->rotateBatchSize(kSpace, 2), 2);
+  delete kSpace[0];
+
+  delete eig;
+  delete dirac;
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+
+  init();
+
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+
+  end();
+  finalizeComms();
+  return result;
+}
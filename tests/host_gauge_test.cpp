@@ -0,0 +1,1080 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <arpa/inet.h>
+
+#include <test_util.h>
+#include <test_params.h>
+#include <wilson_flow_reference.h>
+
+// google test
+#include <gtest/gtest.h>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <gauge_tools.h>
+#include <gauge_update_quda.h>
+#include <momentum.h>
+#include <timer.h>
+#include <fft_quda.h>
+#include <host_parallel.h>
+#include <quda_matrix.h>
+
+/**
+   Test and benchmark of the host gauge tools.  The host plaquette and
+   Wilson flow are compared against the reference implementations, the
+   fused host observables against the separate field strength and
+   charge routines, and a sequence of APE, stout, over-improved stout
+   and Wilson flow steps is timed on host fields.  Single APE, stout
+   and over-improved stout steps are checked against host references,
+   and against the device when it is initialized.  The distributed FFT
+   is checked on plane waves, and the host FFT gauge fixing is
+   required to leave the plaquette unchanged while reducing theta,
+   and to agree with the device on a single rank.
+   computeGaugeFixingFFTQuda is checked to fix partitioned lattices
+   (a single rank is partitioned by hand) on the host.
+   The CRC32 checksum is checked against a bitwise CRC32.
+   The host HMC link update is checked for reversibility and against
+   its expansion, and its rate in link updates per second reported.
+   The NERSC and MILC native loaders are checked by loading back the
+   field written in those formats.
+
+   With --gauge-results-save the sequence is also run on the device,
+   and the measured observables are written to a file, which a later
+   (possibly device-less) run compares the host sequence against with
+   --gauge-results-check.  The device is then also used to check the
+   fused device observables against the host.
+ */
+
+using namespace quda;
+
+static QudaGaugeParam gauge_param;
+static void *hostGauge[4];
+static cpuGaugeField *cpuGauge = nullptr;
+
+static std::string results_save;
+static std::string results_check;
+static bool device_initialized = false;
+
+using Observables = std::vector<std::pair<std::string, double>>;
+
+static void init()
+{
+  gauge_param = newQudaGaugeParam();
+  gauge_param.X[0] = xdim;
+  gauge_param.X[1] = ydim;
+  gauge_param.X[2] = zdim;
+  gauge_param.X[3] = tdim;
+  setDims(gauge_param.X);
+
+  gauge_param.anisotropy = 1.0;
+  gauge_param.type = QUDA_WILSON_LINKS;
+  gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  gauge_param.t_boundary = QUDA_PERIODIC_T;
+  gauge_param.cpu_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.cuda_prec = QUDA_DOUBLE_PRECISION;
+  gauge_param.reconstruct = QUDA_RECONSTRUCT_NO;
+  gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+
+  for (int dir = 0; dir < 4; dir++) hostGauge[dir] = malloc((size_t)V * gaugeSiteSize * sizeof(double));
+  construct_gauge_field(hostGauge, 1, gauge_param.cpu_prec, &gauge_param);
+
+  GaugeFieldParam gParam(hostGauge, gauge_param);
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGauge = new cpuGaugeField(gParam);
+}
+
+static void end()
+{
+  delete cpuGauge;
+  for (int dir = 0; dir < 4; dir++) free(hostGauge[dir]);
+  cpuGaugeField::freeGhostBuffer(); // release the cached exchange plans before the comms
+}
+
+/**
+   @brief Create a field extended by the halo depth used by the
+   interface (2 in each partitioned dimension), with the halo filled
+   @param[in] in The regular field to extend
+   @param[in] location Location of the extended field
+   @param[in] copy Whether to copy and exchange in, or just allocate
+*/
+static GaugeField *createExtended(const GaugeField &in, QudaFieldLocation location, bool copy = true)
+{
+  int R[4];
+  for (int d = 0; d < 4; d++) R[d] = 2 * comm_dim_partitioned(d);
+
+  GaugeFieldParam gParamEx(in);
+  gParamEx.create = QUDA_NULL_FIELD_CREATE;
+  gParamEx.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+  gParamEx.pad = 0;
+  gParamEx.nFace = 1;
+  for (int d = 0; d < 4; d++) {
+    gParamEx.x[d] += 2 * R[d];
+    gParamEx.r[d] = R[d];
+  }
+
+  GaugeField *out = nullptr;
+  if (location == QUDA_CPU_FIELD_LOCATION) {
+    out = new cpuGaugeField(gParamEx);
+    if (copy) copyExtendedGauge(*out, in, QUDA_CPU_FIELD_LOCATION);
+  } else {
+    gParamEx.order = QUDA_FLOAT2_GAUGE_ORDER;
+    gParamEx.setPrecision(gParamEx.Precision(), true);
+    out = new cudaGaugeField(gParamEx);
+    if (copy) out->copy(in);
+  }
+  if (copy) out->exchangeExtendedGhost(R, false);
+  return out;
+}
+
+/**
+   @return The largest deviation of the links of the extended field u
+   from the regular field in the QDP order of hostGauge
+*/
+static double linkDeviation(const GaugeField &u, void **ref)
+{
+  GaugeFieldParam gParam(*cpuGauge);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  cpuGaugeField regular(gParam);
+  copyExtendedGauge(regular, u, QUDA_CPU_FIELD_LOCATION);
+
+  double deviation = 0.0;
+  for (int dir = 0; dir < 4; dir++) {
+    const double *a = static_cast<const double *>(static_cast<void **>(regular.Gauge_p())[dir]);
+    const double *b = static_cast<const double *>(ref[dir]);
+    for (size_t i = 0; i < (size_t)V * gaugeSiteSize; i++) deviation = std::max(deviation, fabs(a[i] - b[i]));
+  }
+  return deviation;
+}
+
+/**
+   @return The largest deviation between the links of two regular QDP-ordered fields
+*/
+static double fieldDeviation(GaugeField &a, GaugeField &b)
+{
+  double deviation = 0.0;
+  for (int dir = 0; dir < 4; dir++) {
+    const double *x = static_cast<const double *>(static_cast<void **>(a.Gauge_p())[dir]);
+    const double *y = static_cast<const double *>(static_cast<void **>(b.Gauge_p())[dir]);
+    for (size_t i = 0; i < (size_t)V * gaugeSiteSize; i++) deviation = std::max(deviation, fabs(x[i] - y[i]));
+  }
+  return deviation;
+}
+
+TEST(HostGauge, plaquette)
+{
+  if (comm_size() > 1) GTEST_SKIP();
+  GaugeField *u = createExtended(*cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  double3 plaq = plaquette(*u);
+  delete u;
+
+  double ref[3];
+  plaquette_reference(ref, hostGauge);
+  printfQuda("Host plaquette %.16e, reference %.16e\n", plaq.x, ref[0]);
+  EXPECT_NEAR(plaq.x, ref[0], 1e-14);
+  EXPECT_NEAR(plaq.y, ref[1], 1e-14);
+  EXPECT_NEAR(plaq.z, ref[2], 1e-14);
+}
+
+/**
+   @brief exp(iQ) by its Taylor series, summed until the terms vanish
+*/
+static Matrix<complex<double>, 3> exponentiateTaylor(const Matrix<complex<double>, 3> &Q)
+{
+  Matrix<complex<double>, 3> e, term;
+  setIdentity(&e);
+  setIdentity(&term);
+  for (int k = 1; k < 40; k++) {
+    term = term * Q;
+    term = complex<double>(0.0, 1.0 / k) * term;
+    e = e + term;
+  }
+  return e;
+}
+
+TEST(HostGauge, exponentiate_iQ)
+{
+  // traceless hermitian Q of both signs of det(Q), the Cayley-Hamilton
+  // coefficients of hep-lat/0311018 eq. 34 differing between the two
+  std::mt19937 rng(2024);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  int negative = 0;
+  double deviation = 0.0;
+  for (int i = 0; i < 64; i++) {
+    Matrix<complex<double>, 3> P;
+    for (int k = 0; k < 9; k++) P(k) = complex<double>(uniform(rng), uniform(rng));
+    makeAntiHerm(P);
+    const double scale = i % 2 ? 0.1 : 1.0;
+    Matrix<complex<double>, 3> Q = complex<double>(0.0, -scale) * P;
+    if (getDeterminant(Q).real() < 0) negative++;
+
+    Matrix<complex<double>, 3> e = exponentiate_iQ(Q), ref = exponentiateTaylor(Q);
+    for (int k = 0; k < 9; k++) deviation = std::max(deviation, abs(e(k) - ref(k)));
+  }
+  printfQuda("exponentiate_iQ deviation from the Taylor series %e (%d of 64 with det(Q) < 0)\n", deviation, negative);
+  EXPECT_GT(negative, 0);
+  EXPECT_LT(deviation, 1e-13);
+}
+
+TEST(HostGauge, checksum_crc32)
+{
+  if (comm_size() > 1) GTEST_SKIP();
+
+  // the standard check value of CRC-32
+  const char *check = "123456789";
+  ASSERT_EQ(crc32_reference(check, 9), 0xCBF43926u);
+
+  auto rotl = [](uint32_t x, int n) { return n ? (x << n) | (x >> (32 - n)) : x; };
+  uint32_t sum29 = 0, sum31 = 0;
+  for (int parity = 0; parity < 2; parity++) {
+    for (int x_cb = 0; x_cb < Vh; x_cb++) {
+      double record[4 * gaugeSiteSize];
+      for (int d = 0; d < 4; d++)
+        memcpy(record + d * gaugeSiteSize,
+               static_cast<double *>(hostGauge[d]) + (parity * Vh + x_cb) * gaugeSiteSize,
+               gaugeSiteSize * sizeof(double));
+      uint32_t crc = crc32_reference(record, sizeof(record));
+      int r = fullLatticeIndex(x_cb, parity);
+      sum29 ^= rotl(crc, r % 29);
+      sum31 ^= rotl(crc, r % 31);
+    }
+  }
+  uint64_t expected = (static_cast<uint64_t>(sum29) << 32) | sum31;
+  EXPECT_EQ(ChecksumCRC32(*cpuGauge), expected);
+
+  // reordering the field does not change the checksum
+  GaugeFieldParam gParam(*cpuGauge);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.order = QUDA_MILC_GAUGE_ORDER;
+  cpuGaugeField milc(gParam);
+  copyGenericGauge(milc, *cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  EXPECT_EQ(ChecksumCRC32(milc), expected);
+}
+
+static void wilsonFlow(QudaWFlowType wflow_type)
+{
+  const int steps = 3;
+  const double epsilon = 0.02;
+
+  GaugeField *in = createExtended(*cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  GaugeField *out = createExtended(*cpuGauge, QUDA_CPU_FIELD_LOCATION, false);
+  GaugeField *temp = createExtended(*cpuGauge, QUDA_CPU_FIELD_LOCATION, false);
+  for (int i = 0; i < steps; i++) {
+    WFlowStep(*out, *temp, *in, epsilon, wflow_type);
+    std::swap(in, out);
+  }
+
+  void *ref[4];
+  for (int dir = 0; dir < 4; dir++) {
+    ref[dir] = malloc((size_t)V * gaugeSiteSize * sizeof(double));
+    memcpy(ref[dir], hostGauge[dir], (size_t)V * gaugeSiteSize * sizeof(double));
+  }
+  wflow_reference(ref, steps * epsilon, epsilon, 0.0, wflow_type);
+
+  double deviation = linkDeviation(*in, ref);
+  printfQuda("Host %s flow deviates from the reference by %e\n",
+             wflow_type == QUDA_WFLOW_TYPE_WILSON ? "Wilson" : "Symanzik", deviation);
+  EXPECT_LT(deviation, 1e-12);
+
+  for (int dir = 0; dir < 4; dir++) free(ref[dir]);
+  delete temp;
+  delete out;
+  delete in;
+}
+
+TEST(HostGauge, wilson_flow)
+{
+  if (comm_size() > 1) GTEST_SKIP();
+  wilsonFlow(QUDA_WFLOW_TYPE_WILSON);
+}
+
+TEST(HostGauge, symanzik_flow)
+{
+  if (comm_size() > 1) GTEST_SKIP();
+  wilsonFlow(QUDA_WFLOW_TYPE_SYMANZIK);
+}
+
+TEST(HostGauge, fused_observables)
+{
+  GaugeField *u = createExtended(*cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  GaugeField *tmp = createExtended(*cpuGauge, QUDA_CPU_FIELD_LOCATION, false);
+  STOUTStep(*u, *tmp, 0.1); // smooth so the charge density is not pure noise
+  delete tmp;
+
+  // fused sweep
+  std::vector<double> density(V);
+  QudaGaugeObservableParam param = newQudaGaugeObservableParam();
+  param.compute_plaquette = QUDA_BOOLEAN_TRUE;
+  param.compute_qcharge = QUDA_BOOLEAN_TRUE;
+  param.compute_qcharge_density = QUDA_BOOLEAN_TRUE;
+  param.qcharge_density = density.data();
+  TimeProfile profile("host_gauge_test");
+  gaugeObservables(*u, param, profile);
+
+  // separate field strength, charge and plaquette
+  GaugeFieldParam tensorParam(cpuGauge->X(), u->Precision(), QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
+  tensorParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  tensorParam.order = QUDA_QDP_GAUGE_ORDER;
+  tensorParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  tensorParam.create = QUDA_NULL_FIELD_CREATE;
+  cpuGaugeField Fmunu(tensorParam);
+  computeFmunu(Fmunu, *u);
+
+  std::vector<double> ref_density(V);
+  double energy[3], qcharge;
+  computeQChargeDensity(energy, qcharge, ref_density.data(), Fmunu);
+  double3 plaq = plaquette(*u);
+
+  printfQuda("Fused: plaquette %.16e energy %.16e charge %.16e\n", param.plaquette[0], param.energy[0], param.qcharge);
+  printfQuda("Split: plaquette %.16e energy %.16e charge %.16e\n", plaq.x, energy[0], qcharge);
+  EXPECT_NEAR(param.plaquette[0], plaq.x, 1e-14);
+  EXPECT_NEAR(param.plaquette[1], plaq.y, 1e-14);
+  EXPECT_NEAR(param.plaquette[2], plaq.z, 1e-14);
+  for (int i = 0; i < 3; i++) EXPECT_NEAR(param.energy[i], energy[i], 1e-13 * std::max(1.0, fabs(energy[i])));
+  EXPECT_NEAR(param.qcharge, qcharge, 1e-12 * std::max(1.0, fabs(qcharge)));
+  double deviation = 0.0;
+  for (int i = 0; i < V; i++) deviation = std::max(deviation, fabs(density[i] - ref_density[i]));
+  EXPECT_LT(deviation, 1e-14);
+
+  delete u;
+}
+
+TEST(HostGauge, extended_exchange)
+{
+  // halo in every dimension, filled locally where not partitioned
+  int R[4] = {2, 2, 2, 2};
+  GaugeFieldParam gParamEx(*cpuGauge);
+  gParamEx.create = QUDA_NULL_FIELD_CREATE;
+  gParamEx.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+  gParamEx.nFace = 1;
+  for (int d = 0; d < 4; d++) {
+    gParamEx.x[d] += 2 * R[d];
+    gParamEx.r[d] = R[d];
+  }
+
+  // the first exchange creates the plan, the later ones reuse it
+  cpuGaugeField a(gParamEx);
+  copyExtendedGauge(a, *cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  a.exchangeExtendedGhost(R, true);
+
+  cpuGaugeField b(gParamEx);
+  b.zero();
+  copyExtendedGauge(b, *cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  const long allocations = host_allocation_count();
+  b.exchangeExtendedGhost(R, true);
+  b.exchangeExtendedGhost(R, true);
+  EXPECT_EQ(host_allocation_count(), allocations) << "exchange allocated after the warm-up";
+
+  size_t bytes = (size_t)a.Volume() * gaugeSiteSize * a.Precision();
+  for (int dir = 0; dir < 4; dir++) {
+    EXPECT_EQ(memcmp(static_cast<void **>(a.Gauge_p())[dir], static_cast<void **>(b.Gauge_p())[dir], bytes), 0)
+      << "dir = " << dir;
+  }
+}
+
+TEST(HostGauge, distributed_fft)
+{
+  const int X[4] = {xdim, ydim, zdim, tdim};
+  const bool dims[4] = {true, true, true, true};
+  DistributedFFT fft(X, dims);
+
+  int N[4];
+  double global_volume = 1.0;
+  for (int d = 0; d < 4; d++) {
+    N[d] = fft.GlobalDim(d);
+    global_volume *= N[d];
+  }
+  const int k[4] = {1 % N[0], 0, 2 % N[2], (N[3] - 1) % N[3]};
+
+  // global coordinates of local site i, with x running fastest
+  auto coords = [&](size_t i, int x[4]) {
+    for (int d = 0; d < 4; d++) {
+      x[d] = comm_coord(d) * X[d] + i % X[d];
+      i /= X[d];
+    }
+  };
+
+  // component 0 is a plane wave of momentum k, component 1 is random
+  const size_t volume = (size_t)V;
+  std::vector<complex<double>> f(2 * volume), f0;
+  srand(1234 + comm_rank());
+  for (size_t i = 0; i < volume; i++) {
+    int x[4];
+    coords(i, x);
+    double phase = 0.0;
+    for (int d = 0; d < 4; d++) phase += 2.0 * M_PI * k[d] * x[d] / N[d];
+    f[i] = complex<double>(cos(phase), sin(phase));
+    f[volume + i] = complex<double>(rand() / (double)RAND_MAX - 0.5, rand() / (double)RAND_MAX - 0.5);
+  }
+  f0 = f;
+
+  fft(f.data(), 2, FFT_FORWARD);
+  double deviation = 0.0;
+  for (size_t i = 0; i < volume; i++) {
+    int x[4];
+    coords(i, x);
+    bool peak = true;
+    for (int d = 0; d < 4; d++) peak = peak && x[d] == k[d];
+    deviation = std::max(deviation, abs(f[i] - complex<double>(peak ? global_volume : 0.0, 0.0)));
+  }
+  comm_allreduce_max(&deviation);
+  printfQuda("Plane wave transform deviation %e with the %s backend\n", deviation, fft.BackendName());
+  EXPECT_LT(deviation, 1e-12 * global_volume);
+
+  fft(f.data(), 2, FFT_INVERSE);
+  deviation = 0.0;
+  for (size_t i = 0; i < 2 * volume; i++) deviation = std::max(deviation, abs(f[i] / global_volume - f0[i]));
+  comm_allreduce_max(&deviation);
+  printfQuda("Round trip deviation %e\n", deviation);
+  EXPECT_LT(deviation, 1e-13);
+}
+
+/**
+   @brief Fix to Landau (gauge_dir = 4) or Coulomb (gauge_dir = 3)
+   gauge on the host, and check the plaquette is unchanged and theta
+   decreases
+*/
+static void gaugeFixFFT(int gauge_dir)
+{
+  GaugeFieldParam gParam(*cpuGauge);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+
+  cpuGaugeField u(gParam);
+  copyGenericGauge(u, *cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  GaugeField *ex = createExtended(u, QUDA_CPU_FIELD_LOCATION);
+  double plaq0 = plaquette(*ex).x;
+  delete ex;
+
+  const int nsteps = 50;
+  double theta0 = gaugefixingFFTCPU(u, gauge_dir, 0, 1, 0.08, 1, 0.0, 1);
+  double theta = gaugefixingFFTCPU(u, gauge_dir, nsteps, nsteps, 0.08, 1, 0.0, 1);
+
+  ex = createExtended(u, QUDA_CPU_FIELD_LOCATION);
+  double plaq = plaquette(*ex).x;
+  delete ex;
+
+  printfQuda("gauge_dir = %d: theta %e -> %e after %d steps, plaquette %.16e -> %.16e\n", gauge_dir, theta0, theta,
+             nsteps, plaq0, plaq);
+  EXPECT_LT(theta, theta0);
+  EXPECT_NEAR(plaq, plaq0, 1e-12);
+
+  if (device_initialized && !comm_partitioned()) {
+    // the device implementation only supports unpartitioned lattices
+    GaugeFieldParam dParam(*cpuGauge);
+    dParam.create = QUDA_NULL_FIELD_CREATE;
+    cpuGaugeField device(dParam);
+    dParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+    dParam.setPrecision(dParam.Precision(), true);
+    cudaGaugeField d(dParam);
+    d.loadCPUField(*cpuGauge);
+    gaugefixingFFT(d, gauge_dir, nsteps, nsteps, 0.08, 1, 0.0, 1);
+    d.saveCPUField(device);
+
+    double deviation = fieldDeviation(u, device);
+    printfQuda("gauge_dir = %d: host and device gauge fixing differ by %e\n", gauge_dir, deviation);
+    EXPECT_LT(deviation, 1e-10);
+  }
+}
+
+TEST(HostGauge, gauge_fix_fft_landau) { gaugeFixFFT(4); }
+
+TEST(HostGauge, gauge_fix_fft_coulomb) { gaugeFixFFT(3); }
+
+/**
+   @brief Fix the gauge through computeGaugeFixingFFTQuda
+   @return The largest deviation from the host gauge fixing of the same field
+*/
+static double interfaceGaugeFixDeviation(int gauge_dir, int nsteps)
+{
+  void *gauge[4];
+  for (int dir = 0; dir < 4; dir++) {
+    gauge[dir] = malloc((size_t)V * gaugeSiteSize * sizeof(double));
+    memcpy(gauge[dir], hostGauge[dir], (size_t)V * gaugeSiteSize * sizeof(double));
+  }
+  QudaGaugeParam param = gauge_param;
+  param.ga_pad = 0;
+  computeGaugeFixingFFTQuda(gauge, gauge_dir, nsteps, nsteps, 0.08, 1, 0.0, 1, &param, nullptr);
+
+  GaugeFieldParam gParam(*cpuGauge);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
+  cpuGaugeField u(gParam);
+  copyGenericGauge(u, *cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  gaugefixingFFTCPU(u, gauge_dir, nsteps, nsteps, 0.08, 1, 0.0, 1);
+
+  GaugeFieldParam rParam(gauge, param);
+  rParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  cpuGaugeField result(rParam);
+  double deviation = fieldDeviation(result, u);
+  comm_allreduce_max(&deviation);
+
+  for (int dir = 0; dir < 4; dir++) free(gauge[dir]);
+  return deviation;
+}
+
+TEST(HostGauge, gauge_fix_fft_routing)
+{
+  const int nsteps = 20;
+
+  // partitioned lattices are fixed on the host, so a single rank is
+  // partitioned by hand to take that route
+  bool forced = !comm_partitioned();
+  if (forced)
+    for (int d = 0; d < 4; d++) comm_dim_partitioned_set(d);
+  if (comm_partitioned()) {
+    double deviation = interfaceGaugeFixDeviation(4, nsteps);
+    printfQuda("Partitioned computeGaugeFixingFFTQuda deviates from the host gauge fixing by %e\n", deviation);
+    EXPECT_EQ(deviation, 0.0);
+  }
+  if (forced) comm_dim_partitioned_reset();
+
+  // unpartitioned lattices are fixed on the device
+  if (device_initialized && !comm_partitioned()) {
+    double deviation = interfaceGaugeFixDeviation(4, nsteps);
+    printfQuda("Unpartitioned computeGaugeFixingFFTQuda deviates from the host gauge fixing by %e\n", deviation);
+    EXPECT_LT(deviation, 1e-10);
+  }
+}
+
+/**
+   @return A random MILC-ordered momentum field, as passed to updateGaugeFieldQuda
+*/
+static cpuGaugeField *createMom()
+{
+  GaugeFieldParam gParam(*cpuGauge);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.reconstruct = QUDA_RECONSTRUCT_10;
+  gParam.link_type = QUDA_ASQTAD_MOM_LINKS;
+  gParam.order = QUDA_MILC_GAUGE_ORDER;
+  gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  auto *mom = new cpuGaugeField(gParam);
+  createMomCPU(mom->Gauge_p(), gParam.Precision());
+  return mom;
+}
+
+/**
+   @brief Apply one smearing step to host fields and compare it with
+   the host reference on a single rank, and with the same step on the
+   device when the device is initialized
+   @param[in] label Name of the smearing
+   @param[in] step The step, applied in place to its first argument
+   @param[in] reference The host reference, applied in place to QDP ordered links
+*/
+static void smearing(const char *label, const std::function<void(GaugeField &, GaugeField &)> &step,
+                     const std::function<void(void **)> &reference)
+{
+  GaugeField *u = createExtended(*cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  GaugeField *tmp = createExtended(*cpuGauge, QUDA_CPU_FIELD_LOCATION, false);
+  step(*u, *tmp);
+
+  if (comm_size() == 1) {
+    void *ref[4];
+    for (int dir = 0; dir < 4; dir++) {
+      ref[dir] = malloc((size_t)V * gaugeSiteSize * sizeof(double));
+      memcpy(ref[dir], hostGauge[dir], (size_t)V * gaugeSiteSize * sizeof(double));
+    }
+    reference(ref);
+    double deviation = linkDeviation(*u, ref);
+    printfQuda("Host %s deviates from the reference by %e\n", label, deviation);
+    EXPECT_LT(deviation, 1e-12) << label;
+    for (int dir = 0; dir < 4; dir++) free(ref[dir]);
+  }
+
+  if (device_initialized) {
+    GaugeField *d = createExtended(*cpuGauge, QUDA_CUDA_FIELD_LOCATION);
+    GaugeField *dtmp = createExtended(*cpuGauge, QUDA_CUDA_FIELD_LOCATION, false);
+    step(*d, *dtmp);
+
+    GaugeFieldParam gParam(*cpuGauge);
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    cpuGaugeField host(gParam), device(gParam);
+    copyExtendedGauge(host, *u, QUDA_CPU_FIELD_LOCATION);
+    gParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+    gParam.setPrecision(gParam.Precision(), true);
+    cudaGaugeField regular(gParam);
+    copyExtendedGauge(regular, *d, QUDA_CUDA_FIELD_LOCATION);
+    regular.saveCPUField(device);
+
+    double deviation = fieldDeviation(host, device);
+    comm_allreduce_max(&deviation);
+    printfQuda("Host and device %s differ by %e\n", label, deviation);
+    EXPECT_LT(deviation, 1e-12) << label;
+    delete dtmp;
+    delete d;
+  }
+
+  delete tmp;
+  delete u;
+}
+
+TEST(HostGauge, ape)
+{
+  smearing(
+    "APE", [](GaugeField &u, GaugeField &tmp) { APEStep(u, tmp, 0.6); },
+    [](void **ref) { ape_reference(ref, 0.6); });
+}
+
+TEST(HostGauge, stout)
+{
+  smearing(
+    "stout", [](GaugeField &u, GaugeField &tmp) { STOUTStep(u, tmp, 0.1); },
+    [](void **ref) { stout_reference(ref, 0.1); });
+}
+
+TEST(HostGauge, ovrimpstout)
+{
+  smearing(
+    "over-improved stout", [](GaugeField &u, GaugeField &tmp) { OvrImpSTOUTStep(u, tmp, 0.06, -0.25); },
+    [](void **ref) { ovrimpstout_reference(ref, 0.06, -0.25); });
+}
+
+TEST(HostGauge, update_gauge_field)
+{
+  const double dt = 0.1;
+  cpuGaugeField *mom = createMom();
+  GaugeFieldParam gParam(*cpuGauge);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  cpuGaugeField exact(gParam), expand(gParam), back(gParam);
+
+  updateGaugeField(exact, dt, *cpuGauge, *mom, false, true);
+  updateGaugeField(expand, dt, *cpuGauge, *mom, false, false);
+  double expansion = fieldDeviation(exact, expand);
+
+  // the exact update is reversible, and conjugating the momentum reverses it
+  updateGaugeField(back, -dt, exact, *mom, false, true);
+  double reverse = fieldDeviation(back, *cpuGauge);
+  updateGaugeField(back, dt, exact, *mom, true, true);
+  double conjugate = fieldDeviation(back, *cpuGauge);
+
+  // in place on a MILC-ordered copy
+  gParam.order = QUDA_MILC_GAUGE_ORDER;
+  cpuGaugeField milc(gParam);
+  copyGenericGauge(milc, *cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  updateGaugeField(milc, dt, milc, *mom, false, true);
+  copyGenericGauge(back, milc, QUDA_CPU_FIELD_LOCATION);
+  double in_place = fieldDeviation(back, exact);
+
+  int fails = projectSU3CPU(exact, 1e-12);
+  delete mom;
+
+  printfQuda("Update deviations: expansion %e, reversed %e, conjugated %e, MILC in place %e, %d non-SU(3) links\n",
+             expansion, reverse, conjugate, in_place, fails);
+  EXPECT_LT(expansion, 1e-10);
+  EXPECT_LT(reverse, 1e-13);
+  EXPECT_LT(conjugate, 1e-13);
+  EXPECT_EQ(in_place, 0.0);
+  EXPECT_EQ(fails, 0);
+}
+
+TEST(HostGauge, mom_action)
+{
+  cpuGaugeField *mom = createMom();
+  double action = computeMomAction(*mom);
+
+  // the MILC convention: the squares of the off-diagonal elements and
+  // half those of the diagonal, less 4 per link
+  double ref = 0.0;
+  const double *m = static_cast<const double *>(mom->Gauge_p());
+  for (size_t i = 0; i < 4 * (size_t)V; i++) {
+    for (int k = 0; k < 6; k++) ref += m[i * momSiteSize + k] * m[i * momSiteSize + k];
+    for (int k = 6; k < 9; k++) ref += 0.5 * m[i * momSiteSize + k] * m[i * momSiteSize + k];
+    ref -= 4.0;
+  }
+  comm_allreduce(&ref);
+  delete mom;
+
+  printfQuda("Momentum action %.16e, reference %.16e\n", action, ref);
+  EXPECT_NEAR(action, ref, 1e-12 * fabs(ref));
+}
+
+TEST(HostGauge, update_gauge_field_rate)
+{
+  const int iter = 5;
+  cpuGaugeField *mom = createMom();
+  GaugeFieldParam gParam(*cpuGauge);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.order = QUDA_MILC_GAUGE_ORDER;
+  cpuGaugeField u(gParam);
+  copyGenericGauge(u, *cpuGauge, QUDA_CPU_FIELD_LOCATION);
+
+  for (bool exact : {true, false}) {
+    updateGaugeField(u, 0.01, u, *mom, false, exact); // tune the schedule
+    Timer timer;
+    timer.Start(__func__, __FILE__, __LINE__);
+    for (int i = 0; i < iter; i++) updateGaugeField(u, 0.01, u, *mom, false, exact);
+    timer.Stop(__func__, __FILE__, __LINE__);
+    printfQuda("Host %-9s update: %e link updates/s with %d threads\n", exact ? "exact" : "expansion",
+               4.0 * V * iter / timer.Last(), host::thread_count());
+  }
+
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+  for (int i = 0; i < iter; i++) computeMomAction(*mom);
+  timer.Stop(__func__, __FILE__, __LINE__);
+  printfQuda("Host momentum action: %e links/s\n", 4.0 * V * iter / timer.Last());
+  delete mom;
+}
+
+template <typename T> static T byteSwap(T v)
+{
+  char b[sizeof(T)];
+  memcpy(b, &v, sizeof(T));
+  std::reverse(b, b + sizeof(T));
+  memcpy(&v, b, sizeof(T));
+  return v;
+}
+
+/**
+   @brief The links of hostGauge in the natural site order of the
+   native formats, gathered over the global lattice from every rank,
+   with the first rows of each link in precision File
+   @param[out] words The 32-bit words of the links in host byte order, for the checksums
+*/
+template <typename File> static std::vector<File> nativeLinks(int rows, std::vector<uint32_t> &words)
+{
+  int N[4];
+  size_t volume = 1;
+  for (int d = 0; d < 4; d++) {
+    N[d] = Z[d] * comm_dim(d);
+    volume *= N[d];
+  }
+
+  // each site is owned by one rank, so the sum over ranks gathers the field
+  std::vector<double> global(volume * 4 * rows * 6, 0.0);
+  for (int i = 0; i < V; i++) {
+    int x[4] = {i % Z[0], (i / Z[0]) % Z[1], (i / (Z[0] * Z[1])) % Z[2], i / (Z[0] * Z[1] * Z[2])};
+    size_t qdp = ((x[0] + x[1] + x[2] + x[3]) & 1) * Vh + i / 2;
+    size_t site = 0;
+    for (int d = 3; d >= 0; d--) site = site * N[d] + comm_coord(d) * Z[d] + x[d];
+    for (int mu = 0; mu < 4; mu++)
+      for (int k = 0; k < rows * 6; k++)
+        global[(site * 4 + mu) * rows * 6 + k] = static_cast<double *>(hostGauge[mu])[qdp * gaugeSiteSize + k];
+  }
+  comm_allreduce_array(global.data(), global.size());
+
+  std::vector<File> links(global.begin(), global.end());
+  words.resize(links.size() * sizeof(File) / sizeof(uint32_t));
+  memcpy(words.data(), links.data(), words.size() * sizeof(uint32_t));
+  return links;
+}
+
+template <typename File> static void writeLinks(FILE *file, std::vector<File> &links, bool swap)
+{
+  if (swap)
+    for (auto &l : links) l = byteSwap(l);
+  fwrite(links.data(), sizeof(File), links.size(), file);
+}
+
+/**
+   @brief Load the file written by rank 0 on every rank, remove it, and
+   return the largest deviation of the local links from hostGauge
+*/
+template <typename Float> static double loadDeviation(const char *filename, QudaPrecision precision)
+{
+  comm_barrier(); // the file is complete before any rank reads it
+
+  std::vector<Float> loaded(4 * V * gaugeSiteSize);
+  void *gauge[4];
+  for (int mu = 0; mu < 4; mu++) gauge[mu] = loaded.data() + mu * V * gaugeSiteSize;
+  load_gauge_field(filename, gauge, precision, Z, 0, nullptr);
+
+  comm_barrier(); // and every rank has read it before it is removed
+  if (comm_rank() == 0) remove(filename);
+
+  double deviation = 0.0;
+  for (int mu = 0; mu < 4; mu++)
+    for (int i = 0; i < V * gaugeSiteSize; i++)
+      deviation
+        = std::max(deviation, fabs(static_cast<Float *>(gauge[mu])[i] - static_cast<double *>(hostGauge[mu])[i]));
+  comm_allreduce_max(&deviation);
+  return deviation;
+}
+
+/**
+   @brief Write hostGauge as a NERSC archive on rank 0, load it back on
+   every rank and return the largest link deviation
+*/
+template <typename File> static double nerscRoundTrip(int rows, bool big)
+{
+  std::vector<uint32_t> words;
+  std::vector<File> links = nativeLinks<File>(rows, words);
+  uint32_t checksum = 0;
+  for (auto w : words) checksum += w;
+
+  GaugeField *u = createExtended(*cpuGauge, QUDA_CPU_FIELD_LOCATION);
+  double plaq = plaquette(*u).x;
+  delete u;
+  double trace = 0.0;
+  for (int mu = 0; mu < 4; mu++)
+    for (int i = 0; i < V; i++)
+      for (int c = 0; c < 3; c++) trace += static_cast<double *>(hostGauge[mu])[i * gaugeSiteSize + 8 * c];
+  comm_allreduce(&trace);
+  trace /= 3.0 * 4 * V * comm_size();
+
+  const char *filename = "host_gauge_test.nersc";
+  if (comm_rank() == 0) {
+    FILE *file = fopen(filename, "wb");
+    fprintf(file, "BEGIN_HEADER\nHDR_VERSION = 1.0\nDATATYPE = %s\nSTORAGE_FORMAT = 1.0\n",
+            rows == 3 ? "4D_SU3_GAUGE_3x3" : "4D_SU3_GAUGE");
+    for (int d = 0; d < 4; d++) fprintf(file, "DIMENSION_%d = %d\n", d + 1, Z[d] * comm_dim(d));
+    fprintf(file, "LINK_TRACE = %.12f\nPLAQUETTE = %.12f\nCHECKSUM = %x\nFLOATING_POINT = IEEE%d%s\nEND_HEADER\n",
+            trace, plaq, checksum, static_cast<int>(8 * sizeof(File)), big ? "BIG" : "LITTLE");
+    bool host_big = htonl(1) == 1;
+    writeLinks(file, links, big != host_big);
+    fclose(file);
+  }
+
+  return loadDeviation<double>(filename, QUDA_DOUBLE_PRECISION);
+}
+
+// on a partitioned lattice this tests the offsets of each rank into the
+// file and the global reduction of the checksum
+TEST(HostGauge, load_nersc)
+{
+  EXPECT_LT(nerscRoundTrip<double>(3, true), 1e-15);
+  EXPECT_LT(nerscRoundTrip<double>(2, true), 1e-14);
+  EXPECT_LT(nerscRoundTrip<float>(2, false), 1e-6);
+}
+
+TEST(HostGauge, load_milc)
+{
+  std::vector<uint32_t> words;
+  std::vector<float> links = nativeLinks<float>(3, words);
+
+  // the checksums rotate each word by its index in the file
+  uint32_t sum29 = 0, sum31 = 0;
+  for (size_t i = 0; i < words.size(); i++) {
+    int r29 = i % 29, r31 = i % 31;
+    sum29 ^= r29 ? (words[i] << r29) | (words[i] >> (32 - r29)) : words[i];
+    sum31 ^= r31 ? (words[i] << r31) | (words[i] >> (32 - r31)) : words[i];
+  }
+
+  // written in the opposite byte order to exercise the swapping
+  const char *filename = "host_gauge_test.milc";
+  if (comm_rank() == 0) {
+    FILE *file = fopen(filename, "wb");
+    int32_t header[5] = {20103, Z[0] * comm_dim(0), Z[1] * comm_dim(1), Z[2] * comm_dim(2), Z[3] * comm_dim(3)};
+    int32_t order = 0;
+    uint32_t sums[2] = {sum29, sum31};
+    char stamp[64] = "host_gauge_test";
+    for (auto &h : header) h = byteSwap(h);
+    for (auto &s : sums) s = byteSwap(s);
+    fwrite(header, sizeof(header), 1, file);
+    fwrite(stamp, sizeof(stamp), 1, file);
+    fwrite(&order, sizeof(order), 1, file);
+    fwrite(sums, sizeof(sums), 1, file);
+    writeLinks(file, links, true);
+    fclose(file);
+  }
+
+  // each rank checks its own words, which are combined with comm_allreduce_xor
+  EXPECT_LT(loadDeviation<float>(filename, QUDA_SINGLE_PRECISION), 1e-6);
+}
+
+TEST(HostGauge, device_update_gauge_field)
+{
+  if (!device_initialized) GTEST_SKIP();
+
+  const double dt = 0.1;
+  cpuGaugeField *mom = createMom();
+  GaugeFieldParam gParam(*cpuGauge);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  cpuGaugeField host(gParam), device(gParam);
+  updateGaugeField(host, dt, *cpuGauge, *mom, false, true);
+  double host_action = computeMomAction(*mom);
+
+  gParam.order = QUDA_FLOAT2_GAUGE_ORDER;
+  gParam.setPrecision(gParam.Precision(), true);
+  cudaGaugeField in(gParam), out(gParam);
+  in.loadCPUField(*cpuGauge);
+  gParam.reconstruct = QUDA_RECONSTRUCT_10;
+  gParam.link_type = QUDA_ASQTAD_MOM_LINKS;
+  cudaGaugeField cudaMom(gParam);
+  cudaMom.loadCPUField(*mom);
+  updateGaugeField(out, dt, in, cudaMom, false, true);
+  out.saveCPUField(device);
+  double device_action = computeMomAction(cudaMom);
+  delete mom;
+
+  double deviation = fieldDeviation(host, device);
+  printfQuda("Host and device updates differ by %e, actions %.16e and %.16e\n", deviation, host_action,
+             device_action);
+  EXPECT_LT(deviation, 1e-13);
+  EXPECT_NEAR(host_action, device_action, 1e-12 * fabs(device_action));
+}
+
+TEST(HostGauge, device_fused_observables)
+{
+  if (!device_initialized) GTEST_SKIP();
+
+  std::vector<double> host_density(V), device_density(V);
+  QudaGaugeObservableParam param[2];
+  std::vector<double> *density[2] = {&host_density, &device_density};
+  QudaFieldLocation location[2] = {QUDA_CPU_FIELD_LOCATION, QUDA_CUDA_FIELD_LOCATION};
+  for (int i = 0; i < 2; i++) {
+    GaugeField *u = createExtended(*cpuGauge, location[i]);
+    param[i] = newQudaGaugeObservableParam();
+    param[i].compute_plaquette = QUDA_BOOLEAN_TRUE;
+    param[i].compute_qcharge = QUDA_BOOLEAN_TRUE;
+    param[i].compute_qcharge_density = QUDA_BOOLEAN_TRUE;
+    param[i].qcharge_density = density[i]->data();
+    TimeProfile profile("host_gauge_test");
+    profile.TPSTART(QUDA_PROFILE_TOTAL);
+    gaugeObservables(*u, param[i], profile);
+    profile.TPSTOP(QUDA_PROFILE_TOTAL);
+    delete u;
+  }
+
+  printfQuda("Host:   plaquette %.16e energy %.16e charge %.16e\n", param[0].plaquette[0], param[0].energy[0],
+             param[0].qcharge);
+  printfQuda("Device: plaquette %.16e energy %.16e charge %.16e\n", param[1].plaquette[0], param[1].energy[0],
+             param[1].qcharge);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(param[0].plaquette[i], param[1].plaquette[i], 1e-13);
+    EXPECT_NEAR(param[0].energy[i], param[1].energy[i], 1e-12 * std::max(1.0, fabs(param[1].energy[i])));
+  }
+  EXPECT_NEAR(param[0].qcharge, param[1].qcharge, 1e-11 * std::max(1.0, fabs(param[1].qcharge)));
+  double deviation = 0.0;
+  for (int i = 0; i < V; i++) deviation = std::max(deviation, fabs(host_density[i] - device_density[i]));
+  EXPECT_LT(deviation, 1e-13);
+}
+
+/**
+   @brief Measure the plaquette, energy and charge of u, appending them
+   to obs under the given label
+*/
+static void measure(Observables &obs, GaugeField &u, const char *label)
+{
+  QudaGaugeObservableParam param = newQudaGaugeObservableParam();
+  param.compute_plaquette = QUDA_BOOLEAN_TRUE;
+  param.compute_qcharge = QUDA_BOOLEAN_TRUE;
+  TimeProfile profile("host_gauge_test");
+  profile.TPSTART(QUDA_PROFILE_TOTAL);
+  gaugeObservables(u, param, profile);
+  profile.TPSTOP(QUDA_PROFILE_TOTAL);
+
+  obs.push_back({std::string(label) + "_plaquette", param.plaquette[0]});
+  obs.push_back({std::string(label) + "_energy", param.energy[0]});
+  obs.push_back({std::string(label) + "_qcharge", param.qcharge});
+}
+
+/**
+   @brief Run two steps each of APE, stout, over-improved stout and
+   Wilson and Symanzik flow on fields at the given location, measuring
+   after each smearing type, and time the steps
+*/
+static Observables runSequence(QudaFieldLocation location)
+{
+  const int steps = 2;
+  const double epsilon = 0.02;
+  const char *where = location == QUDA_CPU_FIELD_LOCATION ? "host" : "device";
+  Observables obs;
+  Timer timer;
+
+  GaugeField *u = createExtended(*cpuGauge, location);
+  GaugeField *tmp = createExtended(*cpuGauge, location, false);
+  GaugeField *temp = createExtended(*cpuGauge, location, false);
+
+  auto run = [&](const char *label, auto step) {
+    timer.Start(__func__, __FILE__, __LINE__);
+    for (int i = 0; i < steps; i++) step();
+    if (location == QUDA_CUDA_FIELD_LOCATION) qudaDeviceSynchronize();
+    timer.Stop(__func__, __FILE__, __LINE__);
+    printfQuda("%s %-12s %d steps in %e secs\n", where, label, steps, timer.Last());
+    measure(obs, *u, label);
+  };
+
+  run("ape", [&]() { APEStep(*u, *tmp, 0.6); });
+  run("stout", [&]() { STOUTStep(*u, *tmp, 0.1); });
+  run("ovrimpstout", [&]() { OvrImpSTOUTStep(*u, *tmp, 0.06, -0.25); });
+  run("wflow", [&]() {
+    WFlowStep(*tmp, *temp, *u, epsilon, QUDA_WFLOW_TYPE_WILSON);
+    std::swap(u, tmp);
+  });
+  run("symanzik", [&]() {
+    WFlowStep(*tmp, *temp, *u, epsilon, QUDA_WFLOW_TYPE_SYMANZIK);
+    std::swap(u, tmp);
+  });
+
+  timer.Start(__func__, __FILE__, __LINE__);
+  Observables unused;
+  measure(unused, *u, "final");
+  timer.Stop(__func__, __FILE__, __LINE__);
+  printfQuda("%s %-12s in %e secs\n", where, "observables", timer.Last());
+
+  delete temp;
+  delete tmp;
+  delete u;
+  return obs;
+}
+
+TEST(HostGauge, sequence)
+{
+  printfQuda("Host gauge tools with %d threads\n", host::thread_count());
+  Observables host = runSequence(QUDA_CPU_FIELD_LOCATION);
+
+  if (!results_check.empty()) {
+    FILE *file = fopen(results_check.c_str(), "r");
+    if (!file) errorQuda("Unable to open %s", results_check.c_str());
+    std::map<std::string, double> device;
+    char name[256];
+    double value;
+    while (fscanf(file, "%255s %lf", name, &value) == 2) device[name] = value;
+    fclose(file);
+
+    for (auto &o : host) {
+      ASSERT_TRUE(device.count(o.first)) << o.first << " missing from " << results_check;
+      EXPECT_NEAR(o.second, device[o.first], 1e-10 * std::max(1.0, fabs(device[o.first]))) << o.first;
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  app->add_option("--gauge-results-save", results_save,
+                  "Run the sequence on the device and save its observables to this file");
+  app->add_option("--gauge-results-check", results_check,
+                  "Compare the host sequence against the observables saved in this file");
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+
+  init();
+
+  if (!results_save.empty()) {
+    // the device is only used to produce the stored results
+    initQuda(device);
+    device_initialized = true;
+    Observables obs = runSequence(QUDA_CUDA_FIELD_LOCATION);
+    if (comm_rank() == 0) {
+      FILE *file = fopen(results_save.c_str(), "w");
+      if (!file) errorQuda("Unable to open %s", results_save.c_str());
+      for (auto &o : obs) fprintf(file, "%s %.17g\n", o.first.c_str(), o.second);
+      fclose(file);
+    }
+    printfQuda("Saved %lu device observables to %s\n", obs.size(), results_save.c_str());
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+
+  if (!results_save.empty()) endQuda();
+  end();
+  finalizeComms();
+  return result;
+}
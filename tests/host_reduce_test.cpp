@@ -0,0 +1,187 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <test_util.h>
+#include <test_params.h>
+
+#include <quda_internal.h>
+#include <timer.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <host_parallel.h>
+
+/**
+   Host reduction benchmark.  Every reduction kernel in reduce_quda.cu
+   is run on host fields and the bandwidth it achieves is reported,
+   counting one read or write of a field per stream of the reducer.
+   Each reduction is then repeated with a single thread, and the
+   result is required to be bitwise identical to the multi-threaded
+   one, since the host reductions use a fixed-shape reduction tree.
+   Finally, the block Gram-Schmidt orthonormalization is checked for
+   its orthogonality loss.
+ */
+
+using namespace quda;
+
+struct Reduction {
+  const char *name;
+  int streams;                          // number of fields read or written (see reduce_core.cuh)
+  std::function<std::vector<double>()> apply;
+};
+
+static std::vector<double> vec(double a) { return {a}; }
+static std::vector<double> vec(const Complex &a) { return {a.real(), a.imag()}; }
+static std::vector<double> vec(const double3 &a) { return {a.x, a.y, a.z}; }
+static std::vector<double> vec(const double4 &a) { return {a.x, a.y, a.z, a.w}; }
+
+static void set_threads(int nthreads)
+{
+#ifdef _OPENMP
+  omp_set_num_threads(nthreads);
+#endif
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+
+  ColorSpinorParam param;
+  param.nColor = 3;
+  param.nSpin = 4;
+  param.nDim = 4;
+  param.x[0] = xdim;
+  param.x[1] = ydim;
+  param.x[2] = zdim;
+  param.x[3] = tdim;
+  param.setPrecision(QUDA_DOUBLE_PRECISION);
+  param.pad = 0;
+  param.siteSubset = QUDA_FULL_SITE_SUBSET;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  param.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.pc_type = QUDA_4D_PC;
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+
+  // six working fields, and a pristine copy of each that is restored
+  // before every reduction, since some reductions also write a field
+  std::vector<cpuColorSpinorField *> field, source;
+  for (int i = 0; i < 6; i++) {
+    source.push_back(new cpuColorSpinorField(param));
+    source[i]->Source(QUDA_RANDOM_SOURCE);
+    field.push_back(new cpuColorSpinorField(param));
+  }
+  auto &x = *field[0], &y = *field[1], &z = *field[2], &w = *field[3], &v = *field[4], &u = *field[5];
+
+  const double a = 0.5, b = -0.25;
+  const Complex ca(0.5, -0.125), cb(-0.25, 0.375);
+
+  std::vector<Reduction> reductions = {
+    {"norm1", 1, [&]() { return vec(blas::norm1(x)); }},
+    {"norm2", 1, [&]() { return vec(blas::norm2(x)); }},
+    {"reDotProduct", 2, [&]() { return vec(blas::reDotProduct(x, y)); }},
+    {"axpbyzNorm", 3, [&]() { return vec(blas::axpbyzNorm(a, x, b, y, z)); }},
+    {"axpyReDot", 3, [&]() { return vec(blas::axpyReDot(a, x, y)); }},
+    {"caxpyNorm", 3, [&]() { return vec(blas::caxpyNorm(ca, x, y)); }},
+    {"caxpyXmazNormX", 5, [&]() { return vec(blas::caxpyXmazNormX(ca, x, y, z)); }},
+    {"cabxpyzAxNorm", 4, [&]() { return vec(blas::cabxpyzAxNorm(a, cb, x, y, z)); }},
+    {"cDotProduct", 2, [&]() { return vec(blas::cDotProduct(x, y)); }},
+    {"caxpyDotzy", 4, [&]() { return vec(blas::caxpyDotzy(ca, x, y, z)); }},
+    {"cDotProductNormA", 2, [&]() { return vec(blas::cDotProductNormA(x, y)); }},
+    {"caxpbypzYmbwcDotProductUYNormY", 7,
+     [&]() { return vec(blas::caxpbypzYmbwcDotProductUYNormY(ca, x, cb, y, z, w, u)); }},
+    {"axpyCGNorm", 3, [&]() { return vec(blas::axpyCGNorm(a, x, y)); }},
+    {"HeavyQuarkResidualNorm", 2, [&]() { return vec(blas::HeavyQuarkResidualNorm(x, y)); }},
+    {"xpyHeavyQuarkResidualNorm", 3, [&]() { return vec(blas::xpyHeavyQuarkResidualNorm(x, y, z)); }},
+    {"tripleCGReduction", 3, [&]() { return vec(blas::tripleCGReduction(x, y, z)); }},
+    {"quadrupleCGReduction", 3, [&]() { return vec(blas::quadrupleCGReduction(x, y, z)); }},
+    {"quadrupleCG3InitNorm", 6, [&]() { return vec(blas::quadrupleCG3InitNorm(a, x, y, z, w, v)); }},
+    {"quadrupleCG3UpdateNorm", 7, [&]() { return vec(blas::quadrupleCG3UpdateNorm(a, b, x, y, z, w, v)); }},
+    {"doubleCG3InitNorm", 3, [&]() { return vec(blas::doubleCG3InitNorm(a, x, y, z)); }},
+    {"doubleCG3UpdateNorm", 4, [&]() { return vec(blas::doubleCG3UpdateNorm(a, b, x, y, z)); }},
+  };
+
+  auto restore = [&]() {
+    for (int i = 0; i < 6; i++) *field[i] = *source[i];
+  };
+
+  const int nthreads = host::thread_count();
+  const int iter = std::max(niter, 1);
+  printfQuda("Host reductions on %d^3x%d sites with %d threads\n", xdim, tdim, nthreads);
+
+  int fail = 0;
+  for (auto &r : reductions) {
+    std::vector<double> result;
+    double best = 0.0;
+    set_threads(nthreads);
+    for (int it = 0; it < iter; it++) {
+      restore();
+      Timer timer;
+      timer.Start(__func__, __FILE__, __LINE__);
+      result = r.apply();
+      timer.Stop(__func__, __FILE__, __LINE__);
+      best = std::max(best, r.streams * x.Bytes() / (timer.Last() * 1e9));
+    }
+
+    // the reduction tree does not depend on the thread count
+    restore();
+    set_threads(1);
+    std::vector<double> serial = r.apply();
+    bool match = memcmp(serial.data(), result.data(), result.size() * sizeof(double)) == 0;
+    if (!match) fail++;
+
+    printfQuda("%-32s %8.2f GB/s  %s\n", r.name, best, match ? "deterministic" : "MISMATCH with 1 thread");
+  }
+  set_threads(nthreads);
+
+  // block Gram-Schmidt on a set of random vectors, one of which is
+  // nearly parallel to another to stress the reorthogonalization, and
+  // again on the same set scaled down, since the dependence test is
+  // relative to the norms of the block
+  for (double scale : {1.0, 1e-12}) {
+    const int nvec = 12;
+    std::vector<ColorSpinorField *> V;
+    for (int i = 0; i < nvec; i++) {
+      V.push_back(new cpuColorSpinorField(param));
+      V[i]->Source(QUDA_RANDOM_SOURCE);
+    }
+    blas::axpy(1e4, *V[2], *V[7]);
+    for (auto f : V) blas::ax(scale, *f);
+
+    double loss = 0.0;
+    int nreduce = blas::blockOrthonormalize(V, 4, &loss);
+    bool orthonormal = loss < 1e-12;
+    if (!orthonormal) fail++;
+    printfQuda("blockOrthonormalize (scale %5.0e) %8d reductions, orthogonality loss %e  %s\n", scale, nreduce, loss,
+               orthonormal ? "" : "FAILED");
+
+    for (auto f : V) delete f;
+  }
+
+  for (int i = 0; i < 6; i++) {
+    delete field[i];
+    delete source[i];
+  }
+
+  if (fail) warningQuda("%d reductions depend on the thread count or are inaccurate", fail);
+
+  finalizeComms();
+  return fail ? 1 : 0;
+}
@@ -0,0 +1,245 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <test_util.h>
+#include <test_params.h>
+
+#include <quda_internal.h>
+#include <timer.h>
+#include <quda_matrix.h>
+#include <host_parallel.h>
+#include <host_su3.h>
+
+/**
+   Host SU(3) kernel benchmark.  Each batched kernel of host_su3.h is
+   run on one matrix (and color vector) per lattice site and the
+   GFLOP/s it achieves is reported, counting the nominal operations of
+   host::su3_flops.  The same operation is then computed site by site
+   with the Matrix<complex<T>,3> operators of quda_matrix.h, timed
+   for comparison and used as the reference the batched result must
+   agree with.  The exponential is referenced in double by a
+   scaling-and-squaring Taylor series, independent of the
+   Cayley-Hamilton form the batched kernel shares with
+   exponentiate_iQ.  Reunitarization has no scalar counterpart and is
+   instead checked for the unitarity and unit determinant of its
+   output.
+ */
+
+using namespace quda;
+
+struct Kernel {
+  const char *name;
+  int flops;
+  std::function<void()> batched;
+  std::function<void()> scalar;
+  std::function<double()> deviation;
+};
+
+template <typename T> using Mat = Matrix<complex<T>, 3>;
+
+template <typename T> static Mat<T> load(const std::vector<T> &v, int i)
+{
+  Mat<T> m;
+  for (int k = 0; k < 9; k++) m(k) = complex<T>(v[18 * i + 2 * k], v[18 * i + 2 * k + 1]);
+  return m;
+}
+
+template <typename T> static void store(std::vector<T> &v, int i, const Mat<T> &m)
+{
+  for (int k = 0; k < 9; k++) {
+    v[18 * i + 2 * k] = m(k).real();
+    v[18 * i + 2 * k + 1] = m(k).imag();
+  }
+}
+
+/**
+   @brief The largest absolute difference of two arrays, relative to the largest element of the reference
+*/
+template <typename T> static double max_deviation(const std::vector<T> &a, const std::vector<T> &ref)
+{
+  double diff = 0.0, scale = 0.0;
+  for (size_t i = 0; i < a.size(); i++) {
+    diff = std::max(diff, fabs(static_cast<double>(a[i]) - static_cast<double>(ref[i])));
+    scale = std::max(scale, fabs(static_cast<double>(ref[i])));
+  }
+  return scale > 0.0 ? diff / scale : diff;
+}
+
+/**
+   @brief exp(iQ) by scaling and squaring: the Taylor series of
+   exp(iQ / 2^s), with s chosen so the row-sum norm of Q / 2^s is at
+   most 1/2, summed until the terms vanish and squared s times
+*/
+static Mat<double> exponentiateTaylor(const Mat<double> &Q)
+{
+  double norm = 0.0;
+  for (int r = 0; r < 3; r++) norm = std::max(norm, abs(Q(r, 0)) + abs(Q(r, 1)) + abs(Q(r, 2)));
+  int s = 0;
+  while (norm > 0.5) {
+    norm /= 2;
+    s++;
+  }
+
+  Mat<double> A = complex<double>(0.0, std::ldexp(1.0, -s)) * Q;
+  Mat<double> e, term;
+  setIdentity(&e);
+  setIdentity(&term);
+  for (int k = 1; k < 30; k++) {
+    term = term * A;
+    term = complex<double>(1.0 / k, 0.0) * term;
+    e = e + term;
+  }
+  for (int i = 0; i < s; i++) e = e * e;
+  return e;
+}
+
+template <typename T> static int benchmark(int n, int iter, double tol)
+{
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<T> uniform(-1.0, 1.0);
+  std::vector<T> a(18 * n), b(18 * n), q(18 * n), x(6 * n);
+  for (auto &v : a) v = uniform(rng);
+  for (auto &v : b) v = uniform(rng);
+  for (auto &v : x) v = uniform(rng);
+
+  // traceless hermitian Q = -i P of a random anti-hermitian P
+  for (int i = 0; i < n; i++) {
+    Mat<T> p = load(a, i);
+    makeAntiHerm(p);
+    store(q, i, complex<T>(0.0, -1.0) * p);
+  }
+
+  std::vector<T> c(18 * n), c_ref(18 * n), y(6 * n), y_ref(6 * n);
+
+  auto mat_vec_ref = [&](bool dagger) {
+    host::parallel_for(n, [&](int i) {
+      for (int r = 0; r < 3; r++) {
+        complex<T> s = 0.0;
+        for (int k = 0; k < 3; k++) {
+          const int e = dagger ? 3 * k + r : 3 * r + k;
+          complex<T> m(a[18 * i + 2 * e], a[18 * i + 2 * e + 1]);
+          if (dagger) m = conj(m);
+          s += m * complex<T>(x[6 * i + 2 * k], x[6 * i + 2 * k + 1]);
+        }
+        y_ref[6 * i + 2 * r] = s.real();
+        y_ref[6 * i + 2 * r + 1] = s.imag();
+      }
+    });
+  };
+
+  // the deviation of reunitarized matrices from SU(3)
+  auto su3_deviation = [&]() {
+    double dev = 0.0;
+    for (int i = 0; i < n; i++) {
+      Mat<T> u = load(c, i);
+      Mat<T> uu = u * conj(u);
+      for (int r = 0; r < 3; r++)
+        for (int s = 0; s < 3; s++)
+          dev = std::max(dev, static_cast<double>(abs(uu(r, s) - complex<T>(r == s ? 1.0 : 0.0, 0.0))));
+      dev = std::max(dev, static_cast<double>(abs(getDeterminant(u) - complex<T>(1.0, 0.0))));
+    }
+    return dev;
+  };
+
+  std::vector<Kernel> kernels = {
+    {"mul_nn", host::su3_flops::mul, [&]() { host::mul_nn(n, c.data(), a.data(), b.data()); },
+     [&]() { host::parallel_for(n, [&](int i) { store(c_ref, i, load(a, i) * load(b, i)); }); },
+     [&]() { return max_deviation(c, c_ref); }},
+    {"mul_na", host::su3_flops::mul, [&]() { host::mul_na(n, c.data(), a.data(), b.data()); },
+     [&]() { host::parallel_for(n, [&](int i) { store(c_ref, i, load(a, i) * conj(load(b, i))); }); },
+     [&]() { return max_deviation(c, c_ref); }},
+    {"mul_an", host::su3_flops::mul, [&]() { host::mul_an(n, c.data(), a.data(), b.data()); },
+     [&]() { host::parallel_for(n, [&](int i) { store(c_ref, i, conj(load(a, i)) * load(b, i)); }); },
+     [&]() { return max_deviation(c, c_ref); }},
+    {"mat_vec", host::su3_flops::mat_vec, [&]() { host::mat_vec(n, y.data(), a.data(), x.data()); },
+     [&]() { mat_vec_ref(false); }, [&]() { return max_deviation(y, y_ref); }},
+    {"adj_mat_vec", host::su3_flops::mat_vec, [&]() { host::adj_mat_vec(n, y.data(), a.data(), x.data()); },
+     [&]() { mat_vec_ref(true); }, [&]() { return max_deviation(y, y_ref); }},
+    {"project", host::su3_flops::project, [&]() { host::project(n, c.data(), a.data()); },
+     [&]() {
+       host::parallel_for(n, [&](int i) {
+         Mat<T> m = load(a, i);
+         makeAntiHerm(m);
+         store(c_ref, i, m);
+       });
+     },
+     [&]() { return max_deviation(c, c_ref); }},
+    {"exponentiate", host::su3_flops::exponentiate, [&]() { host::exponentiate(n, c.data(), q.data()); },
+     [&]() {
+       host::parallel_for(n, [&](int i) {
+         // the reference is always in double precision
+         Mat<T> Q = load(q, i);
+         Mat<double> Qd, e;
+         for (int k = 0; k < 9; k++) Qd(k) = complex<double>(Q(k).real(), Q(k).imag());
+         e = exponentiateTaylor(Qd);
+         for (int k = 0; k < 9; k++) Q(k) = complex<T>(e(k).real(), e(k).imag());
+         store(c_ref, i, Q);
+       });
+     },
+     [&]() { return max_deviation(c, c_ref); }},
+    {"reunitarize", host::su3_flops::reunitarize, [&]() { host::reunitarize(n, c.data(), a.data()); }, nullptr,
+     su3_deviation},
+  };
+
+  auto gflops = [&](const std::function<void()> &f, int flops) {
+    double best = 0.0;
+    for (int it = 0; it < iter; it++) {
+      Timer timer;
+      timer.Start(__func__, __FILE__, __LINE__);
+      f();
+      timer.Stop(__func__, __FILE__, __LINE__);
+      best = std::max(best, static_cast<double>(flops) * n / (timer.Last() * 1e9));
+    }
+    return best;
+  };
+
+  printfQuda("%s precision, tile width %d\n", sizeof(T) == sizeof(double) ? "Double" : "Single",
+             host::simd_width<T>::value);
+  int fail = 0;
+  for (auto &k : kernels) {
+    double batched = gflops(k.batched, k.flops);
+    double scalar = k.scalar ? gflops(k.scalar, k.flops) : 0.0;
+    double dev = k.deviation();
+    bool pass = dev < tol;
+    if (!pass) fail++;
+    if (k.scalar)
+      printfQuda("%-16s %8.2f GFLOP/s  (per-site %8.2f GFLOP/s, %5.2fx)  deviation %e  %s\n", k.name, batched, scalar,
+                 batched / scalar, dev, pass ? "" : "FAILED");
+    else
+      printfQuda("%-16s %8.2f GFLOP/s  %36s deviation %e  %s\n", k.name, batched, "", dev, pass ? "" : "FAILED");
+  }
+
+  return fail;
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+
+  const int n = xdim * ydim * zdim * tdim;
+  const int iter = std::max(niter, 1);
+  printfQuda("Host SU(3) kernels on %dx%dx%dx%d sites with %d threads\n", xdim, ydim, zdim, tdim, host::thread_count());
+
+  int fail = 0;
+  fail += benchmark<double>(n, iter, 1e-12);
+  fail += benchmark<float>(n, iter, 1e-4);
+
+  if (fail) warningQuda("%d kernels disagree with their reference", fail);
+
+  finalizeComms();
+  return fail ? 1 : 0;
+}
@@ -19,6 +19,9 @@
 
 #define MAX(a,b) ((a)>(b)?(a):(b))
 
+// fail if the host relative residual of the solution exceeds this (0 disables the check)
+static double res_check = 0.0;
+
 // In a typical application, quda.h is the only QUDA header required.
 #include <quda.h>
 
@@ -93,6 +96,7 @@ void setEigParam(QudaEigParam &eig_param)
   eig_param.nKr = eig_nKr;
   eig_param.tol = eig_tol;
   eig_param.batched_rotate = eig_batched_rotate;
+  eig_param.block_size = eig_block_size;
   eig_param.require_convergence = eig_require_convergence ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   eig_param.check_interval = eig_check_interval;
   eig_param.max_restarts = eig_max_restarts;
@@ -132,6 +136,8 @@ int main(int argc, char **argv)
   add_eigen_option_group(app);
   add_deflation_option_group(app);
   // add_multigrid_option_group(app);
+  app->add_option("--res-check", res_check,
+                  "Fail if the host L2 relative residual of the solution exceeds this (default 0, no check)");
   try {
     app->parse(argc, argv);
   } catch (const CLI::ParseError &e) {
@@ -358,7 +364,7 @@ int main(int argc, char **argv)
   }
 
   if (strcmp(latfile,"")) {  // load in the command line supplied gauge field
-    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    load_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
     construct_gauge_field(gauge, 2, gauge_param.cpu_prec, &gauge_param);
   } else { // else generate an SU(3) field
     if (unit_gauge) {
@@ -414,6 +420,7 @@ int main(int argc, char **argv)
 
   double *time = new double[Nsrc];
   double *gflops = new double[Nsrc];
+  double *iter_rate = new double[Nsrc];
   auto *rng = new quda::RNG(quda::LatticeFieldParam(gauge_param), 1234);
   rng->Init();
 
@@ -432,8 +439,9 @@ int main(int argc, char **argv)
 
     time[i] = inv_param.secs;
     gflops[i] = inv_param.gflops / inv_param.secs;
-    printfQuda("Done: %i iter / %g secs = %g Gflops\n\n", inv_param.iter, inv_param.secs,
-               inv_param.gflops / inv_param.secs);
+    iter_rate[i] = inv_param.iter / inv_param.secs;
+    printfQuda("Done: %i iter / %g secs = %g Gflops, %g iter/s\n\n", inv_param.iter, inv_param.secs,
+               inv_param.gflops / inv_param.secs, iter_rate[i]);
   }
 
   rng->Release();
@@ -444,8 +452,10 @@ int main(int argc, char **argv)
     auto mean_time2 = 0.0;
     auto mean_gflops = 0.0;
     auto mean_gflops2 = 0.0;
+    auto mean_iter_rate = 0.0;
     // skip first solve due to allocations, potential UVM swapping overhead
     for (int i = 1; i < Nsrc; i++) {
+      mean_iter_rate += iter_rate[i];
       mean_time += time[i];
       mean_time2 += time[i] * time[i];
       mean_gflops += gflops[i];
@@ -463,13 +473,19 @@ int main(int argc, char **argv)
     auto stddev_gflops = NsrcM1 > 1 ?
       sqrt((NsrcM1 / ((double)NsrcM1 - 1.0)) * (mean_gflops2 - mean_gflops * mean_gflops)) :
       std::numeric_limits<double>::infinity();
+    mean_iter_rate /= NsrcM1;
     printfQuda(
       "%d solves, with mean solve time %g (stddev = %g), mean GFLOPS %g (stddev = %g) [excluding first solve]\n", Nsrc,
       mean_time, stddev_time, mean_gflops, stddev_gflops);
+    printfQuda("%s: mean %g iter/s on %d ranks [excluding first solve]\n", get_solver_str(inv_type), mean_iter_rate,
+               comm_size());
   }
 
   delete[] time;
   delete[] gflops;
+  delete[] iter_rate;
+
+  int result = 0;
 
   if (multishift) {
     if (inv_param.mass_normalization == QUDA_MASS_NORMALIZATION) {
@@ -729,6 +745,10 @@ int main(int argc, char **argv)
     printfQuda("Residuals: (L2 relative) tol %g, QUDA = %g, host = %g; (heavy-quark) tol %g, QUDA = %g\n",
 	       inv_param.tol, inv_param.true_res, l2r, inv_param.tol_hq, inv_param.true_res_hq);
 
+    if (res_check > 0.0 && !(l2r <= res_check)) {
+      warningQuda("Host residual %g exceeds %g", l2r, res_check);
+      result = 1;
+    }
   }
 
   freeGaugeQuda();
@@ -755,5 +775,5 @@ int main(int argc, char **argv)
 
   for (int dir = 0; dir<4; dir++) free(gauge[dir]);
 
-  return 0;
+  return result;
 }
@@ -10,6 +10,7 @@
 #include <string.h>
 
 #include <llfat_reference.h>
+#include <host_su3.h>
 
 #include <quda_internal.h>
 #include <complex>
@@ -56,48 +57,24 @@ template <typename su3_matrix>
   void 
 llfat_mult_su3_na(  su3_matrix *a, su3_matrix *b, su3_matrix *c )
 {
-  int i,j,k;
-  typename std::remove_reference<decltype(a->e[0][0])>::type x,y;
-  for(i=0;i<3;i++)for(j=0;j<3;j++){
-    x=0.0;
-    for(k=0;k<3;k++){
-      y = a->e[i][k] * conj(b->e[j][k]);
-      x += y;
-    }
-    c->e[i][j] = x;
-  }
+  using real = typename std::remove_reference<decltype(a->e[0][0])>::type::value_type;
+  quda::host::mul_na(reinterpret_cast<real *>(c), reinterpret_cast<real *>(a), reinterpret_cast<real *>(b));
 }
 
 template <typename su3_matrix>
   void
 llfat_mult_su3_nn( su3_matrix *a, su3_matrix *b, su3_matrix *c )
 {
-  int i,j,k;
-  typename std::remove_reference<decltype(a->e[0][0])>::type x,y;
-  for(i=0;i<3;i++)for(j=0;j<3;j++){
-    x=0.0;
-    for(k=0;k<3;k++){
-      y = a->e[i][k] * b->e[k][j];
-      x += y;
-    }
-    c->e[i][j] = x;
-  }
+  using real = typename std::remove_reference<decltype(a->e[0][0])>::type::value_type;
+  quda::host::mul_nn(reinterpret_cast<real *>(c), reinterpret_cast<real *>(a), reinterpret_cast<real *>(b));
 }
 
 template<typename su3_matrix>
   void
 llfat_mult_su3_an( su3_matrix *a, su3_matrix *b, su3_matrix *c )
 {
-  int i,j,k;
-  typename std::remove_reference<decltype(a->e[0][0])>::type x,y;
-  for(i=0;i<3;i++)for(j=0;j<3;j++){
-    x=0.0;
-    for(k=0;k<3;k++){
-      y = conj(a->e[k][i]) * b->e[k][j];
-      x += y;
-    }
-    c->e[i][j] = x;
-  }
+  using real = typename std::remove_reference<decltype(a->e[0][0])>::type::value_type;
+  quda::host::mul_an(reinterpret_cast<real *>(c), reinterpret_cast<real *>(a), reinterpret_cast<real *>(b));
 }
 
 
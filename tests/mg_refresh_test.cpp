@@ -0,0 +1,130 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <test_util.h>
+#include <test_params.h>
+
+// google test
+#include <gtest/gtest.h>
+
+#include <quda_internal.h>
+#include <multigrid.h>
+
+/**
+   Test of the adaptive multigrid refresh policy.  Sequences of solves
+   and updates are fed to MGRefreshPolicy, and the refresh decisions
+   and the setup time it reports saved are checked against their
+   expected values.
+ */
+
+using namespace quda;
+
+static void solves(MGRefreshPolicy &policy, int n, int iter, double coarse_secs_per_iter)
+{
+  for (int i = 0; i < n; i++) {
+    policy.recordSolve(iter);
+    policy.coarse_secs += iter * coarse_secs_per_iter;
+  }
+}
+
+TEST(MGRefreshPolicy, no_solves)
+{
+  MGRefreshPolicy policy;
+  policy.growth = 1.25;
+  EXPECT_FALSE(policy.refresh());
+  EXPECT_FALSE(policy.baseline_set);
+}
+
+TEST(MGRefreshPolicy, iteration_growth)
+{
+  MGRefreshPolicy policy;
+  policy.growth = 1.25;
+
+  // the first interval sets the baseline
+  solves(policy, 4, 20, 1e-3);
+  EXPECT_FALSE(policy.refresh());
+  EXPECT_TRUE(policy.baseline_set);
+  EXPECT_DOUBLE_EQ(policy.baseline_iter, 20.0);
+  policy.update(false, 1.0);
+
+  // growth within the allowed factor only rebuilds
+  solves(policy, 4, 24, 1e-3);
+  EXPECT_FALSE(policy.refresh());
+  policy.update(false, 1.0);
+
+  solves(policy, 4, 26, 1e-3);
+  EXPECT_TRUE(policy.refresh());
+  policy.update(true, 4.0);
+
+  // the interval after a refresh sets a new baseline
+  EXPECT_FALSE(policy.baseline_set);
+  solves(policy, 2, 30, 1e-3);
+  EXPECT_FALSE(policy.refresh());
+  EXPECT_DOUBLE_EQ(policy.baseline_iter, 30.0);
+  EXPECT_EQ(policy.n_refresh, 1);
+  EXPECT_EQ(policy.n_rebuild, 2);
+}
+
+TEST(MGRefreshPolicy, coarse_time_growth)
+{
+  MGRefreshPolicy policy;
+  policy.growth = 1.25;
+
+  solves(policy, 4, 20, 1e-3);
+  EXPECT_FALSE(policy.refresh());
+  policy.update(false, 1.0);
+
+  // same iteration count, but slower coarse solves
+  solves(policy, 4, 20, 1.5e-3);
+  EXPECT_TRUE(policy.refresh());
+}
+
+TEST(MGRefreshPolicy, secs_saved)
+{
+  MGRefreshPolicy policy;
+  policy.growth = 1.25;
+
+  // rebuilds are not credited before a refresh has been timed
+  policy.update(false, 1.0);
+  policy.update(false, 1.5);
+  EXPECT_DOUBLE_EQ(policy.secs_saved, 0.0);
+
+  // the first timed refresh credits them retroactively
+  policy.update(true, 4.0);
+  EXPECT_DOUBLE_EQ(policy.secs_saved, 2 * 4.0 - 2.5);
+
+  // later rebuilds save the last refresh time less their own
+  policy.update(false, 1.0);
+  EXPECT_DOUBLE_EQ(policy.secs_saved, 5.5 + 3.0);
+
+  // a rebuild slower than a refresh saves nothing
+  policy.update(false, 5.0);
+  EXPECT_DOUBLE_EQ(policy.secs_saved, 8.5);
+
+  // and the most recent refresh is the reference
+  policy.update(true, 2.0);
+  policy.update(false, 0.5);
+  EXPECT_DOUBLE_EQ(policy.secs_saved, 8.5 + 1.5);
+  EXPECT_EQ(policy.n_refresh, 2);
+  EXPECT_EQ(policy.n_rebuild, 5);
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+
+  finalizeComms();
+  return result;
+}
@@ -870,6 +870,7 @@ const char *get_eig_type_str(QudaEigType type)
   case QUDA_EIG_TR_LANCZOS: ret = "trlm"; break;
   case QUDA_EIG_IR_LANCZOS: ret = "irlm"; break;
   case QUDA_EIG_IR_ARNOLDI: ret = "iram"; break;
+  case QUDA_EIG_BLK_TR_LANCZOS: ret = "blktrlm"; break;
   default: ret = "unknown eigensolver"; break;
   }
 
@@ -1065,6 +1066,9 @@ get_solver_str(QudaInverterType type)
   case QUDA_CA_GCR_INVERTER:
     ret = "ca-gcr";
     break;
+  case QUDA_PIPELINED_CG_INVERTER:
+    ret = "pipelined-cg";
+    break;
   default:
     ret = "unknown";
     errorQuda("Error: invalid solver type %d\n", type);
@@ -247,6 +247,7 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     mg_param.num_setup_iter[i] = num_setup_iter[i];
     mg_param.setup_tol[i] = setup_tol[i];
     mg_param.setup_maxiter[i] = setup_maxiter[i];
+    mg_param.setup_batch_size[i] = setup_batch_size[i];
 
     // Basis to use for CA-CGN(E/R) setup
     mg_param.setup_ca_basis[i] = setup_ca_basis[i];
@@ -409,6 +410,9 @@ void setMultigridParam(QudaMultigridParam &mg_param)
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
   mg_param.preserve_deflation = QUDA_BOOLEAN_FALSE;
 
+  mg_param.adaptive_refresh = mg_adaptive_refresh ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  mg_param.refresh_growth = mg_refresh_growth;
+
   // these need to tbe set for now but are actually ignored by the MG setup
   // needed to make it pass the initialization test
   inv_param.inv_type = QUDA_GCR_INVERTER;
@@ -552,6 +556,7 @@ int main(int argc, char **argv)
     num_setup_iter[i] = 1;
     setup_tol[i] = 5e-6;
     setup_maxiter[i] = 500;
+    setup_batch_size[i] = 1;
     setup_maxiter_refresh[i] = 100;
     mu_factor[i] = 1.;
     coarse_solve_type[i] = QUDA_INVALID_SOLVE;
@@ -682,7 +687,7 @@ int main(int argc, char **argv)
   }
 
   if (strcmp(latfile,"")) {  // load in the command line supplied gauge field
-    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    load_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
     construct_gauge_field(gauge, 2, gauge_param.cpu_prec, &gauge_param);
   } else { // else generate an SU(3) field
     if (unit_gauge) {
@@ -846,6 +851,10 @@ int main(int argc, char **argv)
 
       updateMultigridQuda(mg_preconditioner, &mg_param); // update the multigrid operator for new gauge and clover fields
       invertQuda(spinorOut, spinorIn, &inv_param);
+      if (mg_param.adaptive_refresh == QUDA_BOOLEAN_TRUE)
+        printfQuda("step=%d MG %s, iterations = %d, setup time saved = %.3f secs\n", step,
+                   mg_param.refreshed == QUDA_BOOLEAN_TRUE ? "refreshed" : "rebuilt", inv_param.iter,
+                   mg_param.refresh_secs_saved);
 
       if (inv_param.iter == inv_param.maxiter) {
         char vec_outfile[QUDA_MAX_MG_LEVEL][256];
@@ -19,6 +19,12 @@
 
 #define MAX(a,b) ((a)>(b)?(a):(b))
 
+// fail if the host relative residual of the solution exceeds this (0 disables the check)
+static double res_check = 0.0;
+
+// check that a hierarchy restored from its checkpoint reproduces the solve of a fresh setup
+static bool checkpoint_test = false;
+
 // In a typical application, quda.h is the only QUDA header required.
 #include <quda.h>
 
@@ -232,6 +238,7 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     mg_param.num_setup_iter[i] = num_setup_iter[i];
     mg_param.setup_tol[i] = setup_tol[i];
     mg_param.setup_maxiter[i] = setup_maxiter[i];
+    mg_param.setup_batch_size[i] = setup_batch_size[i];
 
     // Basis to use for CA-CGN(E/R) setup
     mg_param.setup_ca_basis[i] = setup_ca_basis[i];
@@ -390,6 +397,10 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     if (strcmp(mg_param.vec_infile[i], "") != 0) mg_param.vec_load[i] = QUDA_BOOLEAN_TRUE;
     if (strcmp(mg_param.vec_outfile[i], "") != 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
   }
+  strcpy(mg_param.checkpoint_infile, mg_checkpoint_infile);
+  strcpy(mg_param.checkpoint_outfile, mg_checkpoint_outfile);
+  mg_param.checkpoint_load = strcmp(mg_checkpoint_infile, "") != 0 ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  mg_param.checkpoint_store = strcmp(mg_checkpoint_outfile, "") != 0 ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
@@ -507,6 +518,7 @@ int main(int argc, char **argv)
     num_setup_iter[i] = 1;
     setup_tol[i] = 5e-6;
     setup_maxiter[i] = 500;
+    setup_batch_size[i] = 1;
     mu_factor[i] = 1.;
     coarse_solve_type[i] = QUDA_INVALID_SOLVE;
     smoother_solve_type[i] = QUDA_INVALID_SOLVE;
@@ -558,6 +570,11 @@ int main(int argc, char **argv)
   // add_eigen_option_group(app);
   // add_deflation_option_group(app);
   add_multigrid_option_group(app);
+  app->add_option("--res-check", res_check,
+                  "Fail if the host L2 relative residual of the solution exceeds this (default 0, no check)");
+  app->add_flag("--mg-checkpoint-test", checkpoint_test,
+                "Check that a hierarchy restored from its checkpoint reproduces the last solve, and that a checkpoint "
+                "is rejected after the operator changes");
   try {
     app->parse(argc, argv);
   } catch (const CLI::ParseError &e) {
@@ -634,7 +651,7 @@ int main(int argc, char **argv)
   }
 
   if (strcmp(latfile,"")) {  // load in the command line supplied gauge field
-    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    load_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
     construct_gauge_field(gauge, 2, gauge_param.cpu_prec, &gauge_param);
   } else { // else generate an SU(3) field
     if (unit_gauge) {
@@ -685,6 +702,8 @@ int main(int argc, char **argv)
   void *mg_preconditioner = newMultigridQuda(&mg_param);
   inv_param.preconditioner = mg_preconditioner;
 
+  if (mg_param.checkpoint_store == QUDA_BOOLEAN_TRUE) dumpMultigridQuda(mg_preconditioner, &mg_param);
+
   auto *rng = new quda::RNG(quda::LatticeFieldParam(gauge_param), 1234);
   rng->Init();
   double *time = new double[Nsrc];
@@ -703,6 +722,55 @@ int main(int argc, char **argv)
   rng->Release();
   delete rng;
 
+  int result = 0;
+  if (checkpoint_test) {
+    int vol = inv_param.solution_type == QUDA_MAT_SOLUTION ? V : Vh;
+    int length = vol * spinorSiteSize * inv_param.Ls;
+    int iter = inv_param.iter;
+
+    if (mg_param.checkpoint_store != QUDA_BOOLEAN_TRUE) {
+      strcpy(mg_param.checkpoint_outfile, "mg_checkpoint_test");
+      mg_param.checkpoint_store = QUDA_BOOLEAN_TRUE;
+      dumpMultigridQuda(mg_preconditioner, &mg_param);
+    }
+    strcpy(mg_param.checkpoint_infile, mg_param.checkpoint_outfile);
+    mg_param.checkpoint_load = QUDA_BOOLEAN_TRUE;
+
+    // a checkpoint of a different operator must be rejected
+    destroyMultigridQuda(mg_preconditioner);
+    double kappa = mg_inv_param.kappa;
+    mg_inv_param.kappa *= 0.99;
+    mg_preconditioner = newMultigridQuda(&mg_param);
+    if (mg_param.checkpoint_restored != QUDA_BOOLEAN_FALSE) {
+      warningQuda("Hierarchy checkpoint was restored for a different kappa");
+      result = 1;
+    }
+    destroyMultigridQuda(mg_preconditioner);
+    mg_inv_param.kappa = kappa;
+
+    // the restored hierarchy must reproduce the last solve of the fresh one
+    mg_preconditioner = newMultigridQuda(&mg_param);
+    inv_param.preconditioner = mg_preconditioner;
+    if (mg_param.checkpoint_restored != QUDA_BOOLEAN_TRUE) {
+      warningQuda("Hierarchy checkpoint %s was not restored", mg_param.checkpoint_infile);
+      result = 1;
+    }
+
+    void *spinorRestored = malloc(V * spinorSiteSize * sSize * inv_param.Ls);
+    invertQuda(spinorRestored, spinorIn, &inv_param);
+    mxpy(spinorOut, spinorRestored, length, inv_param.cpu_prec);
+    double dev
+      = sqrt(norm_2(spinorRestored, length, inv_param.cpu_prec) / norm_2(spinorOut, length, inv_param.cpu_prec));
+    free(spinorRestored);
+
+    printfQuda("Checkpoint: fresh setup %d iter, restored %d iter, relative solution deviation %e\n", iter,
+               inv_param.iter, dev);
+    if (abs(inv_param.iter - iter) > 1 || !(dev <= 10 * inv_param.tol)) {
+      warningQuda("Restored hierarchy does not reproduce the solve of the fresh setup");
+      result = 1;
+    }
+  }
+
   // free the multigrid solver
   destroyMultigridQuda(mg_preconditioner);
 
@@ -819,6 +887,11 @@ int main(int argc, char **argv)
   printfQuda("Residuals: (L2 relative) tol %g, QUDA = %g, host = %g; (heavy-quark) tol %g, QUDA = %g\n",
 	     inv_param.tol, inv_param.true_res, l2r, inv_param.tol_hq, inv_param.true_res_hq);
 
+  if (res_check > 0.0 && !(l2r <= res_check)) {
+    warningQuda("Host residual %g exceeds %g", l2r, res_check);
+    result = 1;
+  }
+
 
   freeGaugeQuda();
   if (dslash_type == QUDA_CLOVER_WILSON_DSLASH || dslash_type == QUDA_TWISTED_CLOVER_DSLASH) freeCloverQuda();
@@ -840,5 +913,5 @@ int main(int argc, char **argv)
 
   for (int dir = 0; dir<4; dir++) free(gauge[dir]);
 
-  return 0;
+  return result;
 }
@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <test_util.h>
+#include <test_params.h>
+
+#include <quda_internal.h>
+#include <timer.h>
+#include <numa_affinity.h>
+
+/**
+   Host memory bandwidth benchmark for the NUMA placement policies.
+   Three arrays are placed with each policy and a STREAM-style triad
+   a = b + s * c is run over them with a static schedule, so that with
+   local placement every thread streams from its own NUMA node.
+ */
+
+static size_t array_mb = 512;
+
+static const char *placement_str(NumaPlacement placement)
+{
+  switch (placement) {
+  case NUMA_PLACEMENT_NONE: return "none (master touch)";
+  case NUMA_PLACEMENT_LOCAL: return "local";
+  case NUMA_PLACEMENT_INTERLEAVE: return "interleave";
+  default: return "unknown";
+  }
+}
+
+static double triad(NumaPlacement placement, size_t n, int iter)
+{
+  // allocate directly, since safe_malloc would apply the QUDA_NUMA_PLACEMENT policy
+  double *a = static_cast<double *>(malloc(n * sizeof(double)));
+  double *b = static_cast<double *>(malloc(n * sizeof(double)));
+  double *c = static_cast<double *>(malloc(n * sizeof(double)));
+  if (!a || !b || !c) errorQuda("Failed to allocate %zu MiB arrays", array_mb);
+
+  for (auto p : {a, b, c}) {
+    if (placement == NUMA_PLACEMENT_NONE) {
+      // everything lands on the node of the master thread
+      for (size_t i = 0; i < n; i++) p[i] = 0.0;
+    } else {
+      numaFirstTouch(p, n * sizeof(double), placement);
+    }
+  }
+
+#pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < n; i++) {
+    b[i] = 1.0;
+    c[i] = 2.0;
+  }
+
+  const double s = 3.0;
+  double best = 0.0;
+  for (int it = 0; it < iter; it++) {
+    quda::Timer timer;
+    timer.Start(__func__, __FILE__, __LINE__);
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; i++) a[i] = b[i] + s * c[i];
+    timer.Stop(__func__, __FILE__, __LINE__);
+    best = std::max(best, 3 * n * sizeof(double) / (timer.Last() * 1e9));
+  }
+
+  for (size_t i = 0; i < n; i++)
+    if (a[i] != 7.0) errorQuda("Triad check failed at %zu: %e", i, a[i]);
+
+  free(c);
+  free(b);
+  free(a);
+  return best;
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  app->add_option("--array-mb", array_mb, "Size of each triad array in MiB (default 512)");
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+
+#ifdef _OPENMP
+  const int nthreads = omp_get_max_threads();
+#else
+  const int nthreads = 1;
+  warningQuda("OpenMP is not enabled: placement policies only differ with multiple threads");
+#endif
+  const int bound = bindHostThreads();
+  printfQuda("NUMA nodes = %d, threads = %d (%d bound)\n", numaNodeCount(), nthreads, bound);
+
+  const size_t n = array_mb * 1024 * 1024 / sizeof(double);
+  const int iter = std::max(niter, 1);
+  for (auto placement : {NUMA_PLACEMENT_NONE, NUMA_PLACEMENT_INTERLEAVE, NUMA_PLACEMENT_LOCAL}) {
+    printfQuda("%-20s triad bandwidth = %8.2f GB/s\n", placement_str(placement), triad(placement, n, iter));
+  }
+
+  finalizeComms();
+  return 0;
+}
@@ -101,7 +101,7 @@ int main(int argc, char **argv)
   bool load_gauge = strcmp(latfile, "");
   // load in the command line supplied gauge field
   if (load_gauge) {
-    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    load_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
     construct_gauge_field(gauge, 2, gauge_param.cpu_prec, &gauge_param);
   }
 
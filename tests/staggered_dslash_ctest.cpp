@@ -217,7 +217,7 @@ void init(int precision, QudaReconstructType link_recon, int partition)
   // load a field WITHOUT PHASES
   if (strcmp(latfile,"")) {
     if (!gauge_loaded) {
-      read_gauge_field(latfile, qdp_inlink, gauge_param.cpu_prec, gauge_param.X, argc_copy, argv_copy);
+      load_gauge_field(latfile, qdp_inlink, gauge_param.cpu_prec, gauge_param.X, argc_copy, argv_copy);
       if (dslash_type != QUDA_LAPLACE_DSLASH) {
         applyGaugeFieldScaling_long(qdp_inlink, Vh, &gauge_param, QUDA_STAGGERED_DSLASH, gauge_param.cpu_prec);
       }
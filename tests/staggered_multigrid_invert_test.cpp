@@ -248,6 +248,7 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     mg_param.num_setup_iter[i] = num_setup_iter[i];
     mg_param.setup_tol[i] = setup_tol[i];
     mg_param.setup_maxiter[i] = setup_maxiter[i];
+    mg_param.setup_batch_size[i] = setup_batch_size[i];
 
     // Basis to use for CA-CGN(E/R) setup
     mg_param.setup_ca_basis[i] = setup_ca_basis[i];
@@ -404,6 +405,10 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     if (strcmp(mg_param.vec_infile[i], "") != 0) mg_param.vec_load[i] = QUDA_BOOLEAN_TRUE;
     if (strcmp(mg_param.vec_outfile[i], "") != 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
   }
+  strcpy(mg_param.checkpoint_infile, mg_checkpoint_infile);
+  strcpy(mg_param.checkpoint_outfile, mg_checkpoint_outfile);
+  mg_param.checkpoint_load = strcmp(mg_checkpoint_infile, "") != 0 ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  mg_param.checkpoint_store = strcmp(mg_checkpoint_outfile, "") != 0 ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
@@ -500,6 +505,7 @@ int main(int argc, char **argv)
     num_setup_iter[i] = 1;
     setup_tol[i] = 5e-6;
     setup_maxiter[i] = 500;
+    setup_batch_size[i] = 1;
     mu_factor[i] = 1.;
     coarse_solve_type[i] = QUDA_INVALID_SOLVE;
     smoother_solve_type[i] = QUDA_INVALID_SOLVE;
@@ -652,7 +658,7 @@ int main(int argc, char **argv)
 
   // load a field WITHOUT PHASES
   if (strcmp(latfile, "")) {
-    read_gauge_field(latfile, qdp_inlink, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    load_gauge_field(latfile, qdp_inlink, gauge_param.cpu_prec, gauge_param.X, argc, argv);
     if (dslash_type != QUDA_LAPLACE_DSLASH) {
       applyGaugeFieldScaling_long(qdp_inlink, Vh, &gauge_param, QUDA_STAGGERED_DSLASH, gauge_param.cpu_prec);
     }
@@ -787,6 +793,8 @@ int main(int argc, char **argv)
   void *mg_preconditioner = newMultigridQuda(&mg_param);
   inv_param.preconditioner = mg_preconditioner;
 
+  if (mg_param.checkpoint_store == QUDA_BOOLEAN_TRUE) dumpMultigridQuda(mg_preconditioner, &mg_param);
+
   // Test: create a dummy invert param just to make sure
   // we're setting up gauge fields and such correctly.
 
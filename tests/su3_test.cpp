@@ -3,11 +3,14 @@
 #include <time.h>
 #include <math.h>
 #include <string.h>
+#include <vector>
+#include <algorithm>
 
 #include <util_quda.h>
 #include <test_util.h>
 #include <test_params.h>
 #include <dslash_util.h>
+#include <wilson_flow_reference.h>
 #include "misc.h"
 
 #include <qio_field.h>
@@ -58,6 +61,7 @@ void display_test_info()
     printfQuda(" - epsilon %f\n", wflow_epsilon);
     printfQuda(" - Wilson flow steps %d\n", wflow_steps);
     printfQuda(" - Wilson flow type %s\n", wflow_type == QUDA_WFLOW_TYPE_WILSON ? "Wilson" : "Symanzik");
+    if (wflow_tol > 0.0) printfQuda(" - Adaptive step size with tolerance %e\n", wflow_tol);
     printfQuda(" - Measurement interval %d\n", measurement_interval);
     break;
   default: errorQuda("Undefined test type %d given", test_type);
@@ -152,7 +156,7 @@ int main(int argc, char **argv)
 
   // load in the command line supplied gauge field
   if (strcmp(latfile, "")) {
-    read_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
+    load_gauge_field(latfile, gauge, gauge_param.cpu_prec, gauge_param.X, argc, argv);
     construct_gauge_field(gauge, 2, gauge_param.cpu_prec, &gauge_param);
   } else { // else generate an SU(3) field
     if (unit_gauge) {
@@ -172,6 +176,8 @@ int main(int argc, char **argv)
   printfQuda("Computed plaquette gauge precise is %.16e (spatial = %.16e, temporal = %.16e)\n", plaq[0], plaq[1],
              plaq[2]);
 
+  bool test_fail = false;
+
 #ifdef GPU_GAUGE_TOOLS
 
   // All user inputs now defined
@@ -254,11 +260,50 @@ int main(int argc, char **argv)
     // Wilson Flow
     // Start the timer
     time0 = -((double)clock());
-    performWFlownStep(wflow_steps, wflow_epsilon, measurement_interval, wflow_type);
+    if (wflow_tol > 0.0) {
+      // measure at the same flow times as the fixed step flow
+      std::vector<double> meas_times;
+      for (int i = measurement_interval; i < wflow_steps; i += measurement_interval)
+        meas_times.push_back(i * wflow_epsilon);
+      meas_times.push_back(wflow_steps * wflow_epsilon);
+      performWFlowAdaptive(meas_times.size(), meas_times.data(), wflow_epsilon, wflow_tol, wflow_type);
+    } else {
+      performWFlownStep(wflow_steps, wflow_epsilon, measurement_interval, wflow_type);
+    }
     // stop the timer
     time0 += clock();
     time0 /= CLOCKS_PER_SEC;
     printfQuda("Total time for Wilson Flow = %g secs\n", time0);
+
+    if (verify_results && wflow_tol > 0.0) {
+      if (comm_size() > 1 || gauge_param.cpu_prec != QUDA_DOUBLE_PRECISION) {
+        printfQuda("Skipping the host flow reference, which needs a single process and double precision\n");
+      } else {
+        // flow the host field with the same integrator
+        void *ref_gauge[4];
+        for (int dir = 0; dir < 4; dir++) {
+          ref_gauge[dir] = malloc(V * gaugeSiteSize * gSize);
+          memcpy(ref_gauge[dir], gauge[dir], V * gaugeSiteSize * gSize);
+        }
+        int ref_steps = wflow_reference(ref_gauge, wflow_steps * wflow_epsilon, wflow_epsilon, wflow_tol, wflow_type);
+
+        double ref_plaq[3];
+        plaquette_reference(ref_plaq, ref_gauge);
+        QudaGaugeObservableParam obs_param = newQudaGaugeObservableParam();
+        obs_param.compute_plaquette = QUDA_BOOLEAN_TRUE;
+        gaugeObservablesQuda(&obs_param);
+
+        double deviation = fabs(obs_param.plaquette[0] - ref_plaq[0]);
+        printfQuda("Host reference flow took %d steps, plaquette %.16e, deviation %e\n", ref_steps, ref_plaq[0],
+                   deviation);
+        const double plaq_tol = prec == QUDA_DOUBLE_PRECISION ? std::max(10 * wflow_tol, 1e-12) : 1e-5;
+        if (deviation > plaq_tol) {
+          warningQuda("Adaptive flow deviates from the host reference by %e > %e", deviation, plaq_tol);
+          test_fail = true;
+        }
+        for (int dir = 0; dir < 4; dir++) free(ref_gauge[dir]);
+      }
+    }
     break;
   default: errorQuda("Undefined test type %d given", test_type);
   }
@@ -279,5 +324,5 @@ int main(int argc, char **argv)
   }
 
   finalizeComms();
-  return 0;
+  return test_fail ? 1 : 0;
 }
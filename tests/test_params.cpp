@@ -53,6 +53,10 @@ int test_type = 0;
 quda::mgarray<int> nvec = {};
 quda::mgarray<char[256]> mg_vec_infile;
 quda::mgarray<char[256]> mg_vec_outfile;
+char mg_checkpoint_infile[256] = "";
+char mg_checkpoint_outfile[256] = "";
+bool mg_adaptive_refresh = false;
+double mg_refresh_growth = 1.25;
 QudaInverterType inv_type;
 bool inv_deflate = false;
 QudaInverterType precon_type = QUDA_INVALID_INVERTER;
@@ -100,6 +104,7 @@ quda::mgarray<int> num_setup_iter = {};
 quda::mgarray<double> setup_tol = {};
 quda::mgarray<int> setup_maxiter = {};
 quda::mgarray<int> setup_maxiter_refresh = {};
+quda::mgarray<int> setup_batch_size = {};
 quda::mgarray<QudaCABasis> setup_ca_basis = {};
 quda::mgarray<int> setup_ca_basis_size = {};
 quda::mgarray<double> setup_ca_lambda_min = {};
@@ -144,7 +149,8 @@ QudaMemoryType mem_type_ritz = QUDA_MEMORY_DEVICE;
 int eig_nEv = 16;
 int eig_nKr = 32;
 int eig_nConv = -1; // If unchanged, will be set to nEv
-int eig_batched_rotate = 0; // If unchanged, will be set to maximum
+int eig_batched_rotate = 0; // If unchanged, will be chosen from the free device memory
+int eig_block_size = 4;
 bool eig_require_convergence = true;
 int eig_check_interval = 10;
 int eig_max_restarts = 1000;
@@ -199,6 +205,7 @@ double ape_smear_rho = 0.6;
 int smear_steps = 50;
 double wflow_epsilon = 0.01;
 int wflow_steps = 100;
+double wflow_tol = 0.0;
 QudaWFlowType wflow_type = QUDA_WFLOW_TYPE_WILSON;
 int measurement_interval = 5;
 
@@ -252,7 +259,8 @@ namespace
                                                            {"ca-cg", QUDA_CA_CG_INVERTER},
                                                            {"ca-cgne", QUDA_CA_CGNE_INVERTER},
                                                            {"ca-cgnr", QUDA_CA_CGNR_INVERTER},
-                                                           {"ca-gcr", QUDA_CA_GCR_INVERTER}};
+                                                           {"ca-gcr", QUDA_CA_GCR_INVERTER},
+                                                           {"pipelined-cg", QUDA_PIPELINED_CG_INVERTER}};
 
   CLI::TransformPairs<QudaPrecision> precision_map {{"double", QUDA_DOUBLE_PRECISION},
                                                     {"single", QUDA_SINGLE_PRECISION},
@@ -266,7 +274,10 @@ namespace
                                                            {"mat-pc-dag-mat-pc", QUDA_MATPCDAG_MATPC_SOLUTION}};
 
   CLI::TransformPairs<QudaEigType> eig_type_map {
-    {"trlm", QUDA_EIG_TR_LANCZOS}, {"irlm", QUDA_EIG_IR_LANCZOS}, {"iram", QUDA_EIG_IR_ARNOLDI}};
+    {"trlm", QUDA_EIG_TR_LANCZOS},
+    {"irlm", QUDA_EIG_IR_LANCZOS},
+    {"iram", QUDA_EIG_IR_ARNOLDI},
+    {"blktrlm", QUDA_EIG_BLK_TR_LANCZOS}};
 
   CLI::TransformPairs<QudaSolveType> solve_type_map {
     {"direct", QUDA_DIRECT_SOLVE},       {"direct-pc", QUDA_DIRECT_PC_SOLVE}, {"normop", QUDA_NORMOP_SOLVE},
@@ -420,10 +431,11 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
   quda_app->add_option("--precon-type", precon_type, "The type of solver to use (default none (=unspecified)).")
     ->transform(CLI::QUDACheckedTransformer(inverter_type_map));
 
-  CLI::TransformPairs<int> rank_order_map {{"col", 0}, {"row", 1}};
+  CLI::TransformPairs<int> rank_order_map {{"col", 0}, {"row", 1}, {"node", 2}};
   quda_app
     ->add_option("--rank-order", rank_order,
-                 "Set the [t][z][y][x] rank order as either column major (t fastest, default) or row major (x fastest)")
+                 "Set the [t][z][y][x] rank order as either column major (t fastest, default), row major (x fastest) "
+                 "or node aware (ranks sharing a node packed into sub-blocks)")
     ->transform(CLI::QUDACheckedTransformer(rank_order_map));
 
   quda_app->add_option("--recon", link_recon, "Link reconstruction type")
@@ -547,7 +559,9 @@ void add_eigen_option_group(std::shared_ptr<QUDAApp> quda_app)
   opgroup->add_option("--eig-nEv", eig_nEv, "The size of eigenvector search space in the eigensolver");
   opgroup->add_option("--eig-nKr", eig_nKr, "The size of the Krylov subspace to use in the eigensolver");
   opgroup->add_option("--eig-batched-rotate", eig_batched_rotate,
-                      "The maximum number of extra eigenvectors the solver may allocate to perform a Ritz rotation.");
+                      "The maximum number of extra eigenvectors the solver may allocate to perform a Ritz rotation (default 0, chosen from the free device memory)");
+  opgroup->add_option("--eig-block-size", eig_block_size,
+                      "The number of vectors the block TRLM applies the operator to at once (default 4)");
   opgroup->add_option("--eig-poly-deg", eig_poly_deg, "TODO");
   opgroup->add_option(
     "--eig-require-convergence",
@@ -660,7 +674,7 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
                          "The size of the Krylov subspace to use in the eigensolver");
   quda_app->add_mgoption(
     opgroup, "--mg-eig-batched-rotate", mg_eig_batched_rotate, CLI::Validator(),
-    "The maximum number of extra eigenvectors the solver may allocate to perform a Ritz rotation.");
+    "The maximum number of extra eigenvectors the solver may allocate to perform a Ritz rotation (default 0, chosen from the free device memory)");
   quda_app->add_mgoption(opgroup, "--mg-eig-poly-deg", mg_eig_poly_deg, CLI::PositiveNumber,
                          "Set the degree of the Chebyshev polynomial (default 100)");
   quda_app->add_mgoption(
@@ -694,6 +708,17 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
                          "Load the vectors <file> for the multigrid_test (requires QIO)");
   quda_app->add_mgoption(opgroup, "--mg-save-vec", mg_vec_outfile, CLI::Validator(),
                          "Save the generated null-space vectors <file> from the multigrid_test (requires QIO)");
+  opgroup->add_option("--mg-load-checkpoint", mg_checkpoint_infile,
+                      "Restore the multigrid hierarchy from the checkpoint <file> if it matches the gauge field and "
+                      "parameters, skipping the setup");
+  opgroup->add_option("--mg-save-checkpoint", mg_checkpoint_outfile,
+                      "Save a checkpoint of the multigrid hierarchy to <file> after the setup");
+  opgroup->add_option("--mg-adaptive-refresh", mg_adaptive_refresh,
+                      "When the multigrid operator is updated, only refresh the null space once the solves have "
+                      "become more expensive, otherwise just rebuild the coarse operators (default false)");
+  opgroup->add_option("--mg-refresh-growth", mg_refresh_growth,
+                      "Growth of the outer iteration count or coarse-solve time that triggers a null-space refresh "
+                      "with --mg-adaptive-refresh (default 1.25)");
 
   opgroup->add_option(
     "--mg-low-mode-check", low_mode_check,
@@ -745,6 +770,9 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
   quda_app->add_mgoption(
     opgroup, "--mg-setup-maxiter-refresh", setup_maxiter_refresh, CLI::Validator(),
     "The maximum number of solver iterations to use when refreshing the pre-existing null space vectors (default 100)");
+  quda_app->add_mgoption(opgroup, "--mg-setup-batch-size", setup_batch_size, CLI::PositiveNumber,
+                         "The number of null space vectors relaxed together with a multi-source coarse operator, "
+                         "on levels 1+ with the mr setup solver (default 1)");
   quda_app->add_mgoption(opgroup, "--mg-setup-tol", setup_tol, CLI::Validator(),
                          "The tolerance to use for the setup of multigrid (default 5e-6)");
 
@@ -790,6 +818,10 @@ void add_su3_option_group(std::shared_ptr<QUDAApp> quda_app)
   opgroup->add_option("--su3-wflow-steps", wflow_steps,
                       "The number of steps in the Runge-Kutta integrator (default 100)");
 
+  opgroup->add_option("--su3-wflow-tol", wflow_tol,
+                      "Tolerance on the local error of an adaptive step size flow to the same flow time (default 0, "
+                      "fixed step size)");
+
   opgroup->add_option("--su3-wflow-type", wflow_type, "The type of action to use in the wilson flow (default wilson)")
     ->transform(CLI::QUDACheckedTransformer(wflow_type_map));
   ;
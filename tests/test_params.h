@@ -186,6 +186,10 @@ extern int test_type;
 extern quda::mgarray<int> nvec;
 extern quda::mgarray<char[256]> mg_vec_infile;
 extern quda::mgarray<char[256]> mg_vec_outfile;
+extern char mg_checkpoint_infile[256];
+extern char mg_checkpoint_outfile[256];
+extern bool mg_adaptive_refresh;
+extern double mg_refresh_growth;
 extern QudaInverterType inv_type;
 extern bool inv_deflate;
 extern QudaInverterType precon_type;
@@ -233,6 +237,7 @@ extern quda::mgarray<int> num_setup_iter;
 extern quda::mgarray<double> setup_tol;
 extern quda::mgarray<int> setup_maxiter;
 extern quda::mgarray<int> setup_maxiter_refresh;
+extern quda::mgarray<int> setup_batch_size;
 extern quda::mgarray<QudaCABasis> setup_ca_basis;
 extern quda::mgarray<int> setup_ca_basis_size;
 extern quda::mgarray<double> setup_ca_lambda_min;
@@ -276,7 +281,8 @@ extern QudaMemoryType mem_type_ritz;
 extern int eig_nEv;
 extern int eig_nKr;
 extern int eig_nConv; // If unchanged, will be set to nEv
-extern int eig_batched_rotate; // If unchanged, will be set to maximum
+extern int eig_batched_rotate; // If unchanged, will be chosen from the free device memory
+extern int eig_block_size;
 extern bool eig_require_convergence;
 extern int eig_check_interval;
 extern int eig_max_restarts;
@@ -331,6 +337,7 @@ extern double ape_smear_rho;
 extern int smear_steps;
 extern double wflow_epsilon;
 extern int wflow_steps;
+extern double wflow_tol;
 extern QudaWFlowType wflow_type;
 extern int measurement_interval;
 
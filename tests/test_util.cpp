@@ -93,8 +93,8 @@ void initComms(int argc, char **argv, int *const commDims)
   QMP_thread_level_t tl;
   QMP_init_msg_passing(&argc, &argv, QMP_THREAD_SINGLE, &tl);
 
-  // make sure the QMP logical ordering matches QUDA's
-  if (rank_order == 0) {
+  // make sure the QMP logical ordering matches QUDA's (the node-aware order falls back to column major)
+  if (rank_order != 1) {
     int map[] = {3, 2, 1, 0};
     QMP_declare_logical_topology_map(commDims, 4, map, 4);
   } else {
@@ -105,13 +105,33 @@ void initComms(int argc, char **argv, int *const commDims)
   MPI_Init(&argc, &argv);
 #endif
 
-  QudaCommsMap func = rank_order == 0 ? lex_rank_from_coords_t : lex_rank_from_coords_x;
+  QudaCommsMap func = rank_order == 1 ? lex_rank_from_coords_x : lex_rank_from_coords_t;
+  void *map_data = NULL;
+
+  CommNodeMapData node_map_data;
+#ifndef QMP_COMMS
+  if (rank_order == 2) {
+    // use the local lattice size to weight the halo surfaces
+    int local_dims[4] = {xdim, ydim, zdim, tdim};
+    node_map_data.ndim = 4;
+    for (int i = 0; i < 4; i++) {
+      node_map_data.dims[i] = commDims[i];
+      node_map_data.local_dims[i] = local_dims[i];
+    }
+    func = comm_node_rank_from_coords;
+    map_data = &node_map_data;
+  }
+#endif
 
-  initCommsGridQuda(4, commDims, func, NULL);
+  initCommsGridQuda(4, commDims, func, map_data);
   initRand();
 
-  printfQuda("Rank order is %s major (%s running fastest)\n",
-	     rank_order == 0 ? "column" : "row", rank_order == 0 ? "t" : "x");
+  if (map_data) {
+    printfQuda("Rank order is node aware (ranks on a node packed into sub-blocks)\n");
+  } else {
+    printfQuda("Rank order is %s major (%s running fastest)\n", rank_order == 1 ? "row" : "column",
+               rank_order == 1 ? "x" : "t");
+  }
 
 }
 
@@ -1216,6 +1236,17 @@ static void checkGauge(Float **oldG, Float **newG, double epsilon) {
 
 }
 
+uint32_t crc32_reference(const void *data, size_t bytes)
+{
+  auto p = static_cast<const unsigned char *>(data);
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < bytes; i++) {
+    crc ^= p[i];
+    for (int k = 0; k < 8; k++) crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
 void check_gauge(void **oldG, void **newG, double epsilon, QudaPrecision precision) {
   if (precision == QUDA_DOUBLE_PRECISION)
     checkGauge((double**)oldG, (double**)newG, epsilon);
@@ -81,6 +81,12 @@
 
   void check_gauge(void **, void **, double epsilon, QudaPrecision precision);
 
+  /**
+     @brief Bitwise CRC32 (reflected polynomial 0xEDB88320), the
+     reference for the SciDAC-style field checksums
+  */
+  uint32_t crc32_reference(const void *data, size_t bytes);
+
   int strong_check_link(void ** linkA, const char* msgA,  void **linkB, const char* msgB, int len, QudaPrecision prec);
   int strong_check_mom(void * momA, void *momB, int len, QudaPrecision prec);
   
@@ -94,6 +100,32 @@
 
   //void readGaugeField(char *filename, float *gauge[], int argc, char *argv[]);
 
+  // ---------- gauge_io.cpp ----------
+
+  /**
+     @brief Load a NERSC archive configuration (3x3 or 3x2-compressed
+     links, either byte order, single or double precision) into the
+     QDP ordered host field gauge.  The checksum, plaquette and link
+     trace are checked against the header.
+     @param[in] X Local lattice dimensions
+  */
+  void read_nersc_gauge_field(const char *filename, void *gauge[], QudaPrecision precision, const int *X);
+
+  /**
+     @brief Load a MILC native binary configuration (natural site
+     order) into the QDP ordered host field gauge, checking the
+     checksums of the header
+     @param[in] X Local lattice dimensions
+  */
+  void read_milc_gauge_field(const char *filename, void *gauge[], QudaPrecision precision, const int *X);
+
+  /**
+     @brief Load a configuration, detecting the NERSC and MILC native
+     formats and otherwise reading it with QIO
+  */
+  void load_gauge_field(const char *filename, void *gauge[], QudaPrecision precision, const int *X, int argc,
+                        char *argv[]);
+
   // additions for dw (quickly hacked on)
   int fullLatticeIndex_4d(int i, int oddBit);
   int fullLatticeIndex_5d(int i, int oddBit);
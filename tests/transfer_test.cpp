@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+#include <test_util.h>
+#include <test_params.h>
+
+// google test
+#include <gtest/gtest.h>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <transfer.h>
+
+/**
+   Test of the multigrid transfer operators.  A transfer operator is
+   built from random null-space vectors, and a set of random vectors is
+   prolongated and restricted with the fused multi-vector Transfer::P
+   and Transfer::R on the host, and one vector at a time on the host
+   and on the device.  All of them must agree to rounding.
+ */
+
+using namespace quda;
+
+static const int n_null = 24;
+static const int n_src = 5;
+static int geo_bs[QUDA_MAX_DIM] = {2, 2, 2, 2};
+static const int spin_bs = 2;
+static const double transfer_tol = 1e-12;
+
+static TimeProfile profile("transfer_test");
+static std::vector<ColorSpinorField *> B;
+static Transfer *transfer = nullptr;
+
+static ColorSpinorParam fineParam()
+{
+  ColorSpinorParam csParam;
+  csParam.nColor = 3;
+  csParam.nSpin = 4;
+  csParam.nDim = 4;
+  csParam.x[0] = xdim;
+  csParam.x[1] = ydim;
+  csParam.x[2] = zdim;
+  csParam.x[3] = tdim;
+  csParam.setPrecision(QUDA_DOUBLE_PRECISION);
+  csParam.pad = 0;
+  csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  csParam.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  csParam.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
+  csParam.pc_type = QUDA_4D_PC;
+  csParam.location = QUDA_CPU_FIELD_LOCATION;
+  csParam.create = QUDA_ZERO_FIELD_CREATE;
+  return csParam;
+}
+
+/**
+   @brief Create n fields on the fine or the coarse lattice, at the
+   given location, and optionally fill them with random numbers
+*/
+static std::vector<ColorSpinorField *> createFields(int n, bool coarse, QudaFieldLocation location, bool random)
+{
+  std::vector<ColorSpinorField *> fields(n);
+  for (auto &f : fields) {
+    ColorSpinorParam csParam = fineParam();
+    ColorSpinorField *fine = new cpuColorSpinorField(csParam);
+    f = coarse ? fine->CreateCoarse(geo_bs, spin_bs, n_null, QUDA_DOUBLE_PRECISION, QUDA_CPU_FIELD_LOCATION) : fine;
+    if (coarse) delete fine;
+    if (random) f->Source(QUDA_RANDOM_SOURCE);
+    if (location == QUDA_CUDA_FIELD_LOCATION) {
+      ColorSpinorParam dParam(*f);
+      dParam.location = QUDA_CUDA_FIELD_LOCATION;
+      dParam.fieldOrder = QUDA_FLOAT2_FIELD_ORDER;
+      dParam.create = QUDA_NULL_FIELD_CREATE;
+      ColorSpinorField *d = ColorSpinorField::Create(dParam);
+      *d = *f;
+      delete f;
+      f = d;
+    }
+  }
+  return fields;
+}
+
+static void destroyFields(std::vector<ColorSpinorField *> &fields)
+{
+  for (auto f : fields) delete f;
+  fields.clear();
+}
+
+/**
+   @return The largest norm of ref[i] - out[i] relative to the norm of
+   ref[i], where out may live on the device
+*/
+static double deviation(const std::vector<ColorSpinorField *> &ref, const std::vector<ColorSpinorField *> &out)
+{
+  double dev = 0.0;
+  for (unsigned int i = 0; i < ref.size(); i++) {
+    ColorSpinorParam csParam(*ref[i]);
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    cpuColorSpinorField o(csParam);
+    o = *out[i];
+    double ref2 = blas::norm2(*ref[i]);
+    dev = std::max(dev, sqrt(blas::xmyNorm(*ref[i], o) / ref2));
+  }
+  return dev;
+}
+
+TEST(Transfer, prolongate)
+{
+  auto in = createFields(n_src, true, QUDA_CPU_FIELD_LOCATION, true);
+  auto ref = createFields(n_src, false, QUDA_CPU_FIELD_LOCATION, false);
+  auto out = createFields(n_src, false, QUDA_CPU_FIELD_LOCATION, false);
+
+  transfer->setTransferGPU(false);
+  for (int i = 0; i < n_src; i++) transfer->P(*ref[i], *in[i]);
+  transfer->P(out, in);
+  double dev = deviation(ref, out);
+  printfQuda("Fused host prolongation of %d vectors: deviation = %e\n", n_src, dev);
+  EXPECT_LE(dev, transfer_tol);
+
+  auto in_d = createFields(n_src, true, QUDA_CUDA_FIELD_LOCATION, false);
+  auto out_d = createFields(n_src, false, QUDA_CUDA_FIELD_LOCATION, false);
+  for (int i = 0; i < n_src; i++) *in_d[i] = *in[i];
+
+  transfer->setTransferGPU(true);
+  for (int i = 0; i < n_src; i++) transfer->P(*out_d[i], *in_d[i]);
+  dev = deviation(ref, out_d);
+  printfQuda("Device prolongation: deviation = %e\n", dev);
+  EXPECT_LE(dev, transfer_tol);
+
+  transfer->P(out_d, in_d);
+  dev = deviation(ref, out_d);
+  printfQuda("Multi-vector device prolongation: deviation = %e\n", dev);
+  EXPECT_LE(dev, transfer_tol);
+
+  destroyFields(out_d);
+  destroyFields(in_d);
+  destroyFields(out);
+  destroyFields(ref);
+  destroyFields(in);
+}
+
+TEST(Transfer, restrict)
+{
+  auto in = createFields(n_src, false, QUDA_CPU_FIELD_LOCATION, true);
+  auto ref = createFields(n_src, true, QUDA_CPU_FIELD_LOCATION, false);
+  auto out = createFields(n_src, true, QUDA_CPU_FIELD_LOCATION, false);
+
+  transfer->setTransferGPU(false);
+  for (int i = 0; i < n_src; i++) transfer->R(*ref[i], *in[i]);
+  transfer->R(out, in);
+  double dev = deviation(ref, out);
+  printfQuda("Fused host restriction of %d vectors: deviation = %e\n", n_src, dev);
+  EXPECT_LE(dev, transfer_tol);
+
+  auto in_d = createFields(n_src, false, QUDA_CUDA_FIELD_LOCATION, false);
+  auto out_d = createFields(n_src, true, QUDA_CUDA_FIELD_LOCATION, false);
+  for (int i = 0; i < n_src; i++) *in_d[i] = *in[i];
+
+  transfer->setTransferGPU(true);
+  for (int i = 0; i < n_src; i++) transfer->R(*out_d[i], *in_d[i]);
+  dev = deviation(ref, out_d);
+  printfQuda("Device restriction: deviation = %e\n", dev);
+  EXPECT_LE(dev, transfer_tol);
+
+  transfer->R(out_d, in_d);
+  dev = deviation(ref, out_d);
+  printfQuda("Multi-vector device restriction: deviation = %e\n", dev);
+  EXPECT_LE(dev, transfer_tol);
+
+  destroyFields(out_d);
+  destroyFields(in_d);
+  destroyFields(out);
+  destroyFields(ref);
+  destroyFields(in);
+}
+
+int main(int argc, char **argv)
+{
+  // command line options
+  auto app = make_app();
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+  int X[4] = {xdim, ydim, zdim, tdim};
+  setDims(X);
+  initQuda(device);
+
+  // the null space is block orthogonalized on the host
+  B = createFields(n_null, false, QUDA_CPU_FIELD_LOCATION, true);
+  transfer = new Transfer(B, n_null, 1, geo_bs, spin_bs, QUDA_DOUBLE_PRECISION, profile);
+
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+
+  delete transfer;
+  destroyFields(B);
+  endQuda();
+  finalizeComms();
+  return result;
+}
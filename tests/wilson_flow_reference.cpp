@@ -0,0 +1,356 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <algorithm>
+
+#include <test_util.h>
+#include <wilson_flow_reference.h>
+
+extern int V;
+
+using complex = std::complex<double>;
+
+struct su3 {
+  complex e[3][3];
+
+  su3 operator*(const su3 &b) const
+  {
+    su3 c;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+        for (int k = 0; k < 3; k++) c.e[i][j] += e[i][k] * b.e[k][j];
+    return c;
+  }
+
+  su3 operator+(const su3 &b) const
+  {
+    su3 c;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) c.e[i][j] = e[i][j] + b.e[i][j];
+    return c;
+  }
+
+  su3 operator-(const su3 &b) const
+  {
+    su3 c;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) c.e[i][j] = e[i][j] - b.e[i][j];
+    return c;
+  }
+
+  su3 operator*(double a) const
+  {
+    su3 c;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) c.e[i][j] = a * e[i][j];
+    return c;
+  }
+};
+
+static su3 dagger(const su3 &a)
+{
+  su3 b;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) b.e[i][j] = std::conj(a.e[j][i]);
+  return b;
+}
+
+static su3 identity()
+{
+  su3 a;
+  for (int i = 0; i < 3; i++) a.e[i][i] = 1.0;
+  return a;
+}
+
+// traceless anti-hermitian part, as makeAntiHerm
+static su3 antiHerm(const su3 &a)
+{
+  su3 b = (a - dagger(a)) * 0.5;
+  complex tr = (b.e[0][0] + b.e[1][1] + b.e[2][2]) / 3.0;
+  for (int i = 0; i < 3; i++) b.e[i][i] -= tr;
+  return b;
+}
+
+// exponential by scaling and squaring of a Taylor series
+static su3 expm(const su3 &a)
+{
+  double norm = 0.0;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) norm = std::max(norm, std::abs(a.e[i][j]));
+  int squarings = 0;
+  while (norm > 0.1) {
+    norm /= 2.0;
+    squarings++;
+  }
+  su3 x = a * pow(0.5, squarings);
+
+  su3 sum = identity(), term = identity();
+  for (int k = 1; k < 16; k++) {
+    term = (term * x) * (1.0 / k);
+    sum = sum + term;
+  }
+  for (int k = 0; k < squarings; k++) sum = sum * sum;
+  return sum;
+}
+
+using Field = std::vector<su3>; // index 4 * site + dir
+
+static int neighbor(int i, int dir, int step)
+{
+  int dx[4] = {0, 0, 0, 0};
+  dx[dir] = step;
+  return neighborIndexFullLattice(i, dx[3], dx[2], dx[1], dx[0]);
+}
+
+// product of the links along a path of signed directions (+/- (dir + 1)) from site i
+static su3 path(const Field &U, int i, const std::vector<int> &dirs)
+{
+  su3 p = identity();
+  for (int d : dirs) {
+    const int dir = abs(d) - 1;
+    if (d > 0) {
+      p = p * U[4 * i + dir];
+      i = neighbor(i, dir, 1);
+    } else {
+      i = neighbor(i, dir, -1);
+      p = p * dagger(U[4 * i + dir]);
+    }
+  }
+  return p;
+}
+
+// staple and 1x2 rectangle sums of the link U_nu(i), over the directions mu < n_dim, as computeStapleRectangle
+static void staples(su3 &staple, su3 &rectangle, const Field &U, int i, int nu, int n_dim)
+{
+  staple = su3();
+  rectangle = su3();
+  const int n = nu + 1;
+  for (int mu = 0; mu < n_dim; mu++) {
+    if (mu == nu) continue;
+    for (int s = -1; s <= 1; s += 2) {
+      const int m = s * (mu + 1);
+      staple = staple + path(U, i, {m, n, -m});
+      rectangle = rectangle + path(U, i, {m, m, n, -m, -m});
+      rectangle = rectangle + path(U, i, {m, n, n, -m, -n});
+      rectangle = rectangle + path(U, i, {-n, m, n, n, -m});
+    }
+  }
+}
+
+// Z = staple * U^dag of the link U_nu(i), as computeStaple in the flow kernel
+static su3 computeZ(const Field &U, int i, int nu, QudaWFlowType wflow_type)
+{
+  su3 staple, rectangle;
+  staples(staple, rectangle, U, i, nu, 4);
+  su3 Z = wflow_type == QUDA_WFLOW_TYPE_SYMANZIK ? staple * (5.0 / 3.0) + rectangle * (-1.0 / 12.0) : staple;
+  return Z * dagger(U[4 * i + nu]);
+}
+
+static void computeZ(Field &Z, const Field &U, QudaWFlowType wflow_type)
+{
+#pragma omp parallel for
+  for (int i = 0; i < V; i++)
+    for (int mu = 0; mu < 4; mu++) Z[4 * i + mu] = computeZ(U, i, mu, wflow_type);
+}
+
+/**
+   @brief One step of the flow from W0, returning the third-order
+   update in W3 and the largest deviation of the embedded
+   second-order update from it
+*/
+static double flowStep(Field &W3, const Field &W0, double h, QudaWFlowType wflow_type)
+{
+  const size_t n = W0.size();
+  Field Z0(n), Z1(n), Z2(n), W1(n), W2(n), T(n);
+
+  computeZ(Z0, W0, wflow_type);
+  for (size_t l = 0; l < n; l++) W1[l] = expm(antiHerm(Z0[l] * (h / 4.0))) * W0[l];
+
+  computeZ(Z1, W1, wflow_type);
+  for (size_t l = 0; l < n; l++) {
+    T[l] = Z1[l] * (8.0 / 9.0) - Z0[l] * (17.0 / 36.0);
+    W2[l] = expm(antiHerm(T[l] * h)) * W1[l];
+  }
+
+  computeZ(Z2, W2, wflow_type);
+  double err = 0.0;
+  for (size_t l = 0; l < n; l++) {
+    W3[l] = expm(antiHerm((Z2[l] * (3.0 / 4.0) - T[l]) * h)) * W2[l];
+    su3 W3e = expm(antiHerm((T[l] * (5.0 / 4.0) - Z0[l] * (3.0 / 16.0)) * h)) * W2[l];
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) err = std::max(err, std::abs(W3[l].e[i][j] - W3e.e[i][j]));
+  }
+  return err;
+}
+
+static void load(Field &U, void **gauge)
+{
+  for (int i = 0; i < V; i++)
+    for (int mu = 0; mu < 4; mu++) {
+      const double *g = static_cast<double *>(gauge[mu]) + 18 * i;
+      for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++) U[4 * i + mu].e[a][b] = complex(g[6 * a + 2 * b], g[6 * a + 2 * b + 1]);
+    }
+}
+
+static void save(void **gauge, const Field &U)
+{
+  for (int i = 0; i < V; i++)
+    for (int mu = 0; mu < 4; mu++) {
+      double *g = static_cast<double *>(gauge[mu]) + 18 * i;
+      for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++) {
+          g[6 * a + 2 * b] = U[4 * i + mu].e[a][b].real();
+          g[6 * a + 2 * b + 1] = U[4 * i + mu].e[a][b].imag();
+        }
+    }
+}
+
+int wflow_reference(void **gauge, double t_final, double step_size, double tol, QudaWFlowType wflow_type)
+{
+  Field in(4 * V), out(4 * V);
+  load(in, gauge);
+
+  // same controller as performWFlowAdaptive
+  const double safety = 0.95;
+  const double min_scale = 0.2;
+  const double max_scale = 2.0;
+
+  double t = 0.0;
+  double epsilon = step_size;
+  int steps = 0;
+  while (t < t_final) {
+    const bool last = t + epsilon >= t_final;
+    const double h = last ? t_final - t : epsilon;
+    const double err = flowStep(out, in, h, wflow_type);
+    steps++;
+
+    if (tol <= 0.0) {
+      // fixed step size
+      t = last ? t_final : t + h;
+      std::swap(in, out);
+      continue;
+    }
+
+    const bool finite = std::isfinite(err);
+    double scale = err > 0.0 ? std::min(std::max(safety * cbrt(tol / err), min_scale), max_scale) : max_scale;
+    if (!finite) scale = min_scale;
+    if (finite && err <= tol) {
+      t = last ? t_final : t + h;
+      std::swap(in, out);
+      if (!last || h * scale < epsilon) epsilon = h * scale;
+    } else {
+      epsilon = h * scale;
+    }
+  }
+
+  save(gauge, in);
+  return steps;
+}
+
+static complex determinant(const su3 &a)
+{
+  return a.e[0][0] * (a.e[1][1] * a.e[2][2] - a.e[1][2] * a.e[2][1])
+    - a.e[0][1] * (a.e[1][0] * a.e[2][2] - a.e[1][2] * a.e[2][0])
+    + a.e[0][2] * (a.e[1][0] * a.e[2][1] - a.e[1][1] * a.e[2][0]);
+}
+
+static su3 inverse(const su3 &a)
+{
+  su3 b;
+  const complex det = determinant(a);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) {
+      // cofactor of a(j, i)
+      const int j1 = (j + 1) % 3, j2 = (j + 2) % 3, i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+      b.e[i][j] = (a.e[j1][i1] * a.e[j2][i2] - a.e[j1][i2] * a.e[j2][i1]) / det;
+    }
+  return b;
+}
+
+// projection onto SU(3) through the unitary polar factor, iterated to convergence
+static su3 projectSU3(const su3 &a)
+{
+  su3 w = a;
+  for (int k = 0; k < 100; k++) {
+    su3 next = (w + dagger(inverse(w))) * 0.5;
+    double change = 0.0;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++) change = std::max(change, std::abs(next.e[i][j] - w.e[i][j]));
+    w = next;
+    if (change < 1e-16) break;
+  }
+
+  const complex det = determinant(w);
+  const complex phase = std::pow(std::abs(det), -1.0 / 3.0) * std::exp(complex(0.0, -std::arg(det) / 3.0));
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) w.e[i][j] *= phase;
+  return w;
+}
+
+/**
+   @brief Replace the links of the directions nu < n_dim by update(staple, rectangle, U_nu), computed from the
+   unsmeared field
+*/
+template <typename Update> static void smear(void **gauge, int n_dim, Update update)
+{
+  Field in(4 * V), out(4 * V);
+  load(in, gauge);
+  out = in;
+
+#pragma omp parallel for
+  for (int i = 0; i < V; i++)
+    for (int nu = 0; nu < n_dim; nu++) {
+      su3 staple, rectangle;
+      staples(staple, rectangle, in, i, nu, n_dim);
+      out[4 * i + nu] = update(staple, rectangle, in[4 * i + nu]);
+    }
+
+  save(gauge, out);
+}
+
+void ape_reference(void **gauge, double alpha)
+{
+  smear(gauge, 3, [=](const su3 &staple, const su3 &, const su3 &U) {
+    return projectSU3(identity() * (1.0 - alpha) + staple * (alpha / 4.0) * dagger(U)) * U;
+  });
+}
+
+void stout_reference(void **gauge, double rho)
+{
+  smear(gauge, 3, [=](const su3 &staple, const su3 &, const su3 &U) {
+    return expm(antiHerm(staple * rho * dagger(U))) * U;
+  });
+}
+
+void ovrimpstout_reference(void **gauge, double rho, double epsilon)
+{
+  const double staple_coeff = rho * (5.0 - 2.0 * epsilon) / 3.0;
+  const double rectangle_coeff = -rho * (1.0 - epsilon) / 12.0;
+  smear(gauge, 4, [=](const su3 &staple, const su3 &rectangle, const su3 &U) {
+    return expm(antiHerm((staple * staple_coeff + rectangle * rectangle_coeff) * dagger(U))) * U;
+  });
+}
+
+void plaquette_reference(double plaq[3], void **gauge)
+{
+  Field U(4 * V);
+  load(U, gauge);
+
+  double sum[2] = {0.0, 0.0}; // spatial, temporal
+  for (int i = 0; i < V; i++) {
+    for (int mu = 0; mu < 3; mu++) {
+      for (int nu = mu + 1; nu < 4; nu++) {
+        su3 p = path(U, i, {mu + 1, nu + 1, -(mu + 1), -(nu + 1)});
+        sum[nu == 3] += (p.e[0][0] + p.e[1][1] + p.e[2][2]).real() / 3.0;
+      }
+    }
+  }
+
+  plaq[1] = sum[0] / (3.0 * V);
+  plaq[2] = sum[1] / (3.0 * V);
+  plaq[0] = 0.5 * (plaq[1] + plaq[2]);
+}
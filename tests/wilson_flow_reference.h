@@ -0,0 +1,51 @@
+#pragma once
+
+#include <quda.h>
+
+/**
+   @brief Host reference of the Wilson flow on a double precision,
+   QDP ordered, single process gauge field with periodic boundary
+   conditions.  The field is integrated with the third-order
+   Runge-Kutta scheme of Luscher (https://arxiv.org/abs/1006.4518v3),
+   using the same adaptive step size controller as
+   performWFlowAdaptive if tol > 0, and a fixed step size otherwise.
+   @param[in,out] gauge The gauge field, flowed in place
+   @param[in] t_final Flow time to integrate to
+   @param[in] step_size The (initial) step size
+   @param[in] tol Tolerance on the largest deviation of a link per step
+   @param[in] wflow_type 1x1 Wilson or 2x1 Symanzik flow type
+   @return The number of steps taken, including the rejected ones
+*/
+int wflow_reference(void **gauge, double t_final, double step_size, double tol, QudaWFlowType wflow_type);
+
+/**
+   @brief Host reference of an APE step, smearing the spatial links
+   with the spatial staples as APEStep
+   @param[in,out] gauge The gauge field (double precision, QDP order), smeared in place
+   @param[in] alpha The APE smearing parameter
+*/
+void ape_reference(void **gauge, double alpha);
+
+/**
+   @brief Host reference of a stout step, smearing the spatial links
+   with the spatial staples as STOUTStep
+   @param[in,out] gauge The gauge field (double precision, QDP order), smeared in place
+   @param[in] rho The stout smearing parameter
+*/
+void stout_reference(void **gauge, double rho);
+
+/**
+   @brief Host reference of an over-improved stout step, smearing all
+   links with the staples and rectangles as OvrImpSTOUTStep
+   @param[in,out] gauge The gauge field (double precision, QDP order), smeared in place
+   @param[in] rho The stout smearing parameter
+   @param[in] epsilon The over-improvement parameter
+*/
+void ovrimpstout_reference(void **gauge, double rho, double epsilon);
+
+/**
+   @brief Host reference of the plaquette, normalized as plaqQuda
+   @param[out] plaq Total, spatial and temporal plaquette
+   @param[in] gauge The gauge field (double precision, QDP order)
+*/
+void plaquette_reference(double plaq[3], void **gauge);